@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "utils/aligned_buffer.h"
+#include "utils/config.h"
+
+// ==================== 逐通道均值 / 方差归一化（与滤波同一次遍历） ====================
+//
+// 原 Python 流程在滤波之后再单独做归一化：EEGPreprocess.zscore 按通道 np.mean / np.std，
+// XGBDIM.preprocess_ZT206_HYX 逐试次减去通道均值，每一步都是一次完整的内存遍历。
+// 这里由滤波器组在每块结果写回前调用 ChannelNormalizer：块为"采样点 x 通道"的 double 布局，
+// 统计量在写回前顺带累积，最内层循环沿通道方向连续访问，与二阶节运算一样由编译器向量化。
+
+// 归一化配置
+struct NormalizerConfig {
+  enum class Mode {
+    kNone,     // 不归一化
+    kEpoch,    // 每个包（试次）用自身的均值 / 标准差，等价于 EEGPreprocess.zscore
+    kRunning,  // 指数加权的滑动基线（Welford 递推），跨包保存，适合连续数据流
+  };
+
+  Mode mode{Mode::kNone};
+  bool scale{true};       // false 时只减均值（XGBDIM.preprocess 的做法），不除以标准差
+  double window{2.0};     // kRunning 的等效窗长（秒），遗忘因子为 1 / (window * fs)
+  double min_std{1e-3};   // 标准差低于此值的通道视为平坦通道，只减均值不缩放（与 zscore 中 std == 0 时的处理一致）
+  double fs{250.0};       // 数据采样率；RsvpPreprocessor 中由抽取配置决定
+
+  // 从配置读取（mode: "none" | "epoch" | "running" / scale / window / min_std），未给出的字段保持默认值
+  static NormalizerConfig from_config(const ConfigNode& node);
+};
+
+/**
+ * @brief 多通道流式归一化，由 SosFilterBank / ZeroPhaseFilterBank 在滤波的同一次遍历中驱动
+ *
+ * 滤波器组每得到一块结果调用一次 accumulate，整段写回后调用一次 finish：
+ *  - kEpoch：accumulate 只累积以每通道首个采样点为偏移的一阶、二阶和（偏移后的双累加器，
+ *    数值上与 Welford 相当但可以沿通道向量化），finish 按本段的均值 / 标准差原地归一化输出。
+ *  - kRunning：accumulate 对每个采样点做指数加权的 Welford 递推并立即归一化该块，finish 不再访问输出；
+ *    前 window * fs 个采样点内遗忘因子取 1 / 已见采样点数（即普通的累计均值 / 方差）。
+ * 方差按总体方差计算（与 np.std 的默认 ddof = 0 一致）。
+ */
+class ChannelNormalizer {
+ public:
+  ChannelNormalizer(const NormalizerConfig& config, int n_channels);
+
+  /**
+   * 处理一块滤波结果（原地）
+   * @param block "采样点 x 通道"布局，每行 stride 个 double（不少于 padded_channels()）
+   * @param stride 相邻两行的元素间距
+   * @param n_samples 本块行数
+   */
+  void accumulate(double* block, size_t stride, size_t n_samples);
+
+  /**
+   * 一段数据全部写回后调用
+   * @param out "通道 x 采样点"的输出，n_channels 行
+   * @param out_stride 输出相邻两行的元素间距
+   * @param n_samples 本段采样点数
+   */
+  void finish(float* out, size_t out_stride, size_t n_samples);
+
+  // 清零统计量（kRunning 的滑动基线重新开始）
+  void reset();
+
+  const NormalizerConfig& config() const { return config_; }
+  int n_channels() const { return n_channels_; }
+  size_t padded_channels() const { return padded_channels_; }
+
+  // 最近一段结束时第 c 个通道的均值与标准差
+  double mean(int c) const { return mean_[c]; }
+  double stddev(int c) const;
+
+  // 被当作平坦通道（标准差低于 min_std）处理的 段 x 通道 数
+  uint64_t flat_channels() const { return flat_channels_; }
+
+ private:
+  NormalizerConfig config_;
+  int n_channels_;
+  size_t padded_channels_;
+  size_t window_samples_;         // kRunning 的遗忘因子下限对应的采样点数
+  uint64_t seen_{0};              // kEpoch：本段已累积的采样点数；kRunning：数据流开始以来的采样点数
+  uint64_t flat_channels_{0};
+  AlignedBuffer<double> shift_;   // kEpoch：每通道的偏移（本段首个采样点）
+  AlignedBuffer<double> sum_;     // kEpoch：偏移后的一阶和
+  AlignedBuffer<double> sum_sq_;  // kEpoch：偏移后的二阶和
+  AlignedBuffer<double> mean_;    // 当前均值
+  AlignedBuffer<double> var_;     // 当前方差
+  AlignedBuffer<double> gain_;    // kRunning：每通道的缩放系数（工作区）
+
+  void accumulate_epoch(const double* block, size_t stride, size_t n_samples);
+  void accumulate_running(double* block, size_t stride, size_t n_samples);
+};
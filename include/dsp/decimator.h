@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "utils/aligned_buffer.h"
+#include "utils/config.h"
+
+// ==================== 通道选择 + 抗混叠抽取（一次遍历） ====================
+//
+// 原 Python 流程先 np.delete 复制整块数据去掉坏道，再滤波、再按 self.channel 重新取通道。
+// 这里把"选通道 -> FIR 低通 -> 抽取"合成一次遍历：每个输出采样点只在被保留的位置上计算
+// （多相结构，不计算会被丢弃的输出），FIR 直接读取输入行，结果直接写入 Runner 使用的布局。
+
+/**
+ * 设计线性相位低通 FIR（Hamming 窗 sinc，直流增益为 1）
+ * @param taps 抽头数
+ * @param cutoff_hz 截止频率（-6 dB）
+ * @param fs 采样频率
+ */
+std::vector<float> design_lowpass_fir(int taps, double cutoff_hz, double fs);
+
+// 抽取配置
+struct DecimatorConfig {
+  double fs{1000.0};         // 输入采样率
+  int factor{4};             // 抽取倍数
+  int taps{32};              // 抗混叠 FIR 抽头数
+  double cutoff{110.0};      // 抗混叠 FIR 截止频率（Hz）
+  std::vector<int> channels;  // 输出第 i 行取输入的第 channels[i] 行（0 基）
+
+  // 默认通道：64 导联去掉 EEGPreprocess.forward 删除的 [32, 42, 59, 63]，即 XGB-DIM 训练时的 60 行
+  static std::vector<int> default_channels();
+
+  // 从配置读取（fs / factor / taps / cutoff / channels，或 drop_channels 表示从 n_input_channels 中去掉的行）
+  static DecimatorConfig from_config(const ConfigNode& node, int n_input_channels = 64);
+};
+
+/**
+ * @brief 流式通道选择 + 多相 FIR 抽取
+ *
+ * 输入为连续数据流的一段（输入通道 x 采样点），输出为选中通道 x 抽取后采样点。
+ * 跨包保存每个通道最近 taps - 1 个输入采样点和抽取相位，分段处理与整段处理结果完全相同。
+ * 输出时刻与 x[:, ::factor] 一致（流中第 0、factor、2 factor ... 个输入采样点）。
+ */
+class ChannelDecimator {
+ public:
+  ChannelDecimator(std::vector<int> channels, int factor, const std::vector<float>& taps);
+  explicit ChannelDecimator(const DecimatorConfig& config);
+
+  // 送入 n_in 个输入采样点后将产生的输出采样点数
+  size_t output_samples(size_t n_in) const;
+
+  /**
+   * 处理一段输入
+   * @param in 输入，至少 max(channels) + 1 行
+   * @param in_stride 输入相邻两行的元素间距
+   * @param n_in 本段输入采样点数
+   * @param out 输出，channels.size() 行，每行至少 output_samples(n_in) 个元素
+   * @param out_stride 输出相邻两行的元素间距
+   * @return 实际写入的输出采样点数
+   */
+  size_t process(const float* in, size_t in_stride, size_t n_in, float* out, size_t out_stride);
+
+  void reset();
+
+  /**
+   * 以 in 的第一个采样点重新开始：历史中填入该值（相当于本段之前是无限长的常数基线），抽取相位归零
+   * 用于逐段独立处理（例如相互重叠的试次），段首不会出现从零开始的 FIR 边缘瞬态
+   */
+  void prime(const float* in, size_t in_stride);
+
+  const std::vector<int>& channels() const { return channels_; }
+  int factor() const { return factor_; }
+  size_t n_taps() const { return n_taps_; }
+
+ private:
+  std::vector<int> channels_;
+  int factor_;
+  size_t n_taps_;
+  AlignedBuffer<float> taps_;     // 反序存放，便于与输入窗口直接做点积
+  AlignedBuffer<float> history_;  // 每个输出通道最近 n_taps - 1 个输入采样点
+  AlignedBuffer<float> edge_;     // 跨包边界的窗口：history + 本段开头 n_taps - 1 个采样点
+  size_t next_{0};                // 下一个输出时刻相对本段开头的偏移
+};
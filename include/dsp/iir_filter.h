@@ -0,0 +1,157 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "utils/aligned_buffer.h"
+#include "utils/config.h"
+
+class ChannelNormalizer;
+
+// ==================== 流式 IIR 滤波（二阶节级联） ====================
+//
+// 与 python/eeg_preprocess.py 中 scipy.signal.butter 的设计一致（模拟原型 -> lp2bp -> 预畸变双线性变换），
+// 但按二阶节（SOS）实现，并在包之间保留每个通道的滤波器状态，可直接处理连续数据流。
+//
+// 多通道数据在内部转置为"时间 x 通道"的 SoA 布局，每个采样点对所有通道同时做一次二阶节运算，
+// 最内层循环沿通道方向连续访问，由编译器向量化（AVX2 / AVX-512 / NEON）。
+
+// 二阶节：H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+struct Biquad {
+  double b0{1.0}, b1{0.0}, b2{0.0};
+  double a1{0.0}, a2{0.0};
+};
+
+/**
+ * 设计 Butterworth 带通滤波器（等价于 scipy.signal.butter(order, [low, high], btype='band', output='sos')）
+ * @param order 原型阶数（带通滤波器实际阶数为 2 * order，共 order 个二阶节）
+ * @param low_hz 下截止频率
+ * @param high_hz 上截止频率
+ * @param fs 采样频率
+ * @return 二阶节系数，增益并入第一节；参数非法时抛出 std::invalid_argument
+ */
+std::vector<Biquad> design_butterworth_bandpass(int order, double low_hz, double high_hz, double fs);
+
+/**
+ * 二阶节级联在频率 freq_hz 处的复频率响应
+ */
+std::complex<double> sos_response(const std::vector<Biquad>& sections, double freq_hz, double fs);
+
+/**
+ * @brief 多通道二阶节级联（转置直接 II 型），数据为"时间 x 通道"布局的 double 数组
+ *
+ * 通道数向上取整到 8 的倍数，每行 padded_channels() 个元素，填充通道的结果无意义。
+ */
+class SosCascade {
+ public:
+  SosCascade(std::vector<Biquad> sections, int n_channels);
+
+  // 原地滤波 n_samples 行；reverse 为 true 时从最后一行向前处理（用于零相位的反向滤波）
+  void filter(double* data, size_t n_samples, bool reverse = false);
+
+  // 清零滤波器状态
+  void reset();
+
+  // 按输入恒为 row（一行 padded_channels() 个元素）时的稳态设置滤波器状态（即 scipy.signal.sosfilt_zi * x0）
+  void settle(const double* row);
+
+  int n_channels() const { return n_channels_; }
+  size_t padded_channels() const { return padded_channels_; }
+  const std::vector<Biquad>& sections() const { return sections_; }
+
+ private:
+  std::vector<Biquad> sections_;
+  int n_channels_;
+  size_t padded_channels_;
+  AlignedBuffer<double> state_;  // 每节 2 行（z1、z2），每行 padded_channels_ 个通道
+};
+
+/**
+ * @brief 因果流式滤波器组：输入输出均为"通道 x 采样点"的 float 矩阵
+ *
+ * 每次调用处理一段连续数据，状态保存到下一次调用；对整段数据一次滤波与分多段滤波结果完全相同。
+ */
+class SosFilterBank {
+ public:
+  SosFilterBank(std::vector<Biquad> sections, int n_channels);
+
+  /**
+   * 滤波一段数据（in 与 out 可以是同一块内存）
+   * @param in 输入，n_channels 行
+   * @param in_stride 输入相邻两行的元素间距
+   * @param out 输出，n_channels 行
+   * @param out_stride 输出相邻两行的元素间距
+   * @param n_samples 本段采样点数
+   * @param normalizer 非空时在同一次遍历中做逐通道归一化（每块写回前调用 accumulate，写回后调用 finish）
+   */
+  void process(const float* in, size_t in_stride, float* out, size_t out_stride, size_t n_samples,
+               ChannelNormalizer* normalizer = nullptr);
+
+  void reset() { cascade_.reset(); }
+
+  // 以 in 的第一个采样点（每个通道）为常数基线的稳态作为状态，用于逐段独立处理
+  void settle(const float* in, size_t in_stride);
+
+  int n_channels() const { return cascade_.n_channels(); }
+
+  static constexpr size_t kBlockSamples = 64;  // 每次转置处理的采样点数
+
+ private:
+  SosCascade cascade_;
+  AlignedBuffer<double> block_;  // kBlockSamples x padded_channels
+};
+
+/**
+ * @brief 固定延迟的近似零相位滤波器组
+ *
+ * 先做因果前向滤波，再在最近 lag + n 个采样点上从零状态反向滤波，只输出已经有 lag 个
+ * "未来"采样点的部分，因此输出比输入固定晚 lag 个采样点（最初 lag 个输出对应流开始前的零值）。
+ * lag 越长越接近 filtfilt：反向滤波的起始瞬态需在 lag 内衰减，低截止频率越低所需 lag 越长。
+ */
+class ZeroPhaseFilterBank {
+ public:
+  ZeroPhaseFilterBank(std::vector<Biquad> sections, int n_channels, size_t lag);
+
+  // 接口同 SosFilterBank::process，输出延迟 lag 个采样点（归一化作用于延迟后的输出）
+  void process(const float* in, size_t in_stride, float* out, size_t out_stride, size_t n_samples,
+               ChannelNormalizer* normalizer = nullptr);
+
+  /**
+   * 把一段数据当作独立的整段做零相位滤波（用于试次）：前向以段首、反向以前向结果的段尾为常数基线的稳态开始，
+   * 两遍都只在本段内进行，输出没有 lag 延迟（接口同 process）。会覆盖流式状态，之后继续 process() 前需 reset()
+   */
+  void process_epoch(const float* in, size_t in_stride, float* out, size_t out_stride, size_t n_samples,
+                     ChannelNormalizer* normalizer = nullptr);
+
+  void reset();
+  size_t lag() const { return lag_; }
+  int n_channels() const { return forward_.n_channels(); }
+
+ private:
+  SosCascade forward_;
+  SosCascade backward_;
+  size_t lag_;
+  size_t capacity_{0};             // history_ / scratch_ 当前可容纳的采样点数
+  AlignedBuffer<double> history_;  // 前向滤波结果：前 lag 行为上一段的尾部
+  AlignedBuffer<double> scratch_;  // 反向滤波工作区
+
+  void reserve(size_t n_samples);
+};
+
+// 预处理滤波配置
+struct IirFilterConfig {
+  enum class Mode { kCausal, kZeroPhase };
+
+  double fs{1000.0};
+  double low_cut{0.5};
+  double high_cut{49.0};
+  int order{4};
+  Mode mode{Mode::kCausal};
+  size_t lag{500};  // 仅 kZeroPhase 使用，单位：采样点
+
+  // 从配置读取（fs / low_cut / high_cut / order / mode: "causal" | "zero_phase" / lag），未给出的字段保持默认值
+  // RsvpPreprocessor 中 fs 由抽取配置决定（输入采样率 / 抽取倍数）
+  static IirFilterConfig from_config(const ConfigNode& node);
+};
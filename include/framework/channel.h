@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "framework/wait_strategy.h"
+#include "utils/ring_buffer.h"
+
+constexpr size_t kDefaultChannelCapacity = 64;  // 阶段间通道默认容量
+
+// 通道模式
+enum class ChannelMode {
+  kSpsc,  // 单生产者：上一阶段只有一个模块
+  kMpsc   // 多生产者：上一阶段有多个模块扇入
+};
+
+// 阶段间通道：固定容量的无锁环形缓冲区，按上游模块数量选择 SPSC / MPSC 实现；
+// 两侧各带一个等待事件，阻塞式的 push / pop 按调用方的等待策略等待
+template <class T>
+class Channel {
+ public:
+  explicit Channel(size_t capacity = kDefaultChannelCapacity, ChannelMode mode = ChannelMode::kSpsc)
+      : mode_(mode) {
+    if (mode_ == ChannelMode::kSpsc) {
+      spsc_ = std::make_unique<SpscRingBuffer<T>>(capacity);
+    } else {
+      mpsc_ = std::make_unique<MpscRingBuffer<T>>(capacity);
+    }
+  }
+
+  Channel(const Channel&) = delete;
+  Channel& operator=(const Channel&) = delete;
+
+  // 尝试写入，通道满时返回 false
+  template <class U>
+  bool try_push(U&& value) {
+    bool pushed = mode_ == ChannelMode::kSpsc ? spsc_->try_push(std::forward<U>(value))
+                                              : mpsc_->try_push(std::forward<U>(value));
+    if (pushed) {
+      not_empty_.notify();
+    }
+    return pushed;
+  }
+
+  // 尝试读取，通道空时返回 false
+  bool try_pop(T& value) {
+    bool popped = mode_ == ChannelMode::kSpsc ? spsc_->try_pop(value) : mpsc_->try_pop(value);
+    if (popped) {
+      not_full_.notify();
+    }
+    return popped;
+  }
+
+  // 按等待策略写入，超时返回 false
+  bool push(const T& value, const WaitStrategy& strategy) {
+    if (try_push(value)) {
+      return true;
+    }
+    return not_full_.wait(strategy, [&]() { return try_push(value); });
+  }
+
+  // 按等待策略读取，超时返回 false
+  bool pop(T& value, const WaitStrategy& strategy) {
+    if (try_pop(value)) {
+      return true;
+    }
+    return not_empty_.wait(strategy, [&]() { return try_pop(value); });
+  }
+
+  // 按等待策略等待通道长度低于 limit，超时返回 false
+  bool wait_below(size_t limit, const WaitStrategy& strategy) {
+    return not_full_.wait(strategy, [&]() { return size() < limit; });
+  }
+
+  size_t size() const { return mode_ == ChannelMode::kSpsc ? spsc_->size() : mpsc_->size(); }
+  size_t capacity() const { return mode_ == ChannelMode::kSpsc ? spsc_->capacity() : mpsc_->capacity(); }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() >= capacity(); }
+  ChannelMode mode() const { return mode_; }
+
+ private:
+  ChannelMode mode_;
+  std::unique_ptr<SpscRingBuffer<T>> spsc_;
+  std::unique_ptr<MpscRingBuffer<T>> mpsc_;
+
+  WaitEvent not_empty_;  // 消费者等待数据
+  WaitEvent not_full_;   // 生产者等待空位
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include "utils/config.h"
+#include "utils/shed_stats.h"
+
+// ==================== 截止时刻与负载削减 ====================
+//
+// BCI 闭环中晚于下一次刺激到达的分类结果已经没有用。Source 为每个包分配截止时刻（产生时刻 + budget），
+// 之后每个阶段在调用 process() 之前检查：已过期的包按本阶段的策略处理，积压不会在 Runner 前无限增长。
+// 被削减的包不会从流水线中消失，而是标记后跳过处理继续向下游转发，Postprocessor 的重排窗口
+// 因此不会把它当作缺包等待。
+
+// 过期包的处理策略（每个阶段各自设置）
+enum class ShedPolicy {
+  kNone,         // 照常处理，只计入 late
+  kSkipExpired,  // 跳过 process() 并标记为已削减，后续阶段直接转发；包并不出队丢弃，仍占用通道容量，只省去处理时间
+  kDropNewest,   // 仅 Source：输出通道已满时丢弃刚产生的包，而不是阻塞等待（已入队的包照常处理）
+  kDegrade,      // 照常调用 process()，但标记为降级（如 RsvpRunner 改用提前退出的快速推理）
+};
+
+// 截止时刻配置
+struct DeadlineConfig {
+  std::chrono::microseconds budget{0};  // Source 产生包到结果可用的时间预算，0 表示不分配截止时刻
+  ShedPolicy policy{ShedPolicy::kNone};
+
+  // 从配置读取，例如 {"budget_us": 10000, "policy": "skip_expired"}
+  static DeadlineConfig from_config(const ConfigNode &node) {
+    DeadlineConfig config;
+    config.budget = std::chrono::microseconds(node.get_int("budget_us", static_cast<int>(config.budget.count())));
+    if (config.budget.count() < 0) {
+      throw std::runtime_error("Deadline budget_us must be >= 0");
+    }
+    config.policy = parse_policy(node.get_string("policy", "none"));
+    return config;
+  }
+
+  // "none" | "skip_expired" | "drop_newest" | "degrade"
+  static ShedPolicy parse_policy(const std::string &name) {
+    if (name == "none") return ShedPolicy::kNone;
+    if (name == "skip_expired") return ShedPolicy::kSkipExpired;
+    if (name == "drop_newest") return ShedPolicy::kDropNewest;
+    if (name == "degrade") return ShedPolicy::kDegrade;
+    throw std::runtime_error("Unknown shed policy: " + name);
+  }
+};
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "framework/module.h"
+#include "utils/config.h"
+
+// 执行器参数
+struct ExecutorConfig {
+  int workers{0};                              // 工作线程数，0 表示 std::thread::hardware_concurrency()
+  std::vector<int> cpus;                       // 第 i 个工作线程绑定到 cpus[i % size]，为空时不绑定
+  int quantum{16};                             // 优先级为 1 的模块每轮最多连续 step 的次数
+  std::chrono::microseconds idle_sleep{50};    // 所有任务都空闲时工作线程的休眠时间
+
+  // 从配置读取，例如 {"workers": 4, "cpus": [2, 3, 4, 5], "quantum": 16, "idle_sleep_us": 50}
+  static ExecutorConfig from_config(const ConfigNode &node) {
+    ExecutorConfig config;
+    config.workers = node.get_int("workers", config.workers);
+    config.cpus = node.get_int_array("cpus");
+    config.quantum = node.get_int("quantum", config.quantum);
+    config.idle_sleep = std::chrono::microseconds(node.get_int("idle_sleep_us", static_cast<int>(config.idle_sleep.count())));
+    if (config.workers < 0 || config.quantum < 1 || config.idle_sleep.count() < 0) {
+      throw std::runtime_error("Executor needs workers >= 0, quantum >= 1 and idle_sleep_us >= 0");
+    }
+    return config;
+  }
+};
+
+/**
+ * @brief 工作窃取执行器：模块作为任务在固定数量的工作线程上轮转（替代每个模块独占一个线程）
+ *
+ * 每个模块是一个常驻任务，任何时刻只在一个工作线程上运行。工作线程从自己的双端队列尾部取任务，
+ * 连续调用 step() 直到无事可做或用完本轮配额（quantum * 优先级），再把任务放回自己队列的头部；
+ * 自己的队列为空或自己的任务整轮都没有进展时，从其他工作线程队列的头部窃取（窃取的任务随之迁移）。
+ *   亲和性  模块设置了 cpu_id 时固定在绑定到该 CPU 的工作线程上（没有时取 cpu_id % workers），不会被窃取
+ *   优先级  Module::set_priority，优先级越高每轮可以连续处理的包越多
+ * 一轮下来所有任务都空闲时工作线程按 idle_sleep 退避，负载不均衡时空闲阶段不再占用整个核心。
+ */
+class WorkStealingExecutor {
+ public:
+  explicit WorkStealingExecutor(const ExecutorConfig &config = ExecutorConfig()) : config_(config) {
+    int workers = config_.workers > 0 ? config_.workers : static_cast<int>(std::thread::hardware_concurrency());
+    workers_.resize(std::max(workers, 1));
+    for (auto &worker : workers_) {
+      worker = std::make_unique<Worker>();
+    }
+  }
+
+  ~WorkStealingExecutor() { stop(); }
+
+  WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+  WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+
+  // 添加模块（需在 start() 之前调用）
+  void add(Module<PackagePtr> *module) {
+    auto task = std::make_unique<Task>();
+    task->module = module;
+    task->home = -1;
+    if (module->get_cpu_id() >= 0) {
+      task->home = home_worker(module->get_cpu_id());
+      workers_[task->home]->tasks.push_back(task.get());
+    } else {
+      workers_[next_worker_++ % workers_.size()]->tasks.push_back(task.get());
+    }
+    tasks_.push_back(std::move(task));
+  }
+
+  void start() {
+    running_ = true;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      threads_.emplace_back(&WorkStealingExecutor::worker_loop, this, i);
+    }
+  }
+
+  // 停止所有工作线程，再依次调用各模块的 finish()
+  void stop() {
+    if (threads_.empty()) {
+      return;
+    }
+    running_ = false;
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+    threads_.clear();
+    for (auto &task : tasks_) {
+      task->module->finish();
+    }
+  }
+
+  size_t worker_count() const { return workers_.size(); }
+
+  // 统计：step 调用次数、成功窃取次数
+  uint64_t steps() const { return steps_.load(std::memory_order_relaxed); }
+  uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Task {
+    Module<PackagePtr> *module{nullptr};
+    int home{-1};  // 固定的工作线程（-1 表示可被窃取）
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task *> tasks;
+  };
+
+  ExecutorConfig config_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::unique_ptr<Task>> tasks_;
+  std::vector<std::thread> threads_;
+  std::atomic<bool> running_{false};
+  size_t next_worker_{0};
+  std::atomic<uint64_t> steps_{0};
+  std::atomic<uint64_t> steals_{0};
+
+  // 绑定到 cpu 的工作线程；没有时取 cpu % workers
+  int home_worker(int cpu) const {
+    for (size_t i = 0; i < workers_.size() && !config_.cpus.empty(); ++i) {
+      if (config_.cpus[i % config_.cpus.size()] == cpu) {
+        return static_cast<int>(i);
+      }
+    }
+    return cpu % static_cast<int>(workers_.size());
+  }
+
+  size_t local_size(size_t index) {
+    Worker &worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    return worker.tasks.size();
+  }
+
+  Task *pop_local(size_t index) {
+    Worker &worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+      return nullptr;
+    }
+    Task *task = worker.tasks.back();
+    worker.tasks.pop_back();
+    return task;
+  }
+
+  // 从其他工作线程队列的头部窃取一个没有固定线程的任务
+  Task *steal(size_t index) {
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+      Worker &victim = *workers_[(index + offset) % workers_.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      for (auto it = victim.tasks.begin(); it != victim.tasks.end(); ++it) {
+        if ((*it)->home < 0) {
+          Task *task = *it;
+          victim.tasks.erase(it);
+          steals_.fetch_add(1, std::memory_order_relaxed);
+          return task;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  // 放回队列头部（固定线程的任务放回其所属线程），本线程的其他任务先于它被取到
+  void requeue(size_t index, Task *task) {
+    Worker &worker = *workers_[task->home >= 0 ? static_cast<size_t>(task->home) : index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_front(task);
+  }
+
+  void worker_loop(size_t index) {
+    if (!config_.cpus.empty()) {
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(config_.cpus[index % config_.cpus.size()], &mask);
+      pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+    }
+
+    size_t idle_turns = 0;
+    while (running_.load(std::memory_order_relaxed)) {
+      // 本线程的任务整轮都没有进展时先从其他线程窃取（例如 Runner 饱和时把同一线程上的其他阶段接过来）
+      Task *task = nullptr;
+      if (idle_turns > 0 && idle_turns >= local_size(index)) {
+        task = steal(index);
+      }
+      if (task == nullptr) {
+        task = pop_local(index);
+      }
+      if (task == nullptr) {
+        task = steal(index);
+      }
+      if (task == nullptr) {
+        std::this_thread::sleep_for(config_.idle_sleep);
+        continue;
+      }
+
+      // 连续 step 直到无事可做或用完配额
+      const int budget = config_.quantum * task->module->get_priority();
+      bool progressed = false;
+      int count = 0;  // 实际调用 step() 的次数
+      while (count < budget) {
+        StepResult result = StepResult::kIdle;
+        ++count;
+        try {
+          result = task->module->step();
+        } catch (const std::exception &e) {
+          MLOG_ERROR("Exception in executor task: %s", e.what());
+        }
+        if (result != StepResult::kProgress) {
+          break;
+        }
+        progressed = true;
+      }
+      steps_.fetch_add(count, std::memory_order_relaxed);
+      requeue(index, task);
+
+      // 连续的空闲轮次达到任务总数时退避
+      idle_turns = progressed ? 0 : idle_turns + 1;
+      if (idle_turns >= tasks_.size()) {
+        idle_turns = 0;
+        std::this_thread::sleep_for(config_.idle_sleep);
+      }
+    }
+  }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "utils/config.h"
+
+// 融合执行参数（Pipeline::run_fused）
+struct FusedConfig {
+  int workers{1};         // 工作线程数，每个线程从 Source 取一个包后依次调用各阶段的 process()
+  std::vector<int> cpus;  // 第 i 个工作线程绑定到 cpus[i % size]，为空时不绑定
+
+  // 从配置读取，例如 {"workers": 2, "cpus": [2, 3]}
+  static FusedConfig from_config(const ConfigNode &node) {
+    FusedConfig config;
+    config.workers = node.get_int("workers", config.workers);
+    config.cpus = node.get_int_array("cpus");
+    if (config.workers < 1) {
+      throw std::runtime_error("Fused mode needs workers >= 1");
+    }
+    return config;
+  }
+};
+
+/**
+ * @brief 融合执行时一个模块的入口：按票号顺序放行，同一时刻只有一个工作线程在调用该模块
+ *
+ * 每个包从 Source 取出时领一个递增的票号。第 i 阶段有 K 个副本时票号 t 的包交给 t % K 号副本，
+ * 该副本的入口依次放行 r, r + K, r + 2K, ...。有状态的阶段（滤波器、重排）因此仍按产生顺序看到包，
+ * 多个工作线程在不同阶段上自然形成流水。持有最小票号的线程从不等待，不会死锁。
+ */
+class FusedGate {
+ public:
+  FusedGate(uint64_t first, uint64_t stride) : next_(first), stride_(stride) {}
+
+  // 等到轮到 ticket（等待的是上一个包离开本阶段，通常只有一个阶段的处理时长，自旋让出即可）
+  void enter(uint64_t ticket) const {
+    while (next_.load(std::memory_order_acquire) != ticket) {
+      std::this_thread::yield();
+    }
+  }
+
+  // 放行下一个票号（只由当前持有者调用）
+  void leave() { next_.store(next_.load(std::memory_order_relaxed) + stride_, std::memory_order_release); }
+
+ private:
+  std::atomic<uint64_t> next_;
+  const uint64_t stride_;
+};
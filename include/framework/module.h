@@ -1,13 +1,18 @@
 #pragma once
 
-#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <list>
 #include <memory>
-#include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
 #include <utility>
 
+#include "framework/channel.h"
+#include "framework/deadline.h"
+#include "framework/tracker.h"
+#include "framework/wait_strategy.h"
 #include "opencv2/opencv.hpp"
 #include "utils/common.h"
 #include "utils/module_logger.h"
@@ -26,6 +31,13 @@ class NonCopyable {
   NonCopyable& operator=(NonCopyable&&) = delete;
 };
 
+// step() 的结果（执行器据此决定是否继续运行该模块或退避）
+enum class StepResult {
+  kIdle,      // 没有可处理的输入
+  kProgress,  // 处理了至少一个包
+  kBlocked,   // 下游通道已满，输出暂存在模块中
+};
+
 // 模块基类
 template <class T1>
 class Module : public NonCopyable {
@@ -39,50 +51,111 @@ class Module : public NonCopyable {
   int* input_flag_{nullptr};   // 输入标志
   int* output_flag_{nullptr};  // 输出标志
 
-  std::mutex* input_mutex_{nullptr};
-  std::mutex* output_mutex_{nullptr};
-
-  std::condition_variable* input_cv_{nullptr};
-  std::condition_variable* output_cv_{nullptr};
+  Channel<T1>* input_ptr_{nullptr};   // 输入通道（无锁环形缓冲区）
+  Channel<T1>* output_ptr_{nullptr};  // 输出通道（无锁环形缓冲区）
 
-  std::queue<T1>* input_ptr_{nullptr};
-  std::queue<T1>* output_ptr_{nullptr};
+  WaitStrategy wait_strategy_;  // 等待上下游通道时的策略
+  int priority_{1};             // 执行器模式下的优先级（每轮连续 step 的次数按比例放大）
 
   ModuleProfiler profiler_;  // 性能分析器
 
+  Tracker* tracker_{nullptr};  // 包追踪（为空时不记录时间戳）
+  int stage_{-1};              // 所在阶段（包追踪用）
+
+  ShedPolicy shed_policy_{ShedPolicy::kNone};  // 过期包的处理策略
+  ShedCounters shed_counters_;                 // 负载削减统计
+
+  std::atomic<bool> exit_flag_{false};  // 退出标志（run() 循环与阻塞写出时检查）
+
  public:
   // 构造函数
   Module() = default;
 
-  explicit Module(int pre_module_nums, bool enable_profiler = false, int cpu_id = -1, int npu_id = -1)
+  explicit Module(int pre_module_nums, bool enable_profiler = false, int cpu_id = -1, int npu_id = -1,
+                  const WaitStrategy& wait_strategy = WaitStrategy())
       : cpu_id_(cpu_id),
         npu_id_(npu_id),
         pre_module_nums_(pre_module_nums),
+        wait_strategy_(wait_strategy),
         profiler_(enable_profiler) {}
 
   virtual ~Module() = default;
 
-  // 纯虚函数，处理主逻辑
-  virtual void run() override = 0;
+  // 纯虚函数，处理主逻辑（每个模块独占一个线程时使用）
+  virtual void run() = 0;
+
+  /**
+   * 非阻塞地推进一步（执行器模式使用，与 run() 二选一）：最多取一次输入并处理，
+   * 下游满时把输出暂存在模块中，下次 step 先写出暂存的包
+   */
+  virtual StepResult step() = 0;
+
+  // 执行器停止后调用一次，用于收尾（例如按顺序处理完暂存的包）
+  virtual void finish() {}
 
   // 子类需要实现的处理逻辑
-  virtual bool process(Package* package) override = 0;
+  virtual bool process(Package* package) = 0;
+
+  // 能否在融合模式中逐包内联调用 process()（一个包进、同一个包出）；一进多出的模块（如试次截取）返回 false
+  virtual bool fusable() const { return true; }
+
+  /**
+   * 融合模式（Pipeline::run_fused）：在调用线程中处理一个包，不经过通道
+   * 与 run()/step() 一样先检查截止时刻，并记录本阶段的处理时延和包追踪时间戳，阶段边界在统计中保持可见
+   * @param last 是否为最后一个阶段（处理完记录端到端追踪，被削减的包不记录）
+   * @return process() 失败时返回 false，后续阶段不再处理该包
+   */
+  bool process_inline(Package* package, bool last) {
+    auto start_time = std::chrono::steady_clock::now();
+    trace_dequeue(package);
+    const bool admitted = admit(package);
+    if (admitted && !process(package)) {
+      return false;
+    }
+    if (!last) {
+      trace_enqueue(package);
+    } else if (admitted) {
+      trace_complete(package);
+    }
+    if (admitted && profiler_.is_enabled()) {
+      auto end_time = std::chrono::steady_clock::now();
+      profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+    }
+    return true;
+  }
+
+  // 安全退出函数：run() 在当前包处理完（或阻塞的写出放弃）后返回
+  void exit() { exit_flag_ = true; }
 
   // 设置输入/输出标志
   void set_input_flag(int* input_flag) { input_flag_ = input_flag; }
   void set_output_flag(int* output_flag) { output_flag_ = output_flag; }
 
-  // 设置输入/输出互斥锁
-  void set_input_mutex(std::mutex* input_mutex) { input_mutex_ = input_mutex; }
-  void set_output_mutex(std::mutex* output_mutex) { output_mutex_ = output_mutex; }
+  // 设置输入/输出通道
+  void set_input_ptr(Channel<T1>* input_ptr) { input_ptr_ = input_ptr; }
+  void set_output_ptr(Channel<T1>* output_ptr) { output_ptr_ = output_ptr; }
+
+  // 设置/获取等待策略（需在 run() 之前设置）
+  void set_wait_strategy(const WaitStrategy& wait_strategy) { wait_strategy_ = wait_strategy; }
+  const WaitStrategy& get_wait_strategy() const { return wait_strategy_; }
+
+  // 设置包追踪（由 Pipeline 在运行前设置）
+  void set_tracker(Tracker* tracker, int stage) {
+    tracker_ = tracker;
+    stage_ = stage;
+  }
+
+  // 设置/获取执行器模式下的优先级（>= 1，需在启动前设置）
+  void set_priority(int priority) { priority_ = priority < 1 ? 1 : priority; }
+  int get_priority() const { return priority_; }
 
-  // 设置输入/输出条件变量
-  void set_input_cv(std::condition_variable* input_cv) { input_cv_ = input_cv; }
-  void set_output_cv(std::condition_variable* output_cv) { output_cv_ = output_cv; }
+  // 设置/获取过期包的处理策略（需在启动前设置；kDropNewest 只对 Source 有效，其他阶段视为 kNone）
+  void set_shed_policy(ShedPolicy policy) { shed_policy_ = policy; }
+  ShedPolicy get_shed_policy() const { return shed_policy_; }
 
-  // 设置输入/输出队列
-  void set_input_ptr(std::queue<T1>* input_ptr) { input_ptr_ = input_ptr; }
-  void set_output_ptr(std::queue<T1>* output_ptr) { output_ptr_ = output_ptr; }
+  // 负载削减统计（可在其他线程读取）
+  ShedStats get_shed_stats() const { return shed_counters_.snapshot(); }
+  const ShedCounters& get_shed_counters() const { return shed_counters_; }
 
   // 获取模块的 CPU 和 NPU ID
   int get_cpu_id() const { return cpu_id_; }
@@ -92,7 +165,8 @@ class Module : public NonCopyable {
   size_t get_cnt() const { return cnt_; }
 
   // 获取性能分析结果
-  double get_profile() { return profiler_.get_profile(); }
+  LatencySnapshot get_profile() const { return profiler_.get_profile(); }
+  const ModuleProfiler& get_profiler() const { return profiler_; }
 
   // 设置线程 CPU 亲和性
   inline void set_cpu_affinity(const char* process_name) {
@@ -112,21 +186,81 @@ class Module : public NonCopyable {
     }
   }
 
-  // 简化的线程安全队列操作
+  // 按等待策略从输入通道取数据；单次等待超时返回空对象，
+  // 以便 run() 循环有机会检查退出标志
   std::optional<T1> pop_input() {
-    std::unique_lock<std::mutex> lock(*input_mutex_);
-    input_cv_->wait(lock, [this]() { return !input_ptr_->empty(); });
-    if (input_ptr_->empty()) return std::nullopt;  // 如果队列仍为空，返回空对象
-    T1 data = std::move(input_ptr_->front());
-    input_ptr_->pop();
-    return data;
+    T1 data;
+    if (input_ptr_->pop(data, wait_strategy_)) {
+      return data;
+    }
+    return std::nullopt;
   }
 
+  // 按等待策略写入输出通道：通道满时一直等到下游腾出空位（背压）；
+  // exit() 之后放弃写出，下游已退出、通道不再被读取时 run() 也能返回
   void push_output(const T1& data) {
-    {
-      std::lock_guard<std::mutex> lock(*output_mutex_);
-      output_ptr_->push(data);
+    while (!output_ptr_->push(data, wait_strategy_) && !exit_flag_) {
+    }
+  }
+
+ protected:
+  std::deque<T1> stalled_;  // step 模式下下游满时暂存的输出
+
+  // 包追踪：取到包时、写入下游前、最后一个阶段处理完时调用（未设置 Tracker 时为空操作）
+  void trace_dequeue(Package* package) {
+    if (tracker_) package->trace().mark_dequeue(stage_, TraceClock::now());
+  }
+  void trace_enqueue(Package* package) {
+    if (tracker_) package->trace().mark_enqueue(stage_, TraceClock::now());
+  }
+  void trace_complete(Package* package) {
+    if (tracker_) {
+      trace_enqueue(package);
+      tracker_->complete(*package);
+    }
+  }
+
+  /**
+   * 调用 process() 之前检查截止时刻（没有截止时刻的包不读时钟）
+   * @return false 表示包已被削减（上游或本阶段）或在上游处理失败，不调用 process()，直接转发给下游
+   */
+  bool admit(Package* package) {
+    if (package->is_shed() || package->is_failed()) {
+      return false;
+    }
+    if (!package->has_deadline() || !package->expired(std::chrono::steady_clock::now())) {
+      return true;
+    }
+    switch (shed_policy_) {
+      case ShedPolicy::kSkipExpired:
+        package->mark_shed();
+        shed_counters_.add_shed();
+        return false;
+      case ShedPolicy::kDegrade:
+        package->mark_degraded();
+        shed_counters_.add_degraded();
+        return true;
+      default:
+        shed_counters_.add_late();
+        return true;
+    }
+  }
+
+  // 非阻塞地写出暂存的输出，全部写出时返回 true
+  bool flush_stalled() {
+    while (!stalled_.empty()) {
+      if (!output_ptr_->try_push(stalled_.front())) {
+        return false;
+      }
+      stalled_.pop_front();
+    }
+    return true;
+  }
+
+  // 非阻塞地写入输出通道，写不进去时按顺序暂存
+  void emit_output(const T1& data) {
+    if (!stalled_.empty() || !output_ptr_->try_push(data)) {
+      stalled_.push_back(data);
     }
-    output_cv_->notify_one();
   }
 };
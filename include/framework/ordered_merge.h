@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "utils/common.h"
+#include "utils/config.h"
+#include "utils/module_logger.h"
+#include "utils/reorder_buffer.h"
+
+// 重排窗口参数
+struct ReorderConfig {
+  size_t window{64};                                // 最多暂存的包数（向上取整到 2 的幂）
+  std::chrono::microseconds max_gap_wait{100000};  // 头部缺包时最多等待多久再跳过
+
+  // 从配置读取，例如 {"window": 64, "max_gap_wait_us": 100000}
+  static ReorderConfig from_config(const ConfigNode &node) {
+    ReorderConfig config;
+    const int window = node.get_int("window", static_cast<int>(config.window));
+    const int max_gap_wait = node.get_int("max_gap_wait_us", static_cast<int>(config.max_gap_wait.count()));
+    if (window < 1 || max_gap_wait < 0) {
+      throw std::runtime_error("Reorder window needs window >= 1 and max_gap_wait_us >= 0");
+    }
+    config.window = static_cast<size_t>(window);
+    config.max_gap_wait = std::chrono::microseconds(max_gap_wait);
+    return config;
+  }
+};
+
+/**
+ * @brief 按 Source 分配的序号恢复包的顺序
+ *
+ * 到达的包放入定长的重排窗口（ReorderBuffer，按序号 O(1) 定位），从窗口头部起连续到达的包按序号
+ * 依次交给 emit，随后窗口不再持有该包：
+ *   迟到的包   序号已被释放或跳过，直接丢弃并计数
+ *   头部缺包   上游丢包时等待 max_gap_wait 后跳过；新包超出窗口时立即跳过
+ * 暂存的包数不超过窗口大小。只在一个线程中调用，统计计数可在其他线程读取。
+ */
+class OrderedMerge {
+ public:
+  explicit OrderedMerge(std::string name, const ReorderConfig &config = ReorderConfig())
+      : name_(std::move(name)), config_(config), window_(std::make_unique<ReorderBuffer<PackagePtr>>(config.window)) {}
+
+  // 重新设置窗口参数（窗口中暂存的包被丢弃，需在开始合并前调用）
+  void configure(const ReorderConfig &config) {
+    config_ = config;
+    window_ = std::make_unique<ReorderBuffer<PackagePtr>>(config.window);
+  }
+  const ReorderConfig &config() const { return config_; }
+
+  /**
+   * 放入一个包并释放已就绪的包；超出窗口时先跳过头部的缺口，直到新包落入窗口
+   * @param emit 按序号依次以 PackagePtr & 调用
+   */
+  template <class Emit>
+  void accept(PackagePtr package, Emit &&emit) {
+    const uint64_t sequence = package->get_sequence();
+    ReorderStatus status = window_->insert(sequence, package);
+    while (status == ReorderStatus::kOutOfWindow) {
+      // 窗口为空时直接从新包开始
+      size_t skipped = window_->pending() > 0 ? window_->skip_gap() : window_->advance_to(sequence);
+      skipped_.fetch_add(skipped, std::memory_order_relaxed);
+      release_ready(emit);
+      status = window_->insert(sequence, package);
+    }
+    if (status == ReorderStatus::kLate) {
+      late_.fetch_add(1, std::memory_order_relaxed);
+      MLOG_WARN("%s dropped late package %llu (expecting %llu)", name_.c_str(),
+                static_cast<unsigned long long>(sequence), static_cast<unsigned long long>(window_->next_sequence()));
+    } else if (status == ReorderStatus::kDuplicate) {
+      late_.fetch_add(1, std::memory_order_relaxed);
+      MLOG_WARN("%s dropped duplicate package %llu", name_.c_str(), static_cast<unsigned long long>(sequence));
+    }
+    release_ready(emit);
+  }
+
+  // 释放窗口头部连续到达的包；头部缺包超过 max_gap_wait 时跳过缺口（输入超时时也应调用）
+  template <class Emit>
+  void release_ready(Emit &&emit) {
+    PackagePtr package;
+    while (true) {
+      while (window_->pop_ready(package)) {
+        released_.fetch_add(1, std::memory_order_relaxed);
+        emit(package);
+        package.reset();
+      }
+      if (!window_->head_missing()) {
+        gap_since_ = Clock::time_point();
+        return;
+      }
+      const auto now = Clock::now();
+      if (gap_since_ == Clock::time_point()) {
+        gap_since_ = now;
+      }
+      if (now - gap_since_ < config_.max_gap_wait) {
+        return;
+      }
+      skipped_.fetch_add(window_->skip_gap(), std::memory_order_relaxed);
+      gap_since_ = Clock::time_point();
+    }
+  }
+
+  // 不再等待缺包，按顺序释放窗口中剩余的包（退出时调用）
+  template <class Emit>
+  void flush(Emit &&emit) {
+    while (window_->pending() > 0) {
+      skipped_.fetch_add(window_->skip_gap(), std::memory_order_relaxed);
+      PackagePtr package;
+      while (window_->pop_ready(package)) {
+        released_.fetch_add(1, std::memory_order_relaxed);
+        emit(package);
+      }
+    }
+  }
+
+  // 窗口中尚未释放的包，不存在时返回 nullptr
+  PackagePtr find(uint64_t sequence) const {
+    PackagePtr *package = window_->find(sequence);
+    return package ? *package : nullptr;
+  }
+
+  // 统计：按顺序释放的包数、丢弃的迟到或重复包数、放弃等待的序号数
+  uint64_t released() const { return released_.load(std::memory_order_relaxed); }
+  uint64_t late() const { return late_.load(std::memory_order_relaxed); }
+  uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+
+  // 单行摘要，例如 "Postprocessor: released=120 late=0 skipped=2"
+  std::string report() const {
+    char buffer[160];
+    snprintf(buffer, sizeof(buffer), "%s: released=%llu late=%llu skipped=%llu", name_.c_str(),
+             static_cast<unsigned long long>(released()), static_cast<unsigned long long>(late()),
+             static_cast<unsigned long long>(skipped()));
+    return std::string(buffer);
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  std::string name_;
+  ReorderConfig config_;
+  std::unique_ptr<ReorderBuffer<PackagePtr>> window_;
+  Clock::time_point gap_since_{};  // 头部开始缺包的时刻（不缺包时为默认值）
+  std::atomic<uint64_t> released_{0};
+  std::atomic<uint64_t> late_{0};
+  std::atomic<uint64_t> skipped_{0};
+};
@@ -1,61 +1,212 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <memory>
-#include <mutex>         // NOLINT
-#include <queue>
+#include <stdexcept>
+#include <string>
 #include <thread>        // NOLINT
 #include <vector>
-#include <condition_variable>
 
+#include "framework/channel.h"
+#include "framework/executor.h"
+#include "framework/fused.h"
 #include "framework/module.h"
 #include "framework/postprocessor.h"
 #include "framework/preprocessor.h"
+#include "framework/replica.h"
 #include "framework/runner.h"
 #include "framework/sink.h"
 #include "framework/source.h"
 #include "framework/tracker.h"
+#include "utils/profile_reporter.h"
+
+/**
+ * @brief Pipeline 类
+ *
+ * 第 0 阶段可以有多个 Source（汇入同一个 MPSC 通道，共用流水线的序号计数器，序号不重复）。其余阶段有 K > 1 个模块时视为同一模块的 K 个副本
+ * （例如 4 个 RsvpRunner 各绑一个核）：上游通道的包由分发线程按 set_replication 指定的策略分给各副本，
+ * 各副本的输出汇入一个 MPSC 通道，再由合并线程按 Source 序号恢复顺序后推入下一阶段，下游看到的顺序
+ * 与不复制时相同。副本丢弃的包在合并时按重排窗口的缺包规则跳过。
+ *
+ * run() 为每个模块（以及分发/合并）各开一个线程；run_executor() 以相同的连接方式把它们作为任务交给
+ * WorkStealingExecutor，在固定数量的工作线程上轮转。run_fused() 不建通道：每个工作线程从 Source 取一个包后
+ * 在本线程内依次调用各阶段的 process()，省去阶段间的排队与线程切换，适合单路低速率的数据流。
+ */
+
+// 运行方式（配置 pipeline.mode）
+enum class PipelineMode {
+  kThreads,   // 每个模块独占一个线程（run）
+  kExecutor,  // 工作窃取执行器（run_executor）
+  kFused,     // 融合执行（run_fused）
+};
+
+struct PipelineRunConfig {
+  PipelineMode mode{PipelineMode::kThreads};
+  ExecutorConfig executor;
+  FusedConfig fused;
+  size_t channel_capacity{kDefaultChannelCapacity};  // 阶段间通道容量（见 Pipeline(int, const PipelineRunConfig&)）
+  WaitStrategy wait_strategy;                        // 各模块的默认等待策略
+
+  // 从 pipeline 配置读取，例如 {"mode": "fused", "channel_capacity": 64, "wait_strategy": "park",
+  // "executor": {...}, "fused": {"workers": 1}}
+  static PipelineRunConfig from_config(const ConfigNode& node) {
+    PipelineRunConfig config;
+    const int capacity = node.get_int("channel_capacity", static_cast<int>(config.channel_capacity));
+    if (capacity < 1) {
+      throw std::runtime_error("pipeline.channel_capacity must be >= 1");
+    }
+    config.channel_capacity = static_cast<size_t>(capacity);
+    if (node.has("wait_strategy")) {
+      config.wait_strategy = WaitStrategy::from_config(node["wait_strategy"]);
+    }
+    const std::string mode = node.get_string("mode", "threads");
+    if (mode == "threads") {
+      config.mode = PipelineMode::kThreads;
+    } else if (mode == "executor") {
+      config.mode = PipelineMode::kExecutor;
+    } else if (mode == "fused") {
+      config.mode = PipelineMode::kFused;
+    } else {
+      throw std::runtime_error("Unknown pipeline mode: " + mode);
+    }
+    if (node.has("executor")) {
+      config.executor = ExecutorConfig::from_config(node["executor"]);
+    }
+    if (node.has("fused")) {
+      config.fused = FusedConfig::from_config(node["fused"]);
+    }
+    return config;
+  }
+
+  // 模块的等待策略（modules.<name> 配置）：有 wait_strategy 时覆盖默认值，只写类型名时其余参数沿用默认值
+  WaitStrategy module_wait_strategy(const ConfigNode& module) const {
+    return module.has("wait_strategy") ? WaitStrategy::from_config(module["wait_strategy"], wait_strategy)
+                                       : wait_strategy;
+  }
+};
 
-// Pipeline 类
 class Pipeline {
  protected:
   // 资源管理：使用智能指针替代裸指针
-  std::vector<std::shared_ptr<int>> flags_;                                 // 阶段标志
-  std::vector<std::shared_ptr<std::mutex>> mutexes_;                        // 每个阶段的互斥锁
-  std::vector<std::shared_ptr<std::condition_variable>> cvs_;               // 每个阶段的条件变量
-  std::vector<std::shared_ptr<std::queue<std::shared_ptr<Package>>>> buffers_;  // 每个阶段的队列
-  int stage_num_;                                                           // 阶段数量
+  std::vector<std::shared_ptr<int>> flags_;                           // 阶段标志
+  std::vector<std::shared_ptr<Channel<PackagePtr>>> buffers_;         // 每个阶段的输出通道（无锁环形缓冲区）
+  std::vector<size_t> capacities_;                                    // 每个阶段输出通道的容量
+  int stage_num_;                                                     // 阶段数量
+
+  // 复制阶段的分发/合并线程及其通道（按阶段下标，不复制的阶段为空）
+  struct ReplicaStage {
+    std::vector<std::shared_ptr<Channel<PackagePtr>>> inputs;  // 每个副本一条 SPSC 输入通道
+    std::shared_ptr<Channel<PackagePtr>> merged;               // 各副本的输出（MPSC）
+    std::unique_ptr<ReplicaDispatcher> dispatcher;
+    std::unique_ptr<ReplicaMerger> merger;                     // 最后一个阶段没有合并线程
+  };
+  std::vector<ReplicaStage> replica_stages_;
+  std::map<int, ReplicationConfig> replication_;  // 各阶段的复制参数（未设置时轮流分发）
+
+  Tracker* tracker_{nullptr};                         // 包追踪（为空时各阶段不记录时间戳）
+  std::chrono::milliseconds profile_interval_{1000};  // enable_profile 时各阶段时延统计的输出周期
+
+  // 执行器模式下 run_executor() 等待 exit()
+  std::mutex exit_mutex_;
+  std::condition_variable exit_cv_;
+  bool exit_requested_{false};
+  std::atomic<bool> stop_fused_{false};  // 融合模式的工作线程在取下一个包之前检查
+  std::atomic<uint64_t> sequence_{0};    // 第 0 阶段有多个 Source 时共用的序号计数器
 
  public:
-  // 构造函数
-  explicit Pipeline(int stage_num) : stage_num_(stage_num) {
-    initialize_resources(stage_num_);
-  }
+  // 构造函数：所有阶段间通道使用同一容量
+  explicit Pipeline(int stage_num, size_t capacity = kDefaultChannelCapacity)
+      : capacities_(stage_num > 1 ? stage_num - 1 : 0, capacity), stage_num_(stage_num) {}
+
+  // 构造函数：通道容量取 config.channel_capacity
+  Pipeline(int stage_num, const PipelineRunConfig& config) : Pipeline(stage_num, config.channel_capacity) {}
+
+  // 构造函数：逐阶段指定通道容量（capacities[i] 为第 i 与第 i+1 阶段之间的通道）
+  explicit Pipeline(const std::vector<size_t>& capacities)
+      : capacities_(capacities), stage_num_(static_cast<int>(capacities.size()) + 1) {}
 
   // 析构函数：智能指针会自动管理资源，无需手动释放
   ~Pipeline() = default;
 
   // 运行函数：支持并行运行模式
-  void run(const std::vector<std::vector<Module<Package*>*>>& modules, bool enable_profile);
+  void run(const std::vector<std::vector<Module<PackagePtr>*>>& modules, bool enable_profile);
+
+  /**
+   * 执行器模式：模块不独占线程，由工作窃取执行器调用各模块的 step()
+   * 阻塞直到 exit() 被调用，随后停止执行器并调用各模块的 finish()
+   * @param config 工作线程数、CPU 绑定与每轮配额
+   */
+  void run_executor(const std::vector<std::vector<Module<PackagePtr>*>>& modules, const ExecutorConfig& config,
+                    bool enable_profile);
+
+  /**
+   * 融合模式：不建通道，config.workers 个工作线程各自从 Source 取一个包，在本线程内依次调用各阶段的
+   * process_inline()。各阶段仍按包的产生顺序处理（见 FusedGate），处理时延照常按阶段统计。
+   * 要求第 0 阶段均为 Source、其余模块均可内联（Module::fusable）；Runner 的微批与 Postprocessor 的重排窗口不参与。
+   * 复制阶段第 t 个包交给 t % K 号副本。阻塞直到 exit() 被调用
+   */
+  void run_fused(const std::vector<std::vector<Module<PackagePtr>*>>& modules, const FusedConfig& config,
+                 bool enable_profile);
+
+  // 按 config.mode 选择 run() / run_executor() / run_fused()
+  void run(const std::vector<std::vector<Module<PackagePtr>*>>& modules, const PipelineRunConfig& config,
+           bool enable_profile);
+
+  // 设置包追踪（需在 run() 之前设置，tracker 的阶段数应与流水线相同；传入 nullptr 关闭）
+  void set_tracker(Tracker* tracker) { tracker_ = tracker; }
+
+  // 设置 enable_profile 时周期输出各阶段时延统计的间隔（需在 run() 之前设置）
+  void set_profile_interval(std::chrono::milliseconds interval) { profile_interval_ = interval; }
+
+  // 设置第 stage 阶段的分发策略与合并窗口（需在 run() 之前设置）
+  void set_replication(int stage, const ReplicationConfig& config) { replication_[stage] = config; }
+
+  // 停止复制阶段的分发/合并线程（各模块仍需各自调用 exit()，之后 run() 才会返回）；
+  // 执行器模式下 run_executor() 随即返回，融合模式下各工作线程处理完手上的包后 run_fused() 返回。
+  // 只作用于当前这次运行：每次运行开始时清除退出标志，同一个 Pipeline 可以再次运行
+  void exit();
 
-  // 顺序运行函数
-  void seq_run(const std::vector<std::vector<Module<Package*>*>>& modules, bool enable_profile);
+  // 顺序运行：单个工作线程的融合模式
+  void seq_run(const std::vector<std::vector<Module<PackagePtr>*>>& modules, bool enable_profile);
 
  private:
-  // 初始化资源
-  void initialize_resources(int stage_num) {
-    for (int i = 0; i < stage_num - 1; ++i) {
-      flags_.emplace_back(std::make_shared<int>(0));                          // 标志初始化为0
-      mutexes_.emplace_back(std::make_shared<std::mutex>());                  // 每个阶段一个互斥锁
-      cvs_.emplace_back(std::make_shared<std::condition_variable>());         // 每个阶段一个条件变量
-      buffers_.emplace_back(std::make_shared<std::queue<std::shared_ptr<Package>>>());  // 每个阶段一个队列
+  // 初始化资源：多个 Source 汇入 MPSC 通道，复制阶段经合并线程输出，其余为 SPSC 通道
+  void initialize_resources(const std::vector<std::vector<Module<PackagePtr>*>>& modules) {
+    flags_.clear();
+    buffers_.clear();
+    for (int i = 0; i < stage_num_ - 1; ++i) {
+      ChannelMode mode = i == 0 && modules[i].size() > 1 ? ChannelMode::kMpsc : ChannelMode::kSpsc;
+      flags_.emplace_back(std::make_shared<int>(0));                                       // 标志初始化为0
+      buffers_.emplace_back(std::make_shared<Channel<PackagePtr>>(capacities_[i], mode));  // 每个阶段一个通道
     }
   }
 
-  // 辅助函数：模块运行逻辑
-  void run_module(Module<Package*>* module, int stage_index, bool enable_profile);
+  // 辅助函数：检查阶段数与各阶段模块数
+  bool validate(const std::vector<std::vector<Module<PackagePtr>*>>& modules) const;
+
+  // 辅助函数：检查融合模式的要求（第 0 阶段均为 Source，其余模块均可内联），并取出各 Source
+  bool validate_fused(const std::vector<std::vector<Module<PackagePtr>*>>& modules,
+                      std::vector<Source*>& sources) const;
+
+  // 辅助函数：清除上一次运行留下的退出标志
+  void reset_exit();
+
+  // 辅助函数：第 0 阶段有多个 Source 时让它们共用 sequence_，下游的重排窗口才能区分各 Source 的包
+  void share_sequence(const std::vector<std::vector<Module<PackagePtr>*>>& modules);
 
-  // 辅助函数：处理单个模块的输入输出
-  std::shared_ptr<Package> pop_from_buffer(int stage_index);
-  void push_to_buffer(int stage_index, std::shared_ptr<Package> package);
+  // 辅助函数：将各模块连接到对应阶段的输入/输出通道
+  void connect_modules(const std::vector<std::vector<Module<PackagePtr>*>>& modules);
+
+  // 辅助函数：为第 stage 阶段的副本创建分发/合并线程及通道
+  void build_replica_stage(int stage, const std::vector<Module<PackagePtr>*>& replicas);
+
+  // 辅助函数：登记各阶段启用了性能分析的模块（副本按 "Stage i.r" 命名）
+  void add_profiles(ProfileReporter& reporter, const std::vector<std::vector<Module<PackagePtr>*>>& modules) const;
+
+  // 辅助函数：模块运行逻辑
+  void run_module(Module<PackagePtr>* module, int stage_index, bool enable_profile);
 };
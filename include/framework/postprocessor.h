@@ -1,21 +1,31 @@
 #pragma once
 
 #include <atomic>
-#include <mutex>
-#include <unordered_map>
-#include <vector>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include "framework/module.h"
+#include "framework/ordered_merge.h"
 
-class Postprocessor : public Module<Package *> {
+/**
+ * @brief 后处理阶段：按 Source 分配的序号恢复顺序后逐包处理
+ *
+ * 到达的包先放入定长的重排窗口（OrderedMerge），按序号依次调用 process()，处理成功且连接了下游时
+ * 推入输出通道。暂存的包数不超过窗口大小，长时间运行内存保持不变；退出时按顺序处理完窗口中剩余的包。
+ * 截止时刻在包按序号轮到时检查（重排窗口中的等待也计入），被削减的包不调用 process()。
+ * 上游处理失败的包同样按序号到达、不留缺口，轮到时不调用 process()，只转发。
+ */
+class Postprocessor : public Module<PackagePtr> {
  public:
   // 构造函数
-  explicit Postprocessor(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id)
-      : Module<Package *>(pre_module_nums, enable_profiler, cpu_id, npu_id), exit_flag_(false) {}
+  explicit Postprocessor(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id,
+                         const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy),
+        merge_("Postprocessor") {}
 
   // 析构函数
-  virtual ~Postprocessor() { clear_buffer(); }
+  virtual ~Postprocessor() = default;
 
   // 禁止拷贝和移动
   Postprocessor(const Postprocessor &) = delete;
@@ -28,60 +38,106 @@ class Postprocessor : public Module<Package *> {
     set_cpu_affinity("Postprocessor");  // 设置 CPU 亲和性
     while (!exit_flag_) {
       try {
-        // 从输入队列中获取数据
+        // 从输入队列中获取数据（超时返回空，用于检查缺包等待是否到期）
         auto input_package = pop_input();
-        if (!input_package) {
-          continue;  // 如果输入为空，继续等待
+        if (input_package) {
+          merge_.accept(std::move(*input_package), [this](PackagePtr &package) { emit(package); });
+        } else {
+          merge_.release_ready([this](PackagePtr &package) { emit(package); });
         }
-
-        // 调用子类实现的处理逻辑
-        if (!process(input_package.get())) {
-          MLOG_ERROR("Postprocessor failed to process package");
-          continue;
-        }
-
-        // 将处理结果存入缓冲区
-        add_to_buffer(cur_idx_, std::move(input_package));
-        cur_idx_++;
       } catch (const std::exception &e) {
         MLOG_ERROR("Exception in Postprocessor: %s", e.what());
       }
     }
-    MLOG_INFO("Postprocessor has exited.");
+
+    // 退出前按顺序处理完窗口中剩余的包
+    merge_.flush([this](PackagePtr &package) { emit(package); });
+    MLOG_INFO("Postprocessor has exited. %s", merge_.report().c_str());
+  }
+
+  // 执行器模式：取一个包放入重排窗口，按序号处理已就绪的包（下游满时输出暂存在模块中）
+  StepResult step() final {
+    if (!flush_stalled()) {
+      return StepResult::kBlocked;
+    }
+    auto emit = [this](PackagePtr &package) {
+      trace_dequeue(package.get());
+      if (admit(package.get()) && !process_timed(package.get())) {
+        MLOG_ERROR("Postprocessor failed to process package");
+      } else if (output_ptr_) {
+        trace_enqueue(package.get());
+        emit_output(package);
+      } else if (!package->is_shed() && !package->is_failed()) {
+        trace_complete(package.get());
+      }
+    };
+    const uint64_t released = merge_.released();
+    try {
+      PackagePtr input_package;
+      if (input_ptr_->try_pop(input_package)) {
+        merge_.accept(std::move(input_package), emit);
+        return StepResult::kProgress;
+      }
+      merge_.release_ready(emit);
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in Postprocessor: %s", e.what());
+    }
+    return merge_.released() != released ? StepResult::kProgress : StepResult::kIdle;
   }
 
-  // 子类必须实现的处理逻辑
+  // 执行器停止后按顺序处理完窗口中剩余的包（下游已停止，只尝试写入一次）
+  void finish() override {
+    flush_stalled();
+    stalled_.clear();
+    merge_.flush([this](PackagePtr &package) {
+      if ((!admit(package.get()) || process_timed(package.get())) && output_ptr_) {
+        output_ptr_->try_push(package);
+      }
+    });
+    MLOG_INFO("%s", merge_.report().c_str());
+  }
+
+  // 子类必须实现的处理逻辑（按序号顺序调用）
   virtual bool process(Package *package) = 0;
 
-  // 安全退出函数
-  void exit() { exit_flag_ = true; }
+  // 设置重排窗口参数（需在 run() 之前设置）
+  void set_reorder(const ReorderConfig &config) { merge_.configure(config); }
+  const ReorderConfig &get_reorder() const { return merge_.config(); }
 
- private:
-  std::unordered_map<int, std::shared_ptr<Package>> buffer_;  // 缓冲区
-  std::mutex buffer_mutex_;                                  // 缓冲区互斥锁
-  std::atomic<int> cur_idx_{0};                              // 当前缓冲区索引
-  std::atomic<bool> exit_flag_;                              // 退出标志
-
-  // 清空缓冲区
-  void clear_buffer() {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    buffer_.clear();
-  }
+  // 重排统计（可在其他线程读取）
+  const OrderedMerge &get_merge() const { return merge_; }
 
  protected:
-  // 添加数据到缓冲区
-  void add_to_buffer(int index, std::shared_ptr<Package> package) {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    buffer_[index] = std::move(package);
+  // 窗口中尚未处理的包（只在 Postprocessor 线程中调用），不存在时返回 nullptr
+  std::shared_ptr<Package> get_from_buffer(uint64_t sequence) const { return merge_.find(sequence); }
+
+ private:
+  OrderedMerge merge_;           // 重排窗口
+
+  // 按序号处理一个包，成功且连接了下游时推入输出通道（退出后下游可能已停止，只按等待策略尝试一次）；
+  // 重排窗口中的等待计入包追踪的排队时间
+  void emit(PackagePtr &package) {
+    trace_dequeue(package.get());
+    if (admit(package.get()) && !process_timed(package.get())) {
+      MLOG_ERROR("Postprocessor failed to process package");
+    } else if (!output_ptr_) {
+      if (!package->is_shed() && !package->is_failed()) trace_complete(package.get());
+    } else {
+      trace_enqueue(package.get());
+      while (!output_ptr_->push(package, wait_strategy_) && !exit_flag_) {
+      }
+    }
   }
 
-  // 获取缓冲区中的数据（可扩展函数）
-  std::shared_ptr<Package> get_from_buffer(int index) {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    auto it = buffer_.find(index);
-    if (it != buffer_.end()) {
-      return it->second;
+  // 调用 process() 并记录处理时延
+  bool process_timed(Package *package) {
+    if (!profiler_.is_enabled()) {
+      return process(package);
     }
-    return nullptr;
+    auto start_time = std::chrono::steady_clock::now();
+    bool ok = process(package);
+    profiler_.add_profile(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count());
+    return ok;
   }
 };
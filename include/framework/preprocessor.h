@@ -7,11 +7,12 @@
 
 #include "framework/module.h"
 
-class Preprocessor : public Module<Package *> {
+class Preprocessor : public Module<PackagePtr> {
  public:
   // 构造函数
-  explicit Preprocessor(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id)
-      : Module<Package *>(pre_module_nums, enable_profiler, cpu_id, npu_id), exit_flag_(false) {}
+  explicit Preprocessor(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id,
+                        const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy) {}
 
   // 析构函数
   virtual ~Preprocessor() = default;
@@ -28,27 +29,30 @@ class Preprocessor : public Module<Package *> {
 
     while (!exit_flag_) {
       try {
-        auto start_time = std::chrono::high_resolution_clock::now();
+        auto start_time = std::chrono::steady_clock::now();
 
         // 从输入队列中获取数据
         auto input_package = pop_input();
         if (!input_package) {
           continue;  // 如果输入为空，继续等待
         }
+        trace_dequeue(input_package->get());
 
-        // 调用子类实现的处理逻辑
-        if (!process(input_package.get())) {
+        // 调用子类实现的处理逻辑（已过期并被削减的包不处理，直接转发）；
+        // 处理失败的包标记后照常转发，下游的重排窗口不必等待这个序号
+        if (admit(input_package->get()) && !process(input_package->get())) {
           MLOG_ERROR("Preprocessor failed to process package");
-          continue;
+          (*input_package)->mark_failed();
         }
 
         // 将处理结果推入输出队列
-        push_output(input_package);
+        trace_enqueue(input_package->get());
+        push_output(*input_package);
 
         // 性能分析
         if (profiler_.is_enabled()) {
-          auto end_time = std::chrono::high_resolution_clock::now();
-          auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+          auto end_time = std::chrono::steady_clock::now();
+          auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
           profiler_.add_profile(duration);
         }
       } catch (const std::exception &e) {
@@ -59,13 +63,37 @@ class Preprocessor : public Module<Package *> {
     MLOG_INFO("Preprocessor has exited.");
   }
 
+  // 执行器模式：取一个包处理后写入输出通道
+  StepResult step() final {
+    if (!flush_stalled()) {
+      return StepResult::kBlocked;
+    }
+    PackagePtr input_package;
+    if (!input_ptr_->try_pop(input_package)) {
+      return StepResult::kIdle;
+    }
+    try {
+      auto start_time = std::chrono::steady_clock::now();
+      trace_dequeue(input_package.get());
+      if (admit(input_package.get()) && !process(input_package.get())) {
+        MLOG_ERROR("Preprocessor failed to process package");
+        input_package->mark_failed();
+      }
+      trace_enqueue(input_package.get());
+      emit_output(input_package);
+      if (profiler_.is_enabled()) {
+        auto end_time = std::chrono::steady_clock::now();
+        profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+      }
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in Preprocessor: %s", e.what());
+    }
+    return StepResult::kProgress;
+  }
+
   // 子类必须实现的处理逻辑
   virtual bool process(Package *package) = 0;
 
-  // 安全退出函数
-  void exit() { exit_flag_ = true; }
-
  private:
-  std::atomic<bool> exit_flag_;  // 退出标志
 };
 
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "framework/module.h"
+#include "framework/ordered_merge.h"
+#include "utils/config.h"
+
+// 副本间的分发策略
+enum class DispatchPolicy {
+  kRoundRobin,   // 依次轮流
+  kLeastLoaded,  // 输入队列最短的副本（相同时轮流）
+};
+
+inline DispatchPolicy parse_dispatch_policy(const std::string &name) {
+  if (name == "round_robin") return DispatchPolicy::kRoundRobin;
+  if (name == "least_loaded") return DispatchPolicy::kLeastLoaded;
+  throw std::runtime_error("Unknown dispatch policy: " + name);
+}
+
+// 阶段复制参数
+struct ReplicationConfig {
+  int replicas{1};  // 副本数（由构建流水线的代码据此创建模块）
+  DispatchPolicy dispatch{DispatchPolicy::kRoundRobin};
+  ReorderConfig reorder;  // 合并时的重排窗口（Pipeline 会放大到不小于各副本在途包数之和）
+
+  // 从配置读取，例如 {"replicas": 4, "dispatch": "least_loaded", "reorder": {"window": 256}}
+  static ReplicationConfig from_config(const ConfigNode &node) {
+    ReplicationConfig config;
+    config.replicas = node.get_int("replicas", config.replicas);
+    if (config.replicas < 1) {
+      throw std::runtime_error("Replication needs replicas >= 1");
+    }
+    config.dispatch = parse_dispatch_policy(node.get_string("dispatch", "round_robin"));
+    if (node.has("reorder")) {
+      config.reorder = ReorderConfig::from_config(node["reorder"]);
+    }
+    return config;
+  }
+};
+
+/**
+ * @brief 把上游通道的包分发到同一阶段的多个副本（每个副本一条 SPSC 输入通道）
+ *
+ * 目标副本的通道满时按等待策略等待（背压），不会改投其他副本，保证轮流分发的顺序可预期。
+ */
+class ReplicaDispatcher : public Module<PackagePtr> {
+ public:
+  ReplicaDispatcher(std::vector<Channel<PackagePtr> *> replicas, DispatchPolicy policy,
+                    const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(1, false, -1, -1, wait_strategy), replicas_(std::move(replicas)), policy_(policy) {
+    if (replicas_.empty()) {
+      throw std::invalid_argument("ReplicaDispatcher needs at least one replica");
+    }
+  }
+
+  void run() override {
+    while (!exit_flag_) {
+      auto input_package = pop_input();
+      if (!input_package) {
+        continue;
+      }
+      Channel<PackagePtr> *target = replicas_[select()];
+      while (!target->push(*input_package, wait_strategy_) && !exit_flag_) {
+      }
+      ++cnt_;
+    }
+  }
+
+  // 执行器模式：分发一个包；目标副本满时保留该包，下次 step 继续投给同一副本
+  StepResult step() override {
+    if (!held_) {
+      if (!input_ptr_->try_pop(held_)) {
+        return StepResult::kIdle;
+      }
+      held_target_ = select();
+    }
+    if (!replicas_[held_target_]->try_push(held_)) {
+      return StepResult::kBlocked;
+    }
+    held_.reset();
+    ++cnt_;
+    return StepResult::kProgress;
+  }
+
+  // 分发器不处理包
+  bool process(Package *) override { return true; }
+
+ private:
+  std::vector<Channel<PackagePtr> *> replicas_;
+  DispatchPolicy policy_;
+  size_t next_{0};  // 下一个轮到的副本
+  PackagePtr held_;  // step 模式下尚未投递成功的包
+  size_t held_target_{0};
+
+  size_t select() {
+    const size_t count = replicas_.size();
+    size_t chosen = next_;
+    if (policy_ == DispatchPolicy::kLeastLoaded) {
+      size_t best = replicas_[chosen]->size();
+      for (size_t i = 1; i < count && best > 0; ++i) {
+        size_t candidate = (next_ + i) % count;
+        size_t load = replicas_[candidate]->size();
+        if (load < best) {
+          best = load;
+          chosen = candidate;
+        }
+      }
+    }
+    next_ = (chosen + 1) % count;
+    return chosen;
+  }
+};
+
+/**
+ * @brief 汇合各副本的输出（MPSC 通道），按 Source 序号恢复顺序后推入下一阶段
+ */
+class ReplicaMerger : public Module<PackagePtr> {
+ public:
+  ReplicaMerger(const std::string &name, const ReorderConfig &reorder,
+                const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(1, false, -1, -1, wait_strategy), merge_(name, reorder) {}
+
+  void run() override {
+    // 退出后下游可能已停止，只按等待策略尝试一次
+    auto emit = [this](PackagePtr &package) {
+      while (!output_ptr_->push(package, wait_strategy_) && !exit_flag_) {
+      }
+      ++cnt_;
+    };
+    while (!exit_flag_) {
+      auto input_package = pop_input();
+      if (input_package) {
+        merge_.accept(std::move(*input_package), emit);
+      } else {
+        merge_.release_ready(emit);
+      }
+    }
+    merge_.flush(emit);
+    MLOG_INFO("%s", merge_.report().c_str());
+  }
+
+  // 执行器模式：取一个包放入重排窗口，写出已就绪的包（下游满时暂存在模块中）
+  StepResult step() override {
+    if (!flush_stalled()) {
+      return StepResult::kBlocked;
+    }
+    auto emit = [this](PackagePtr &package) {
+      emit_output(package);
+      ++cnt_;
+    };
+    const uint64_t released = merge_.released();
+    PackagePtr input_package;
+    if (input_ptr_->try_pop(input_package)) {
+      merge_.accept(std::move(input_package), emit);
+      return StepResult::kProgress;
+    }
+    merge_.release_ready(emit);
+    return merge_.released() != released ? StepResult::kProgress : StepResult::kIdle;
+  }
+
+  // 执行器停止后按顺序写出窗口中剩余的包（下游已停止，只尝试写入一次）
+  void finish() override {
+    flush_stalled();
+    stalled_.clear();
+    merge_.flush([this](PackagePtr &package) { output_ptr_->try_push(package); });
+    MLOG_INFO("%s", merge_.report().c_str());
+  }
+
+  // 合并器不处理包
+  bool process(Package *) override { return true; }
+
+  const OrderedMerge &get_merge() const { return merge_; }
+
+ private:
+  OrderedMerge merge_;
+};
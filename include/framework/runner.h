@@ -4,14 +4,35 @@
 #include <chrono>
 #include <memory>
 #include <exception>
+#include <vector>
 
 #include "framework/module.h"
+#include "utils/config.h"
+#include "utils/histogram.h"
 
-class Runner : public Module<Package *> {
+// 微批配置：凑满 max_batch 个包或从第一个包取出起等待 max_wait，先到者为准
+struct BatchConfig {
+  int max_batch{1};                         // 1 表示不攒批，逐包处理
+  std::chrono::microseconds max_wait{200};  // 攒批附加的最长排队时间
+
+  // 从配置读取，例如 {"max_batch": 8, "max_wait_us": 200}
+  static BatchConfig from_config(const ConfigNode &node) {
+    BatchConfig config;
+    config.max_batch = node.get_int("max_batch", config.max_batch);
+    config.max_wait = std::chrono::microseconds(node.get_int("max_wait_us", static_cast<int>(config.max_wait.count())));
+    if (config.max_batch < 1 || config.max_wait.count() < 0) {
+      throw std::runtime_error("Runner batching needs max_batch >= 1 and max_wait_us >= 0");
+    }
+    return config;
+  }
+};
+
+class Runner : public Module<PackagePtr> {
  public:
   // 构造函数
-  explicit Runner(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id)
-      : Module<Package *>(pre_module_nums, enable_profiler, cpu_id, npu_id), exit_flag_(false) {}
+  explicit Runner(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id,
+                  const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy) {}
 
   // 析构函数
   virtual ~Runner() = default;
@@ -26,29 +47,39 @@ class Runner : public Module<Package *> {
   void run() final {
     set_cpu_affinity("Runner");  // 设置 CPU 亲和性
 
+    if (batch_config_.max_batch > 1) {
+      run_batched();
+      MLOG_INFO("Runner has exited. %s", batch_fill_.report("batch_fill").c_str());
+      MLOG_INFO("%s", queue_delay_.report("batch_queue_delay_us").c_str());
+      return;
+    }
+
     while (!exit_flag_) {
       try {
-        auto start_time = std::chrono::high_resolution_clock::now();
+        auto start_time = std::chrono::steady_clock::now();
 
         // 从输入队列中获取数据
         auto input_package = pop_input();
         if (!input_package) {
           continue;  // 如果输入为空，继续等待
         }
+        trace_dequeue(input_package->get());
 
-        // 调用子类实现的处理逻辑
-        if (!process(input_package.get())) {
+        // 调用子类实现的处理逻辑（已过期并被削减的包不处理，直接转发）；
+        // 处理失败的包标记后照常转发，下游的重排窗口不必等待这个序号
+        if (admit(input_package->get()) && !process(input_package->get())) {
           MLOG_ERROR("Runner failed to process package");
-          continue;
+          (*input_package)->mark_failed();
         }
 
         // 将处理结果推入输出队列
-        push_output(input_package);
+        trace_enqueue(input_package->get());
+        push_output(*input_package);
 
         // 性能分析
         if (profiler_.is_enabled()) {
-          auto end_time = std::chrono::high_resolution_clock::now();
-          auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+          auto end_time = std::chrono::steady_clock::now();
+          auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
           profiler_.add_profile(duration);
         }
       } catch (const std::exception &e) {
@@ -59,12 +90,187 @@ class Runner : public Module<Package *> {
     MLOG_INFO("Runner has exited.");
   }
 
+  // 执行器模式：取出当前已到达的包（开启微批时最多 max_batch 个，不等待截止时间）批量处理
+  StepResult step() final {
+    if (!flush_stalled()) {
+      return StepResult::kBlocked;
+    }
+    const size_t max_batch = static_cast<size_t>(batch_config_.max_batch);
+    step_batch_.clear();
+    PackagePtr next;
+    while (step_batch_.size() < max_batch && input_ptr_->try_pop(next)) {
+      step_batch_.push_back(std::move(next));
+    }
+    if (step_batch_.empty()) {
+      return StepResult::kIdle;
+    }
+
+    try {
+      const auto start_time = std::chrono::steady_clock::now();
+      step_packages_.clear();
+      step_admitted_.clear();
+      for (auto &package : step_batch_) {
+        trace_dequeue(package.get());
+        step_admitted_.push_back(admit(package.get()));
+        if (step_admitted_.back()) {
+          step_packages_.push_back(package.get());
+        }
+      }
+      if (step_ok_size_ < max_batch) {
+        step_ok_.reset(new bool[max_batch]);
+        step_ok_size_ = max_batch;
+      }
+      if (max_batch > 1) {
+        batch_fill_.record(step_batch_.size());
+      }
+      if (!step_packages_.empty()) {
+        process_batch(step_packages_.data(), step_packages_.size(), step_ok_.get());
+      }
+      for (size_t i = 0, j = 0; i < step_batch_.size(); ++i) {
+        if (step_admitted_[i] && !step_ok_[j++]) {
+          MLOG_ERROR("Runner failed to process package");
+          step_batch_[i]->mark_failed();
+        }
+        trace_enqueue(step_batch_[i].get());
+        emit_output(step_batch_[i]);
+      }
+      if (profiler_.is_enabled()) {
+        auto duration =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time).count();
+        auto per_package = duration / static_cast<decltype(duration)>(step_batch_.size());
+        for (size_t i = 0; i < step_batch_.size(); ++i) {
+          profiler_.add_profile(per_package);
+        }
+      }
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in Runner: %s", e.what());
+    }
+    return StepResult::kProgress;
+  }
+
   // 子类必须实现的处理逻辑
   virtual bool process(Package *package) = 0;
 
-  // 安全退出函数
-  void exit() { exit_flag_ = true; }
+  /**
+   * 批处理逻辑（开启微批时调用），默认逐包调用 process
+   * @param packages 本批的包，按到达顺序排列
+   * @param count 包数，1 <= count <= max_batch
+   * @param ok 输出，ok[i] 为 false 的包不会推入下游
+   */
+  virtual void process_batch(Package *const *packages, size_t count, bool *ok) {
+    for (size_t i = 0; i < count; ++i) {
+      ok[i] = process(packages[i]);
+    }
+  }
+
+  // 设置微批参数（需在 run() 之前设置）
+  void set_batching(const BatchConfig &config) {
+    batch_config_ = config;
+    batch_fill_ = Histogram::linear(config.max_batch);
+    queue_delay_ = Histogram::exponential(static_cast<uint64_t>(config.max_wait.count()) * 4);
+  }
+  const BatchConfig &get_batching() const { return batch_config_; }
+
+  // 批大小分布，以及每个包因攒批多等待的时间（微秒，从取出到开始处理）
+  const Histogram &batch_fill_histogram() const { return batch_fill_; }
+  const Histogram &queue_delay_histogram() const { return queue_delay_; }
 
  private:
-  std::atomic<bool> exit_flag_;  // 退出标志
+  BatchConfig batch_config_;
+  Histogram batch_fill_{Histogram::linear(1)};
+  Histogram queue_delay_{Histogram::exponential(1)};
+
+  // step() 的工作区
+  std::vector<PackagePtr> step_batch_;
+  std::vector<Package *> step_packages_;
+  std::vector<char> step_admitted_;  // 第 i 个包是否需要处理（被削减的包只转发）
+  std::unique_ptr<bool[]> step_ok_;
+  size_t step_ok_size_{0};
+
+  // 微批主循环：第一个包按等待策略阻塞获取，其余包只等到该包的截止时间
+  void run_batched() {
+    using Clock = std::chrono::steady_clock;
+    const size_t max_batch = static_cast<size_t>(batch_config_.max_batch);
+    std::vector<PackagePtr> batch;
+    std::vector<Package *> packages;
+    std::vector<Clock::time_point> arrivals;
+    std::vector<char> admitted;
+    std::unique_ptr<bool[]> ok(new bool[max_batch]);
+    batch.reserve(max_batch);
+    packages.reserve(max_batch);
+    arrivals.reserve(max_batch);
+    admitted.reserve(max_batch);
+
+    while (!exit_flag_) {
+      try {
+        batch.clear();
+        packages.clear();
+        arrivals.clear();
+        admitted.clear();
+
+        auto first = pop_input();
+        if (!first) {
+          continue;  // 如果输入为空，继续等待
+        }
+        arrivals.push_back(Clock::now());
+        batch.push_back(std::move(*first));
+        const auto deadline = arrivals.front() + batch_config_.max_wait;
+
+        // 攒批：已有数据时直接取，否则按等待策略等到截止时间
+        WaitStrategy strategy = wait_strategy_;
+        while (batch.size() < max_batch) {
+          PackagePtr next;
+          if (!input_ptr_->try_pop(next)) {
+            auto now = Clock::now();
+            if (now >= deadline) {
+              break;
+            }
+            strategy.timeout = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+            if (!input_ptr_->pop(next, strategy)) {
+              break;
+            }
+          }
+          batch.push_back(std::move(next));
+          arrivals.push_back(Clock::now());
+        }
+
+        // 攒批的等待计入排队时间（包追踪从这里开始计处理时间）；攒批期间过期的包同样按策略削减
+        const auto start_time = Clock::now();
+        for (size_t i = 0; i < batch.size(); ++i) {
+          trace_dequeue(batch[i].get());
+          admitted.push_back(admit(batch[i].get()));
+          if (admitted.back()) {
+            packages.push_back(batch[i].get());
+          }
+          queue_delay_.record(
+              std::chrono::duration_cast<std::chrono::microseconds>(start_time - arrivals[i]).count());
+        }
+        batch_fill_.record(batch.size());
+
+        // 调用子类实现的批处理逻辑，结果按原顺序推入输出队列（被削减的包直接转发，处理失败的包标记后转发）
+        if (!packages.empty()) {
+          process_batch(packages.data(), packages.size(), ok.get());
+        }
+        for (size_t i = 0, j = 0; i < batch.size(); ++i) {
+          if (admitted[i] && !ok[j++]) {
+            MLOG_ERROR("Runner failed to process package");
+            batch[i]->mark_failed();
+          }
+          trace_enqueue(batch[i].get());
+          push_output(batch[i]);
+        }
+
+        // 性能分析（按包平均）
+        if (profiler_.is_enabled()) {
+          auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time).count();
+          auto per_package = duration / static_cast<decltype(duration)>(batch.size());
+          for (size_t i = 0; i < batch.size(); ++i) {
+            profiler_.add_profile(per_package);
+          }
+        }
+      } catch (const std::exception &e) {
+        MLOG_ERROR("Exception in Runner: %s", e.what());
+      }
+    }
+  }
 };
@@ -7,11 +7,12 @@
 
 #include "framework/module.h"
 
-class Sink : public Module<Package *> {
+class Sink : public Module<PackagePtr> {
  public:
   // 构造函数
-  explicit Sink(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id)
-      : Module<Package *>(pre_module_nums, enable_profiler, cpu_id, npu_id), exit_flag_(false) {}
+  explicit Sink(int pre_module_nums, bool enable_profiler, int cpu_id, int npu_id,
+                const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy) {}
 
   // 析构函数
   virtual ~Sink() = default;
@@ -28,24 +29,31 @@ class Sink : public Module<Package *> {
 
     while (!exit_flag_) {
       try {
-        auto start_time = std::chrono::high_resolution_clock::now();
+        auto start_time = std::chrono::steady_clock::now();
 
         // 从输入队列中获取数据
         auto input_package = pop_input();
         if (!input_package) {
           continue;  // 如果输入为空，继续等待
         }
+        trace_dequeue(input_package->get());
+
+        // 被削减或在上游处理失败的包不输出结果，也不计入端到端时延
+        if (!admit(input_package->get())) {
+          continue;
+        }
 
         // 处理数据并输出结果
-        if (!process(input_package.get())) {
+        if (!process(input_package->get())) {
           MLOG_ERROR("Sink failed to process package");
           continue;
         }
+        trace_complete(input_package->get());
 
         // 性能分析
         if (profiler_.is_enabled()) {
-          auto end_time = std::chrono::high_resolution_clock::now();
-          auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+          auto end_time = std::chrono::steady_clock::now();
+          auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
           profiler_.add_profile(duration);
         }
       } catch (const std::exception &e) {
@@ -56,12 +64,35 @@ class Sink : public Module<Package *> {
     MLOG_INFO("Sink has exited.");
   }
 
+  // 执行器模式：取一个包处理
+  StepResult step() final {
+    PackagePtr input_package;
+    if (!input_ptr_->try_pop(input_package)) {
+      return StepResult::kIdle;
+    }
+    try {
+      auto start_time = std::chrono::steady_clock::now();
+      trace_dequeue(input_package.get());
+      if (!admit(input_package.get())) {
+        return StepResult::kProgress;
+      }
+      if (!process(input_package.get())) {
+        MLOG_ERROR("Sink failed to process package");
+        return StepResult::kProgress;
+      }
+      trace_complete(input_package.get());
+      if (profiler_.is_enabled()) {
+        auto end_time = std::chrono::steady_clock::now();
+        profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+      }
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in Sink: %s", e.what());
+    }
+    return StepResult::kProgress;
+  }
+
   // 子类需要实现的核心处理逻辑
   virtual bool process(Package *package) = 0;
 
-  // 安全退出函数
-  void exit() { exit_flag_ = true; }
-
  private:
-  std::atomic<bool> exit_flag_;  // 退出标志
 };
@@ -6,16 +6,17 @@
 #include <memory>
 
 #include "framework/module.h"
+#include "utils/package_pool.h"
 #include "opencv2/highgui.hpp"
 #include "opencv2/videoio.hpp"
 
-class Source : public Module<Package *> {
+class Source : public Module<PackagePtr> {
  public:
   // 构造函数
-  explicit Source(int max_queue_length, bool enable_profiler, int cpu_id, int npu_id)
-      : Module<Package *>(0, enable_profiler, cpu_id, npu_id), 
-        max_queue_length_(max_queue_length), 
-        exit_flag_(false) {}
+  explicit Source(int max_queue_length, bool enable_profiler, int cpu_id, int npu_id,
+                  const WaitStrategy &wait_strategy = WaitStrategy())
+      : Module<PackagePtr>(0, enable_profiler, cpu_id, npu_id, wait_strategy), 
+        max_queue_length_(max_queue_length) {}
 
   // 析构函数
   virtual ~Source() = default;
@@ -29,33 +30,42 @@ class Source : public Module<Package *> {
   // 运行函数
   void run() final {
     set_cpu_affinity("Source");  // 设置线程的 CPU 亲和性
+    may_block_ = true;
+    const bool drop_newest = shed_policy_ == ShedPolicy::kDropNewest;
 
     while (!exit_flag_) {
       try {
-        auto start_time = std::chrono::high_resolution_clock::now();
+        auto start_time = std::chrono::steady_clock::now();
 
-        // 检查队列长度是否超限
-        if (is_queue_full()) {
-          std::this_thread::sleep_for(std::chrono::milliseconds(10));  // 等待队列有空闲空间
+        // 按等待策略等待输出通道有空闲位置（超时则重新检查退出标志）；
+        // kDropNewest 下不等待，照常读取数据，下游积压时丢弃新包，避免数据在设备缓冲区中变旧
+        if (!drop_newest && !wait_for_free_slot()) {
           continue;
         }
 
-        // 创建一个新的数据包
-        std::shared_ptr<Package> package = std::make_shared<Package>();
+        // 从数据包池中取出一个可复用的数据包
+        PackagePtr package = package_pool_.acquire();
+        trace_dequeue(package.get());
 
-        // 调用子类实现的具体处理逻辑
+        // 调用子类实现的具体处理逻辑（返回 false 视为暂无数据，包直接归还）
         if (!process(package.get())) {
-          MLOG_ERROR("Source failed to process package");
+          continue;
+        }
+        if (drop_newest && output_full()) {
+          shed_counters_.add_dropped();
           continue;
         }
 
-        // 将数据推入输出队列
+        // 处理成功的包按产生顺序编号、分配截止时刻后推入输出队列
+        package->set_sequence(take_sequence());
+        assign_deadline(package.get());
+        trace_produced(package.get());
         push_output(package);
 
         // 性能分析
         if (profiler_.is_enabled()) {
-          auto end_time = std::chrono::high_resolution_clock::now();
-          auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+          auto end_time = std::chrono::steady_clock::now();
+          auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
           profiler_.add_profile(duration);
         }
       } catch (const std::exception &e) {
@@ -66,19 +76,134 @@ class Source : public Module<Package *> {
     MLOG_INFO("Source has exited.");
   }
 
-  // 子类需要实现的核心处理逻辑
+  // 执行器模式：输出通道未满时产生一个包（process 返回 false 视为暂无数据）
+  StepResult step() final {
+    const bool drop_newest = shed_policy_ == ShedPolicy::kDropNewest;
+    if (!flush_stalled() || (!drop_newest && output_full())) {
+      return StepResult::kBlocked;
+    }
+    try {
+      auto start_time = std::chrono::steady_clock::now();
+      PackagePtr package = package_pool_.acquire();
+      trace_dequeue(package.get());
+      if (!process(package.get())) {
+        return StepResult::kIdle;
+      }
+      if (drop_newest && output_full()) {
+        shed_counters_.add_dropped();
+        return StepResult::kProgress;
+      }
+      package->set_sequence(take_sequence());
+      assign_deadline(package.get());
+      trace_produced(package.get());
+      emit_output(package);
+      if (profiler_.is_enabled()) {
+        auto end_time = std::chrono::steady_clock::now();
+        profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+      }
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in Source: %s", e.what());
+    }
+    return StepResult::kProgress;
+  }
+
+  /**
+   * 融合模式（Pipeline::run_fused）：在调用线程中产生一个包，编号并分配截止时刻，不写入输出通道
+   * 调用方需保证同一时刻只有一个线程调用；融合模式没有通道积压，kDropNewest 不会丢包
+   * @return 已退出或暂无数据时返回空指针
+   */
+  PackagePtr produce() {
+    may_block_ = true;  // 融合模式的工作线程只服务于流水线，process 可以阻塞等待数据
+    if (exit_flag_) {
+      return nullptr;
+    }
+    try {
+      auto start_time = std::chrono::steady_clock::now();
+      PackagePtr package = package_pool_.acquire();
+      trace_dequeue(package.get());
+      if (!process(package.get())) {
+        return nullptr;
+      }
+      package->set_sequence(take_sequence());
+      assign_deadline(package.get());
+      trace_produced(package.get());
+      if (profiler_.is_enabled()) {
+        auto end_time = std::chrono::steady_clock::now();
+        profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+      }
+      return package;
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in Source: %s", e.what());
+    }
+    return nullptr;
+  }
+
+  /**
+   * 子类需要实现的核心处理逻辑：向包中写入一段数据
+   * @return 暂无数据时返回 false（不占用序号）。may_block() 为 true 时可以阻塞等待数据，
+   *         否则应立即返回，避免占住执行器的工作线程
+   * 子类可以按采集时刻自行 set_deadline()，否则设置了预算时按 process() 返回的时刻分配
+   */
   virtual bool process(Package *package) = 0;
 
-  // 安全退出函数
-  void exit() { exit_flag_ = true; }
+  // 设置截止时刻预算与本阶段的策略（需在启动前设置；下游各阶段用 set_shed_policy 设置各自的策略）
+  void set_deadline(const DeadlineConfig &config) {
+    deadline_budget_ = config.budget;
+    shed_policy_ = config.policy;
+  }
+  std::chrono::microseconds get_deadline_budget() const { return deadline_budget_; }
+
+  // 本 Source 已产生的包数（不共用序号计数器时即下一个包的序号）
+  uint64_t get_next_sequence() const { return next_sequence_; }
+
+  // 多个 Source 汇入同一条流水线时共用一个序号计数器，序号在各 Source 之间不重复
+  // （由 Pipeline 在启动前设置；nullptr 表示按本 Source 的产生顺序编号）
+  void share_sequence(std::atomic<uint64_t> *counter) { shared_sequence_ = counter; }
+
+  // 获取数据包池（用于查看分配统计）
+  const PackagePool &get_package_pool() const { return package_pool_; }
+
+ protected:
+  // process 是否运行在专用线程上（run() 或融合模式的工作线程），执行器模式下为 false
+  bool may_block() const { return may_block_; }
+
+  // 等待的最长时间（may_block() 为 true 时，process 单次阻塞不应超过它，以便及时响应退出）
+  std::chrono::microseconds block_timeout() const { return wait_strategy_.timeout; }
 
  private:
   int max_queue_length_;         // 队列的最大长度
-  std::atomic<bool> exit_flag_;  // 退出标志
+  PackagePool package_pool_;     // 数据包池（最后一个阶段释放后自动归还）
+  uint64_t next_sequence_{0};    // 已产生的包数（只在 Source 线程中修改）
+  std::atomic<uint64_t> *shared_sequence_{nullptr};  // 共用的序号计数器（为空时序号即 next_sequence_）
+  bool may_block_{false};        // 由 run() 或 produce() 驱动
+  std::chrono::microseconds deadline_budget_{0};  // 截止时刻预算，0 表示不分配
+
+  // 为处理成功的包分配序号
+  uint64_t take_sequence() {
+    const uint64_t own = next_sequence_++;
+    return shared_sequence_ ? shared_sequence_->fetch_add(1, std::memory_order_relaxed) : own;
+  }
+
+  // 按预算分配截止时刻（子类已写入的保持不变）
+  void assign_deadline(Package *package) {
+    if (deadline_budget_.count() > 0 && !package->has_deadline()) {
+      package->set_deadline(std::chrono::steady_clock::now() + deadline_budget_);
+    }
+  }
+
+  bool output_full() const { return output_ptr_->size() >= static_cast<size_t>(max_queue_length_); }
+
+  // 包追踪：子类没有写入刺激/采集时刻时取开始处理的时刻
+  void trace_produced(Package *package) {
+    if (tracker_) {
+      PackageTrace &trace = package->trace();
+      if (trace.origin == 0) trace.origin = trace.dequeue[0];
+      trace_enqueue(package);
+    }
+  }
 
-  // 检查队列是否已满
-  bool is_queue_full() {
-    std::lock_guard<std::mutex> lock(*output_mutex_);
-    return output_ptr_ && output_ptr_->size() >= static_cast<size_t>(max_queue_length_);
+  // 等待输出通道长度低于 max_queue_length_
+  bool wait_for_free_slot() {
+    return output_ptr_ && output_ptr_->wait_below(static_cast<size_t>(max_queue_length_), wait_strategy_);
   }
 };
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/common.h"
+#include "utils/config.h"
+#include "utils/latency_histogram.h"
+
+// 包追踪参数
+struct TrackerConfig {
+  uint32_t sample_every{100};  // 每隔多少个序号保留一个完整样本用于导出（0 表示不保留）
+  size_t max_samples{4096};    // 最多保留的样本数（环形覆盖最早的样本）
+
+  // 从配置读取，例如 {"sample_every": 100, "max_samples": 4096}
+  static TrackerConfig from_config(const ConfigNode &node) {
+    TrackerConfig config;
+    const int sample_every = node.get_int("sample_every", static_cast<int>(config.sample_every));
+    const int max_samples = node.get_int("max_samples", static_cast<int>(config.max_samples));
+    if (sample_every < 0 || max_samples < 1) {
+      throw std::runtime_error("Tracker needs sample_every >= 0 and max_samples >= 1");
+    }
+    config.sample_every = static_cast<uint32_t>(sample_every);
+    config.max_samples = static_cast<size_t>(max_samples);
+    return config;
+  }
+};
+
+/**
+ * @brief 端到端的包追踪：汇总各阶段的排队/处理时间与刺激到决策的总时延，并导出 Chrome trace
+ *
+ * 各阶段把时间戳写在包自带的 PackageTrace 中（见 Module::trace_dequeue / trace_enqueue），
+ * 最后一个阶段处理完后调用 complete()：时延计入各阶段的直方图，按序号抽样的包复制到预先分配的
+ * 样本环中。记录路径不分配内存、不加锁，可以被多个线程（例如复制的最后阶段）同时调用。
+ * 导出的 JSON 可以直接在 chrome://tracing 或 Perfetto 中打开。
+ */
+class Tracker {
+ public:
+  explicit Tracker(int stage_num, const TrackerConfig &config = TrackerConfig())
+      : stage_num_(checked_stage_num(stage_num)),
+        config_(config),
+        queue_wait_(new LatencyHistogram[stage_num_]),
+        service_(new LatencyHistogram[stage_num_]),
+        samples_(config.max_samples) {
+    TraceClock::ns_per_tick();  // 提前校准，避免在记录路径上校准
+    for (int i = 0; i < stage_num_; ++i) {
+      stage_names_.push_back("Stage " + std::to_string(i));
+    }
+  }
+
+  Tracker(const Tracker &) = delete;
+  Tracker &operator=(const Tracker &) = delete;
+
+  int stage_num() const { return stage_num_; }
+
+  // 设置导出与报告中的阶段名（需在开始追踪前设置）
+  void set_stage_name(int stage, const std::string &name) {
+    if (stage >= 0 && stage < stage_num_) stage_names_[stage] = name;
+  }
+
+  // 最后一个阶段处理完一个包后调用
+  void complete(const Package &package) {
+    const PackageTrace &trace = package.trace();
+    int64_t last = 0;
+    for (int i = 0; i < stage_num_; ++i) {
+      if (i > 0 && trace.dequeue[i] > 0 && trace.enqueue[i - 1] > 0) {
+        queue_wait_[i].record(elapsed_ns(trace.enqueue[i - 1], trace.dequeue[i]));
+      }
+      if (trace.dequeue[i] > 0 && trace.enqueue[i] > 0) {
+        service_[i].record(elapsed_ns(trace.dequeue[i], trace.enqueue[i]));
+        last = trace.enqueue[i];
+      }
+    }
+    if (trace.origin > 0 && last > 0) {
+      end_to_end_.record(elapsed_ns(trace.origin, last));
+    }
+
+    if (config_.sample_every > 0 && package.get_sequence() % config_.sample_every == 0) {
+      const uint64_t index = next_sample_.fetch_add(1, std::memory_order_relaxed);
+      Sample &sample = samples_[index % samples_.size()];
+      sample.sequence = package.get_sequence();
+      sample.trace = trace;
+    }
+  }
+
+  // 第 stage 阶段的排队时间（上一阶段写入 -> 本阶段取到）与处理时间
+  LatencySnapshot queue_wait(int stage) const { return queue_wait_[stage].snapshot(); }
+  LatencySnapshot service(int stage) const { return service_[stage].snapshot(); }
+
+  // 刺激/采集时刻到最后一个阶段处理完的总时延
+  LatencySnapshot end_to_end() const { return end_to_end_.snapshot(); }
+
+  // 已保留的样本数
+  size_t sample_count() const {
+    return static_cast<size_t>(std::min<uint64_t>(next_sample_.load(std::memory_order_relaxed), samples_.size()));
+  }
+
+  // 多行摘要：每个阶段的排队/处理时间，以及总时延
+  std::string report() const {
+    std::string text;
+    for (int i = 0; i < stage_num_; ++i) {
+      if (i > 0) text += queue_wait(i).format(stage_names_[i] + " queue") + "\n";
+      text += service(i).format(stage_names_[i] + " service") + "\n";
+    }
+    text += end_to_end().format("end-to-end");
+    return text;
+  }
+
+  /**
+   * 把保留的样本导出为 Chrome trace_event JSON（每个阶段一条轨道，排队与处理各为一个区间）
+   * 应在流水线停止后调用
+   * @param path 输出文件路径
+   * @return 是否写入成功
+   */
+  bool export_chrome_trace(const std::string &path) const {
+    FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+      return false;
+    }
+    const size_t count = sample_count();
+    int64_t base = 0;
+    for (size_t s = 0; s < count; ++s) {
+      const int64_t origin = first_stamp(samples_[s].trace);
+      if (origin > 0 && (base == 0 || origin < base)) base = origin;
+    }
+    const double us_per_tick = TraceClock::ns_per_tick() / 1e3;
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    auto separator = [&]() {
+      if (!first) std::fprintf(file, ",\n");
+      first = false;
+    };
+    for (int i = 0; i < stage_num_; ++i) {
+      separator();
+      std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", i,
+                   stage_names_[i].c_str());
+    }
+    auto event = [&](const char *name, int stage, uint64_t sequence, int64_t begin, int64_t end) {
+      if (begin <= 0 || end < begin) return;
+      separator();
+      std::fprintf(file,
+                   "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                   "\"args\":{\"sequence\":%llu}}",
+                   name, stage, (begin - base) * us_per_tick, (end - begin) * us_per_tick,
+                   static_cast<unsigned long long>(sequence));
+    };
+    for (size_t s = 0; s < count; ++s) {
+      const Sample &sample = samples_[s];
+      const PackageTrace &trace = sample.trace;
+      event("origin", 0, sample.sequence, trace.origin, trace.dequeue[0]);
+      for (int i = 0; i < stage_num_; ++i) {
+        if (i > 0) event("queue", i, sample.sequence, trace.enqueue[i - 1], trace.dequeue[i]);
+        event(stage_names_[i].c_str(), i, sample.sequence, trace.dequeue[i], trace.enqueue[i]);
+      }
+    }
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+  }
+
+ private:
+  struct Sample {
+    uint64_t sequence{0};
+    PackageTrace trace;
+  };
+
+  int stage_num_;
+  TrackerConfig config_;
+  std::vector<std::string> stage_names_;
+  std::unique_ptr<LatencyHistogram[]> queue_wait_;
+  std::unique_ptr<LatencyHistogram[]> service_;
+  LatencyHistogram end_to_end_;
+  std::vector<Sample> samples_;               // 预先分配的样本环
+  std::atomic<uint64_t> next_sample_{0};
+
+  // 超过 PackageTrace::kMaxStages 的阶段不追踪
+  static int checked_stage_num(int stage_num) {
+    if (stage_num < 1) {
+      throw std::invalid_argument("Tracker needs at least one stage");
+    }
+    return std::min(stage_num, PackageTrace::kMaxStages);
+  }
+
+  static uint64_t elapsed_ns(int64_t begin, int64_t end) {
+    return end > begin ? static_cast<uint64_t>(TraceClock::to_ns(end - begin)) : 0;
+  }
+
+  static int64_t first_stamp(const PackageTrace &trace) { return trace.origin > 0 ? trace.origin : trace.dequeue[0]; }
+};
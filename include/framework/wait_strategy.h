@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "utils/config.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// 自旋等待时的 CPU 提示（降低功耗并让出超线程资源）
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+// 等待策略类型
+enum class WaitStrategyType {
+  kBusySpin,   // 忙等：独占核心时延迟最低
+  kSpinYield,  // 有限自旋后 yield：折中
+  kPark        // 有限自旋后挂起在条件变量上：共享机器上最省 CPU
+};
+
+/**
+ * @brief 模块等待上下游通道时使用的策略
+ *
+ * 每次等待最多持续 timeout，超时后返回，让 run() 循环有机会检查退出标志。
+ */
+struct WaitStrategy {
+  WaitStrategyType type{WaitStrategyType::kSpinYield};
+  int spin_iterations{256};                     // 进入 yield / park 之前的自旋次数
+  std::chrono::microseconds timeout{10000};     // 单次等待的最长时间
+
+  static WaitStrategy busy_spin() { return WaitStrategy{WaitStrategyType::kBusySpin}; }
+  static WaitStrategy spin_yield(int spins = 256) { return WaitStrategy{WaitStrategyType::kSpinYield, spins}; }
+  static WaitStrategy park(int spins = 64) { return WaitStrategy{WaitStrategyType::kPark, spins}; }
+
+  // 名称与类型互转（配置文件中使用 "busy_spin" / "spin_yield" / "park"）
+  static WaitStrategyType parse_type(const std::string& name) {
+    if (name == "busy_spin") return WaitStrategyType::kBusySpin;
+    if (name == "spin_yield") return WaitStrategyType::kSpinYield;
+    if (name == "park") return WaitStrategyType::kPark;
+    throw std::runtime_error("Unknown wait strategy: " + name);
+  }
+
+  static const char* type_name(WaitStrategyType type) {
+    switch (type) {
+      case WaitStrategyType::kBusySpin: return "busy_spin";
+      case WaitStrategyType::kSpinYield: return "spin_yield";
+      case WaitStrategyType::kPark: return "park";
+      default: return "unknown";
+    }
+  }
+
+  // 从配置读取，例如 {"type": "park", "spin_iterations": 64, "timeout_us": 10000}
+  // 也接受直接写字符串 "busy_spin"
+  static WaitStrategy from_config(const ConfigNode& node) { return from_config(node, WaitStrategy()); }
+
+  // 同上，未给出的字段取 defaults（如 pipeline.wait_strategy）
+  static WaitStrategy from_config(const ConfigNode& node, const WaitStrategy& defaults) {
+    WaitStrategy strategy = defaults;
+    if (node.type() == ConfigNode::Type::kString) {
+      strategy.type = parse_type(node.as_string());
+      return strategy;
+    }
+    strategy.type = parse_type(node.get_string("type", type_name(strategy.type)));
+    strategy.spin_iterations = node.get_int("spin_iterations", strategy.spin_iterations);
+    strategy.timeout = std::chrono::microseconds(node.get_int("timeout_us", static_cast<int>(strategy.timeout.count())));
+    return strategy;
+  }
+};
+
+/**
+ * @brief 通道一侧的等待事件（"非空" 或 "非满"）
+ *
+ * 只有 Park 策略会真正挂起；通知方在没有挂起者时只付出一次内存屏障和一次原子读。
+ */
+class WaitEvent {
+ public:
+  WaitEvent() = default;
+  WaitEvent(const WaitEvent&) = delete;
+  WaitEvent& operator=(const WaitEvent&) = delete;
+
+  // 条件可能已满足时由对端调用
+  void notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_.notify_all();
+    }
+  }
+
+  // 按策略等待 ready() 为真，超时返回 false
+  template <class Predicate>
+  bool wait(const WaitStrategy& strategy, Predicate ready) {
+    if (ready()) {
+      return true;
+    }
+    for (int i = 0; i < strategy.spin_iterations; ++i) {
+      cpu_relax();
+      if (ready()) {
+        return true;
+      }
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + strategy.timeout;
+    switch (strategy.type) {
+      case WaitStrategyType::kBusySpin:
+        for (;;) {
+          for (int i = 0; i < kClockCheckInterval; ++i) {
+            if (ready()) {
+              return true;
+            }
+            cpu_relax();
+          }
+          if (std::chrono::steady_clock::now() >= deadline) {
+            return ready();
+          }
+        }
+      case WaitStrategyType::kSpinYield:
+        for (;;) {
+          if (ready()) {
+            return true;
+          }
+          if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+          }
+          std::this_thread::yield();
+        }
+      case WaitStrategyType::kPark:
+      default: {
+        std::unique_lock<std::mutex> lock(mutex_);
+        parked_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool satisfied = cv_.wait_until(lock, deadline, ready);
+        parked_.fetch_sub(1, std::memory_order_relaxed);
+        return satisfied;
+      }
+    }
+  }
+
+ private:
+  static constexpr int kClockCheckInterval = 1024;  // 忙等时每隔多少次检查一次时钟
+
+  std::atomic<int> parked_{0};  // 当前挂起的等待者数量
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
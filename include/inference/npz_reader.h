@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 从 .npy / .npz 读出的数组（统一转换为 double，C 顺序）
+ */
+struct NpyArray {
+  std::vector<size_t> shape;  // 0 维数组的 shape 为空
+  std::vector<double> data;
+
+  size_t size() const { return data.size(); }
+  size_t dim(size_t axis) const { return axis < shape.size() ? shape[axis] : 1; }
+  double scalar() const { return data.empty() ? 0.0 : data[0]; }
+};
+
+/**
+ * 读取 NumPy np.savez 生成的 .npz 文件（仅支持未压缩条目，即 np.savez 而非 np.savez_compressed）
+ * @param path 文件路径
+ * @return 数组名（不含 .npy 后缀）到数组的映射，格式错误时抛出 std::runtime_error
+ */
+std::map<std::string, NpyArray> load_npz(const std::string& path);
+
+/**
+ * 解析内存中的单个 .npy 数据
+ * @param data .npy 字节
+ * @param size 字节数
+ * @return 解析后的数组，格式错误时抛出 std::runtime_error
+ */
+NpyArray parse_npy(const unsigned char* data, size_t size);
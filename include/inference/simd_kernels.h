@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ==================== 推理用向量化内核 ====================
+//
+// 运行时按 CPU 能力选择 AVX-512 / AVX2+FMA / 标量实现（aarch64 上使用标量实现，
+// 由编译器自动向量化为 NEON）。首次调用时完成选择，之后只是一次间接调用。
+
+// 当前选用的指令集
+enum class SimdLevel { kScalar, kAvx2, kAvx512 };
+
+/**
+ * 获取当前 CPU 上选用的指令集
+ */
+SimdLevel simd_level();
+
+/**
+ * 指令集名称（日志用）
+ */
+const char* simd_level_name(SimdLevel level);
+
+/**
+ * 强制使用某一指令集（测试与基准用，不支持的级别会回退到标量）
+ */
+void set_simd_level(SimdLevel level);
+
+/**
+ * 单精度点积 sum(a[i] * b[i])，a / b 无需对齐
+ */
+float dot_f32(const float* a, const float* b, size_t n);
+
+/**
+ * 聚集点积：多个子模型直接从矩阵 x 中读取各自的若干段连续数据做点积，返回所有子模型之和
+ *
+ *   sum_{k < n_models} sum_{r < n_rows} sum_{t < run} w[k * w_stride + r * run + t] * x[rows[k * n_rows + r] * x_stride + cols[k] + t]
+ *
+ * 用于 XGB-DIM 局部子模型：k 为子模型，r 为电极块内的电极，t 为时间窗内的采样点，不生成中间立方体。
+ */
+float gather_dot_f32(const float* w, size_t w_stride, const int32_t* rows, const int32_t* cols, size_t n_models,
+                     int n_rows, int run, const float* x, size_t x_stride);
+
+// ==================== 定点内核（int16 输入 x int8 权重，int32 累加） ====================
+//
+// x86 上按 CPU 能力选择 AVX-512 VNNI / AVX-512BW / AVX-VNNI / AVX2 实现（VNNI 用 vpdpwssd 一条指令完成
+// 乘加，否则用 vpmaddwd + vpaddd），aarch64 等其他平台使用标量实现（由编译器自动向量化）。
+// 调用方负责按 32 个元素补零对齐，内核没有尾部处理。
+
+// 单次定点点积的最大长度：512 * 32767 * 127 < 2^31，int32 累加不会溢出
+constexpr size_t kQuantMaxDot = 512;
+
+/**
+ * 定点点积 sum(x[i] * w[i])
+ * @param n 元素个数，32 的倍数且不超过 kQuantMaxDot
+ */
+int32_t dot_i16i8(const int16_t* x, const int8_t* w, size_t n);
+
+/**
+ * 定点聚集点积：与 gather_dot_f32 相同的访问方式，每个子模型的整数点积乘以各自的缩放系数后相加
+ *
+ *   sum_k scales[k] * sum_{r < n_rows} sum_{t < run} W_k[r][t] * x[rows[k * n_rows + r] * x_stride + cols[k] + t]
+ *
+ * W_k 从 w + k * w_stride 开始，按 4 段一组、每组 8 个元素一块存放（每块 4 x 8 = 32 字节连续）：
+ *   W_k[r][t] = w[k * w_stride + ((r / 4) * (run / 8) + t / 8) * 32 + (r % 4) * 8 + t % 8]
+ * @param n_rows 每个子模型的段数，4 的倍数（不足时用权重为 0 的段补齐）
+ * @param run 每段长度，8 的倍数（超出时间窗的权重为 0，x 每行 cols[k] 之后须有 run 个可读元素）
+ * 每个子模型 n_rows * run 不超过 kQuantMaxDot
+ */
+float gather_dot_i16i8(const int8_t* w, size_t w_stride, const float* scales, const int32_t* rows,
+                       const int32_t* cols, size_t n_models, int n_rows, int run, const int16_t* x, size_t x_stride);
+
+/**
+ * 最大绝对值 max(|x[i]|)
+ */
+float max_abs_f32(const float* x, size_t n);
+
+/**
+ * 量化到 int16：out[i] = round(x[i] * scale)，调用方保证结果不超出 int16 范围
+ */
+void quantize_f32_i16(const float* x, size_t n, float scale, int16_t* out);
+
+/**
+ * 当前定点内核名称（日志用，如 "avx512-vnni"）
+ */
+const char* quant_kernel_name();
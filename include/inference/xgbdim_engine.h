@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inference/xgbdim_model.h"
+#include "utils/aligned_buffer.h"
+
+class XgbdimQuantizedModel;
+
+// 推理精度
+enum class XgbdimPrecision {
+  kFloat32,  // 折叠后的 float 权重
+  kInt8,     // int8 权重 x int16 输入（见 XgbdimQuantizedModel）
+};
+
+// 单个 trial 的推理结果
+struct XgbdimResult {
+  float score{0.0f};        // sigmoid 概率
+  float decision{0.0f};     // sigmoid 之前的判决值 h
+  int label{0};             // score >= 0.5 为 1
+  int models_evaluated{0};  // 实际求值的局部子模型数（提前退出时小于 n_local）
+};
+
+/**
+ * @brief 局部子模型的提前退出
+ *
+ * 子模型按 conv_sort（boosting 的选择顺序）依次求值，每求完 block 个检查一次：剩余子模型的贡献满足
+ *   |<w'_k, x_k>| <= sum_r ||w'_{k,r}||_1 * max_t |x[rows_k[r], t]|
+ * （各电极权重的 L1 范数在加载时算好，每个 trial 只需求各行的最大绝对值）。若当前部分和 h 的绝对值
+ * 已超过剩余贡献之和的上界，sigmoid(h) 不可能再跨过 0.5，直接停止。
+ *   strict       使用上述可证明的上界（另留出 float 舍入余量），标签与完整求和完全相同
+ *   bound_scale  非严格模式下上界乘以该系数（L1 上界通常很松，< 1 时退出更早，但标签可能翻转）
+ */
+struct XgbdimEarlyExit {
+  bool enabled{false};
+  bool strict{true};
+  double bound_scale{0.25};
+  int block{16};  // 每次检查之间求值的子模型数
+
+  /**
+   * 配置项：enabled、strict、bound_scale、block
+   * @throws std::runtime_error block < 1 或 bound_scale <= 0
+   */
+  static XgbdimEarlyExit from_config(const ConfigNode& node);
+};
+
+/**
+ * @brief 折叠后的模型：推理只需要这些数据（数组均按 64 字节对齐，由 XgbdimEngine 或映射文件持有）
+ */
+struct XgbdimFoldedModel {
+  double bias{0.0};                     // 全局与所有局部子模型折叠后的常数项之和
+  int n_local{0};                       // 参与推理的局部子模型数（N_model - 1）
+  size_t local_stride{0};               // 每个子模型权重的存放步长（t_local 向上取整到 16）
+  const float* global_weight{nullptr};  // n_channels x n_samples，折叠后的全局权重
+  const float* local_weight{nullptr};   // n_local x local_stride，每个子模型按 [电极][时间] 排列
+  const int32_t* local_rows{nullptr};   // n_local x chan_len，聚集表：子模型各电极在 epoch 中的行
+  const int32_t* local_cols{nullptr};   // n_local，聚集表：子模型时间窗在 epoch 中的起点列
+};
+
+/**
+ * @brief XGB-DIM 集成模型的原生推理引擎
+ *
+ * 等价于 XGBDIM.predict_ZT206_HYX：按通道去均值 -> 全局 GSTF 双线性项 -> 各局部子模型
+ * 批归一化后的加权点积 -> sigmoid。加载时把批归一化、lr_model 与 gstf_weight 全部折叠进
+ * 权重和偏置：
+ *   全局项  sum_{m,p} W[m,:] X_bn Q[:,p] / (N_sp N_te) = <W_g, X> + c_g
+ *   局部项  lr_k * (w_k . x_bn + w_k0)                 = <w'_k, x_k> + c_k
+ * 推理只剩若干次连续的点积，权重按 64 字节对齐存放。
+ *
+ * 局部子模型不生成立方体：加载时由 channel_conv、window_st 与 conv_sort 预先算出前 N_model - 1 个
+ * 立方体的聚集表（每个电极所在行 + 时间窗起点），权重按 [电极][时间] 重新排列，推理时直接从 epoch
+ * 的各行读取连续的 win_len 个采样点。只有开启按通道去均值时才复制一份去均值后的 epoch（若折叠为
+ * sum W x - sum_r mean_r * W_r，大直流偏置下 float 累加会抵消掉有效位）。
+ *
+ * 对象构造后只读，可在多个线程中并发调用 predict。
+ */
+class XgbdimEngine {
+ public:
+  // 由原始参数折叠得到（权重由引擎自己持有）
+  XgbdimEngine(const XgbdimParams& params, const XgbdimGeometry& geometry);
+
+  // 直接使用已折叠的权重（如内存映射的二进制模型），storage 保证权重在引擎生命周期内有效
+  XgbdimEngine(const XgbdimGeometry& geometry, const XgbdimFoldedModel& folded, std::shared_ptr<const void> storage);
+
+  // 是否先按通道去均值（predict_ZT206_HYX 的预处理；预处理阶段已做时可关闭）
+  void set_demean(bool demean) { demean_ = demean; }
+  bool demean() const { return demean_; }
+
+  // 推理精度（切换到 kInt8 时由折叠后的权重量化得到定点模型，需在开始推理前设置）
+  void set_precision(XgbdimPrecision precision);
+  XgbdimPrecision precision() const { return quantized_ ? XgbdimPrecision::kInt8 : XgbdimPrecision::kFloat32; }
+
+  // 提前退出（只作用于 float32 推理，定点推理总是完整求和）
+  void set_early_exit(const XgbdimEarlyExit& early_exit) { early_exit_ = early_exit; }
+  const XgbdimEarlyExit& early_exit() const { return early_exit_; }
+
+  // 定点模型（precision 为 kInt8 时有效）
+  const XgbdimQuantizedModel* quantized() const { return quantized_.get(); }
+
+  // 精度名称互转（配置中使用 "float32" / "int8"）
+  static XgbdimPrecision parse_precision(const std::string& name);
+  static const char* precision_name(XgbdimPrecision precision);
+
+  /**
+   * 单个 trial 推理
+   * @param epoch n_channels x n_samples 的 float 矩阵
+   * @param row_stride 相邻两行之间的元素个数（连续存放时等于 n_samples）
+   */
+  XgbdimResult predict(const float* epoch, size_t row_stride) const;
+
+  // 单个 trial 推理，本次使用指定的提前退出设置（例如过期包降级为非严格的快速推理）
+  XgbdimResult predict(const float* epoch, size_t row_stride, const XgbdimEarlyExit& early_exit) const;
+
+  /**
+   * 多个 trial 批量推理，结果与逐个 predict 相同（累加顺序不同，误差在 float 舍入范围内）；
+   * 开启提前退出或定点推理时逐个调用 predict
+   *
+   * 每 kBatchBlock 个 epoch 为一块，每行全局权重和每个子模型的权重只读入一次、依次作用于块内
+   * 所有 epoch，模型超出缓存时可以显著减少权重的内存读取。
+   * @param epochs count 个 n_channels x n_samples 的 float 矩阵
+   * @param row_strides 各矩阵的行间距
+   * @param results 输出，count 个结果
+   */
+  void predict_batch(const float* const* epochs, const size_t* row_strides, size_t count,
+                     XgbdimResult* results) const;
+
+  static constexpr size_t kBatchBlock = 8;
+
+  const XgbdimGeometry& geometry() const { return geometry_; }
+  const XgbdimFoldedModel& folded() const { return folded_; }
+  int n_local_models() const { return folded_.n_local; }
+
+ private:
+  XgbdimGeometry geometry_;
+  bool demean_{true};
+  XgbdimEarlyExit early_exit_;
+  XgbdimFoldedModel folded_;
+
+  // 由原始参数折叠时的权重存储（映射文件构造时为空）
+  AlignedBuffer<float> global_weight_;
+  AlignedBuffer<float> local_weight_;
+  std::vector<int32_t> local_rows_;
+  std::vector<int32_t> local_cols_;
+  std::shared_ptr<const void> storage_;  // 外部权重的持有者
+  std::shared_ptr<const XgbdimQuantizedModel> quantized_;
+
+  // 各子模型每个电极权重的 L1 范数，n_local x chan_len（提前退出的上界）
+  std::vector<float> local_l1_;
+
+  void fold_global(const XgbdimParams& params);
+  void fold_local(const XgbdimParams& params);
+  void build_bounds();
+
+  // 从 block 个子模型起依次求值局部项，满足退出条件时停止，返回求值的子模型数
+  int local_early_exit(const float* x, size_t stride, const XgbdimEarlyExit& early_exit, double& h) const;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "utils/config.h"
+
+/**
+ * @brief XGB-DIM 的时空划分参数（与 python/UI_XGBDIM_cpu.py 中 XGBDIM.get_3Dconv 一致）
+ *
+ * 输入 epoch 为 n_channels x n_samples 的矩阵；局部子模型的输入是从 epoch 中取出的
+ * "3x3 电极块 x win_len 采样点" 立方体，立方体内元素按 cup.T.flatten() 的顺序排列，
+ * 即第 j 个元素对应 (t, c) = (j / chan_len, j % chan_len)。
+ * 立方体在 epoch 中就是 chan_len 行上各一段连续的 win_len 个采样点，推理时按行号和时间窗起点直接读取。
+ */
+struct XgbdimGeometry {
+  int n_channels{60};   // epoch 通道数（全局模型输入行数）
+  int n_samples{250};   // epoch 采样点数
+  int win_len{6};       // 时间窗长度
+  int chan_xlen{3};     // 电极块宽度
+  int chan_ylen{3};     // 电极块高度
+  int step_x{3};        // 电极块横向步长
+  int step_y{3};        // 电极块纵向步长
+  int grid_rows{6};     // 电极排布行数（channel_loc）
+  int grid_cols{9};     // 电极排布列数（channel_loc）
+  int max_n_model{299};   // 子模型数上限（含全局模型）
+  float gstf_weight{0.3f};  // 全局模型权重
+  std::vector<int> channel_map;  // 逻辑电极 -> epoch 行（1 基，对应 self.channel）
+
+  // 以下由 build() 计算
+  int chan_len{0};   // 每个电极块的电极数
+  int t_local{0};    // 每个立方体的元素数（win_len * chan_len）
+  int n_win{0};      // 时间窗数量
+  int n_chanwin{0};  // 电极块数量
+  int n_conv{0};     // 立方体总数
+  int n_model{0};    // 实际子模型数（含全局模型）
+  std::vector<std::vector<int>> channel_conv;  // 每个电极块包含的逻辑电极（1 基）
+  std::vector<int> window_start;               // 每个时间窗的起点（0 基）
+
+  // 计算派生参数；channel_map 为空时使用 NeuroScan 默认映射
+  void build();
+
+  // 立方体 conv（= 电极块下标 * n_win + 时间窗下标）的 chan_len 个电极在 epoch 中的行，以及时间窗起点列
+  void cuboid_gather(int conv, int* rows, int* col) const;
+
+  // 从配置读取，未给出的字段保持默认值
+  static XgbdimGeometry from_config(const ConfigNode& node);
+};
+
+/**
+ * @brief XGB-DIM 模型参数（XGBDIM.load_model 读取的 .npz 内容，保持原始形状，行主序）
+ */
+struct XgbdimParams {
+  int n_sp{0};  // W_global 行数
+  int n_te{0};  // Q_global 列数
+
+  std::vector<double> w_global;      // n_sp x n_channels
+  std::vector<double> q_global;      // n_samples x n_te
+  double b_global{0.0};
+  std::vector<double> gamma_global;  // n_channels x n_samples（标量时展开）
+  std::vector<double> beta_global;   // n_channels x n_samples（标量时展开）
+  std::vector<double> m_global;      // n_channels x n_samples
+  std::vector<double> sigma_global;  // n_channels x n_samples
+
+  int n_local{0};                    // W_local 行数
+  std::vector<double> w_local;       // n_local x (t_local + 1)，第 0 列为偏置
+  std::vector<double> gamma;         // n_local
+  std::vector<double> beta;          // n_local
+  std::vector<double> m_local;       // n_local x t_local
+  std::vector<double> sigma;         // n_local x t_local
+  std::vector<double> lr_model;      // n_conv
+  std::vector<int> conv_sort;        // n_conv，按判别性排序后的立方体下标
+
+  // 从 np.savez 保存的模型文件读取，并按 geometry 检查形状
+  static XgbdimParams load_npz(const std::string& path, const XgbdimGeometry& geometry);
+
+  // 检查形状是否与 geometry 一致，不一致时抛出 std::runtime_error
+  void validate(const XgbdimGeometry& geometry) const;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "inference/xgbdim_engine.h"
+
+// ==================== XGB-DIM 二进制模型格式（.xgbm） ====================
+//
+// 由 xgbdim_convert 从 np.savez 的 .npz 模型离线生成，内容是折叠后的权重（批归一化、
+// lr_model、gstf_weight 已并入，见 XgbdimEngine）。运行时 mmap 后直接作为推理权重使用，不做解析。
+//
+//   [XgbdimModelHeader][channel_map][global_weight][local_weight][local_rows][local_cols]
+//
+// 所有数组起点按 64 字节对齐，小端存放；crc32 覆盖文件第 16 字节之后的全部内容（含头部其余字段）。
+// 写入时先写临时文件再 rename，热替换时读到的一定是完整文件。
+
+constexpr char kXgbdimModelMagic[8] = {'X', 'G', 'B', 'D', 'I', 'M', 'M', 'F'};
+constexpr uint32_t kXgbdimModelVersion = 2;  // 2：局部权重按 [电极][时间] 排列，聚集表每个子模型一组
+constexpr uint32_t kXgbdimModelFlagDemean = 1u << 0;  // 推理前按通道去均值
+
+struct XgbdimModelHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t crc32;  // 文件 [16, file_size) 的 CRC-32
+  uint64_t file_size;
+  uint32_t header_size;
+  uint32_t flags;
+
+  // 时空划分参数（与 XgbdimGeometry 同名字段一致）
+  int32_t n_channels;
+  int32_t n_samples;
+  int32_t win_len;
+  int32_t chan_xlen;
+  int32_t chan_ylen;
+  int32_t step_x;
+  int32_t step_y;
+  int32_t grid_rows;
+  int32_t grid_cols;
+  int32_t max_n_model;
+  int32_t n_local;
+  int32_t t_local;
+  uint32_t local_stride;
+  float gstf_weight;
+  double bias;
+
+  // 数组偏移（字节，相对文件起点）
+  uint32_t channel_map_count;
+  uint32_t reserved;
+  uint64_t channel_map_offset;    // int32 x channel_map_count
+  uint64_t global_weight_offset;  // float x n_channels x n_samples
+  uint64_t local_weight_offset;   // float x n_local x local_stride
+  uint64_t local_rows_offset;     // int32 x n_local x chan_len
+  uint64_t local_cols_offset;     // int32 x n_local
+};
+
+static_assert(sizeof(XgbdimModelHeader) == 144, "XgbdimModelHeader layout changed, bump kXgbdimModelVersion");
+
+/**
+ * 把引擎中折叠后的权重写成二进制模型文件
+ * @param engine 已加载的引擎
+ * @param path 输出路径（先写 path.tmp 再原子 rename）
+ */
+void save_xgbdim_model(const XgbdimEngine& engine, const std::string& path);
+
+/**
+ * 映射二进制模型文件并构造引擎，权重直接指向映射内存
+ * @param path 模型路径
+ * @return 推理引擎；格式、版本、校验和或形状不符时抛出 std::runtime_error
+ */
+std::shared_ptr<XgbdimEngine> load_xgbdim_model(const std::string& path);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "inference/xgbdim_model.h"
+#include "utils/aligned_buffer.h"
+
+struct XgbdimFoldedModel;
+
+/**
+ * @brief XGB-DIM 的定点推理模型（int8 权重 x int16 输入，int32 累加）
+ *
+ * 由折叠后的浮点模型量化得到（批归一化、lr_model、gstf_weight 已并入权重）：
+ *   全局权重  每行（电极）一个缩放系数，对称量化到 [-127, 127]
+ *   局部权重  每个子模型一个缩放系数；每个电极的时间窗补零到 8 的倍数，电极数补齐到 4 的倍数
+ *   输入      每个 epoch 一个缩放系数，对称量化到 [-32767, 32767]
+ * 权重约为浮点模型的 1/4，点积用 dot_i16i8 / gather_dot_i16i8（VNNI / AVX2 / 标量）。
+ *
+ * 对象构造后只读，可在多个线程中并发调用 decision。
+ */
+class XgbdimQuantizedModel {
+ public:
+  XgbdimQuantizedModel(const XgbdimGeometry& geometry, const XgbdimFoldedModel& folded);
+
+  /**
+   * 判决值 h（sigmoid 之前）；需要去均值时由调用方先完成
+   * @param epoch n_channels x n_samples 的 float 矩阵
+   * @param row_stride 相邻两行之间的元素个数
+   */
+  double decision(const float* epoch, size_t row_stride) const;
+
+  // 定点权重、缩放系数与聚集表占用的字节数
+  size_t weight_bytes() const;
+
+ private:
+  int n_channels_;
+  int n_samples_;
+  int n_local_;
+  int n_rows_;          // 每个子模型的电极数（补齐到 4 的倍数）
+  int run_;             // 每个电极的时间窗长度（补零到 8 的倍数）
+  size_t row_stride_;   // 量化后 epoch 与全局权重的行间距（32 的倍数，每行末尾至少留 run_ 个元素）
+  size_t local_stride_;  // 每个子模型的权重个数（n_rows_ x run_）
+  double bias_;
+
+  AlignedBuffer<int8_t> global_weight_;  // n_channels x row_stride_
+  AlignedBuffer<float> global_scale_;    // n_channels
+  AlignedBuffer<int8_t> local_weight_;   // n_local x local_stride_
+  AlignedBuffer<float> local_scale_;     // n_local
+  std::vector<int32_t> local_rows_;      // n_local x n_rows_
+  std::vector<int32_t> local_cols_;      // n_local
+};
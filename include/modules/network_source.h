@@ -0,0 +1,123 @@
+#pragma once
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "framework/source.h"
+#include "utils/config.h"
+#include "utils/eeg_frame.h"
+#include "utils/latency_histogram.h"
+
+// 网络接收参数
+struct NetworkSourceConfig {
+  enum class Protocol {
+    kUdp,  // 绑定 host:port 接收数据报，每个数据报一帧
+    kTcp   // 连接到放大器 host:port（放大器为服务端），断开后自动重连
+  };
+
+  Protocol protocol{Protocol::kUdp};
+  std::string host{"127.0.0.1"};
+  int port{4000};
+  int n_channels{64};            // 期望的通道数（不符的帧按格式错误丢弃）
+  int max_samples{256};          // 单帧每个通道最多的采样点数（决定接收缓冲区大小）
+  int batch{16};                 // UDP 每次 recvmmsg 最多取的数据报数
+  int socket_buffer_kb{4096};    // SO_RCVBUF
+
+  // 从配置读取，例如 {"protocol": "udp", "host": "0.0.0.0", "port": 4000, "n_channels": 64, "batch": 16}
+  static NetworkSourceConfig from_config(const ConfigNode &node);
+
+  // 单帧的最大字节数
+  size_t max_frame_bytes() const {
+    return sizeof(EegFrameHeader) + static_cast<size_t>(n_channels) * max_samples * sizeof(float);
+  }
+};
+
+/**
+ * @brief 网络数据接收模块：接收放大器数据帧（见 eeg_frame.h），每帧一个包
+ *
+ * 输出：Slot::kRawEeg（CV_32F，n_channels x 本帧采样点数，微伏）；帧含触发时另写 Slot::kTrigger 与 Slot::kTriggerOffset。
+ *
+ * 接收缓冲区在构造时一次分配：UDP 用 recvmmsg 一次取一批数据报，TCP 读入一段字节流缓冲区后按帧切分；
+ * 帧数据从接收缓冲区直接解码到包内复用的 kRawEeg 缓冲区，不经过中间拷贝。
+ * 按帧序号检测丢帧：序号跳跃计入 lost，序号回退（重复或乱序）的帧丢弃并计入 out_of_order。
+ * ingest_latency 记录每帧从内核收到（UDP 取 SO_TIMESTAMPNS，TCP 取 recv 返回时刻）到交给 Source 入队的时间。
+ */
+class NetworkSource : public Source {
+ public:
+  // 接收统计
+  struct Stats {
+    uint64_t frames{0};        // 交给下游的帧数
+    uint64_t lost{0};          // 按序号推算丢失的帧数
+    uint64_t gaps{0};          // 序号跳跃的次数
+    uint64_t out_of_order{0};  // 序号回退而丢弃的帧数
+    uint64_t malformed{0};     // 格式错误的帧数（TCP 下还包括重新对齐时跳过的段数）
+    uint64_t bytes{0};         // 收到的字节数
+    uint64_t reconnects{0};    // TCP 重连次数
+  };
+
+  NetworkSource(const NetworkSourceConfig &config, int max_queue_length, bool enable_profiler, int cpu_id,
+                int npu_id, const WaitStrategy &wait_strategy = WaitStrategy());
+  ~NetworkSource() override;
+
+  bool process(Package *package) override;
+
+  const NetworkSourceConfig &config() const { return config_; }
+
+  // UDP 实际绑定的端口（配置端口为 0 时由系统分配）
+  int local_port() const { return local_port_; }
+
+  // 统计（可在其他线程读取）
+  Stats stats() const;
+
+  // 内核收到到入队的时延
+  LatencySnapshot ingest_latency() const { return ingest_latency_.snapshot(); }
+
+ private:
+  // 一个待解码的帧
+  struct Frame {
+    const unsigned char *data;
+    size_t size;
+    int64_t receive_ns;  // CLOCK_REALTIME 纳秒
+  };
+
+  NetworkSourceConfig config_;
+  int fd_{-1};
+  int local_port_{0};
+
+  // UDP：recvmmsg 的预分配缓冲区，received_ 个数据报中下一个待处理的是 cursor_
+  std::vector<unsigned char> datagrams_;
+  std::vector<unsigned char> controls_;
+  std::vector<iovec> iovecs_;
+  std::vector<mmsghdr> messages_;
+  int received_{0};
+  int cursor_{0};
+
+  // TCP：字节流缓冲区，[read_pos_, write_pos_) 为未解析的数据
+  std::vector<unsigned char> stream_;
+  size_t read_pos_{0};
+  size_t write_pos_{0};
+  int64_t stream_receive_ns_{0};
+
+  bool has_sequence_{false};
+  uint32_t next_sequence_{0};
+
+  std::atomic<uint64_t> frames_{0}, lost_{0}, gaps_{0}, out_of_order_{0}, malformed_{0}, bytes_{0}, reconnects_{0};
+  LatencyHistogram ingest_latency_;
+
+  void open_udp();
+  bool connect_tcp();
+  void close_socket();
+
+  // 等待可读（只在 may_block() 时等待，最多 block_timeout()），返回是否可读
+  bool wait_readable();
+
+  bool next_udp_frame(Frame &frame);
+  bool next_tcp_frame(Frame &frame);
+
+  // 检查帧头与序号，通过时解码到包中
+  bool accept_frame(const Frame &frame, Package *package);
+};
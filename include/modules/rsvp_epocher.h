@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include "framework/module.h"
+#include "utils/config.h"
+#include "utils/latency_histogram.h"
+#include "utils/mirrored_ring.h"
+#include "utils/package_pool.h"
+
+// 试次截取参数（采样点数，按原始采样率计）
+struct EpochConfig {
+  int pre{0};        // 刺激起点之前保留的采样点数（基线）
+  int post{1000};    // 刺激起点之后的采样点数（含起点）
+  int capacity{0};   // 环形缓冲区每个通道保存的采样点数，0 表示取 4 * (pre + post)
+
+  // 从配置读取，例如 {"pre": 200, "post": 1000, "capacity": 8192}
+  static EpochConfig from_config(const ConfigNode &node);
+
+  int length() const { return pre + post; }
+};
+
+/**
+ * @brief 试次截取模块：位于 Source 与 Preprocessor 之间，把连续数据按触发切成试次
+ *
+ * 输入：Slot::kRawEeg（CV_32F，n_channels x 本包采样点数，包与包在时间上首尾相接），
+ *       含触发时带 Slot::kTrigger 与 Slot::kTriggerOffset（每包最多一个，见各 Source）。
+ * 输出：每个触发一个新包，Slot::kRawEeg 为 n_channels x (pre + post) 的试次，Slot::kTrigger 为触发码，
+ *       Slot::kTriggerOffset 为 pre（刺激起点在试次中的位置），与离线的 X1/X2 试次数组一一对应。
+ *
+ * 连续数据写入按通道镜像映射的环形缓冲区（MirroredChannelRing），试次的 kRawEeg 直接指向环中的窗口，
+ * 不做拷贝：10 Hz 呈现时相邻试次大部分重叠，共享同一段存储。试次在刺激后第 post 个采样点到达时立即发出。
+ * 视图是只读的，下游阶段不能原地修改 kRawEeg。试次彼此重叠、不再首尾相接，下游的 RsvpPreprocessor
+ * 需设置为 InputMode::kEpoch 逐试次独立处理。
+ *
+ * 环中被已发出、尚未释放的试次引用的部分不会被覆盖：写入前若空间不足，暂停读取输入直到下游释放
+ * （每个试次保留一个 weak_ptr，包归还到池中即视为释放）。容量因此决定了下游最多能积压多少试次。
+ * 输出包按产生顺序重新编号；截止时刻以及开启包追踪时的追踪记录沿用使试次完整的那个输入包。
+ * onset_latency 记录从含刺激起点的输入包到达到试次发出的时间（实时数据流中约为 post 个采样点的时长）。
+ */
+class RsvpEpocher : public Module<PackagePtr> {
+ public:
+  // 截取统计
+  struct Stats {
+    uint64_t epochs{0};    // 发出的试次数
+    uint64_t dropped{0};   // 刺激起点之前的数据已不在环中（或数据流开始前）而丢弃的触发数
+    uint64_t stalls{0};    // 因下游未释放试次而暂停读取输入的次数
+  };
+
+  RsvpEpocher(const EpochConfig &config, int n_channels, int pre_module_nums, bool enable_profiler, int cpu_id,
+              int npu_id, const WaitStrategy &wait_strategy = WaitStrategy());
+
+  void run() final;
+  StepResult step() final;
+
+  // 追加一个连续数据包并登记其中的触发（不发出试次）；输入格式不符时返回 false
+  bool process(Package *package) override;
+
+  // 一个输入包对应零到多个试次，不能在融合模式中内联
+  bool fusable() const override { return false; }
+
+  const EpochConfig &config() const { return config_; }
+  const MirroredChannelRing &ring() const { return *ring_; }
+
+  // 统计（可在其他线程读取）
+  Stats stats() const;
+
+  // 刺激起点所在的包到达到试次发出的时延
+  LatencySnapshot onset_latency() const { return onset_latency_.snapshot(); }
+
+ private:
+  // 已登记、尚未凑齐 post 个采样点的触发
+  struct PendingEpoch {
+    uint64_t onset;  // 刺激起点的采样点下标
+    int code;
+    std::chrono::steady_clock::time_point arrived;
+  };
+
+  // 已发出的试次引用的环中起点
+  struct Lease {
+    std::weak_ptr<Package> package;
+    uint64_t start;
+  };
+
+  EpochConfig config_;
+  std::shared_ptr<MirroredChannelRing> ring_;
+  PackagePool package_pool_;  // 共享状态持有 ring_：试次可以比本模块活得更久，其视图所指的环不会被提前解除映射
+  std::deque<PendingEpoch> pending_;
+  std::deque<Lease> leases_;
+  uint64_t next_sequence_{0};
+  PackagePtr held_;  // step 模式下因空间不足暂未追加的输入
+
+  std::atomic<uint64_t> epochs_{0}, dropped_{0}, stalls_{0};
+  LatencyHistogram onset_latency_;
+
+  // 追加 n 个采样点是否不会覆盖仍被引用或等待截取的数据
+  bool has_room(size_t n);
+
+  // 输入包的采样点数（格式不符时为 0）
+  size_t input_samples(const Package &package) const;
+
+  // 发出所有已凑齐的试次，input 为刚追加的输入包
+  template <class Emit>
+  void emit_ready(const Package &input, Emit emit);
+};
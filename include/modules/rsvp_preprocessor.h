@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "dsp/channel_normalizer.h"
+#include "dsp/decimator.h"
+#include "dsp/iir_filter.h"
+#include "framework/preprocessor.h"
+#include "utils/config.h"
+
+/**
+ * @brief RSVP 预处理模块：选通道 + 抗混叠抽取，再做 Butterworth 带通滤波与逐通道归一化
+ *
+ * 输入：Slot::kRawEeg（CV_32F，n_input_channels x 本包采样点数，包与包在时间上首尾相接）
+ * 输出：Slot::kEpoch（CV_32F，选中通道 x 抽取后采样点数，即 Runner 使用的布局，复用包内已有的缓冲区）
+ *
+ * 抽取结果直接写入 kEpoch，带通滤波在其上原地进行（滤波器工作在抽取后的采样率 fs / factor）。
+ * 归一化（NormalizerConfig）在滤波的同一次遍历中累积均值 / 方差，结果原地写回 kEpoch：
+ * kEpoch 模式按每个包自身的统计量，kRunning 模式按跨包保存的滑动基线。
+ * 输入方式（InputMode）：
+ * - kStream：kRawEeg 是连续数据流的一段，抽取与滤波状态都跨包保存，因此同一数据流的包必须按顺序交给
+ *   同一个 RsvpPreprocessor；零相位模式下输出比输入固定晚 lag 个（抽取后的）采样点。
+ * - kEpoch：kRawEeg 是 RsvpEpocher 切出的试次，相邻试次在时间上重叠，必须各自独立处理（与离线逐试次处理一致）。
+ *   每个试次开始前以其第一个采样点为常数基线重置抽取历史与滤波器状态（相当于试次之前补了无限长的基线，
+ *   不会出现从零状态开始的边缘瞬态），归一化只使用本试次；零相位模式对整个试次做前向 + 反向滤波，没有 lag。
+ */
+class RsvpPreprocessor : public Preprocessor {
+ public:
+  enum class InputMode { kStream, kEpoch };
+
+  // "stream" | "epoch"，其他值抛出 std::runtime_error
+  static InputMode parse_input_mode(const std::string &name);
+
+  RsvpPreprocessor(const DecimatorConfig &decimation, const IirFilterConfig &filter,
+                   const NormalizerConfig &normalization, int n_input_channels, int pre_module_nums,
+                   bool enable_profiler, int cpu_id, int npu_id, const WaitStrategy &wait_strategy = WaitStrategy());
+
+  bool process(Package *package) override;
+
+  // 清零滤波器与滑动基线状态（数据流中断后重新开始时调用）
+  void reset();
+
+  // 需在流水线启动前设置，默认 kStream
+  void set_input_mode(InputMode mode) { input_mode_ = mode; }
+  InputMode input_mode() const { return input_mode_; }
+
+  const IirFilterConfig &filter_config() const { return filter_; }
+  const NormalizerConfig &normalization_config() const { return normalization_; }
+  // 未启用归一化时为空
+  const ChannelNormalizer *normalizer() const { return normalizer_.get(); }
+  int n_input_channels() const { return n_input_channels_; }
+  int n_output_channels() const { return static_cast<int>(decimator_.channels().size()); }
+
+ private:
+  IirFilterConfig filter_;
+  NormalizerConfig normalization_;
+  int n_input_channels_;
+  InputMode input_mode_{InputMode::kStream};
+  ChannelDecimator decimator_;
+  std::unique_ptr<SosFilterBank> causal_;
+  std::unique_ptr<ZeroPhaseFilterBank> zero_phase_;
+  std::unique_ptr<ChannelNormalizer> normalizer_;
+};
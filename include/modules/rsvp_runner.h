@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "framework/runner.h"
+#include "inference/xgbdim_engine.h"
+#include "utils/config.h"
+
+/**
+ * @brief RSVP 推理模块：对每个 epoch 运行 XGB-DIM 集成模型
+ *
+ * 输入：Slot::kEpoch（CV_32F，n_channels x n_samples）
+ * 输出：Slot::kScore（目标概率）、Slot::kLabel（score >= 0.5 为 1）、
+ *       Slot::kModelsEvaluated（实际求值的局部子模型数）
+ *
+ * 模型可在运行中热替换：新模型在调用线程中加载完毕后原子地替换引擎指针，
+ * 推理线程每个包取一次当前引擎，正在使用旧模型的包处理完后旧模型随引用计数释放。
+ *
+ * 开启微批（Runner::set_batching）时整批使用同一个引擎，调用 XgbdimEngine::predict_batch，
+ * 每批的权重只从内存读取一次。
+ *
+ * 过期后被标记为降级的包（ShedPolicy::kDegrade）改用 degraded_early_exit 做提前退出的快速推理，
+ * 默认为非严格模式，以少量标签翻转的风险换取更早退出。
+ */
+class RsvpRunner : public Runner {
+ public:
+  RsvpRunner(std::shared_ptr<const XgbdimEngine> engine, int pre_module_nums, bool enable_profiler, int cpu_id,
+             int npu_id, const WaitStrategy &wait_strategy = WaitStrategy());
+
+  /**
+   * 按配置加载模型，配置项：
+   *   model_path  .xgbm 二进制模型（mmap 加载）或 np.savez 保存的 .npz 模型
+   *   demean      是否按通道去均值（.npz 默认 true，.xgbm 默认取文件中的设置）
+   *   precision   推理精度 "float32"（默认）或 "int8"（加载后量化，见 XgbdimQuantizedModel）
+   *   early_exit  局部子模型的提前退出（见 XgbdimEarlyExit::from_config），默认关闭
+   *   geometry    时空划分参数（仅 .npz 使用，见 XgbdimGeometry::from_config）
+   */
+  static std::shared_ptr<const XgbdimEngine> load_engine(const ConfigNode &node);
+
+  /**
+   * 热替换模型（可在任意线程调用，不阻塞推理线程）
+   * @param model_path 新模型路径，沿用当前的精度与提前退出设置，.npz 模型还沿用时空划分和去均值设置
+   * @return 加载失败或输入形状与当前模型不一致时返回 false，并继续使用旧模型
+   */
+  bool reload_model(const std::string &model_path);
+
+  // 直接替换推理引擎
+  void swap_engine(std::shared_ptr<const XgbdimEngine> engine);
+
+  // 当前使用的推理引擎
+  std::shared_ptr<const XgbdimEngine> engine() const;
+
+  // 降级推理使用的提前退出设置（需在启动前设置，enabled 为 false 时降级的包照常推理）
+  void set_degraded_early_exit(const XgbdimEarlyExit &early_exit) { degraded_early_exit_ = early_exit; }
+  const XgbdimEarlyExit &degraded_early_exit() const { return degraded_early_exit_; }
+
+  bool process(Package *package) override;
+  void process_batch(Package *const *packages, size_t count, bool *ok) override;
+
+ private:
+  std::shared_ptr<const XgbdimEngine> engine_;  // 通过 std::atomic_load / atomic_store 访问
+  XgbdimEarlyExit degraded_early_exit_{true, false};  // 默认：开启、非严格
+
+  // 推理一个 epoch 并写入结果（降级的包使用 degraded_early_exit_）
+  void predict_one(const XgbdimEngine &engine, Package *package);
+
+  // 批处理的工作区（只在 Runner 线程中使用）
+  std::vector<const float *> batch_epochs_;
+  std::vector<size_t> batch_strides_;
+  std::vector<size_t> batch_index_;
+  std::vector<XgbdimResult> batch_results_;
+
+  // 检查 epoch 的类型与形状
+  static bool check_epoch(const Package &package, const XgbdimGeometry &geometry);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "framework/source.h"
+#include "utils/config.h"
+#include "utils/recording_file.h"
+
+// 回放参数
+struct ReplayConfig {
+  enum class Mode {
+    kRealtime,  // 按原始采样率（乘以 speed）定时产生包
+    kMaxSpeed   // 只受输出通道背压限制，用于测峰值吞吐
+  };
+
+  std::string path;             // .rsvpr 录制文件（见 recording_file.h）
+  Mode mode{Mode::kRealtime};
+  double speed{1.0};            // 实时模式的回放倍速
+  int chunk{40};                // 每包最多的采样点数
+  bool loop{false};             // 放完后从头重放（序号与定时连续）
+  bool populate{true};          // 映射时预读全部页面
+  bool verify{true};            // 打开时校验 CRC
+
+  // 从配置读取，例如 {"path": "...", "mode": "max_speed", "chunk": 40, "loop": true}
+  static ReplayConfig from_config(const ConfigNode &node);
+};
+
+/**
+ * @brief 录制数据回放模块：把 mmap 的连续 EEG 按块切成包
+ *
+ * 输出：Slot::kRawEeg（CV_32F，n_channels x 本包采样点数，包与包在时间上首尾相接）；
+ *       本包含触发时另写 Slot::kTrigger 与 Slot::kTriggerOffset。
+ *
+ * kRawEeg 直接指向映射内存（行间距为文件的 row_stride），不做拷贝；映射是只读的，下游阶段不能原地修改它。
+ * 每包最多含一个触发：块内出现第二个触发时在它之前截断，下一个包从该触发开始。
+ * 实时模式下包在其最后一个采样点"采集完成"的时刻产生，开启包追踪时以该时刻作为 origin，
+ * 端到端时延因此包含 Source 自身落后于时间表的部分。
+ */
+class RsvpSource : public Source {
+ public:
+  RsvpSource(const ReplayConfig &config, int max_queue_length, bool enable_profiler, int cpu_id, int npu_id,
+             const WaitStrategy &wait_strategy = WaitStrategy());
+
+  bool process(Package *package) override;
+
+  const RecordingFile &recording() const { return recording_; }
+  const ReplayConfig &config() const { return config_; }
+
+  // 已产生的采样点数（循环回放时累计）
+  uint64_t samples_emitted() const { return emitted_.load(std::memory_order_relaxed); }
+
+  // 非循环回放已放完
+  bool finished() const { return finished_.load(std::memory_order_acquire); }
+
+ private:
+  ReplayConfig config_;
+  RecordingFile recording_;
+
+  // 以下只在 Source 线程中使用
+  size_t position_{0};    // 下一个包在文件中的起始采样点
+  size_t next_event_{0};  // 下一个未发出的事件
+  bool started_{false};
+  std::chrono::steady_clock::time_point start_time_;
+  double seconds_per_sample_{0.0};
+
+  std::atomic<uint64_t> emitted_{0};
+  std::atomic<bool> finished_{false};
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "framework/source.h"
+#include "utils/config.h"
+#include "utils/latency_histogram.h"
+#include "utils/serial_frame.h"
+
+// 串口接收参数
+struct SerialSourceConfig {
+  // 等待数据的方式
+  enum class Wakeup {
+    kEpoll,  // epoll 等到有字节就读：唤醒次数多，时延最低
+    kBatch   // 按波特率估算攒够 batch_frames 帧所需的时间后一次 read()：系统调用少，时延多出最多 batch_frames 帧
+  };
+
+  std::string device{"/dev/ttyUSB0"};
+  int baud{921600};
+  int n_channels{8};
+  int chunk{40};                 // 每包的采样点数（遇到第二个触发时提前截断）
+  float resolution{0.02235f};    // 每个计数对应的微伏数（ADS1299，增益 24）
+  Wakeup wakeup{Wakeup::kEpoll};
+  int batch_frames{8};           // kBatch：每次 read() 前等待攒够的帧数
+  int buffer_frames{4096};       // 接收缓冲区能容纳的帧数（至少 2 * chunk）
+
+  // 从配置读取，例如 {"device": "/dev/ttyUSB0", "baud": 921600, "n_channels": 8, "wakeup": "epoll"}
+  static SerialSourceConfig from_config(const ConfigNode &node);
+};
+
+/**
+ * @brief 串口数据接收模块：按帧（见 serial_frame.h）解析串口字节流，每 chunk 个采样点一个包
+ *
+ * 输出：Slot::kRawEeg（CV_32F，n_channels x 本包采样点数，微伏）；本包含触发（电平由 0 或其他值变为非零）时
+ *       另写 Slot::kTrigger 与 Slot::kTriggerOffset，每包最多一个触发。
+ *
+ * 字节直接读入一块定长缓冲区，解析时只记录有效帧的起点，不搬移数据：同步字不符或 CRC 错误时向后查找下一个同步字；
+ * 攒够一包后从缓冲区直接解码到包内复用的 kRawEeg 缓冲区。只有缓冲区写满时才把尚未成包的尾部（不足一包）移回开头。
+ * 按帧计数检测丢帧。ingest_latency 记录每包最后一帧的字节从 read() 返回到交给 Source 入队的时间。
+ * 设备断开（read 返回 EIO 或 0）后关闭并在下次调用时重新打开。
+ */
+class SerialSource : public Source {
+ public:
+  // 接收统计
+  struct Stats {
+    uint64_t samples{0};        // 交给下游的采样点（帧）数
+    uint64_t packages{0};
+    uint64_t lost{0};           // 按帧计数推算丢失的帧数
+    uint64_t gaps{0};           // 帧计数跳跃的次数
+    uint64_t crc_errors{0};     // 同步字匹配但 CRC 错误的帧数
+    uint64_t skipped_bytes{0};  // 重新对齐时跳过的字节数
+    uint64_t bytes{0};          // 读到的字节数
+    uint64_t reopens{0};        // 重新打开设备的次数
+  };
+
+  SerialSource(const SerialSourceConfig &config, int max_queue_length, bool enable_profiler, int cpu_id, int npu_id,
+               const WaitStrategy &wait_strategy = WaitStrategy());
+  ~SerialSource() override;
+
+  bool process(Package *package) override;
+
+  const SerialSourceConfig &config() const { return config_; }
+
+  // 统计（可在其他线程读取）
+  Stats stats() const;
+
+  // 字节读入到入队的时延
+  LatencySnapshot ingest_latency() const { return ingest_latency_.snapshot(); }
+
+ private:
+  // 一次 read() 读入的字节在缓冲区中的终点与返回时刻（CLOCK_REALTIME 纳秒）
+  struct ReadMark {
+    size_t end;
+    int64_t ns;
+  };
+
+  SerialSourceConfig config_;
+  size_t frame_bytes_;
+  int fd_{-1};
+  int epoll_fd_{-1};
+
+  // 接收缓冲区：[scan_pos_, write_pos_) 为尚未解析的字节，frames_ 为当前包已找到的帧起点
+  std::vector<unsigned char> buffer_;
+  size_t scan_pos_{0};
+  size_t write_pos_{0};
+  std::vector<size_t> frames_;
+  std::vector<ReadMark> reads_;
+  size_t read_head_{0};  // reads_ 中第一个尚未解析完的记录
+
+  int trigger_index_{-1};     // 当前包中触发所在的帧（-1 表示没有）
+  uint8_t trigger_code_{0};
+  uint8_t trigger_level_{0};  // 上一个已收下的帧的触发电平
+  bool has_counter_{false};
+  uint8_t next_counter_{0};
+
+  std::atomic<uint64_t> samples_{0}, packages_{0}, lost_{0}, gaps_{0}, crc_errors_{0}, skipped_bytes_{0}, bytes_{0},
+      reopens_{0};
+  LatencyHistogram ingest_latency_;
+
+  // 打开并配置设备（raw、非阻塞、设置波特率），失败时 throw_on_error 为 true 则抛出 std::runtime_error
+  bool open_device(bool throw_on_error);
+  void close_device();
+
+  // 从 scan_pos_ 开始查找有效帧加入 frames_，返回当前包是否已经完整（满 chunk 帧或遇到第二个触发）
+  bool index_frames();
+
+  // 读入一段字节（按 wakeup 方式等待，只在 may_block() 时等待，最多 block_timeout()），返回是否读到
+  bool fill();
+
+  // 把 frames_ 解码到包中
+  void emit(Package *package);
+
+  // 缓冲区 offset 处结束的帧是哪次 read() 读入的
+  int64_t read_time(size_t end);
+};
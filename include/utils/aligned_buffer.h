@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+constexpr size_t kSimdAlignment = 64;  // 满足 AVX-512 对齐加载
+
+/**
+ * @brief 64 字节对齐的定长数组（只移动不拷贝，内容初始化为 0）
+ */
+template <class T>
+class AlignedBuffer {
+ public:
+  AlignedBuffer() = default;
+  explicit AlignedBuffer(size_t size) { resize(size); }
+  ~AlignedBuffer() { std::free(data_); }
+
+  AlignedBuffer(const AlignedBuffer&) = delete;
+  AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+  AlignedBuffer(AlignedBuffer&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+  AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+    if (this != &other) {
+      std::free(data_);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  // 重新分配并清零（size 不变时只清零）
+  void resize(size_t size) {
+    if (size != size_) {
+      std::free(data_);
+      data_ = nullptr;
+      size_ = size;
+      if (size_ > 0) {
+        size_t bytes = (size_ * sizeof(T) + kSimdAlignment - 1) / kSimdAlignment * kSimdAlignment;
+        data_ = static_cast<T*>(std::aligned_alloc(kSimdAlignment, bytes));
+        if (data_ == nullptr) {
+          throw std::bad_alloc();
+        }
+      }
+    }
+    if (size_ > 0) {
+      std::memset(static_cast<void*>(data_), 0, size_ * sizeof(T));
+    }
+  }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T& operator[](size_t i) { return data_[i]; }
+  const T& operator[](size_t i) const { return data_[i]; }
+
+ private:
+  T* data_{nullptr};
+  size_t size_{0};
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>  // NOLINT
+#include <type_traits>
+#include <vector>
+
+#include "utils/ring_buffer.h"
+
+enum class LogLevel {
+  DEBUG,
+  INFO,
+  WARN,
+  ERROR
+};
+
+/**
+ * @brief 一条日志的二进制记录（定长，生产者不格式化、不分配内存）
+ *
+ * format 必须是字符串字面量（只保存指针）；参数按类型标签依次写入 payload：
+ *   'i' int64  'u' uint64  'd' double  'p' 指针  's' uint16 长度 + 字符串内容（复制，过长时截断）
+ * payload 放不下的参数被舍弃，格式化时以 "<?>" 代替。
+ */
+struct LogRecord {
+  static constexpr size_t kPayloadSize = 200;
+
+  const char *format{nullptr};
+  const char *file{nullptr};
+  int line{0};
+  LogLevel level{LogLevel::INFO};
+  uint32_t thread{0};
+  int64_t time_ns{0};  // 粗粒度的系统时间（纳秒）
+  uint16_t size{0};    // payload 已用字节数
+  char payload[kPayloadSize];
+
+  void put_int(int64_t value) { put('i', &value, sizeof(value)); }
+  void put_uint(uint64_t value) { put('u', &value, sizeof(value)); }
+  void put_double(double value) { put('d', &value, sizeof(value)); }
+  void put_pointer(const void *value) { put('p', &value, sizeof(value)); }
+
+  void put_string(const char *value) {
+    if (value == nullptr) value = "(null)";
+    if (size + 1 + sizeof(uint16_t) > kPayloadSize) {
+      size = kPayloadSize;  // 放不下，后续参数一并舍弃
+      return;
+    }
+    const size_t room = kPayloadSize - size - 1 - sizeof(uint16_t);
+    const uint16_t length = static_cast<uint16_t>(strnlen(value, room));
+    payload[size] = 's';
+    std::memcpy(payload + size + 1, &length, sizeof(length));
+    std::memcpy(payload + size + 1 + sizeof(length), value, length);
+    size = static_cast<uint16_t>(size + 1 + sizeof(length) + length);
+  }
+
+ private:
+  void put(char tag, const void *value, size_t bytes) {
+    if (size + 1 + bytes > kPayloadSize) {
+      size = kPayloadSize;
+      return;
+    }
+    payload[size] = tag;
+    std::memcpy(payload + size + 1, value, bytes);
+    size = static_cast<uint16_t>(size + 1 + bytes);
+  }
+};
+
+/**
+ * @brief 异步日志后端（MLOG_* 与 ModuleLogger 共用）
+ *
+ * 生产者线程把 LogRecord 写入自己的 SPSC 环（首次写日志时登记），不加锁、不做系统调用；
+ * 时间取后台线程每毫秒更新一次的缓存值。环满时丢弃并计数，不阻塞调用线程。
+ * 后台线程轮流取出各环的记录，统一格式化后成批写出，并定期报告丢弃的条数。
+ */
+class AsyncLogger {
+ public:
+  static constexpr size_t kRingCapacity = 1024;  // 每个线程的环容量（条）
+
+  // 进程内唯一的实例（首次使用时启动后台线程，进程退出时写完剩余记录）
+  static AsyncLogger &instance();
+
+  ~AsyncLogger();
+
+  AsyncLogger(const AsyncLogger &) = delete;
+  AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+  // 全局日志级别（低于该级别的 MLOG_* 不会生成记录）
+  static void set_level(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+  static LogLevel level() { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+  static bool enabled(LogLevel level) { return static_cast<int>(level) >= level_.load(std::memory_order_relaxed); }
+
+  // 输出目标（默认 stdout）；文件路径为空或打开失败时返回 false 并保持原目标
+  bool set_output_file(const std::string &path);
+  void set_output(FILE *stream);
+
+  /**
+   * 写入一条日志（由 MLOG_* 调用）
+   * @param format 字符串字面量，printf 风格
+   * @param args 整数、浮点、C 字符串或指针
+   */
+  template <class... Args>
+  void write(LogLevel level, const char *file, int line, const char *format, const Args &...args) {
+    LogRecord record;
+    record.format = format;
+    record.file = file;
+    record.line = line;
+    record.level = level;
+    record.time_ns = coarse_now_ns_.load(std::memory_order_relaxed);
+    (encode(record, args), ...);
+    submit(record);
+  }
+
+  // 等待此前写入的记录全部写出（测试与退出前使用）
+  void flush();
+
+  // 因环满被丢弃的记录数（累计）
+  uint64_t dropped() const;
+
+ private:
+  struct Ring {
+    explicit Ring(uint32_t id) : records(kRingCapacity), thread(id) {}
+    SpscRingBuffer<LogRecord> records;
+    uint32_t thread;
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> closed{false};  // 所属线程已退出，取空后回收
+  };
+
+  static std::atomic<int> level_;
+
+  mutable std::mutex rings_mutex_;  // 只在登记/回收环和统计时使用，不在写日志的路径上
+  std::vector<std::shared_ptr<Ring>> rings_;
+  uint64_t dropped_total_{0};       // 已回收的环丢弃的记录数
+  std::atomic<uint32_t> next_thread_{0};
+  std::atomic<int64_t> coarse_now_ns_{0};
+  std::atomic<uint64_t> cycles_{0};  // 后台线程完成的轮数（flush 用）
+  uint64_t dropped_reported_{0};     // 已报告过的丢弃数（只在后台线程中使用）
+  time_t cached_second_{-1};         // 时间字符串缓存（只在后台线程中使用）
+  char cached_time_[32]{};
+  std::mutex output_mutex_;          // 切换输出目标与写出互斥
+  FILE *output_{stdout};
+  FILE *owned_file_{nullptr};
+  std::atomic<bool> running_{true};
+  std::thread worker_;
+
+  AsyncLogger();
+
+  Ring &local_ring();
+  void submit(const LogRecord &record);
+  void run();
+  size_t drain(std::string &buffer);
+  void format(const LogRecord &record, uint32_t thread, std::string &buffer);
+
+  template <class T>
+  static void encode(LogRecord &record, const T &value) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, char *> || std::is_same_v<U, const char *>) {
+      record.put_string(value);
+    } else if constexpr (std::is_floating_point_v<U>) {
+      record.put_double(static_cast<double>(value));
+    } else if constexpr (std::is_enum_v<U>) {
+      record.put_int(static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+      record.put_int(static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<U>) {
+      record.put_uint(static_cast<uint64_t>(value));
+    } else if constexpr (std::is_pointer_v<U>) {
+      record.put_pointer(static_cast<const void *>(value));
+    } else {
+      static_assert(std::is_pointer_v<U>, "MLOG_* arguments must be printf-compatible");
+    }
+  }
+};
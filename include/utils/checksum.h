@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ==================== CRC-32 校验 ====================
+//
+// IEEE 802.3 多项式（反射形式 0xEDB88320），与 zlib.crc32 / Python binascii.crc32 结果一致。
+
+namespace detail {
+
+constexpr std::array<uint32_t, 256> make_crc32_table() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t value = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      value = (value & 1u) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+    }
+    table[i] = value;
+  }
+  return table;
+}
+
+inline constexpr std::array<uint32_t, 256> kCrc32Table = make_crc32_table();
+
+}  // namespace detail
+
+/**
+ * 计算 CRC-32
+ * @param data 数据
+ * @param size 字节数
+ * @param crc 上一段数据的 CRC（分段计算时传入，首段为 0）
+ * @return 累计 CRC
+ */
+inline uint32_t crc32(const void* data, size_t size, uint32_t crc = 0) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = detail::kCrc32Table[(crc ^ bytes[i]) & 0xFFu] ^ (crc >> 8);
+  }
+  return ~crc;
+}
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <iostream>
 #include <string>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 #include "opencv2/opencv.hpp"  // 如果涉及图像数据传输，可以使用 OpenCV 类型
+#include "utils/package_schema.h"
+#include "utils/package_trace.h"
 
 
 
@@ -96,6 +104,10 @@ std::string to_upper(const std::string& str);
 
 /**
  * @brief 定义 Package 数据包，作为模块间的统一传输载体
+ *
+ * 快路径：slot<Slot::kXxx>() 按编译期槽位下标访问，返回引用，无哈希、无拷贝（见 package_schema.h）。
+ * 慢路径：add_data / get_data 等字符串键接口保留兼容；键属于 schema 时落到对应槽位，
+ *         否则存入通用的键值表。
  */
 class Package {
  public:
@@ -106,8 +118,53 @@ class Package {
   // 包的唯一标识 ID（可用于追踪数据流）
   std::string package_id_;
 
-  // 数据存储容器（键值对形式，支持多种类型）
-  std::unordered_map<std::string, DataType> data_;
+  // 由 Source 按产生顺序分配的序号（下游据此恢复顺序）
+  uint64_t sequence_{0};
+
+  // 各阶段时间戳（设置了 Tracker 时由各阶段写入）
+  PackageTrace trace_;
+
+  // 截止时刻（由 Source 分配，time_point::max() 表示没有截止时刻）与负载削减标记
+  std::chrono::steady_clock::time_point deadline_{std::chrono::steady_clock::time_point::max()};
+  bool shed_{false};      // 已被某个阶段削减：后续阶段不再调用 process()，只转发
+  bool degraded_{false};  // 过期后按降级方式处理
+  bool failed_{false};    // 某个阶段 process() 失败：后续阶段不再处理，只转发，重排窗口照常按序号释放
+
+  // 强类型槽位及其有效位
+  PackageSlots slots_;
+  uint64_t present_{0};
+
+  // 键值表中的条目：generation 与包当前的 generation_ 相同才有效。
+  // recycle() 只递增 generation_，旧条目随之失效，但节点与 cv::Mat / vector 缓冲区保留供下次复用
+  struct Entry {
+    DataType value;
+    uint64_t generation{0};
+  };
+
+  // 数据存储容器（键值对形式，支持多种类型，存放 schema 之外的数据）
+  std::unordered_map<std::string, Entry> data_;
+  uint64_t generation_{1};
+
+  // 查找当前有效的条目，不存在或已随 recycle() 失效时返回 nullptr
+  const Entry* find_entry(const std::string& key) const {
+    auto it = data_.find(key);
+    if (it == data_.end() || it->second.generation != generation_) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  // 兼容路径下的类型转换：同类型直接赋值，算术类型之间允许转换
+  template <typename To, typename From>
+  static void assign_compatible(To& to, const From& from, const std::string& key) {
+    if constexpr (std::is_same_v<To, From>) {
+      to = from;
+    } else if constexpr (std::is_arithmetic_v<To> && std::is_arithmetic_v<From>) {
+      to = static_cast<To>(from);
+    } else {
+      throw std::runtime_error("Type mismatch for package slot: " + key);
+    }
+  }
 
  public:
   // 默认构造函数
@@ -122,33 +179,154 @@ class Package {
   // 设置包的唯一 ID
   void set_id(const std::string& id) { package_id_ = id; }
 
+  // 获取/设置序号
+  uint64_t get_sequence() const { return sequence_; }
+  void set_sequence(uint64_t sequence) { sequence_ = sequence; }
+
+  // 各阶段时间戳
+  PackageTrace& trace() { return trace_; }
+  const PackageTrace& trace() const { return trace_; }
+
+  // 截止时刻
+  void set_deadline(std::chrono::steady_clock::time_point deadline) { deadline_ = deadline; }
+  std::chrono::steady_clock::time_point get_deadline() const { return deadline_; }
+  bool has_deadline() const { return deadline_ != std::chrono::steady_clock::time_point::max(); }
+  bool expired(std::chrono::steady_clock::time_point now) const { return now > deadline_; }
+
+  // 负载削减标记
+  void mark_shed() { shed_ = true; }
+  bool is_shed() const { return shed_; }
+  void mark_degraded() { degraded_ = true; }
+  bool is_degraded() const { return degraded_; }
+
+  // 处理失败标记
+  void mark_failed() { failed_ = true; }
+  bool is_failed() const { return failed_; }
+
+  // ==================== 槽位接口（快路径） ====================
+
+  // 获取可写引用并标记为有效；已有的 cv::Mat / vector 缓冲区可直接 create / resize 复用
+  template <Slot S>
+  typename SlotTraits<S>::type& slot() {
+    present_ |= uint64_t{1} << static_cast<size_t>(S);
+    return SlotTraits<S>::get(slots_);
+  }
+
+  // 获取只读引用，槽位无效时抛出异常
+  template <Slot S>
+  const typename SlotTraits<S>::type& slot() const {
+    if (!has_slot<S>()) {
+      throw std::runtime_error(std::string("Slot not set in package: ") + SlotTraits<S>::name);
+    }
+    return SlotTraits<S>::get(slots_);
+  }
+
+  // 写入槽位
+  template <Slot S>
+  void set_slot(const typename SlotTraits<S>::type& value) {
+    slot<S>() = value;
+  }
+
+  // 槽位是否有效
+  template <Slot S>
+  bool has_slot() const {
+    return (present_ >> static_cast<size_t>(S)) & 1U;
+  }
+
+  // 使槽位失效（保留其缓冲区）
+  template <Slot S>
+  void reset_slot() {
+    present_ &= ~(uint64_t{1} << static_cast<size_t>(S));
+  }
+
+  // ==================== 字符串键接口（兼容慢路径） ====================
+
   // 添加数据到包中
   template <typename T>
   void add_data(const std::string& key, const T& value) {
-    data_[key] = value;
+    int index = find_slot(key);
+    if (index >= 0) {
+      visit_slot(slots_, index, [&](auto& member) { assign_compatible(member, value, key); });
+      present_ |= uint64_t{1} << index;
+      return;
+    }
+    auto& entry = data_[key];
+    entry.value = value;
+    entry.generation = generation_;
+  }
+
+  // 获取可写引用（键不存在或类型不同时按类型默认构造）。
+  // 复用包时可直接在返回的 cv::Mat / vector 上 create / resize，已有缓冲区不会重新分配；
+  // 与槽位一样，条目已随 recycle() 失效时返回的引用仍可能带着上一次的内容，调用方需完整写入
+  template <typename T>
+  T& mutable_data(const std::string& key) {
+    int index = find_slot(key);
+    if (index >= 0) {
+      T* result = nullptr;
+      visit_slot(slots_, index, [&](auto& member) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(member)>, T>) {
+          result = &member;
+        }
+      });
+      if (result == nullptr) {
+        throw std::runtime_error("Type mismatch for package slot: " + key);
+      }
+      present_ |= uint64_t{1} << index;
+      return *result;
+    }
+    auto& entry = data_[key];
+    if (!std::holds_alternative<T>(entry.value)) {
+      entry.value = T();
+    }
+    entry.generation = generation_;
+    return std::get<T>(entry.value);
   }
 
   // 检查是否存在某个键
   bool has_key(const std::string& key) const {
-    return data_.find(key) != data_.end();
+    int index = find_slot(key);
+    if (index >= 0) {
+      return (present_ >> index) & 1U;
+    }
+    return find_entry(key) != nullptr;
   }
 
   // 获取数据（带类型检查）
   template <typename T>
   T get_data(const std::string& key) const {
-    auto it = data_.find(key);
-    if (it == data_.end()) {
+    int index = find_slot(key);
+    if (index >= 0) {
+      if (!((present_ >> index) & 1U)) {
+        throw std::runtime_error("Key not found in package: " + key);
+      }
+      T result{};
+      visit_slot(slots_, index, [&](const auto& member) { assign_compatible(result, member, key); });
+      return result;
+    }
+    const Entry* entry = find_entry(key);
+    if (entry == nullptr) {
       throw std::runtime_error("Key not found in package: " + key);
     }
-    return std::get<T>(it->second);
+    return std::get<T>(entry->value);
   }
 
   // 获取数据（无异常处理，返回 nullptr）
   template <typename T>
   std::optional<T> try_get_data(const std::string& key) const {
-    auto it = data_.find(key);
-    if (it != data_.end()) {
-      if (auto value = std::get_if<T>(&it->second)) {
+    int index = find_slot(key);
+    if (index >= 0) {
+      std::optional<T> result;
+      if ((present_ >> index) & 1U) {
+        visit_slot(slots_, index, [&](const auto& member) {
+          if constexpr (std::is_same_v<std::decay_t<decltype(member)>, T>) {
+            result = member;
+          }
+        });
+      }
+      return result;
+    }
+    if (const Entry* entry = find_entry(key)) {
+      if (auto value = std::get_if<T>(&entry->value)) {
         return *value;
       }
     }
@@ -157,19 +335,55 @@ class Package {
 
   // 移除某个键值对
   void remove_data(const std::string& key) {
+    int index = find_slot(key);
+    if (index >= 0) {
+      present_ &= ~(uint64_t{1} << index);
+      return;
+    }
     data_.erase(key);
   }
 
   // 清空包中的所有数据
   void clear() {
+    sequence_ = 0;
+    trace_.reset();
+    deadline_ = std::chrono::steady_clock::time_point::max();
+    shed_ = false;
+    degraded_ = false;
+    failed_ = false;
+    present_ = 0;
+    slots_ = PackageSlots();
     data_.clear();
   }
 
+  // 归还到 PackagePool 前调用：槽位与键值表条目全部置为无效，但保留槽位缓冲区与键值表节点供下次复用
+  void recycle() {
+    package_id_.clear();
+    sequence_ = 0;
+    trace_.reset();
+    deadline_ = std::chrono::steady_clock::time_point::max();
+    shed_ = false;
+    degraded_ = false;
+    failed_ = false;
+    present_ = 0;
+    ++generation_;
+  }
+
   // 打印包内容（调试用）
   void debug_print() const {
     std::cout << "Package ID: " << package_id_ << std::endl;
-    for (const auto& [key, value] : data_) {
-      std::cout << "  Key: " << key << ", Value Type: " << value.index() << std::endl;
+    for (size_t i = 0; i < kSlotCount; ++i) {
+      if ((present_ >> i) & 1U) {
+        std::cout << "  Slot: " << i << std::endl;
+      }
+    }
+    for (const auto& [key, entry] : data_) {
+      if (entry.generation == generation_) {
+        std::cout << "  Key: " << key << ", Value Type: " << entry.value.index() << std::endl;
+      }
     }
   }
-};
\ No newline at end of file
+};
+
+// 模块间传递的数据包句柄（最后一个持有者释放时销毁）
+using PackagePtr = std::shared_ptr<Package>;
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 配置节点（JSON 值），由 parse_config / load_config 生成
+ *
+ * 只覆盖配置文件需要的 JSON 子集：null / bool / number / string / array / object。
+ * 查询接口均为只读，访问不存在的键或类型不符时抛出 std::runtime_error。
+ */
+class ConfigNode {
+ public:
+  enum class Type { kNull, kBool, kNumber, kString, kArray, kObject };
+
+  ConfigNode() = default;
+  explicit ConfigNode(bool value) : type_(Type::kBool), bool_(value) {}
+  explicit ConfigNode(double value) : type_(Type::kNumber), number_(value) {}
+  explicit ConfigNode(std::string value) : type_(Type::kString), string_(std::move(value)) {}
+
+  static ConfigNode make_array() {
+    ConfigNode node;
+    node.type_ = Type::kArray;
+    return node;
+  }
+  static ConfigNode make_object() {
+    ConfigNode node;
+    node.type_ = Type::kObject;
+    return node;
+  }
+
+  Type type() const { return type_; }
+  bool is_null() const { return type_ == Type::kNull; }
+  bool is_object() const { return type_ == Type::kObject; }
+  bool is_array() const { return type_ == Type::kArray; }
+
+  // 标量访问
+  bool as_bool() const {
+    check(Type::kBool, "bool");
+    return bool_;
+  }
+  double as_double() const {
+    check(Type::kNumber, "number");
+    return number_;
+  }
+  int as_int() const { return static_cast<int>(as_double()); }
+  const std::string& as_string() const {
+    check(Type::kString, "string");
+    return string_;
+  }
+
+  // 数组访问
+  size_t size() const { return type_ == Type::kArray ? items_.size() : members_.size(); }
+  const ConfigNode& at(size_t index) const {
+    check(Type::kArray, "array");
+    if (index >= items_.size()) {
+      throw std::runtime_error("Config array index out of range: " + std::to_string(index));
+    }
+    return items_[index];
+  }
+  const std::vector<ConfigNode>& items() const {
+    check(Type::kArray, "array");
+    return items_;
+  }
+  void push_back(ConfigNode node) { items_.push_back(std::move(node)); }
+
+  // 对象访问
+  bool has(const std::string& key) const {
+    return type_ == Type::kObject && members_.find(key) != members_.end();
+  }
+  const ConfigNode& operator[](const std::string& key) const {
+    check(Type::kObject, "object");
+    auto it = members_.find(key);
+    if (it == members_.end()) {
+      throw std::runtime_error("Key not found in config: " + key);
+    }
+    return it->second;
+  }
+  const std::map<std::string, ConfigNode>& members() const {
+    check(Type::kObject, "object");
+    return members_;
+  }
+  void set(const std::string& key, ConfigNode node) { members_[key] = std::move(node); }
+
+  // 带默认值的查询（键不存在时返回默认值）
+  bool get_bool(const std::string& key, bool default_value) const {
+    return has(key) ? (*this)[key].as_bool() : default_value;
+  }
+  int get_int(const std::string& key, int default_value) const {
+    return has(key) ? (*this)[key].as_int() : default_value;
+  }
+  double get_double(const std::string& key, double default_value) const {
+    return has(key) ? (*this)[key].as_double() : default_value;
+  }
+  std::string get_string(const std::string& key, const std::string& default_value) const {
+    return has(key) ? (*this)[key].as_string() : default_value;
+  }
+  std::vector<int> get_int_array(const std::string& key) const {
+    std::vector<int> values;
+    if (has(key)) {
+      for (const auto& item : (*this)[key].items()) {
+        values.push_back(item.as_int());
+      }
+    }
+    return values;
+  }
+
+ private:
+  Type type_{Type::kNull};
+  bool bool_{false};
+  double number_{0.0};
+  std::string string_;
+  std::vector<ConfigNode> items_;
+  std::map<std::string, ConfigNode> members_;
+
+  void check(Type expected, const char* name) const {
+    if (type_ != expected) {
+      throw std::runtime_error(std::string("Config value is not a ") + name);
+    }
+  }
+};
+
+/**
+ * 解析 JSON 文本
+ * @param text JSON 文本
+ * @return 根节点，语法错误时抛出 std::runtime_error
+ */
+ConfigNode parse_config(const std::string& text);
+
+/**
+ * 从文件加载 JSON 配置
+ * @param path 配置文件路径
+ * @return 根节点，文件不可读或语法错误时抛出 std::runtime_error
+ */
+ConfigNode load_config(const std::string& path);
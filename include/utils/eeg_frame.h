@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ==================== 放大器数据帧 ====================
+//
+// 网络 Source 与放大器模拟器之间的数据块格式（参照 NeuroScan Acquire 的数据块：定长头 + 按采样点交织的各通道数据）：
+//
+//   [EegFrameHeader][payload: n_samples x n_channels，按采样点存放（s0c0 s0c1 ... s1c0 ...）]
+//
+// UDP 每个数据报一帧；TCP 按字节流首尾相接，magic 用于失步后重新对齐。小端存放。
+
+constexpr uint32_t kEegFrameMagic = 0x46474545;  // "EEGF"
+
+// 采样点编码
+enum class EegSampleFormat : uint8_t {
+  kInt16 = 0,    // 乘以 resolution 得到微伏
+  kFloat32 = 1,  // 直接为微伏
+};
+
+struct EegFrameHeader {
+  uint32_t magic;
+  uint32_t sequence;        // 帧序号（每帧加 1，回绕），用于检测丢帧
+  uint16_t n_channels;
+  uint16_t n_samples;       // 本帧每个通道的采样点数
+  uint8_t format;           // EegSampleFormat
+  uint8_t reserved;
+  int16_t trigger_offset;   // 触发在本帧中的采样点下标，无触发时为 -1
+  int32_t trigger_code;
+  float resolution;         // kInt16 时每个计数对应的微伏数
+  uint64_t send_ns;         // 发送端 steady_clock 时间（同机回环测时延用，跨机器无意义）
+};
+
+static_assert(sizeof(EegFrameHeader) == 32, "EegFrameHeader layout changed");
+
+// 每个采样点的字节数
+inline size_t eeg_sample_bytes(uint8_t format) {
+  return format == static_cast<uint8_t>(EegSampleFormat::kInt16) ? sizeof(int16_t) : sizeof(float);
+}
+
+// 帧的总字节数（头部 + 数据）
+inline size_t eeg_frame_bytes(const EegFrameHeader& header) {
+  return sizeof(EegFrameHeader) + static_cast<size_t>(header.n_channels) * header.n_samples *
+                                      eeg_sample_bytes(header.format);
+}
+
+/**
+ * 把交织的帧数据解码为按通道存放的微伏值
+ * @param header 帧头（调用方已检查 format 与形状）
+ * @param payload 紧跟在帧头之后的数据
+ * @param out 输出，n_channels 行，每行至少 n_samples 个元素
+ * @param out_stride 输出相邻两行的元素间距
+ */
+inline void decode_eeg_frame(const EegFrameHeader& header, const unsigned char* payload, float* out,
+                             size_t out_stride) {
+  const size_t n_channels = header.n_channels;
+  const size_t n_samples = header.n_samples;
+  if (header.format == static_cast<uint8_t>(EegSampleFormat::kInt16)) {
+    const float scale = header.resolution;
+    for (size_t s = 0; s < n_samples; ++s) {
+      const unsigned char* row = payload + s * n_channels * sizeof(int16_t);
+      for (size_t c = 0; c < n_channels; ++c) {
+        int16_t value;
+        std::memcpy(&value, row + c * sizeof(int16_t), sizeof(value));
+        out[c * out_stride + s] = value * scale;
+      }
+    }
+  } else {
+    for (size_t s = 0; s < n_samples; ++s) {
+      const unsigned char* row = payload + s * n_channels * sizeof(float);
+      for (size_t c = 0; c < n_channels; ++c) {
+        std::memcpy(&out[c * out_stride + s], row + c * sizeof(float), sizeof(float));
+      }
+    }
+  }
+}
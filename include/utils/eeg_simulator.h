@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "utils/eeg_frame.h"
+#include "utils/package_schema.h"
+#include "utils/serial_frame.h"
+
+// 模拟放大器参数
+struct EegSimulatorConfig {
+  bool tcp{false};               // false：向 host:port 发 UDP 数据报；true：在 host:port 上监听，向接入的一个客户端发送
+  std::string host{"127.0.0.1"};
+  int port{4000};                // TCP 为 0 时由系统分配（见 local_port）
+  int n_channels{64};
+  int samples_per_frame{40};
+  double fs{1000.0};
+  EegSampleFormat format{EegSampleFormat::kInt16};
+  float resolution{0.1f};        // kInt16 时每个计数对应的微伏数
+  int trigger_every{100};        // 每隔多少个采样点一个触发（0 表示不发触发），目标与非目标交替
+  bool realtime{true};           // 按 fs 定时发送；false 时尽快发送
+  int drop_every{0};             // 每隔多少帧跳过一个序号（模拟丢帧，0 表示不丢）
+};
+
+/**
+ * @brief 模拟放大器：按 eeg_frame.h 的格式发送合成 EEG（回环测试与基准测试用）
+ *
+ * 第 c 个通道第 t 个采样点的值见 sample_value（10 Hz 正弦，各通道相位不同），发送端与接收端可以逐点核对。
+ */
+class EegSimulator {
+ public:
+  explicit EegSimulator(const EegSimulatorConfig &config);
+  ~EegSimulator();
+
+  EegSimulator(const EegSimulator &) = delete;
+  EegSimulator &operator=(const EegSimulator &) = delete;
+
+  /**
+   * 发送若干帧（阻塞；TCP 下先等待客户端接入）
+   * @param n_frames 帧数，0 表示一直发送到 stop()
+   */
+  void send(uint64_t n_frames);
+
+  // 在后台线程中 send(n_frames)
+  void start(uint64_t n_frames = 0);
+  void stop();
+
+  // TCP 监听的端口
+  int local_port() const { return local_port_; }
+
+  uint64_t frames_sent() const { return frames_sent_.load(std::memory_order_relaxed); }
+
+  // 合成信号（微伏）
+  static float sample_value(int channel, uint64_t sample, double fs);
+
+ private:
+  EegSimulatorConfig config_;
+  int fd_{-1};         // UDP 发送或 TCP 监听
+  int client_fd_{-1};  // TCP 已接入的客户端
+  int local_port_{0};
+  uint32_t sequence_{0};
+  uint64_t sample_{0};
+  std::vector<unsigned char> frame_;
+  std::atomic<bool> running_{false};
+  std::atomic<uint64_t> frames_sent_{0};
+  std::thread thread_;
+
+  void build_frame();
+  bool write_frame();
+};
+
+// 模拟串口放大器参数
+struct SerialSimulatorConfig {
+  int n_channels{8};
+  double fs{1000.0};
+  int baud{921600};              // 只用于检查线路带宽是否够 fs（伪终端本身不限速）
+  float resolution{0.02235f};    // 每个计数对应的微伏数
+  int trigger_every{100};        // 每隔多少个采样点一个触发（0 表示不发触发），目标与非目标交替
+  int trigger_hold{10};          // 触发电平保持的采样点数
+  bool realtime{true};           // 按 fs 定时发送；false 时尽快发送
+  int drop_every{0};             // 每隔多少帧跳过一个计数（模拟丢帧，0 表示不丢）
+  int corrupt_every{0};          // 每隔多少帧破坏一个数据字节（模拟线路误码，接收端应 CRC 报错并计为丢失一帧）
+};
+
+/**
+ * @brief 模拟串口放大器：在伪终端（/dev/ptmx）主端按 serial_frame.h 的格式逐采样点发帧，接收端打开 device()
+ *
+ * 信号与 EegSimulator 相同（见 EegSimulator::sample_value），按 resolution 量化为 24 位计数。
+ * 从端在模拟器存在期间一直保持打开（raw 模式），接收端可以随时打开或重新打开。
+ */
+class SerialEegSimulator {
+ public:
+  explicit SerialEegSimulator(const SerialSimulatorConfig &config);
+  ~SerialEegSimulator();
+
+  SerialEegSimulator(const SerialEegSimulator &) = delete;
+  SerialEegSimulator &operator=(const SerialEegSimulator &) = delete;
+
+  // 伪终端从端的路径（例如 /dev/pts/3）
+  const std::string &device() const { return device_; }
+
+  /**
+   * 发送若干帧（阻塞）
+   * @param n_frames 帧数，0 表示一直发送到 stop()
+   */
+  void send(uint64_t n_frames);
+
+  // 在后台线程中 send(n_frames)
+  void start(uint64_t n_frames = 0);
+  void stop();
+
+  uint64_t frames_sent() const { return frames_sent_.load(std::memory_order_relaxed); }
+
+  // 最近一次 start() 的时刻：实时模式下第 i 帧在 start_time() + (i + 1) / fs 时发出
+  std::chrono::steady_clock::time_point start_time() const { return start_time_; }
+
+ private:
+  SerialSimulatorConfig config_;
+  int master_fd_{-1};
+  int slave_fd_{-1};
+  std::string device_;
+  uint8_t counter_{0};
+  uint64_t sample_{0};
+  std::vector<int32_t> counts_;
+  std::vector<unsigned char> frame_;
+  std::atomic<bool> running_{false};
+  std::atomic<uint64_t> frames_sent_{0};
+  std::chrono::steady_clock::time_point start_time_;
+  std::thread thread_;
+
+  void run(uint64_t n_frames);
+  bool write_frame();
+};
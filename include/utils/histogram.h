@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 固定分桶的计数直方图
+ *
+ * 桶由递增的上界给出：第 i 个桶统计 (bounds[i-1], bounds[i]] 内的值，超过最后一个上界的值计入溢出桶。
+ * 只有一个线程调用 record()，其他线程可以随时读取（计数为 relaxed 原子量，读到的是近似快照）。
+ */
+class Histogram {
+ public:
+  explicit Histogram(std::vector<uint64_t> bounds)
+      : bounds_(std::move(bounds)), counts_(new std::atomic<uint64_t>[bounds_.size() + 2]) {
+    if (bounds_.empty() || !std::is_sorted(bounds_.begin(), bounds_.end())) {
+      throw std::invalid_argument("Histogram bounds must be non-empty and sorted");
+    }
+    reset();
+  }
+
+  // 上界为 1, 2, ..., max_value（适合批大小这类小整数）
+  static Histogram linear(uint64_t max_value) {
+    std::vector<uint64_t> bounds;
+    for (uint64_t v = 1; v <= std::max<uint64_t>(max_value, 1); ++v) bounds.push_back(v);
+    return Histogram(std::move(bounds));
+  }
+
+  // 上界为 0, 1, 2, 4, ..., 2^k >= max_value（适合时延这类跨数量级的值）
+  static Histogram exponential(uint64_t max_value) {
+    std::vector<uint64_t> bounds{0};
+    for (uint64_t v = 1;; v *= 2) {
+      bounds.push_back(v);
+      if (v >= max_value) break;
+    }
+    return Histogram(std::move(bounds));
+  }
+
+  Histogram(Histogram&&) = default;
+  Histogram& operator=(Histogram&&) = default;
+
+  void record(uint64_t value) {
+    size_t bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    counts_[bounds_.size() + 1].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void reset() {
+    for (size_t i = 0; i < bounds_.size() + 2; ++i) counts_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // 桶数（含溢出桶）及各桶计数
+  size_t bucket_count() const { return bounds_.size() + 1; }
+  uint64_t bucket(size_t i) const { return counts_[i].load(std::memory_order_relaxed); }
+  const std::vector<uint64_t>& bounds() const { return bounds_; }
+
+  uint64_t count() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < bucket_count(); ++i) total += bucket(i);
+    return total;
+  }
+
+  double mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(counts_[bounds_.size() + 1].load(std::memory_order_relaxed)) / n;
+  }
+
+  // 分位数（返回所在桶的上界；落在溢出桶时返回最后一个上界）
+  uint64_t percentile(double p) const {
+    uint64_t n = count();
+    if (n == 0) return 0;
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * n)));  // 最近秩
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bounds_.size(); ++i) {
+      seen += bucket(i);
+      if (seen >= rank) return bounds_[i];
+    }
+    return bounds_.back();
+  }
+
+  // 单行摘要，例如 "batch_fill: n=120 mean=3.20 p50=3 p90=6 p99=8"
+  std::string report(const std::string& name) const {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s: n=%llu mean=%.2f p50=%llu p90=%llu p99=%llu", name.c_str(),
+             static_cast<unsigned long long>(count()), mean(), static_cast<unsigned long long>(percentile(50)),
+             static_cast<unsigned long long>(percentile(90)), static_cast<unsigned long long>(percentile(99)));
+    return std::string(buffer);
+  }
+
+ private:
+  std::vector<uint64_t> bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counts_;  // 各桶计数 + 溢出桶 + 所有值之和
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+// 一组时延的统计摘要（单位纳秒）
+struct LatencySnapshot {
+  uint64_t count{0};
+  uint64_t min_ns{0};
+  uint64_t max_ns{0};
+  double mean_ns{0.0};
+  uint64_t p50_ns{0};
+  uint64_t p90_ns{0};
+  uint64_t p99_ns{0};
+  uint64_t p999_ns{0};
+  double throughput{0.0};  // 每秒记录次数（由调用方按统计时长填写）
+
+  // 单行摘要（微秒），例如 "Runner: n=1200 rate=100.0/s mean=812.3us p50=790.5us ... max=2300.1us"
+  // 吞吐量为 0 时省略 rate
+  std::string format(const std::string &name) const {
+    char rate[48] = "";
+    if (throughput > 0.0) {
+      snprintf(rate, sizeof(rate), " rate=%.1f/s", throughput);
+    }
+    char buffer[320];
+    snprintf(buffer, sizeof(buffer),
+             "%s: n=%llu%s mean=%.1fus p50=%.1fus p90=%.1fus p99=%.1fus p99.9=%.1fus max=%.1fus", name.c_str(),
+             static_cast<unsigned long long>(count), rate, mean_ns / 1e3, p50_ns / 1e3, p90_ns / 1e3, p99_ns / 1e3,
+             p999_ns / 1e3, max_ns / 1e3);
+    return std::string(buffer);
+  }
+};
+
+/**
+ * @brief 对数-线性分桶的时延直方图（HDR 风格，单位纳秒）
+ *
+ * 小于 2^(kSubBits+1) 的值每个整数一个桶；更大的值每个 2 的幂区间 [2^k, 2^(k+1)) 再线性分成 2^kSubBits 个桶，
+ * 相对误差不超过 1/2^kSubBits（约 3%）。覆盖 0 ~ 2^kMaxExponent ns（约 36 分钟），更大的值计入最后一个桶。
+ * 计数为 relaxed 原子量：多个线程可以同时 record()，其他线程可以随时 snapshot()（读到的是近似快照）。
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBits = 5;
+  static constexpr int kMaxExponent = 41;
+  static constexpr uint64_t kSubCount = 1ULL << kSubBits;
+  static constexpr size_t kBucketCount = 2 * kSubCount + (kMaxExponent - kSubBits - 1) * kSubCount;
+
+  LatencyHistogram() { reset(); }
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  void record(uint64_t ns) {
+    counts_[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+    seen = min_.load(std::memory_order_relaxed);
+    while (ns < seen && !min_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() {
+    for (auto &count : counts_) count.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  }
+
+  // 累加到合并用的计数中（counts 大小为 kBucketCount），用于合并多个直方图
+  void accumulate(std::vector<uint64_t> &counts, uint64_t &sum, uint64_t &min_ns, uint64_t &max_ns) const {
+    for (size_t i = 0; i < kBucketCount; ++i) counts[i] += counts_[i].load(std::memory_order_relaxed);
+    sum += sum_.load(std::memory_order_relaxed);
+    min_ns = std::min(min_ns, min_.load(std::memory_order_relaxed));
+    max_ns = std::max(max_ns, max_.load(std::memory_order_relaxed));
+  }
+
+  LatencySnapshot snapshot() const {
+    std::vector<uint64_t> counts(kBucketCount, 0);
+    uint64_t sum = 0, min_ns = std::numeric_limits<uint64_t>::max(), max_ns = 0;
+    accumulate(counts, sum, min_ns, max_ns);
+    return summarize(counts, sum, min_ns, max_ns);
+  }
+
+  // 由合并后的计数计算摘要（分位数取所在桶的上界，不超过观测到的最大值）
+  static LatencySnapshot summarize(const std::vector<uint64_t> &counts, uint64_t sum, uint64_t min_ns,
+                                   uint64_t max_ns) {
+    LatencySnapshot snapshot;
+    for (uint64_t count : counts) snapshot.count += count;
+    if (snapshot.count == 0) {
+      return snapshot;
+    }
+    snapshot.min_ns = min_ns;
+    snapshot.max_ns = max_ns;
+    snapshot.mean_ns = static_cast<double>(sum) / snapshot.count;
+    const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+    uint64_t *targets[] = {&snapshot.p50_ns, &snapshot.p90_ns, &snapshot.p99_ns, &snapshot.p999_ns};
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t i = 0; i < counts.size() && next < 4; ++i) {
+      seen += counts[i];
+      // 最近秩
+      while (next < 4 && seen >= std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantiles[next] * snapshot.count)))) {
+        *targets[next++] = std::min(bucket_upper(i), max_ns);
+      }
+    }
+    return snapshot;
+  }
+
+  // 值所在的桶
+  static size_t bucket_index(uint64_t ns) {
+    if (ns < 2 * kSubCount) {
+      return static_cast<size_t>(ns);
+    }
+    const int exponent = 63 - __builtin_clzll(ns);
+    if (exponent >= kMaxExponent) {
+      return kBucketCount - 1;
+    }
+    const int shift = exponent - kSubBits;
+    const uint64_t sub = (ns >> shift) - kSubCount;
+    return 2 * kSubCount + static_cast<size_t>(exponent - kSubBits - 1) * kSubCount + static_cast<size_t>(sub);
+  }
+
+  // 桶内的最大值
+  static uint64_t bucket_upper(size_t index) {
+    if (index < 2 * kSubCount) {
+      return index;
+    }
+    const size_t offset = index - 2 * kSubCount;
+    const int shift = static_cast<int>(offset / kSubCount) + 1;
+    const uint64_t sub = offset % kSubCount;
+    return ((kSubCount + sub + 1) << shift) - 1;
+  }
+
+ private:
+  std::atomic<uint64_t> counts_[kBucketCount];
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
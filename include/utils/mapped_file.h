@@ -0,0 +1,89 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/**
+ * @brief 只读内存映射文件
+ *
+ * 打开时整体 mmap（MAP_PRIVATE + PROT_READ），析构时 munmap。映射地址按页对齐，
+ * 文件内按 64 字节对齐存放的数组可直接作为 SIMD 输入使用，无需拷贝或解析。
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  /**
+   * 映射文件
+   * @param path 文件路径
+   * @param populate 是否在映射时预读全部页面（MAP_POPULATE），避免首次访问时缺页
+   */
+  explicit MappedFile(const std::string& path, bool populate = true) : path_(path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw std::runtime_error("Failed to stat " + path + ": " + std::strerror(error));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+      int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+      if (populate) flags |= MAP_POPULATE;
+#endif
+      void* address = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+      if (address == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Failed to mmap " + path + ": " + std::strerror(error));
+      }
+      data_ = static_cast<const unsigned char*>(address);
+    }
+    ::close(fd);  // 映射建立后不再需要文件描述符
+  }
+
+  ~MappedFile() { unmap(); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept
+      : path_(std::move(other.path_)), data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      path_ = std::move(other.path_);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  const unsigned char* data() const { return data_; }
+  size_t size() const { return size_; }
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+  const unsigned char* data_{nullptr};
+  size_t size_{0};
+
+  void unmap() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<unsigned char*>(data_), size_);
+      data_ = nullptr;
+    }
+  }
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief 按通道存放的连续采样环形缓冲区（镜像映射）
+ *
+ * 每个通道一段 capacity 个 float 的环，同一段物理内存在虚拟地址上紧挨着映射两次：
+ * 第 c 个通道占 [row(c), row(c) + 2 * capacity)，后一半是前一半的镜像。因此任意不超过 capacity 的采样窗口
+ * 在每个通道内都是连续的，可以直接作为 cv::Mat 的一行（行间距 row_stride()），窗口跨过环尾时也不需要拷贝。
+ *
+ * capacity 向上取整到页大小的整数倍（以 float 计）。只由一个线程写入；读者需保证所读窗口尚未被覆盖。
+ */
+class MirroredChannelRing {
+ public:
+  /**
+   * @param n_channels 通道数
+   * @param min_capacity 每个通道至少能保存的采样点数
+   */
+  MirroredChannelRing(int n_channels, size_t min_capacity) : n_channels_(n_channels) {
+    if (n_channels < 1 || min_capacity < 1) {
+      throw std::invalid_argument("MirroredChannelRing: invalid channel count or capacity");
+    }
+    const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    row_bytes_ = (min_capacity * sizeof(float) + page - 1) / page * page;
+    capacity_ = row_bytes_ / sizeof(float);
+
+    const int fd = ::memfd_create("rsvp_channel_ring", MFD_CLOEXEC);
+    if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(row_bytes_ * n_channels_)) != 0) {
+      const int error = errno;
+      if (fd >= 0) ::close(fd);
+      throw std::runtime_error(std::string("MirroredChannelRing: memfd failed: ") + std::strerror(error));
+    }
+    // 先占住整段虚拟地址，再把每个通道的物理页以 MAP_FIXED 映射两次
+    mapping_bytes_ = 2 * row_bytes_ * n_channels_;
+    void *base = ::mmap(nullptr, mapping_bytes_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd);
+      throw std::runtime_error(std::string("MirroredChannelRing: mmap failed: ") + std::strerror(error));
+    }
+    base_ = static_cast<float *>(base);
+    for (int c = 0; c < n_channels_; ++c) {
+      unsigned char *row = reinterpret_cast<unsigned char *>(base_) + 2 * row_bytes_ * c;
+      const off_t offset = static_cast<off_t>(row_bytes_ * c);
+      if (::mmap(row, row_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, offset) == MAP_FAILED ||
+          ::mmap(row + row_bytes_, row_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, offset) ==
+              MAP_FAILED) {
+        const int error = errno;
+        ::close(fd);
+        ::munmap(base_, mapping_bytes_);
+        throw std::runtime_error(std::string("MirroredChannelRing: mirror mmap failed: ") + std::strerror(error));
+      }
+    }
+    ::close(fd);  // 映射建立后不再需要文件描述符
+  }
+
+  ~MirroredChannelRing() { ::munmap(base_, mapping_bytes_); }
+
+  MirroredChannelRing(const MirroredChannelRing &) = delete;
+  MirroredChannelRing &operator=(const MirroredChannelRing &) = delete;
+
+  int n_channels() const { return n_channels_; }
+
+  // 每个通道保存的采样点数
+  size_t capacity() const { return capacity_; }
+
+  // 相邻两个通道的间距（float 个数）
+  size_t row_stride() const { return 2 * capacity_; }
+
+  // 已写入的采样点总数（第一个采样点的下标为 0）
+  uint64_t written() const { return written_; }
+
+  // 仍保存在环中的最早采样点
+  uint64_t oldest() const { return written_ > capacity_ ? written_ - capacity_ : 0; }
+
+  /**
+   * 追加一段采样点
+   * @param data 按通道存放的数据，第 c 个通道从 data + c * stride 开始
+   * @param stride 输入相邻两个通道的间距（float 个数）
+   * @param n 每个通道的采样点数（不超过 capacity()）
+   */
+  void append(const float *data, size_t stride, size_t n) {
+    const size_t position = static_cast<size_t>(written_ % capacity_);
+    for (int c = 0; c < n_channels_; ++c) {
+      std::memcpy(base_ + row_stride() * c + position, data + stride * c, n * sizeof(float));
+    }
+    written_ += n;
+  }
+
+  // 第 0 个通道中第 sample 个采样点的地址（sample 须在 [oldest(), written()) 内），第 c 个通道再加 c * row_stride()
+  float *at(uint64_t sample) const { return base_ + static_cast<size_t>(sample % capacity_); }
+
+ private:
+  int n_channels_;
+  size_t row_bytes_{0};
+  size_t capacity_{0};
+  size_t mapping_bytes_{0};
+  float *base_{nullptr};
+  uint64_t written_{0};
+};
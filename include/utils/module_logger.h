@@ -1,67 +1,38 @@
 #pragma once
 
-#include <iostream>
-#include <fstream>
-#include <mutex>
-#include <string>
+#include <cstdio>
 #include <sstream>
-#include <ctime>
-#include <iomanip>
+#include <string>
 
-enum class LogLevel {
-  DEBUG,
-  INFO,
-  WARN,
-  ERROR
-};
+#include "utils/async_logger.h"
+
+/**
+ * MLOG_*：printf 风格的日志宏，写入 AsyncLogger（调用线程只编码参数，格式化与写出在后台线程）
+ * format 必须是字符串字面量；级别低于 AsyncLogger::level() 时不求值参数。
+ * `if (false) std::printf(...)` 只用于让编译器检查格式串与参数是否匹配，不会执行。
+ */
+#define MLOG_WRITE(level, format, ...)                                                       \
+  do {                                                                                       \
+    if (AsyncLogger::enabled(level)) {                                                       \
+      if (false) std::printf(format, ##__VA_ARGS__);                                         \
+      AsyncLogger::instance().write(level, __FILE__, __LINE__, "" format, ##__VA_ARGS__);    \
+    }                                                                                        \
+  } while (0)
+
+#define MLOG_DEBUG(format, ...) MLOG_WRITE(LogLevel::DEBUG, format, ##__VA_ARGS__)
+#define MLOG_INFO(format, ...) MLOG_WRITE(LogLevel::INFO, format, ##__VA_ARGS__)
+#define MLOG_WARN(format, ...) MLOG_WRITE(LogLevel::WARN, format, ##__VA_ARGS__)
+#define MLOG_ERROR(format, ...) MLOG_WRITE(LogLevel::ERROR, format, ##__VA_ARGS__)
 
 class ModuleLogger {
  private:
-  LogLevel log_level_;              // 当前日志级别
-  std::ostream* output_stream_;     // 日志输出流（默认是 std::cout）
-  std::ofstream file_stream_;       // 如果日志写入文件，则使用此流
-  std::mutex log_mutex_;            // 用于线程安全的日志操作
-
-  // 获取当前时间的字符串
-  std::string get_current_time() const {
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_time = std::chrono::system_clock::to_time_t(now);
-    std::tm local_time = *std::localtime(&now_time);
-
-    std::ostringstream oss;
-    oss << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
-  }
-
-  // 将日志级别转换为字符串
-  std::string log_level_to_string(LogLevel level) const {
-    switch (level) {
-      case LogLevel::DEBUG: return "DEBUG";
-      case LogLevel::INFO: return "INFO";
-      case LogLevel::WARN: return "WARN";
-      case LogLevel::ERROR: return "ERROR";
-      default: return "UNKNOWN";
-    }
-  }
+  LogLevel log_level_;  // 当前日志级别
 
  public:
-  // 构造函数，默认输出到标准输出，日志级别为 INFO
-  explicit ModuleLogger(LogLevel level = LogLevel::INFO, const std::string& file_path = "")
-      : log_level_(level), output_stream_(&std::cout) {
-    if (!file_path.empty()) {
-      file_stream_.open(file_path, std::ios::out | std::ios::app);
-      if (file_stream_.is_open()) {
-        output_stream_ = &file_stream_;
-      } else {
-        std::cerr << "Failed to open log file: " << file_path << std::endl;
-      }
-    }
-  }
-
-  // 析构函数，关闭文件流
-  ~ModuleLogger() {
-    if (file_stream_.is_open()) {
-      file_stream_.close();
+  // 构造函数，默认输出到标准输出，日志级别为 INFO；file_path 非空时日志改写到该文件（进程内共用）
+  explicit ModuleLogger(LogLevel level = LogLevel::INFO, const std::string& file_path = "") : log_level_(level) {
+    if (!file_path.empty() && !AsyncLogger::instance().set_output_file(file_path)) {
+      MLOG_ERROR("Failed to open log file: %s", file_path.c_str());
     }
   }
 
@@ -75,26 +46,16 @@ class ModuleLogger {
     return log_level_;
   }
 
-  // 写日志（通用模板）
+  // 写日志（通用模板）：内容在调用线程拼接，写出交给 AsyncLogger
   template <typename... Args>
   void log(LogLevel level, const std::string& module_name, Args... args) {
     if (level < log_level_) {
       return;  // 如果日志级别低于当前设置的日志级别，忽略
     }
 
-    std::lock_guard<std::mutex> lock(log_mutex_);
-
-    // 生成日志内容
     std::ostringstream oss;
-    oss << "[" << get_current_time() << "] "
-        << "[" << log_level_to_string(level) << "] "
-        << "[" << module_name << "] ";
     (oss << ... << args);  // 使用 C++17 的折叠表达式处理变参
-    oss << std::endl;
-
-    // 写入日志到输出流
-    (*output_stream_) << oss.str();
-    output_stream_->flush();
+    AsyncLogger::instance().write(level, nullptr, 0, "[%s] %s", module_name.c_str(), oss.str().c_str());
   }
 
   // 便捷的日志接口
@@ -1,58 +1,97 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <vector>
 
-class ModuleProfiler {
- private:
-  bool enabled_;  // 是否启用性能分析
-  std::chrono::steady_clock::time_point start_time_;  // 起始时间
-  std::chrono::steady_clock::time_point end_time_;    // 结束时间
-  double total_time_{0.0};  // 累积时间（毫秒）
-  size_t run_count_{0};     // 运行次数
+#include "utils/latency_histogram.h"
 
+/**
+ * @brief 模块处理时延统计（纳秒精度）
+ *
+ * 每个记录线程写入自己的直方图分片（按线程编号取模，首次使用时分配），记录路径无锁；
+ * get_profile() 合并所有分片，可以在任何线程随时调用。未启用时不分配内存，记录为空操作。
+ */
+class ModuleProfiler {
  public:
+  using Clock = std::chrono::steady_clock;
+  static constexpr size_t kShards = 8;  // 分片数（多于此数的线程共用分片，计数仍为原子操作）
+
   // 默认构造函数，不启用性能分析
-  ModuleProfiler(bool enabled = false) : enabled_(enabled) {}
+  ModuleProfiler(bool enabled = false) : enabled_(enabled), since_(Clock::now().time_since_epoch().count()) {
+    for (auto &shard : shards_) shard.store(nullptr, std::memory_order_relaxed);
+  }
 
-  // 重置性能统计数据
+  ~ModuleProfiler() {
+    for (auto &shard : shards_) delete shard.load(std::memory_order_relaxed);
+  }
+
+  ModuleProfiler(const ModuleProfiler &) = delete;
+  ModuleProfiler &operator=(const ModuleProfiler &) = delete;
+
+  // 重置性能统计数据（与记录并发时结果为近似值）
   void reset() {
-    total_time_ = 0.0;
-    run_count_ = 0;
+    for (auto &shard : shards_) {
+      LatencyHistogram *histogram = shard.load(std::memory_order_acquire);
+      if (histogram) histogram->reset();
+    }
+    since_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
   }
 
-  // 开始计时
+  // 开始计时（只用于单线程调用 start/stop 的场合）
   void start() {
     if (enabled_) {
-      start_time_ = std::chrono::steady_clock::now();
+      start_time_ = Clock::now();
     }
   }
 
-  // 停止计时并更新统计数据
+  // 停止计时并记录
   void stop() {
     if (enabled_) {
-      end_time_ = std::chrono::steady_clock::now();
-      double elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_time_ - start_time_).count();
-      total_time_ += elapsed_time;
-      ++run_count_;
+      add_profile(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time_).count()));
     }
   }
 
-  // 获取平均处理时间（毫秒）
-  double get_average_time() const {
-    if (run_count_ == 0) return 0.0;
-    return total_time_ / run_count_;
+  /**
+   * 记录一次处理时延
+   * @param ns 纳秒
+   */
+  void add_profile(uint64_t ns) {
+    if (enabled_) {
+      shard().record(ns);
+    }
+  }
+
+  // 合并所有分片的摘要，吞吐量按自构造或 reset() 以来的时长计算
+  LatencySnapshot get_profile() const {
+    std::vector<uint64_t> counts(LatencyHistogram::kBucketCount, 0);
+    uint64_t sum = 0, min_ns = std::numeric_limits<uint64_t>::max(), max_ns = 0;
+    for (const auto &shard : shards_) {
+      const LatencyHistogram *histogram = shard.load(std::memory_order_acquire);
+      if (histogram) histogram->accumulate(counts, sum, min_ns, max_ns);
+    }
+    LatencySnapshot snapshot = LatencyHistogram::summarize(counts, sum, min_ns, max_ns);
+    const Clock::time_point since(Clock::duration(since_.load(std::memory_order_relaxed)));
+    const double elapsed = std::chrono::duration<double>(Clock::now() - since).count();
+    snapshot.throughput = elapsed > 0.0 ? snapshot.count / elapsed : 0.0;
+    return snapshot;
   }
 
+  // 获取平均处理时间（毫秒）
+  double get_average_time() const { return get_profile().mean_ns / 1e6; }
+
   // 获取总运行时间（毫秒）
   double get_total_time() const {
-    return total_time_;
+    LatencySnapshot snapshot = get_profile();
+    return snapshot.mean_ns * snapshot.count / 1e6;
   }
 
   // 获取运行次数
-  size_t get_run_count() const {
-    return run_count_;
-  }
+  size_t get_run_count() const { return static_cast<size_t>(get_profile().count); }
 
   // 获取是否启用性能分析
   bool is_enabled() const {
@@ -60,15 +99,33 @@ class ModuleProfiler {
   }
 
   // 打印性能分析结果
-  std::string report(const std::string& module_name = "Module") const {
+  std::string report(const std::string &module_name = "Module") const {
     if (!enabled_) {
       return module_name + " Profiler: Disabled";
     }
+    return get_profile().format(module_name);
+  }
 
-    char buffer[256];
-    snprintf(buffer, sizeof(buffer),
-             "%s Profiler: Total Time = %.2f ms, Average Time = %.2f ms, Run Count = %zu",
-             module_name.c_str(), total_time_, get_average_time(), run_count_);
-    return std::string(buffer);
+ private:
+  bool enabled_;                                         // 是否启用性能分析
+  Clock::time_point start_time_;                         // start() 的起始时间
+  std::atomic<Clock::rep> since_;                        // 统计起点（用于计算吞吐量）
+  std::atomic<LatencyHistogram *> shards_[kShards];      // 各线程的直方图分片
+
+  // 当前线程的分片，首次使用时分配
+  LatencyHistogram &shard() {
+    static std::atomic<size_t> next_thread{0};
+    thread_local size_t thread_index = next_thread.fetch_add(1, std::memory_order_relaxed);
+    std::atomic<LatencyHistogram *> &slot = shards_[thread_index % kShards];
+    LatencyHistogram *histogram = slot.load(std::memory_order_acquire);
+    if (histogram == nullptr) {
+      LatencyHistogram *created = new LatencyHistogram();
+      if (slot.compare_exchange_strong(histogram, created, std::memory_order_acq_rel)) {
+        histogram = created;
+      } else {
+        delete created;
+      }
+    }
+    return *histogram;
   }
 };
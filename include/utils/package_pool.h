@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "utils/common.h"
+#include "utils/ring_buffer.h"
+
+constexpr size_t kDefaultPackagePoolCapacity = 256;  // 默认预分配的 Package 数量
+
+// 数据包池统计
+struct PackagePoolStats {
+  uint64_t acquired{0};            // acquire() 总次数
+  uint64_t recycled{0};            // 归还到池中的次数
+  uint64_t package_allocations{0};  // 新建 Package 次数（预分配 + 池空时补充）
+  uint64_t block_allocations{0};    // 控制块未命中内存池、回退到堆上的次数
+  uint64_t discarded{0};           // 池已满、归还时直接释放的次数
+  size_t available{0};             // 当前池中可用数量
+};
+
+/**
+ * @brief shared_ptr 控制块的定长内存池
+ *
+ * 每个 PackagePtr 都需要一个控制块，这里预先分配固定数量的定长块，
+ * 分配/释放通过 MPSC 环形缓冲区完成（分配只在 acquire 线程，释放可在任意线程）。
+ */
+class ControlBlockArena {
+ public:
+  static constexpr size_t kBlockSize = 128;  // 足以容纳带删除器和分配器的控制块
+
+  explicit ControlBlockArena(size_t block_count)
+      : block_count_(round_up_pow2(block_count)),
+        storage_(new Block[block_count_]),
+        free_list_(block_count_) {
+    for (size_t i = 0; i < block_count_; ++i) {
+      free_list_.try_push(static_cast<void*>(&storage_[i]));
+    }
+  }
+
+  ControlBlockArena(const ControlBlockArena&) = delete;
+  ControlBlockArena& operator=(const ControlBlockArena&) = delete;
+
+  void* allocate(size_t size) {
+    void* block = nullptr;
+    if (size <= kBlockSize && free_list_.try_pop(block)) {
+      return block;
+    }
+    fallback_allocations_.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size);
+  }
+
+  void deallocate(void* block) {
+    if (owns(block)) {
+      free_list_.try_push(block);
+    } else {
+      ::operator delete(block);
+    }
+  }
+
+  uint64_t fallback_allocations() const { return fallback_allocations_.load(std::memory_order_relaxed); }
+
+ private:
+  struct alignas(std::max_align_t) Block {
+    unsigned char bytes[kBlockSize];
+  };
+
+  bool owns(const void* block) const {
+    auto* begin = reinterpret_cast<const unsigned char*>(storage_.get());
+    auto* end = begin + block_count_ * sizeof(Block);
+    auto* p = static_cast<const unsigned char*>(block);
+    return p >= begin && p < end;
+  }
+
+  const size_t block_count_;
+  std::unique_ptr<Block[]> storage_;
+  MpscRingBuffer<void*> free_list_;
+  std::atomic<uint64_t> fallback_allocations_{0};
+};
+
+// 供 shared_ptr 使用的控制块分配器。
+// 持有 arena 的 shared_ptr：控制块在最后一个持有者释放时才归还，此时池本身可能已析构
+template <class T>
+struct ControlBlockAllocator {
+  using value_type = T;
+
+  std::shared_ptr<ControlBlockArena> arena;
+
+  explicit ControlBlockAllocator(std::shared_ptr<ControlBlockArena> arena_ptr) : arena(std::move(arena_ptr)) {}
+  template <class U>
+  ControlBlockAllocator(const ControlBlockAllocator<U>& other) : arena(other.arena) {}  // NOLINT
+
+  T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T))); }
+  void deallocate(T* p, size_t) { arena->deallocate(p); }
+
+  template <class U>
+  bool operator==(const ControlBlockAllocator<U>& other) const { return arena == other.arena; }
+  template <class U>
+  bool operator!=(const ControlBlockAllocator<U>& other) const { return arena != other.arena; }
+};
+
+/**
+ * @brief 可回收的 Package 池
+ *
+ * acquire() 返回的 PackagePtr 在最后一个持有者释放时自动归还到池中，
+ * Package 保留其数据表的桶和已有的张量缓冲区，稳态下不再触发堆分配。
+ *
+ * 空闲队列、控制块内存池与统计放在共享状态中，由每个已发出包的删除器和控制块分配器共同持有：
+ * 包可以比 PackagePool（以及持有它的 Source）活得更久，最后一个包释放后共享状态才析构。
+ * 构造时可传入 owner，与共享状态同生命周期，用于保住包内数据引用的外部存储（如试次视图所指的环形缓冲区）。
+ *
+ * 约束：acquire() 只能由单个线程调用（通常是 Source 线程）；归还可在任意线程发生。
+ */
+class PackagePool {
+ public:
+  explicit PackagePool(size_t capacity = kDefaultPackagePoolCapacity, std::shared_ptr<const void> owner = nullptr)
+      : shared_(std::make_shared<Shared>(capacity, std::move(owner))) {}
+
+  PackagePool(const PackagePool&) = delete;
+  PackagePool& operator=(const PackagePool&) = delete;
+
+  // 取出一个 Package；池空时新建一个（计入 package_allocations）
+  PackagePtr acquire() {
+    Package* package = nullptr;
+    if (!shared_->free_list.try_pop(package)) {
+      package = new Package();
+      shared_->package_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    shared_->acquired.fetch_add(1, std::memory_order_relaxed);
+    return PackagePtr(package, Recycler{shared_},
+                      ControlBlockAllocator<Package>(std::shared_ptr<ControlBlockArena>(shared_, &shared_->arena)));
+  }
+
+  size_t available() const { return shared_->free_list.size(); }
+
+  PackagePoolStats stats() const {
+    PackagePoolStats stats;
+    stats.acquired = shared_->acquired.load(std::memory_order_relaxed);
+    stats.recycled = shared_->recycled.load(std::memory_order_relaxed);
+    stats.package_allocations = shared_->package_allocations.load(std::memory_order_relaxed);
+    stats.block_allocations = shared_->arena.fallback_allocations();
+    stats.discarded = shared_->discarded.load(std::memory_order_relaxed);
+    stats.available = available();
+    return stats;
+  }
+
+ private:
+  // 池与已发出的包共享的状态
+  struct Shared {
+    Shared(size_t capacity, std::shared_ptr<const void> owner_ptr)
+        : owner(std::move(owner_ptr)), free_list(capacity * 2), arena(capacity * 2) {
+      for (size_t i = 0; i < capacity; ++i) {
+        free_list.try_push(new Package());
+        package_allocations.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    ~Shared() {
+      Package* package = nullptr;
+      while (free_list.try_pop(package)) {
+        delete package;
+      }
+    }
+
+    void release(Package* package) {
+      package->recycle();
+      if (free_list.try_push(package)) {
+        recycled.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        discarded.fetch_add(1, std::memory_order_relaxed);
+        delete package;
+      }
+    }
+
+    std::shared_ptr<const void> owner;  // 最后析构：包内视图引用的外部存储
+    MpscRingBuffer<Package*> free_list;
+    ControlBlockArena arena;
+
+    std::atomic<uint64_t> acquired{0};
+    std::atomic<uint64_t> recycled{0};
+    std::atomic<uint64_t> package_allocations{0};
+    std::atomic<uint64_t> discarded{0};
+  };
+
+  // 删除器：最后一个持有者释放时把 Package 归还到池中
+  struct Recycler {
+    std::shared_ptr<Shared> shared;
+    void operator()(Package* package) const { shared->release(package); }
+  };
+
+  std::shared_ptr<Shared> shared_;
+};
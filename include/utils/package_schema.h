@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "opencv2/opencv.hpp"
+
+// ==================== Package 数据槽定义 ====================
+//
+// 每个槽位在此声明一次：X(枚举名, 兼容字符串键, 存储类型)。
+// 槽位在编译期解析为整数下标，访问不经过哈希、也不做拷贝；
+// 字符串键只用于旧接口 add_data / get_data 的兼容慢路径。
+//
+//   kRawEeg : 原始 EEG，通道 x 采样点（float）
+//   kEpoch  : 预处理后送入 Runner 的数据，通道 x 采样点（float）
+//   kTrigger: 触发码（刺激类型）
+//   kTriggerOffset: 触发在本包 kRawEeg 中的采样点下标（与 kTrigger 同时写入）
+//   kScore  : 模型输出概率
+//   kLabel  : 模型判决结果（0/1）
+//   kModelsEvaluated : 实际求值的局部子模型数（开启提前退出时小于子模型总数）
+#define RSVP_PACKAGE_SCHEMA(X)                 \
+  X(kRawEeg, "raw_eeg", cv::Mat)               \
+  X(kEpoch, "epoch", cv::Mat)                  \
+  X(kTrigger, "trigger", int)                  \
+  X(kTriggerOffset, "trigger_offset", int)     \
+  X(kScore, "score", float)                    \
+  X(kLabel, "label", int)                      \
+  X(kModelsEvaluated, "models_evaluated", int)
+
+// 触发码（Slot::kTrigger 的取值，与 python/convert_recording.py 一致）
+constexpr int kTriggerTarget = 1;     // 目标刺激（X1 试次）
+constexpr int kTriggerNonTarget = 2;  // 非目标刺激（X2 试次）
+
+// 槽位编号
+enum class Slot : size_t {
+#define RSVP_SLOT_ENUM(id, key, type) id,
+  RSVP_PACKAGE_SCHEMA(RSVP_SLOT_ENUM)
+#undef RSVP_SLOT_ENUM
+  kCount
+};
+
+constexpr size_t kSlotCount = static_cast<size_t>(Slot::kCount);
+static_assert(kSlotCount <= 64, "Slot presence mask holds at most 64 slots");
+
+// 槽位存储：每个槽位一个强类型成员
+struct PackageSlots {
+#define RSVP_SLOT_MEMBER(id, key, type) type id{};
+  RSVP_PACKAGE_SCHEMA(RSVP_SLOT_MEMBER)
+#undef RSVP_SLOT_MEMBER
+};
+
+// 槽位特征：类型、兼容字符串键、成员访问
+template <Slot S>
+struct SlotTraits;
+
+#define RSVP_SLOT_TRAITS(id, key, slot_type)                              \
+  template <>                                                             \
+  struct SlotTraits<Slot::id> {                                           \
+    using type = slot_type;                                               \
+    static constexpr const char* name = key;                              \
+    static type& get(PackageSlots& slots) { return slots.id; }            \
+    static const type& get(const PackageSlots& slots) { return slots.id; } \
+  };
+RSVP_PACKAGE_SCHEMA(RSVP_SLOT_TRAITS)
+#undef RSVP_SLOT_TRAITS
+
+/**
+ * 按字符串键查找槽位（兼容慢路径）
+ * @param key 字符串键
+ * @return 槽位下标，不属于 schema 时返回 -1
+ */
+inline int find_slot(const std::string& key) {
+  static const char* const kNames[] = {
+#define RSVP_SLOT_NAME(id, name, type) name,
+      RSVP_PACKAGE_SCHEMA(RSVP_SLOT_NAME)
+#undef RSVP_SLOT_NAME
+  };
+  for (size_t i = 0; i < kSlotCount; ++i) {
+    if (std::strcmp(kNames[i], key.c_str()) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// 按运行期下标访问槽位成员，f 接收对应类型的引用
+template <class Slots, class F>
+void visit_slot(Slots& slots, size_t index, F&& f) {
+  switch (index) {
+#define RSVP_SLOT_CASE(id, key, type)    \
+  case static_cast<size_t>(Slot::id):    \
+    f(slots.id);                         \
+    return;
+    RSVP_PACKAGE_SCHEMA(RSVP_SLOT_CASE)
+#undef RSVP_SLOT_CASE
+    default:
+      return;
+  }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>  // NOLINT
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RSVP_TRACE_TSC 1
+#endif
+
+/**
+ * @brief 包追踪用的时钟
+ *
+ * x86 上直接读 TSC（不经过 vDSO，单次约十几到二十纳秒），要求处理器支持 constant_tsc；
+ * 其他平台取 steady_clock 纳秒。时间戳只用于求差，汇总时再用 to_ns 换算。
+ */
+struct TraceClock {
+  static int64_t now() {
+#ifdef RSVP_TRACE_TSC
+    return static_cast<int64_t>(__rdtsc());
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+  }
+
+  // 每个计数对应的纳秒数（首次调用时对照 steady_clock 校准约 10ms）
+  static double ns_per_tick() {
+#ifdef RSVP_TRACE_TSC
+    static const double scale = [] {
+      const auto steady_start = std::chrono::steady_clock::now();
+      const int64_t tick_start = now();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      const int64_t ticks = now() - tick_start;
+      const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - steady_start).count();
+      return ticks > 0 ? ns / ticks : 1.0;
+    }();
+    return scale;
+#else
+    return 1.0;
+#endif
+  }
+
+  static int64_t to_ns(int64_t ticks) { return static_cast<int64_t>(ticks * ns_per_tick()); }
+  static int64_t from_ns(int64_t ns) { return static_cast<int64_t>(ns / ns_per_tick()); }
+};
+
+/**
+ * @brief 随 Package 传递的各阶段时间戳（TraceClock 计数，定长，不分配内存）
+ *
+ * 第 i 阶段取到包时记 dequeue[i]，处理完写入下游前记 enqueue[i]：
+ *   第 i 阶段排队时间 = dequeue[i] - enqueue[i-1]
+ *   第 i 阶段处理时间 = enqueue[i] - dequeue[i]
+ * origin 为刺激/采集时刻（Source 可以按 TraceClock 写入设备时间，未写入时取 Source 开始处理的时刻）。
+ * 为 0 的时间戳表示未经过该阶段。超过 kMaxStages 的阶段不记录。
+ */
+struct PackageTrace {
+  static constexpr int kMaxStages = 8;
+
+  int64_t origin;
+  int64_t dequeue[kMaxStages];
+  int64_t enqueue[kMaxStages];
+
+  PackageTrace() { reset(); }
+
+  void reset() { std::memset(this, 0, sizeof(*this)); }
+
+  void mark_dequeue(int stage, int64_t ticks) {
+    if (stage >= 0 && stage < kMaxStages) dequeue[stage] = ticks;
+  }
+
+  void mark_enqueue(int stage, int64_t ticks) {
+    if (stage >= 0 && stage < kMaxStages) enqueue[stage] = ticks;
+  }
+};
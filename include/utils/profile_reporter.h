@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "utils/module_logger.h"
+#include "utils/module_profiler.h"
+#include "utils/shed_stats.h"
+
+/**
+ * @brief 周期性输出各阶段的时延统计
+ *
+ * 每隔 interval 为每个登记的 ModuleProfiler 输出一行摘要：分位数为累计值，rate 为本周期内的吞吐量；
+ * 同时登记了负载削减计数且有过削减时，在行尾追加累计的 late / shed / degraded / dropped。
+ * 只读取统计快照，不影响记录路径。
+ */
+class ProfileReporter {
+ public:
+  using Output = std::function<void(const std::string &)>;
+
+  explicit ProfileReporter(std::chrono::milliseconds interval, Output output = nullptr)
+      : interval_(interval), output_(output ? std::move(output) : [](const std::string &line) {
+          MLOG_INFO("%s", line.c_str());
+        }) {}
+
+  ~ProfileReporter() { stop(); }
+
+  ProfileReporter(const ProfileReporter &) = delete;
+  ProfileReporter &operator=(const ProfileReporter &) = delete;
+
+  // 登记一个阶段（需在 start() 之前调用，profiler 与 shed 的生命周期需长于 reporter）
+  void add(const std::string &name, const ModuleProfiler *profiler, const ShedCounters *shed = nullptr) {
+    stages_.push_back({name, profiler, shed, 0, std::chrono::steady_clock::now()});
+  }
+
+  size_t size() const { return stages_.size(); }
+
+  void start() {
+    if (thread_.joinable()) {
+      return;
+    }
+    stop_ = false;
+    thread_ = std::thread([this] {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!cv_.wait_for(lock, interval_, [this] { return stop_; })) {
+        report_once();
+      }
+    });
+  }
+
+  // 停止周期输出，并输出一次最终统计
+  void stop() {
+    if (!thread_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    report_once();
+  }
+
+  // 立即输出所有阶段
+  void report_once() {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto &stage : stages_) {
+      LatencySnapshot snapshot = stage.profiler->get_profile();
+      const double elapsed = std::chrono::duration<double>(now - stage.last_time).count();
+      const uint64_t delta = snapshot.count >= stage.last_count ? snapshot.count - stage.last_count : snapshot.count;
+      snapshot.throughput = elapsed > 0.0 ? delta / elapsed : 0.0;
+      stage.last_count = snapshot.count;
+      stage.last_time = now;
+      std::string line = snapshot.format(stage.name);
+      if (stage.shed) {
+        const ShedStats shed = stage.shed->snapshot();
+        if (shed.total() > 0) line += shed.format();
+      }
+      output_(line);
+    }
+  }
+
+ private:
+  struct Stage {
+    std::string name;
+    const ModuleProfiler *profiler;
+    const ShedCounters *shed;                         // 可为空
+    uint64_t last_count;                              // 上次输出时的累计次数
+    std::chrono::steady_clock::time_point last_time;  // 上次输出的时刻
+  };
+
+  std::chrono::milliseconds interval_;
+  Output output_;
+  std::vector<Stage> stages_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+};
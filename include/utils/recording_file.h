@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/mapped_file.h"
+
+// ==================== 连续 EEG 录制格式（.rsvpr） ====================
+//
+// 由 python/convert_recording.py 从 X1/X2 试次文件（.npz 或 .mat）离线生成，供 RsvpSource 回放。
+// 运行时 mmap 后直接按行读取，不做解析：
+//
+//   [RecordingHeader][data: float32 n_channels x row_stride，按通道存放][events: RecordingEvent x n_events]
+//
+// 每个通道一行，row_stride >= n_samples（按 16 个 float 对齐），data 与 events 起点按 64 字节对齐，小端存放；
+// crc32 覆盖文件第 16 字节之后的全部内容。事件按采样点升序排列，触发码见 package_schema.h。
+
+constexpr char kRecordingMagic[8] = {'R', 'S', 'V', 'P', 'R', 'E', 'C', '1'};
+constexpr uint32_t kRecordingVersion = 1;
+
+struct RecordingHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t crc32;  // 文件 [16, file_size) 的 CRC-32
+  uint64_t file_size;
+  uint32_t header_size;
+  uint32_t flags;
+  int32_t n_channels;
+  int32_t reserved;
+  double fs;              // 采样率（Hz）
+  uint64_t n_samples;     // 每个通道的采样点数
+  uint64_t row_stride;    // 相邻两个通道的间距（float 个数）
+  uint64_t data_offset;   // 字节，相对文件起点
+  uint64_t n_events;
+  uint64_t events_offset;  // 字节，相对文件起点
+};
+
+static_assert(sizeof(RecordingHeader) == 88, "RecordingHeader layout changed, bump kRecordingVersion");
+
+// 触发事件：第 sample 个采样点上出现触发码 code
+struct RecordingEvent {
+  int64_t sample;
+  int32_t code;
+  int32_t reserved;
+};
+
+static_assert(sizeof(RecordingEvent) == 16, "RecordingEvent layout changed, bump kRecordingVersion");
+
+/**
+ * 写入录制文件
+ * @param path 输出路径（先写 path.tmp 再原子 rename）
+ * @param fs 采样率
+ * @param n_channels 通道数
+ * @param n_samples 每个通道的采样点数
+ * @param data 按通道存放的数据，第 c 个通道从 data + c * n_samples 开始
+ * @param events 触发事件（写入前按采样点排序，超出数据范围时抛出 std::invalid_argument）
+ */
+void save_recording(const std::string& path, double fs, int n_channels, size_t n_samples, const float* data,
+                    std::vector<RecordingEvent> events);
+
+/**
+ * @brief 只读映射的录制文件
+ *
+ * 数据与事件直接指向映射内存，在对象销毁前一直有效。
+ */
+class RecordingFile {
+ public:
+  /**
+   * 映射并校验录制文件
+   * @param path 文件路径
+   * @param populate 是否在映射时预读全部页面（回放测吞吐时避免缺页；文件很大时可关闭）
+   * @param verify 是否校验 CRC（需要完整读一遍文件）
+   * 格式、版本、校验和或各段范围不符时抛出 std::runtime_error
+   */
+  explicit RecordingFile(const std::string& path, bool populate = true, bool verify = true);
+
+  int n_channels() const { return header_.n_channels; }
+  double fs() const { return header_.fs; }
+  size_t n_samples() const { return static_cast<size_t>(header_.n_samples); }
+  size_t row_stride() const { return static_cast<size_t>(header_.row_stride); }
+
+  // 第 channel 个通道的第 0 个采样点，相邻通道间隔 row_stride() 个 float
+  const float* data() const { return data_; }
+  const float* row(int channel) const { return data_ + static_cast<size_t>(channel) * header_.row_stride; }
+
+  const RecordingEvent* events() const { return events_; }
+  size_t n_events() const { return static_cast<size_t>(header_.n_events); }
+
+  // 第一个 sample >= 给定采样点的事件下标（没有时返回 n_events()）
+  size_t lower_event(size_t sample) const;
+
+  const std::string& path() const { return file_.path(); }
+
+ private:
+  MappedFile file_;
+  RecordingHeader header_{};
+  const float* data_{nullptr};
+  const RecordingEvent* events_{nullptr};
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "utils/ring_buffer.h"
+
+// 插入结果
+enum class ReorderStatus {
+  kAccepted,     // 已放入窗口
+  kLate,         // 序号小于下一个待释放的序号（已释放或已被跳过），应丢弃
+  kDuplicate,    // 窗口中已有相同序号
+  kOutOfWindow,  // 序号超出窗口，需先 skip_gap() 腾出位置
+};
+
+/**
+ * @brief 按序号重排的定长窗口
+ *
+ * 序号在 [next, next + capacity) 内的元素放在 seq & (capacity - 1) 号槽位，插入、查找、释放均为 O(1)。
+ * 元素只能按序号连续地从头部释放；头部缺失（上游丢包）时由调用方决定何时 skip_gap() 放弃等待。
+ * 非线程安全，只在一个线程中使用。
+ */
+template <class T>
+class ReorderBuffer {
+ public:
+  /**
+   * @param capacity 窗口大小（向上取整到 2 的幂，至少为 2）
+   * @param first_sequence 第一个待释放的序号
+   */
+  explicit ReorderBuffer(size_t capacity, uint64_t first_sequence = 0)
+      : capacity_(round_up_pow2(capacity)),
+        mask_(capacity_ - 1),
+        slots_(new Slot[capacity_]),
+        next_(first_sequence) {
+    if (capacity == 0) {
+      throw std::invalid_argument("ReorderBuffer capacity must be positive");
+    }
+  }
+
+  ReorderBuffer(const ReorderBuffer&) = delete;
+  ReorderBuffer& operator=(const ReorderBuffer&) = delete;
+
+  ReorderStatus insert(uint64_t sequence, T value) {
+    if (sequence < next_) {
+      return ReorderStatus::kLate;
+    }
+    if (sequence - next_ >= capacity_) {
+      return ReorderStatus::kOutOfWindow;
+    }
+    Slot& slot = slots_[sequence & mask_];
+    if (slot.occupied) {
+      return ReorderStatus::kDuplicate;
+    }
+    slot.value = std::move(value);
+    slot.occupied = true;
+    ++pending_;
+    return ReorderStatus::kAccepted;
+  }
+
+  // 头部元素已到达时取出并前移窗口
+  bool pop_ready(T& value) {
+    Slot& slot = slots_[next_ & mask_];
+    if (!slot.occupied) {
+      return false;
+    }
+    value = std::move(slot.value);
+    slot.value = T();
+    slot.occupied = false;
+    --pending_;
+    ++next_;
+    return true;
+  }
+
+  // 放弃等待头部缺失的序号：窗口前移到最早的已到达元素，返回跳过的序号数（窗口为空时不动）
+  size_t skip_gap() {
+    if (pending_ == 0) {
+      return 0;
+    }
+    size_t skipped = 0;
+    while (!slots_[next_ & mask_].occupied) {
+      ++next_;
+      ++skipped;
+    }
+    return skipped;
+  }
+
+  // 窗口为空时把下一个待释放的序号前移到 sequence，返回跳过的序号数（窗口非空或 sequence 更小时不动）
+  size_t advance_to(uint64_t sequence) {
+    if (pending_ > 0 || sequence <= next_) {
+      return 0;
+    }
+    size_t skipped = static_cast<size_t>(sequence - next_);
+    next_ = sequence;
+    return skipped;
+  }
+
+  // 窗口中序号为 sequence 的元素，不存在时返回 nullptr
+  T* find(uint64_t sequence) {
+    if (sequence < next_ || sequence - next_ >= capacity_) {
+      return nullptr;
+    }
+    Slot& slot = slots_[sequence & mask_];
+    return slot.occupied ? &slot.value : nullptr;
+  }
+
+  // 序号是否落在当前窗口内
+  bool in_window(uint64_t sequence) const { return sequence >= next_ && sequence - next_ < capacity_; }
+
+  // 头部是否缺失（有元素在等待更早的序号）
+  bool head_missing() const { return pending_ > 0 && !slots_[next_ & mask_].occupied; }
+
+  uint64_t next_sequence() const { return next_; }
+  size_t pending() const { return pending_; }
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct Slot {
+    T value{};
+    bool occupied{false};
+  };
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  uint64_t next_;
+  size_t pending_{0};
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// ==================== 无锁有界环形缓冲区 ====================
+//
+// SpscRingBuffer: 单生产者/单消费者，head/tail 各占一个缓存行，并缓存对端索引，
+//                 稳态下每次 push/pop 只有一次 release store，无 CAS。
+// MpscRingBuffer: 多生产者/单消费者（Vyukov 有界队列），生产者通过 CAS 抢占槽位，
+//                 每个槽位带序号，消费者无需 CAS，用于扇入（fan-in）场景。
+//
+// 容量在构造时确定并向上取整到 2 的幂，运行期间不再分配内存。
+
+constexpr size_t kCacheLineSize = 64;  // 缓存行大小（x86 / ARMv8 均为 64 字节）
+
+/**
+ * 向上取整到 2 的幂（至少为 2）
+ * @param n 期望容量
+ * @return 不小于 n 的最小 2 的幂
+ */
+inline size_t round_up_pow2(size_t n) {
+  size_t capacity = 2;
+  while (capacity < n) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+// 单生产者/单消费者环形缓冲区
+template <class T>
+class SpscRingBuffer {
+ public:
+  explicit SpscRingBuffer(size_t capacity)
+      : capacity_(round_up_pow2(capacity)), mask_(capacity_ - 1), slots_(new T[capacity_]) {}
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  // 尝试写入，缓冲区满时返回 false（仅生产者线程调用）
+  template <class U>
+  bool try_push(U&& value) {
+    const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+    if (tail - producer_.cached_head >= capacity_) {
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      if (tail - producer_.cached_head >= capacity_) {
+        return false;
+      }
+    }
+    slots_[tail & mask_] = std::forward<U>(value);
+    producer_.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 尝试读取，缓冲区空时返回 false（仅消费者线程调用）
+  bool try_pop(T& value) {
+    const size_t head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.cached_tail) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.cached_tail) {
+        return false;
+      }
+    }
+    value = std::move(slots_[head & mask_]);
+    consumer_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 近似元素个数（任意线程可调用）
+  size_t size() const {
+    const size_t head = consumer_.head.load(std::memory_order_acquire);
+    const size_t tail = producer_.tail.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct alignas(kCacheLineSize) ProducerSide {
+    std::atomic<size_t> tail{0};  // 下一个写入位置
+    size_t cached_head{0};        // 生产者缓存的消费者位置
+  };
+  struct alignas(kCacheLineSize) ConsumerSide {
+    std::atomic<size_t> head{0};  // 下一个读取位置
+    size_t cached_tail{0};        // 消费者缓存的生产者位置
+  };
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<T[]> slots_;
+
+  ProducerSide producer_;
+  ConsumerSide consumer_;
+};
+
+// 多生产者/单消费者环形缓冲区
+template <class T>
+class MpscRingBuffer {
+ public:
+  explicit MpscRingBuffer(size_t capacity)
+      : capacity_(round_up_pow2(capacity)), mask_(capacity_ - 1), slots_(new Slot[capacity_]) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRingBuffer(const MpscRingBuffer&) = delete;
+  MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+  // 尝试写入，缓冲区满时返回 false（任意生产者线程调用）
+  template <class U>
+  bool try_push(U&& value) {
+    size_t pos = tail_.value.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      const size_t seq = slot->sequence.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // 槽位尚未被消费者释放：缓冲区满
+      } else {
+        pos = tail_.value.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::forward<U>(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 尝试读取，缓冲区空时返回 false（仅消费者线程调用）
+  bool try_pop(T& value) {
+    const size_t pos = head_.value.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+      return false;
+    }
+    value = std::move(slot.value);
+    slot.sequence.store(pos + capacity_, std::memory_order_release);
+    head_.value.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 近似元素个数（任意线程可调用）
+  size_t size() const {
+    const size_t head = head_.value.load(std::memory_order_acquire);
+    const size_t tail = tail_.value.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct alignas(kCacheLineSize) Slot {
+    std::atomic<size_t> sequence{0};  // 槽位序号，用于区分空/满
+    T value{};
+  };
+  struct alignas(kCacheLineSize) PaddedIndex {
+    std::atomic<size_t> value{0};
+  };
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+
+  PaddedIndex tail_;  // 生产者共享的写入位置
+  PaddedIndex head_;  // 消费者独占的读取位置
+};
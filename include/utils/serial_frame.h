@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "utils/checksum.h"
+
+// ==================== 串口采样帧 ====================
+//
+// 串口放大器每个采样点发一帧（参照 ADS1299 类放大器的输出：24 位大端补码，各通道依次排列），帧长固定：
+//
+//   [0xA5 0x5A][counter: u8][trigger: u8][n_channels x int24 大端][crc32: u32 小端]
+//
+// counter 每帧加 1（回绕），用于检测丢帧；trigger 为触发线的电平（0 表示无触发，非零值保持到下一次变化）；
+// crc32 覆盖 counter 到最后一个通道（见 checksum.h）。同步字只用于在字节流中定位帧起点，以 CRC 为准。
+
+constexpr unsigned char kSerialSync0 = 0xA5;
+constexpr unsigned char kSerialSync1 = 0x5A;
+constexpr size_t kSerialHeaderBytes = 4;  // 同步字 + counter + trigger
+
+// 帧的总字节数
+inline size_t serial_frame_bytes(int n_channels) {
+  return kSerialHeaderBytes + static_cast<size_t>(n_channels) * 3 + sizeof(uint32_t);
+}
+
+// 帧是否完整有效：同步字匹配且 CRC 正确（frame 至少有 serial_frame_bytes(n_channels) 字节）
+inline bool serial_frame_valid(const unsigned char* frame, int n_channels) {
+  if (frame[0] != kSerialSync0 || frame[1] != kSerialSync1) {
+    return false;
+  }
+  const size_t body = serial_frame_bytes(n_channels) - sizeof(uint32_t) - 2;
+  uint32_t crc;
+  std::memcpy(&crc, frame + 2 + body, sizeof(crc));
+  return crc32(frame + 2, body) == crc;
+}
+
+// 第 channel 个通道的原始计数（24 位补码符号扩展）
+inline int32_t serial_frame_count(const unsigned char* frame, int channel) {
+  const unsigned char* p = frame + kSerialHeaderBytes + static_cast<size_t>(channel) * 3;
+  const uint32_t value = (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+  return static_cast<int32_t>(value << 8) >> 8;
+}
+
+/**
+ * 编码一帧
+ * @param frame 输出，至少 serial_frame_bytes(n_channels) 字节
+ * @param counter 帧计数
+ * @param trigger 触发线电平
+ * @param counts 各通道的原始计数（截断到 24 位）
+ * @param n_channels 通道数
+ */
+inline void encode_serial_frame(unsigned char* frame, uint8_t counter, uint8_t trigger, const int32_t* counts,
+                                int n_channels) {
+  frame[0] = kSerialSync0;
+  frame[1] = kSerialSync1;
+  frame[2] = counter;
+  frame[3] = trigger;
+  for (int c = 0; c < n_channels; ++c) {
+    const uint32_t value = static_cast<uint32_t>(counts[c]);
+    unsigned char* p = frame + kSerialHeaderBytes + static_cast<size_t>(c) * 3;
+    p[0] = static_cast<unsigned char>(value >> 16);
+    p[1] = static_cast<unsigned char>(value >> 8);
+    p[2] = static_cast<unsigned char>(value);
+  }
+  const size_t body = serial_frame_bytes(n_channels) - sizeof(uint32_t) - 2;
+  const uint32_t crc = crc32(frame + 2, body);
+  std::memcpy(frame + 2 + body, &crc, sizeof(crc));
+}
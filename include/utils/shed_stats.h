@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// 一个阶段的负载削减统计（见 framework/deadline.h）
+struct ShedStats {
+  uint64_t late{0};      // 取到时已过截止时刻、仍照常处理的包
+  uint64_t shed{0};      // 本阶段因过期而跳过 process() 的包（之后各阶段直接转发）
+  uint64_t degraded{0};  // 过期后按降级方式处理的包
+  uint64_t dropped{0};   // Source 在下游积压时直接丢弃的新包（不占用序号）
+
+  uint64_t total() const { return late + shed + degraded + dropped; }
+
+  // 追加在时延摘要之后的一段，例如 " late=3 shed=12 degraded=0 dropped=0"
+  std::string format() const {
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), " late=%llu shed=%llu degraded=%llu dropped=%llu",
+             static_cast<unsigned long long>(late), static_cast<unsigned long long>(shed),
+             static_cast<unsigned long long>(degraded), static_cast<unsigned long long>(dropped));
+    return std::string(buffer);
+  }
+};
+
+/**
+ * @brief 负载削减计数（relaxed 原子量：阶段线程写入，其他线程随时读取快照）
+ */
+class ShedCounters {
+ public:
+  void add_late() { late_.fetch_add(1, std::memory_order_relaxed); }
+  void add_shed() { shed_.fetch_add(1, std::memory_order_relaxed); }
+  void add_degraded() { degraded_.fetch_add(1, std::memory_order_relaxed); }
+  void add_dropped() { dropped_.fetch_add(1, std::memory_order_relaxed); }
+
+  ShedStats snapshot() const {
+    ShedStats stats;
+    stats.late = late_.load(std::memory_order_relaxed);
+    stats.shed = shed_.load(std::memory_order_relaxed);
+    stats.degraded = degraded_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  std::atomic<uint64_t> late_{0}, shed_{0}, degraded_{0}, dropped_{0};
+};
@@ -0,0 +1,34 @@
+"""
+测量原 NumPy 预处理路径的耗时，与 tests/benchmark/bench_decimator.cpp 对照
+
+路径与 EEGPreprocess.forward 相同：np.delete 去掉 [32, 42, 59, 63] -> filtfilt 带通 -> x[:, ::4] 抽取
+用法：python bench_preprocess_numpy.py [iterations]
+"""
+import sys
+import time
+
+import numpy as np
+
+from eeg_preprocess import EEGPreprocess
+
+
+def main(iterations=200):
+    rng = np.random.default_rng(1)
+    x = rng.standard_normal((64, 1000)) * 10
+    preprocess = EEGPreprocess(fs=1000, low_cut=0.5, high_cut=49, filter_order=4)
+
+    def run_once():
+        y = np.delete(x, [32, 42, 59, 63], axis=0)
+        y = preprocess.filtering(y)
+        return np.ascontiguousarray(y[:, ::4])
+
+    run_once()
+    start = time.perf_counter()
+    for _ in range(iterations):
+        run_once()
+    elapsed_us = (time.perf_counter() - start) / iterations * 1e6
+    print('numpy    %10.1f us/block %10.1f Msamples/s' % (elapsed_us, x.size / elapsed_us))
+
+
+if __name__ == "__main__":
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 200)
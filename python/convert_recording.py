@@ -0,0 +1,116 @@
+"""
+把 X1/X2 试次文件转换为连续 EEG 录制文件（.rsvpr），供 RsvpSource 回放（格式见 include/utils/recording_file.h）
+
+用法：python convert_recording.py <input.npz|input.mat> <output.rsvpr> [fs] [trigger_offset] [seed]
+  input       .npz（np.load）或 .mat（v7.3，h5py 读取后转置，与 UI_XGBDIM_cpu.read_data 相同），
+              X1 为目标试次、X2 为非目标试次，形状 通道 x 采样点 x trial
+  fs          采样率，默认 1000
+  trigger_offset  刺激在每个试次内的采样点下标，默认 0
+  seed        试次顺序的随机种子，默认 0；为 -1 时按 X1 全部在前、X2 在后的原始顺序拼接
+
+试次按打乱后的顺序首尾拼接成一段连续记录，每个试次在 trigger_offset 处写一个触发：
+目标为 1（kTriggerTarget），非目标为 2（kTriggerNonTarget）。
+"""
+import struct
+import sys
+import zlib
+
+import numpy as np
+
+MAGIC = b'RSVPREC1'
+VERSION = 1
+HEADER_FORMAT = '<8sIIQIIiidQQQQQ'  # 与 RecordingHeader 一致（88 字节）
+EVENT_FORMAT = '<qii'               # 与 RecordingEvent 一致（16 字节）
+CRC_OFFSET = 16
+ALIGNMENT = 64
+ROW_ALIGNMENT = 16
+TRIGGER_TARGET = 1
+TRIGGER_NON_TARGET = 2
+
+
+def align_up(value, alignment=ALIGNMENT):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def load_trials(path):
+    if path.endswith('.mat'):
+        import h5py
+        with h5py.File(path, 'r') as data:
+            return np.transpose(data['X1']), np.transpose(data['X2'])
+    data = np.load(path)
+    return data['X1'], data['X2']
+
+
+def concatenate_trials(X1, X2, trigger_offset=0, seed=0):
+    """按试次顺序拼接，返回 (通道 x 采样点 的 float32 数据, [(sample, code), ...])"""
+    if X1.shape[:2] != X2.shape[:2]:
+        raise ValueError('X1 and X2 must have the same channels and trial length')
+    n_channels, trial_len = X1.shape[0], X1.shape[1]
+    if not 0 <= trigger_offset < trial_len:
+        raise ValueError('trigger_offset must be inside a trial')
+
+    trials = [(X1, k, TRIGGER_TARGET) for k in range(X1.shape[2])] + \
+             [(X2, k, TRIGGER_NON_TARGET) for k in range(X2.shape[2])]
+    if seed >= 0:
+        order = np.random.RandomState(seed).permutation(len(trials))
+        trials = [trials[i] for i in order]
+
+    data = np.empty((n_channels, trial_len * len(trials)), dtype=np.float32)
+    events = []
+    for index, (X, k, code) in enumerate(trials):
+        start = index * trial_len
+        data[:, start:start + trial_len] = X[:, :, k]
+        events.append((start + trigger_offset, code))
+    return data, events
+
+
+def write_recording(path, data, events, fs):
+    """写入 .rsvpr（与 save_recording 的布局和校验和一致）"""
+    data = np.ascontiguousarray(data, dtype='<f4')
+    n_channels, n_samples = data.shape
+    events = sorted(events, key=lambda event: event[0])
+    for sample, _ in events:
+        if not 0 <= sample < n_samples:
+            raise ValueError('event at sample %d is outside the recording' % sample)
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    row_stride = align_up(n_samples, ROW_ALIGNMENT)
+    data_offset = align_up(header_size)
+    events_offset = align_up(data_offset + n_channels * row_stride * 4)
+    file_size = align_up(events_offset + len(events) * struct.calcsize(EVENT_FORMAT))
+
+    buffer = bytearray(file_size)
+    padded = np.zeros((n_channels, row_stride), dtype='<f4')
+    padded[:, :n_samples] = data
+    buffer[data_offset:data_offset + padded.nbytes] = padded.tobytes()
+    offset = events_offset
+    for sample, code in events:
+        struct.pack_into(EVENT_FORMAT, buffer, offset, int(sample), int(code), 0)
+        offset += struct.calcsize(EVENT_FORMAT)
+
+    def pack_header(crc):
+        struct.pack_into(HEADER_FORMAT, buffer, 0, MAGIC, VERSION, crc, file_size, header_size, 0,
+                         n_channels, 0, float(fs), n_samples, row_stride, data_offset, len(events), events_offset)
+
+    pack_header(0)
+    pack_header(zlib.crc32(bytes(buffer[CRC_OFFSET:])) & 0xFFFFFFFF)
+    with open(path, 'wb') as f:
+        f.write(buffer)
+
+
+def convert(input_path, output_path, fs=1000.0, trigger_offset=0, seed=0):
+    X1, X2 = load_trials(input_path)
+    data, events = concatenate_trials(X1, X2, trigger_offset, seed)
+    write_recording(output_path, data, events, fs)
+    print('wrote %d channels x %d samples (%.1f s at %g Hz), %d targets, %d non-targets to %s' %
+          (data.shape[0], data.shape[1], data.shape[1] / fs, fs, X1.shape[2], X2.shape[2], output_path))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+    convert(sys.argv[1], sys.argv[2],
+            float(sys.argv[3]) if len(sys.argv) > 3 else 1000.0,
+            int(sys.argv[4]) if len(sys.argv) > 4 else 0,
+            int(sys.argv[5]) if len(sys.argv) > 5 else 0)
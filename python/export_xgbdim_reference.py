@@ -0,0 +1,47 @@
+"""
+导出 XGBDIM.predict_ZT206_HYX 的逐 trial 输出，供 src/tools/xgbdim_verify.cpp 核对原生推理引擎
+
+用法：python export_xgbdim_reference.py <data.npz> <model.npz> <reference.npz>
+"""
+import sys
+
+import numpy as np
+
+from UI_XGBDIM_cpu import XGBDIM
+
+
+def export_reference(data_path, model_path, output_path):
+    data = np.load(data_path)
+    X1 = data['X1'].astype(np.float64)
+
+    # 与 ZT206_HYX_prog_CPU 相同的超参数
+    xgb = XGBDIM('./', 1, np.array([1]), np.array([2, 3, 4]),
+                 './', model_path, X1, None,
+                 50, 6, 3, 3, 3, 3,
+                 0.5, 0.05, 100, 20, 1, 1, 299, 0.3,
+                 True, 30, False, False)
+    xgb.load_model()
+    xgb.get_3Dconv()
+
+    # 与 predict_ZT206_HYX 相同的步骤，保留 decision_value 返回的 s 和 h
+    K1 = X1.shape[2]
+    X1 = xgb.preprocess_ZT206_HYX(X1.copy(), K1)
+    X_test = xgb.get_3D_cuboids_ZT206_HYX(X1, K1)[:, :, xgb.I_sort[:xgb.N_model]]
+    X_global_BN = xgb.batchnormalize_global(X1, xgb.Gamma_global, xgb.Beta_global,
+                                            xgb.M_global, xgb.Sigma_global)
+    X_minibatch_BN = np.zeros((K1, xgb.T_local, xgb.N_model - 1))
+    for idx_conv in range(xgb.N_model - 1):
+        X_minibatch_BN[:, :, idx_conv] = xgb.batchnormalize(X_test[:, :, idx_conv],
+                                                            xgb.Gamma[idx_conv], xgb.Beta[idx_conv],
+                                                            xgb.M_local[idx_conv, :], xgb.Sigma[idx_conv, :])
+    s, h = xgb.decision_value(X_minibatch_BN, X_global_BN, xgb.N_model, K1)
+
+    np.savez(output_path, score=s[:, 0], decision=h[:, 0])
+    print('exported %d trials to %s' % (K1, output_path))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4:
+        print(__doc__)
+        sys.exit(1)
+    export_reference(sys.argv[1], sys.argv[2], sys.argv[3])
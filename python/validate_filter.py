@@ -0,0 +1,45 @@
+"""
+为 C++ 流式滤波器生成 SciPy 参考结果，配合 src/tools/filter_verify.cpp 使用
+
+用法：python validate_filter.py <data.npz> <key> <reference.npz> [fs] [low_cut] [high_cut] [order]
+  data.npz[key] 为 通道 x 采样点 的连续记录（三维 通道 x 采样点 x trial 时按 trial 首尾拼接）
+
+输出 reference.npz：
+  x         float32 输入（C++ 端直接使用，保证两边输入一致）
+  sos       scipy.signal.butter(..., output='sos')
+  causal    sosfilt 的因果滤波结果（对应 SosFilterBank）
+  filtfilt  与 eeg_preprocess.py 相同的 filtfilt 零相位结果（对应 ZeroPhaseFilterBank）
+  params    [fs, low_cut, high_cut, order]
+"""
+import sys
+
+import numpy as np
+from scipy.signal import butter, filtfilt, sosfilt
+
+
+def make_reference(data_path, key, output_path, fs=1000.0, low_cut=0.5, high_cut=49.0, order=4):
+    x = np.load(data_path)[key]
+    if x.ndim == 3:
+        x = np.concatenate([x[:, :, k] for k in range(x.shape[2])], axis=1)
+    x = x.astype(np.float32)
+    xd = x.astype(np.float64)
+
+    nyquist = 0.5 * fs
+    sos = butter(order, [low_cut / nyquist, high_cut / nyquist], btype='band', output='sos')
+    b, a = butter(order, [low_cut / nyquist, high_cut / nyquist], btype='band')
+
+    np.savez(output_path, x=x, sos=sos,
+             causal=sosfilt(sos, xd, axis=-1),
+             filtfilt=filtfilt(b, a, xd, axis=-1),
+             params=np.array([fs, low_cut, high_cut, order], dtype=np.float64))
+    print('reference for %d channels x %d samples written to %s' % (x.shape[0], x.shape[1], output_path))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 4:
+        print(__doc__)
+        sys.exit(1)
+    extra = [float(v) for v in sys.argv[4:8]]
+    if len(extra) == 4:
+        extra[3] = int(extra[3])
+    make_reference(sys.argv[1], sys.argv[2], sys.argv[3], *extra)
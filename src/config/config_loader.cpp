@@ -0,0 +1,14 @@
+#include <fstream>
+#include <sstream>
+
+#include "utils/config.h"
+
+ConfigNode load_config(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open config file: " + path);
+  }
+  std::ostringstream oss;
+  oss << file.rdbuf();
+  return parse_config(oss.str());
+}
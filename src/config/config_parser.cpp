@@ -0,0 +1,176 @@
+#include <cctype>
+#include <cstdlib>
+
+#include "utils/config.h"
+
+namespace {
+
+// 递归下降 JSON 解析器
+class ConfigParser {
+ public:
+  explicit ConfigParser(const std::string& text) : text_(text) {}
+
+  ConfigNode parse() {
+    ConfigNode root = parse_value();
+    skip_whitespace();
+    if (pos_ != text_.size()) {
+      fail("Unexpected trailing characters");
+    }
+    return root;
+  }
+
+ private:
+  const std::string& text_;
+  size_t pos_{0};
+
+  [[noreturn]] void fail(const std::string& message) const {
+    throw std::runtime_error("Config parse error at offset " + std::to_string(pos_) + ": " + message);
+  }
+
+  void skip_whitespace() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  char peek() {
+    skip_whitespace();
+    if (pos_ >= text_.size()) {
+      fail("Unexpected end of input");
+    }
+    return text_[pos_];
+  }
+
+  void expect(char c) {
+    if (peek() != c) {
+      fail(std::string("Expected '") + c + "'");
+    }
+    ++pos_;
+  }
+
+  bool consume_literal(const char* literal) {
+    size_t len = std::char_traits<char>::length(literal);
+    if (text_.compare(pos_, len, literal) == 0) {
+      pos_ += len;
+      return true;
+    }
+    return false;
+  }
+
+  ConfigNode parse_value() {
+    char c = peek();
+    if (c == '{') return parse_object();
+    if (c == '[') return parse_array();
+    if (c == '"') return ConfigNode(parse_string());
+    if (consume_literal("true")) return ConfigNode(true);
+    if (consume_literal("false")) return ConfigNode(false);
+    if (consume_literal("null")) return ConfigNode();
+    return parse_number();
+  }
+
+  ConfigNode parse_object() {
+    ConfigNode node = ConfigNode::make_object();
+    expect('{');
+    if (peek() == '}') {
+      ++pos_;
+      return node;
+    }
+    for (;;) {
+      if (peek() != '"') {
+        fail("Expected object key");
+      }
+      std::string key = parse_string();
+      expect(':');
+      node.set(key, parse_value());
+      if (peek() == ',') {
+        ++pos_;
+        continue;
+      }
+      expect('}');
+      return node;
+    }
+  }
+
+  ConfigNode parse_array() {
+    ConfigNode node = ConfigNode::make_array();
+    expect('[');
+    if (peek() == ']') {
+      ++pos_;
+      return node;
+    }
+    for (;;) {
+      node.push_back(parse_value());
+      if (peek() == ',') {
+        ++pos_;
+        continue;
+      }
+      expect(']');
+      return node;
+    }
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string value;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c == '\\') {
+        if (pos_ >= text_.size()) {
+          fail("Unterminated escape");
+        }
+        char e = text_[pos_++];
+        switch (e) {
+          case 'n': value += '\n'; break;
+          case 't': value += '\t'; break;
+          case 'r': value += '\r'; break;
+          case 'b': value += '\b'; break;
+          case 'f': value += '\f'; break;
+          case 'u': {
+            if (pos_ + 4 > text_.size()) {
+              fail("Bad unicode escape");
+            }
+            unsigned code = std::strtoul(text_.substr(pos_, 4).c_str(), nullptr, 16);
+            pos_ += 4;
+            // 配置文件只需要 ASCII / BMP，按 UTF-8 编码
+            if (code < 0x80) {
+              value += static_cast<char>(code);
+            } else if (code < 0x800) {
+              value += static_cast<char>(0xC0 | (code >> 6));
+              value += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+              value += static_cast<char>(0xE0 | (code >> 12));
+              value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+              value += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            break;
+          }
+          default: value += e; break;
+        }
+      } else {
+        value += c;
+      }
+    }
+    if (pos_ >= text_.size()) {
+      fail("Unterminated string");
+    }
+    ++pos_;  // 跳过结尾引号
+    return value;
+  }
+
+  ConfigNode parse_number() {
+    const char* begin = text_.c_str() + pos_;
+    char* end = nullptr;
+    double value = std::strtod(begin, &end);
+    if (end == begin) {
+      fail("Invalid value");
+    }
+    pos_ += static_cast<size_t>(end - begin);
+    return ConfigNode(value);
+  }
+};
+
+}  // namespace
+
+ConfigNode parse_config(const std::string& text) {
+  return ConfigParser(text).parse();
+}
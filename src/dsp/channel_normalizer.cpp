@@ -0,0 +1,155 @@
+#include "dsp/channel_normalizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr size_t kChannelLanes = 8;  // 与 SosCascade 的通道填充粒度一致
+
+size_t pad_channels(int n_channels) {
+  return (static_cast<size_t>(n_channels) + kChannelLanes - 1) / kChannelLanes * kChannelLanes;
+}
+
+}  // namespace
+
+NormalizerConfig NormalizerConfig::from_config(const ConfigNode& node) {
+  NormalizerConfig config;
+  config.scale = node.get_bool("scale", config.scale);
+  config.window = node.get_double("window", config.window);
+  config.min_std = node.get_double("min_std", config.min_std);
+  config.fs = node.get_double("fs", config.fs);
+
+  std::string mode = node.get_string("mode", "none");
+  if (mode == "none") {
+    config.mode = Mode::kNone;
+  } else if (mode == "epoch") {
+    config.mode = Mode::kEpoch;
+  } else if (mode == "running") {
+    config.mode = Mode::kRunning;
+  } else {
+    throw std::runtime_error("Unknown normalization mode: " + mode);
+  }
+  return config;
+}
+
+ChannelNormalizer::ChannelNormalizer(const NormalizerConfig& config, int n_channels)
+    : config_(config), n_channels_(n_channels), padded_channels_(pad_channels(n_channels)) {
+  if (n_channels_ <= 0 || !(config_.min_std >= 0.0)) {
+    throw std::invalid_argument("ChannelNormalizer needs at least one channel and min_std >= 0");
+  }
+  if (config_.mode == NormalizerConfig::Mode::kRunning && !(config_.window * config_.fs >= 1.0)) {
+    throw std::invalid_argument("ChannelNormalizer: running window must cover at least one sample");
+  }
+  window_samples_ = static_cast<size_t>(std::max(1.0, config_.window * config_.fs));
+  shift_.resize(padded_channels_);
+  sum_.resize(padded_channels_);
+  sum_sq_.resize(padded_channels_);
+  mean_.resize(padded_channels_);
+  var_.resize(padded_channels_);
+  gain_.resize(padded_channels_);
+}
+
+double ChannelNormalizer::stddev(int c) const { return std::sqrt(var_[c]); }
+
+void ChannelNormalizer::accumulate(double* block, size_t stride, size_t n_samples) {
+  if (config_.mode == NormalizerConfig::Mode::kEpoch) {
+    accumulate_epoch(block, stride, n_samples);
+  } else if (config_.mode == NormalizerConfig::Mode::kRunning) {
+    accumulate_running(block, stride, n_samples);
+  }
+}
+
+void ChannelNormalizer::accumulate_epoch(const double* block, size_t stride, size_t n_samples) {
+  if (n_samples == 0) {
+    return;
+  }
+  const size_t channels = padded_channels_;
+  double* __restrict shift = shift_.data();
+  double* __restrict sum = sum_.data();
+  double* __restrict sum_sq = sum_sq_.data();
+  // 以本段第一个采样点为偏移，避免直流分量较大时 E[x^2] - E[x]^2 的相消误差
+  if (seen_ == 0) {
+    std::copy(block, block + channels, shift);
+    std::fill(sum, sum + channels, 0.0);
+    std::fill(sum_sq, sum_sq + channels, 0.0);
+  }
+  for (size_t t = 0; t < n_samples; ++t) {
+    const double* __restrict x = block + t * stride;
+    for (size_t c = 0; c < channels; ++c) {
+      double d = x[c] - shift[c];
+      sum[c] += d;
+      sum_sq[c] += d * d;
+    }
+  }
+  seen_ += n_samples;
+}
+
+void ChannelNormalizer::accumulate_running(double* block, size_t stride, size_t n_samples) {
+  const size_t channels = padded_channels_;
+  const double min_var = config_.min_std * config_.min_std;
+  const bool scale = config_.scale;
+  double* __restrict mean = mean_.data();
+  double* __restrict var = var_.data();
+  double* __restrict gain = gain_.data();
+  for (size_t t = 0; t < n_samples; ++t) {
+    ++seen_;
+    // 指数加权 Welford：alpha = 1 / n 时即普通的累计均值与总体方差
+    const double alpha = 1.0 / static_cast<double>(std::min<uint64_t>(seen_, window_samples_));
+    double* __restrict x = block + t * stride;
+    for (size_t c = 0; c < channels; ++c) {
+      double diff = x[c] - mean[c];
+      double increment = alpha * diff;
+      mean[c] += increment;
+      var[c] = (1.0 - alpha) * (var[c] + diff * increment);
+      gain[c] = scale && var[c] >= min_var ? 1.0 / std::sqrt(var[c]) : 1.0;
+      x[c] = (x[c] - mean[c]) * gain[c];
+    }
+  }
+}
+
+void ChannelNormalizer::finish(float* out, size_t out_stride, size_t n_samples) {
+  const double min_var = config_.min_std * config_.min_std;
+  if (config_.mode == NormalizerConfig::Mode::kRunning) {
+    if (config_.scale && n_samples > 0) {
+      for (int c = 0; c < n_channels_; ++c) {
+        flat_channels_ += var_[c] < min_var ? 1 : 0;
+      }
+    }
+    return;
+  }
+  if (config_.mode != NormalizerConfig::Mode::kEpoch || seen_ == 0) {
+    return;
+  }
+
+  const double inv_n = 1.0 / static_cast<double>(seen_);
+  for (int c = 0; c < n_channels_; ++c) {
+    double m = sum_[c] * inv_n;
+    var_[c] = std::max(sum_sq_[c] * inv_n - m * m, 0.0);
+    mean_[c] = shift_[c] + m;
+    double gain = 1.0;
+    if (config_.scale) {
+      if (var_[c] < min_var) {
+        ++flat_channels_;  // 平坦通道只减均值，不放大噪声也不产生 inf / nan
+      } else {
+        gain = 1.0 / std::sqrt(var_[c]);
+      }
+    }
+    // 本段输出刚写回，仍在缓存中
+    const float offset = static_cast<float>(mean_[c]);
+    const float factor = static_cast<float>(gain);
+    float* __restrict row = out + c * out_stride;
+    for (size_t t = 0; t < n_samples; ++t) {
+      row[t] = (row[t] - offset) * factor;
+    }
+  }
+  seen_ = 0;
+}
+
+void ChannelNormalizer::reset() {
+  seen_ = 0;
+  mean_.resize(mean_.size());
+  var_.resize(var_.size());
+}
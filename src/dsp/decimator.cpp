@@ -0,0 +1,138 @@
+#include "dsp/decimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "inference/simd_kernels.h"
+
+std::vector<float> design_lowpass_fir(int taps, double cutoff_hz, double fs) {
+  if (taps < 1 || !(cutoff_hz > 0.0) || !(cutoff_hz < fs / 2)) {
+    throw std::invalid_argument("Low-pass FIR needs taps >= 1 and 0 < cutoff < fs / 2");
+  }
+  const double pi = std::acos(-1.0);
+  const double fc = cutoff_hz / fs;
+  const double center = (taps - 1) / 2.0;
+
+  std::vector<double> h(taps);
+  double sum = 0.0;
+  for (int k = 0; k < taps; ++k) {
+    double n = k - center;
+    double sinc = n == 0.0 ? 2.0 * fc : std::sin(2.0 * pi * fc * n) / (pi * n);
+    double window = taps > 1 ? 0.54 - 0.46 * std::cos(2.0 * pi * k / (taps - 1)) : 1.0;
+    h[k] = sinc * window;
+    sum += h[k];
+  }
+  std::vector<float> result(taps);
+  for (int k = 0; k < taps; ++k) {
+    result[k] = static_cast<float>(h[k] / sum);
+  }
+  return result;
+}
+
+std::vector<int> DecimatorConfig::default_channels() {
+  std::vector<int> channels;
+  for (int c = 0; c < 64; ++c) {
+    if (c != 32 && c != 42 && c != 59 && c != 63) {
+      channels.push_back(c);
+    }
+  }
+  return channels;
+}
+
+DecimatorConfig DecimatorConfig::from_config(const ConfigNode& node, int n_input_channels) {
+  DecimatorConfig config;
+  config.fs = node.get_double("fs", config.fs);
+  config.factor = node.get_int("factor", config.factor);
+  config.taps = node.get_int("taps", config.taps);
+  config.cutoff = node.get_double("cutoff", config.cutoff);
+  if (node.has("channels")) {
+    config.channels = node.get_int_array("channels");
+  } else if (node.has("drop_channels")) {
+    std::vector<int> drop = node.get_int_array("drop_channels");
+    for (int c = 0; c < n_input_channels; ++c) {
+      if (std::find(drop.begin(), drop.end(), c) == drop.end()) {
+        config.channels.push_back(c);
+      }
+    }
+  } else {
+    config.channels = default_channels();
+  }
+  for (int c : config.channels) {
+    if (c < 0 || c >= n_input_channels) {
+      throw std::runtime_error("Decimator channel " + std::to_string(c) + " is outside the input");
+    }
+  }
+  return config;
+}
+
+ChannelDecimator::ChannelDecimator(std::vector<int> channels, int factor, const std::vector<float>& taps)
+    : channels_(std::move(channels)), factor_(factor), n_taps_(taps.size()) {
+  if (channels_.empty() || factor_ < 1 || n_taps_ == 0) {
+    throw std::invalid_argument("ChannelDecimator needs channels, factor >= 1 and at least one tap");
+  }
+  taps_.resize(n_taps_);
+  std::reverse_copy(taps.begin(), taps.end(), taps_.data());
+  history_.resize(channels_.size() * (n_taps_ - 1));
+  edge_.resize(2 * (n_taps_ - 1));
+}
+
+ChannelDecimator::ChannelDecimator(const DecimatorConfig& config)
+    : ChannelDecimator(config.channels, config.factor,
+                       design_lowpass_fir(config.taps, config.cutoff, config.fs)) {}
+
+size_t ChannelDecimator::output_samples(size_t n_in) const {
+  return n_in > next_ ? (n_in - next_ + factor_ - 1) / factor_ : 0;
+}
+
+size_t ChannelDecimator::process(const float* in, size_t in_stride, size_t n_in, float* out, size_t out_stride) {
+  const size_t keep = n_taps_ - 1;
+  const size_t n_out = output_samples(n_in);
+  const size_t head = std::min(n_in, keep);  // 与历史拼接的本段开头部分
+
+  for (size_t c = 0; c < channels_.size(); ++c) {
+    const float* src = in + channels_[c] * in_stride;
+    float* dst = out + c * out_stride;
+    float* history = history_.data() + c * keep;
+
+    // 输出时刻 i（相对本段开头）的窗口为 x[i - keep, i]；i >= keep 时窗口完全落在本段输入内
+    size_t j = 0;
+    size_t i = next_;
+    if (i < keep && n_out > 0) {
+      std::memcpy(edge_.data(), history, keep * sizeof(float));
+      std::memcpy(edge_.data() + keep, src, head * sizeof(float));
+      for (; j < n_out && i < keep; ++j, i += factor_) {
+        dst[j] = dot_f32(taps_.data(), edge_.data() + i, n_taps_);
+      }
+    }
+    for (; j < n_out; ++j, i += factor_) {
+      dst[j] = dot_f32(taps_.data(), src + i - keep, n_taps_);
+    }
+
+    // 更新历史：保留 [history | 本段] 的最后 keep 个采样点
+    if (n_in >= keep) {
+      std::memcpy(history, src + n_in - keep, keep * sizeof(float));
+    } else {
+      std::memmove(history, history + n_in, (keep - n_in) * sizeof(float));
+      std::memcpy(history + keep - n_in, src, n_in * sizeof(float));
+    }
+  }
+
+  next_ = next_ + n_out * factor_ - n_in;
+  return n_out;
+}
+
+void ChannelDecimator::reset() {
+  history_.resize(history_.size());
+  next_ = 0;
+}
+
+void ChannelDecimator::prime(const float* in, size_t in_stride) {
+  const size_t keep = n_taps_ - 1;
+  for (size_t c = 0; c < channels_.size(); ++c) {
+    std::fill_n(history_.data() + c * keep, keep, in[channels_[c] * in_stride]);
+  }
+  next_ = 0;
+}
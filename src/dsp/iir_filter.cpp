@@ -0,0 +1,294 @@
+#include "dsp/iir_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "dsp/channel_normalizer.h"
+
+namespace {
+
+constexpr size_t kChannelLanes = 8;  // 通道填充粒度（AVX-512 一次 8 个 double）
+
+size_t pad_channels(int n_channels) {
+  return (static_cast<size_t>(n_channels) + kChannelLanes - 1) / kChannelLanes * kChannelLanes;
+}
+
+// 对一个采样点的全部通道做一节运算（转置直接 II 型）
+inline void biquad_row(const Biquad& s, double* __restrict x, double* __restrict z1, double* __restrict z2,
+                       size_t channels) {
+  for (size_t c = 0; c < channels; c += kChannelLanes) {
+    for (size_t l = 0; l < kChannelLanes; ++l) {
+      double xi = x[c + l];
+      double y = s.b0 * xi + z1[c + l];
+      z1[c + l] = s.b1 * xi - s.a1 * y + z2[c + l];
+      z2[c + l] = s.b2 * xi - s.a2 * y;
+      x[c + l] = y;
+    }
+  }
+}
+
+// "通道 x 采样点" float -> "采样点 x 通道" double
+void transpose_in(const float* in, size_t in_stride, int n_channels, size_t n_samples, double* block,
+                  size_t padded) {
+  for (int c = 0; c < n_channels; ++c) {
+    const float* src = in + c * in_stride;
+    for (size_t t = 0; t < n_samples; ++t) {
+      block[t * padded + c] = src[t];
+    }
+  }
+}
+
+// "采样点 x 通道" double -> "通道 x 采样点" float
+void transpose_out(const double* block, size_t padded, int n_channels, size_t n_samples, float* out,
+                   size_t out_stride) {
+  for (int c = 0; c < n_channels; ++c) {
+    float* dst = out + c * out_stride;
+    for (size_t t = 0; t < n_samples; ++t) {
+      dst[t] = static_cast<float>(block[t * padded + c]);
+    }
+  }
+}
+
+}  // namespace
+
+std::vector<Biquad> design_butterworth_bandpass(int order, double low_hz, double high_hz, double fs) {
+  if (order < 1 || !(low_hz > 0.0) || !(high_hz > low_hz) || !(high_hz < fs / 2)) {
+    throw std::invalid_argument("Butterworth band-pass needs order >= 1 and 0 < low < high < fs / 2");
+  }
+  using Complex = std::complex<double>;
+  const double pi = std::acos(-1.0);
+
+  // 预畸变（scipy 以 fs = 2 设计数字滤波器）
+  const double nyquist = fs / 2;
+  const double w_low = 4.0 * std::tan(pi * (low_hz / nyquist) / 2.0);
+  const double w_high = 4.0 * std::tan(pi * (high_hz / nyquist) / 2.0);
+  const double bw = w_high - w_low;
+  const double wo = std::sqrt(w_low * w_high);
+
+  // 模拟原型极点 -exp(j pi m / (2N))，m = -N+1, -N+3, ..., N-1；lp2bp 后每个极点变为两个
+  std::vector<Complex> poles;
+  for (int m = -order + 1; m < order; m += 2) {
+    Complex p = -std::exp(Complex(0.0, pi * m / (2.0 * order))) * (bw / 2.0);
+    Complex root = std::sqrt(p * p - wo * wo);
+    poles.push_back(p + root);
+    poles.push_back(p - root);
+  }
+
+  // 双线性变换：极点 (4 + p) / (4 - p)，order 个零点在 z = 1（模拟零点 0），order 个在 z = -1
+  double gain = std::pow(bw, order);
+  Complex denominator = 1.0;
+  for (Complex& p : poles) {
+    denominator *= 4.0 - p;
+    p = (4.0 + p) / (4.0 - p);
+  }
+  gain *= (std::pow(4.0, order) / denominator).real();
+
+  // 共轭极点配成一节，实极点两两配对；每节的零点为 {1, -1}，即分子 1 - z^-2
+  std::vector<Biquad> sections;
+  std::vector<double> real_poles;
+  for (const Complex& p : poles) {
+    if (std::abs(p.imag()) <= 1e-12 * std::abs(p)) {
+      real_poles.push_back(p.real());
+    } else if (p.imag() > 0) {
+      Biquad s;
+      s.b0 = 1.0;
+      s.b2 = -1.0;
+      s.a1 = -2.0 * p.real();
+      s.a2 = std::norm(p);
+      sections.push_back(s);
+    }
+  }
+  for (size_t i = 0; i + 1 < real_poles.size(); i += 2) {
+    Biquad s;
+    s.b0 = 1.0;
+    s.b2 = -1.0;
+    s.a1 = -(real_poles[i] + real_poles[i + 1]);
+    s.a2 = real_poles[i] * real_poles[i + 1];
+    sections.push_back(s);
+  }
+
+  sections.front().b0 *= gain;
+  sections.front().b1 *= gain;
+  sections.front().b2 *= gain;
+  return sections;
+}
+
+std::complex<double> sos_response(const std::vector<Biquad>& sections, double freq_hz, double fs) {
+  const double omega = 2.0 * std::acos(-1.0) * freq_hz / fs;
+  const std::complex<double> z1 = std::polar(1.0, -omega);
+  const std::complex<double> z2 = z1 * z1;
+  std::complex<double> response = 1.0;
+  for (const Biquad& s : sections) {
+    response *= (s.b0 + s.b1 * z1 + s.b2 * z2) / (1.0 + s.a1 * z1 + s.a2 * z2);
+  }
+  return response;
+}
+
+// ==================== SosCascade ====================
+
+SosCascade::SosCascade(std::vector<Biquad> sections, int n_channels)
+    : sections_(std::move(sections)), n_channels_(n_channels), padded_channels_(pad_channels(n_channels)) {
+  if (n_channels_ <= 0 || sections_.empty()) {
+    throw std::invalid_argument("SosCascade needs at least one channel and one section");
+  }
+  state_.resize(sections_.size() * 2 * padded_channels_);
+}
+
+void SosCascade::filter(double* data, size_t n_samples, bool reverse) {
+  const size_t channels = padded_channels_;
+  for (size_t i = 0; i < n_samples; ++i) {
+    double* x = data + (reverse ? n_samples - 1 - i : i) * channels;
+    double* state = state_.data();
+    for (const Biquad& s : sections_) {
+      biquad_row(s, x, state, state + channels, channels);
+      state += 2 * channels;
+    }
+  }
+}
+
+void SosCascade::reset() { state_.resize(state_.size()); }
+
+void SosCascade::settle(const double* row) {
+  // 转置直接 II 型在恒定输入 x 下：y = H(1) x，z1 = y - b0 x，z2 = b2 x - a2 y；本节的 y 即下一节的输入
+  const size_t channels = padded_channels_;
+  for (size_t c = 0; c < channels; ++c) {
+    double x = row[c];
+    double* state = state_.data();
+    for (const Biquad& s : sections_) {
+      const double y = x * (s.b0 + s.b1 + s.b2) / (1.0 + s.a1 + s.a2);
+      state[c] = y - s.b0 * x;
+      state[channels + c] = s.b2 * x - s.a2 * y;
+      state += 2 * channels;
+      x = y;
+    }
+  }
+}
+
+// ==================== SosFilterBank ====================
+
+SosFilterBank::SosFilterBank(std::vector<Biquad> sections, int n_channels)
+    : cascade_(std::move(sections), n_channels) {
+  block_.resize(kBlockSamples * cascade_.padded_channels());
+}
+
+void SosFilterBank::process(const float* in, size_t in_stride, float* out, size_t out_stride, size_t n_samples,
+                            ChannelNormalizer* normalizer) {
+  const size_t padded = cascade_.padded_channels();
+  for (size_t start = 0; start < n_samples; start += kBlockSamples) {
+    size_t count = std::min(kBlockSamples, n_samples - start);
+    transpose_in(in + start, in_stride, cascade_.n_channels(), count, block_.data(), padded);
+    cascade_.filter(block_.data(), count);
+    if (normalizer) {
+      normalizer->accumulate(block_.data(), padded, count);
+    }
+    transpose_out(block_.data(), padded, cascade_.n_channels(), count, out + start, out_stride);
+  }
+  if (normalizer) {
+    normalizer->finish(out, out_stride, n_samples);
+  }
+}
+
+void SosFilterBank::settle(const float* in, size_t in_stride) {
+  transpose_in(in, in_stride, cascade_.n_channels(), 1, block_.data(), cascade_.padded_channels());
+  cascade_.settle(block_.data());
+}
+
+// ==================== ZeroPhaseFilterBank ====================
+
+ZeroPhaseFilterBank::ZeroPhaseFilterBank(std::vector<Biquad> sections, int n_channels, size_t lag)
+    : forward_(sections, n_channels), backward_(std::move(sections), n_channels), lag_(lag) {
+  reserve(SosFilterBank::kBlockSamples);
+}
+
+void ZeroPhaseFilterBank::reserve(size_t n_samples) {
+  if (n_samples <= capacity_) {
+    return;
+  }
+  const size_t padded = forward_.padded_channels();
+  AlignedBuffer<double> history((lag_ + n_samples) * padded);
+  if (!history_.empty()) {
+    std::memcpy(history.data(), history_.data(), lag_ * padded * sizeof(double));
+  }
+  history_ = std::move(history);
+  scratch_.resize((lag_ + n_samples) * padded);
+  capacity_ = n_samples;
+}
+
+void ZeroPhaseFilterBank::process(const float* in, size_t in_stride, float* out, size_t out_stride,
+                                  size_t n_samples, ChannelNormalizer* normalizer) {
+  reserve(n_samples);
+  const size_t padded = forward_.padded_channels();
+  const size_t total = lag_ + n_samples;
+
+  // 新数据接在上一段尾部之后，做因果前向滤波
+  double* fresh = history_.data() + lag_ * padded;
+  transpose_in(in, in_stride, forward_.n_channels(), n_samples, fresh, padded);
+  forward_.filter(fresh, n_samples);
+
+  // 在最近 lag + n 个采样点上从零状态反向滤波，前 n 个结果已有 lag 个后续采样点
+  std::memcpy(scratch_.data(), history_.data(), total * padded * sizeof(double));
+  backward_.reset();
+  backward_.filter(scratch_.data(), total, true);
+  if (normalizer) {
+    normalizer->accumulate(scratch_.data(), padded, n_samples);
+  }
+  transpose_out(scratch_.data(), padded, forward_.n_channels(), n_samples, out, out_stride);
+  if (normalizer) {
+    normalizer->finish(out, out_stride, n_samples);
+  }
+
+  // 保留最后 lag 个前向滤波结果
+  std::memmove(history_.data(), history_.data() + n_samples * padded, lag_ * padded * sizeof(double));
+}
+
+void ZeroPhaseFilterBank::process_epoch(const float* in, size_t in_stride, float* out, size_t out_stride,
+                                        size_t n_samples, ChannelNormalizer* normalizer) {
+  if (n_samples == 0) {
+    return;
+  }
+  reserve(n_samples);
+  const size_t padded = forward_.padded_channels();
+  double* data = scratch_.data();
+  transpose_in(in, in_stride, forward_.n_channels(), n_samples, data, padded);
+  forward_.settle(data);
+  forward_.filter(data, n_samples);
+  backward_.settle(data + (n_samples - 1) * padded);
+  backward_.filter(data, n_samples, true);
+  if (normalizer) {
+    normalizer->accumulate(data, padded, n_samples);
+  }
+  transpose_out(data, padded, forward_.n_channels(), n_samples, out, out_stride);
+  if (normalizer) {
+    normalizer->finish(out, out_stride, n_samples);
+  }
+}
+
+void ZeroPhaseFilterBank::reset() {
+  forward_.reset();
+  backward_.reset();
+  history_.resize(history_.size());
+}
+
+// ==================== IirFilterConfig ====================
+
+IirFilterConfig IirFilterConfig::from_config(const ConfigNode& node) {
+  IirFilterConfig config;
+  config.fs = node.get_double("fs", config.fs);
+  config.low_cut = node.get_double("low_cut", config.low_cut);
+  config.high_cut = node.get_double("high_cut", config.high_cut);
+  config.order = node.get_int("order", config.order);
+  config.lag = static_cast<size_t>(node.get_int("lag", static_cast<int>(config.lag)));
+
+  std::string mode = node.get_string("mode", "causal");
+  if (mode == "causal") {
+    config.mode = Mode::kCausal;
+  } else if (mode == "zero_phase") {
+    config.mode = Mode::kZeroPhase;
+  } else {
+    throw std::runtime_error("Unknown filter mode: " + mode);
+  }
+  return config;
+}
@@ -0,0 +1,347 @@
+#include "framework/pipeline.h"
+
+#include <algorithm>
+#include <string>
+
+void Pipeline::run(const std::vector<std::vector<Module<PackagePtr>*>>& modules, bool enable_profile) {
+  if (!validate(modules)) {
+    return;
+  }
+
+  reset_exit();
+  initialize_resources(modules);
+  connect_modules(modules);
+  share_sequence(modules);
+
+  // 每个模块一个线程，复制阶段另有分发/合并线程
+  std::vector<std::thread> threads;
+  for (int i = 0; i < stage_num_; ++i) {
+    for (auto* module : modules[i]) {
+      threads.emplace_back(&Pipeline::run_module, this, module, i, enable_profile);
+    }
+    ReplicaStage& replica = replica_stages_[i];
+    if (replica.dispatcher) {
+      threads.emplace_back(&Pipeline::run_module, this, replica.dispatcher.get(), i, false);
+    }
+    if (replica.merger) {
+      threads.emplace_back(&Pipeline::run_module, this, replica.merger.get(), i, false);
+    }
+  }
+
+  ProfileReporter reporter(profile_interval_);
+  if (enable_profile) {
+    add_profiles(reporter, modules);
+    reporter.start();
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  reporter.stop();
+}
+
+void Pipeline::run_executor(const std::vector<std::vector<Module<PackagePtr>*>>& modules, const ExecutorConfig& config,
+                            bool enable_profile) {
+  if (!validate(modules)) {
+    return;
+  }
+
+  reset_exit();
+  initialize_resources(modules);
+  connect_modules(modules);
+  share_sequence(modules);
+
+  // 连接方式与 run() 相同，模块与分发/合并都作为任务
+  WorkStealingExecutor executor(config);
+  for (int i = 0; i < stage_num_; ++i) {
+    for (auto* module : modules[i]) {
+      executor.add(module);
+    }
+    ReplicaStage& replica = replica_stages_[i];
+    if (replica.dispatcher) {
+      executor.add(replica.dispatcher.get());
+    }
+    if (replica.merger) {
+      executor.add(replica.merger.get());
+    }
+  }
+  MLOG_INFO("Pipeline running on %zu executor workers (profile %s)", executor.worker_count(),
+            enable_profile ? "on" : "off");
+  executor.start();
+  ProfileReporter reporter(profile_interval_);
+  if (enable_profile) {
+    add_profiles(reporter, modules);
+    reporter.start();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(exit_mutex_);
+    exit_cv_.wait(lock, [this] { return exit_requested_; });
+  }
+  executor.stop();
+  reporter.stop();
+  MLOG_INFO("Executor stopped after %llu steps (%llu steals)", static_cast<unsigned long long>(executor.steps()),
+            static_cast<unsigned long long>(executor.steals()));
+}
+
+void Pipeline::run_fused(const std::vector<std::vector<Module<PackagePtr>*>>& modules, const FusedConfig& config,
+                         bool enable_profile) {
+  std::vector<Source*> sources;
+  if (!validate(modules) || !validate_fused(modules, sources)) {
+    return;
+  }
+  reset_exit();
+  share_sequence(modules);
+  for (int i = 0; i < stage_num_; ++i) {
+    for (auto* module : modules[i]) {
+      module->set_tracker(tracker_, i);
+    }
+  }
+
+  // 每个模块一个入口：第 i 阶段有 K 个副本时，r 号副本依次放行票号 r, r + K, ...
+  std::vector<std::vector<std::unique_ptr<FusedGate>>> gates(stage_num_);
+  for (int i = 1; i < stage_num_; ++i) {
+    const size_t count = modules[i].size();
+    for (size_t r = 0; r < count; ++r) {
+      gates[i].push_back(std::make_unique<FusedGate>(r, count));
+    }
+  }
+  std::vector<std::mutex> source_mutexes(sources.size());
+  std::atomic<uint64_t> next_ticket{0};
+
+  auto worker = [&](int index) {
+    if (!config.cpus.empty()) {
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      CPU_SET(config.cpus[index % config.cpus.size()], &mask);
+      pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+    }
+    size_t cursor = static_cast<size_t>(index);
+    while (!stop_fused_.load(std::memory_order_acquire)) {
+      // 轮流从各 Source 取包；取包与领票号在同一把锁内，同一 Source 的包按序号领票
+      const size_t s = cursor++ % sources.size();
+      PackagePtr package;
+      uint64_t ticket = 0;
+      {
+        std::lock_guard<std::mutex> lock(source_mutexes[s]);
+        package = sources[s]->produce();
+        if (package) {
+          ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      if (!package) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      // 领到票号的包必须经过每个阶段的入口（失败后只放行不处理），否则后面的包会一直等待
+      bool ok = true;
+      for (int i = 1; i < stage_num_; ++i) {
+        const size_t r = ticket % modules[i].size();
+        FusedGate& gate = *gates[i][r];
+        gate.enter(ticket);
+        if (ok) {
+          try {
+            ok = modules[i][r]->process_inline(package.get(), i == stage_num_ - 1);
+            if (!ok) {
+              MLOG_ERROR("Stage %d failed to process package %llu", i,
+                         static_cast<unsigned long long>(package->get_sequence()));
+            }
+          } catch (const std::exception& e) {
+            MLOG_ERROR("Exception in stage %d: %s", i, e.what());
+            ok = false;
+          }
+        }
+        gate.leave();
+      }
+    }
+  };
+
+  MLOG_INFO("Pipeline running fused on %d workers (profile %s)", config.workers, enable_profile ? "on" : "off");
+  ProfileReporter reporter(profile_interval_);
+  if (enable_profile) {
+    add_profiles(reporter, modules);
+    reporter.start();
+  }
+  std::vector<std::thread> threads;
+  for (int w = 0; w < config.workers; ++w) {
+    threads.emplace_back(worker, w);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  reporter.stop();
+  MLOG_INFO("Fused pipeline stopped after %llu packages", static_cast<unsigned long long>(next_ticket.load()));
+}
+
+void Pipeline::seq_run(const std::vector<std::vector<Module<PackagePtr>*>>& modules, bool enable_profile) {
+  run_fused(modules, FusedConfig(), enable_profile);
+}
+
+void Pipeline::run(const std::vector<std::vector<Module<PackagePtr>*>>& modules, const PipelineRunConfig& config,
+                   bool enable_profile) {
+  switch (config.mode) {
+    case PipelineMode::kExecutor:
+      run_executor(modules, config.executor, enable_profile);
+      break;
+    case PipelineMode::kFused:
+      run_fused(modules, config.fused, enable_profile);
+      break;
+    default:
+      run(modules, enable_profile);
+      break;
+  }
+}
+
+void Pipeline::exit() {
+  for (auto& replica : replica_stages_) {
+    if (replica.dispatcher) {
+      replica.dispatcher->exit();
+    }
+    if (replica.merger) {
+      replica.merger->exit();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(exit_mutex_);
+    exit_requested_ = true;
+  }
+  exit_cv_.notify_all();
+  stop_fused_.store(true, std::memory_order_release);
+}
+
+bool Pipeline::validate(const std::vector<std::vector<Module<PackagePtr>*>>& modules) const {
+  if (static_cast<int>(modules.size()) != stage_num_) {
+    MLOG_ERROR("Pipeline expects %d stages but got %zu", stage_num_, modules.size());
+    return false;
+  }
+  for (int i = 0; i < stage_num_; ++i) {
+    if (modules[i].empty()) {
+      MLOG_ERROR("Stage %d has no modules", i);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Pipeline::validate_fused(const std::vector<std::vector<Module<PackagePtr>*>>& modules,
+                              std::vector<Source*>& sources) const {
+  sources.clear();
+  for (auto* module : modules[0]) {
+    auto* source = dynamic_cast<Source*>(module);
+    if (!source) {
+      MLOG_ERROR("Fused mode needs every stage 0 module to be a Source");
+      return false;
+    }
+    sources.push_back(source);
+  }
+  for (int i = 1; i < stage_num_; ++i) {
+    for (auto* module : modules[i]) {
+      if (!module->fusable()) {
+        MLOG_ERROR("Stage %d module cannot be fused (it does not map one package to one package)", i);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void Pipeline::add_profiles(ProfileReporter& reporter,
+                            const std::vector<std::vector<Module<PackagePtr>*>>& modules) const {
+  for (int i = 0; i < stage_num_; ++i) {
+    for (size_t r = 0; r < modules[i].size(); ++r) {
+      if (!modules[i][r]->get_profiler().is_enabled()) {
+        continue;
+      }
+      std::string name = "Stage " + std::to_string(i);
+      if (modules[i].size() > 1) {
+        name += "." + std::to_string(r);
+      }
+      reporter.add(name, &modules[i][r]->get_profiler(), &modules[i][r]->get_shed_counters());
+    }
+  }
+}
+
+void Pipeline::reset_exit() {
+  {
+    std::lock_guard<std::mutex> lock(exit_mutex_);
+    exit_requested_ = false;
+  }
+  stop_fused_.store(false, std::memory_order_release);
+}
+
+void Pipeline::share_sequence(const std::vector<std::vector<Module<PackagePtr>*>>& modules) {
+  if (modules[0].size() < 2) {
+    return;
+  }
+  for (auto* module : modules[0]) {
+    if (auto* source = dynamic_cast<Source*>(module)) {
+      source->share_sequence(&sequence_);
+    }
+  }
+}
+
+void Pipeline::connect_modules(const std::vector<std::vector<Module<PackagePtr>*>>& modules) {
+  replica_stages_.clear();
+  replica_stages_.resize(stage_num_);
+  for (int i = 0; i < stage_num_; ++i) {
+    for (auto* module : modules[i]) {
+      module->set_tracker(tracker_, i);
+    }
+    if (i > 0 && modules[i].size() > 1) {
+      build_replica_stage(i, modules[i]);
+      continue;
+    }
+    for (auto* module : modules[i]) {
+      if (i > 0) {
+        module->set_input_ptr(buffers_[i - 1].get());
+      }
+      if (i < stage_num_ - 1) {
+        module->set_output_ptr(buffers_[i].get());
+      }
+    }
+  }
+}
+
+void Pipeline::build_replica_stage(int stage, const std::vector<Module<PackagePtr>*>& replicas) {
+  const ReplicationConfig config = replication_.count(stage) ? replication_[stage] : ReplicationConfig();
+  const size_t count = replicas.size();
+  const size_t input_capacity = capacities_[stage - 1];
+  const WaitStrategy& wait_strategy = replicas.front()->get_wait_strategy();
+  ReplicaStage& replica = replica_stages_[stage];
+
+  std::vector<Channel<PackagePtr>*> inputs;
+  for (size_t r = 0; r < count; ++r) {
+    replica.inputs.emplace_back(std::make_shared<Channel<PackagePtr>>(input_capacity, ChannelMode::kSpsc));
+    inputs.push_back(replica.inputs.back().get());
+    replicas[r]->set_input_ptr(inputs.back());
+  }
+  replica.dispatcher = std::make_unique<ReplicaDispatcher>(inputs, config.dispatch, wait_strategy);
+  replica.dispatcher->set_input_ptr(buffers_[stage - 1].get());
+
+  // 最后一个阶段没有下游，不需要合并
+  if (stage == stage_num_ - 1) {
+    return;
+  }
+  const size_t output_capacity = capacities_[stage];
+  replica.merged = std::make_shared<Channel<PackagePtr>>(output_capacity, ChannelMode::kMpsc);
+  for (auto* module : replicas) {
+    module->set_output_ptr(replica.merged.get());
+  }
+
+  // 重排窗口至少容纳分发线程与合并线程之间所有在途的包
+  ReorderConfig reorder = config.reorder;
+  reorder.window = std::max(reorder.window, 2 * (count * (input_capacity + 1) + output_capacity));
+  replica.merger =
+      std::make_unique<ReplicaMerger>("Stage " + std::to_string(stage) + " merge", reorder, wait_strategy);
+  replica.merger->set_input_ptr(replica.merged.get());
+  replica.merger->set_output_ptr(buffers_[stage].get());
+  MLOG_INFO("Stage %d replicated x%zu (%s dispatch, reorder window %zu)", stage, count,
+            config.dispatch == DispatchPolicy::kLeastLoaded ? "least_loaded" : "round_robin", reorder.window);
+}
+
+void Pipeline::run_module(Module<PackagePtr>* module, int stage_index, bool enable_profile) {
+  MLOG_DEBUG("Stage %d module started (profile %s)", stage_index, enable_profile ? "on" : "off");
+  module->run();
+  MLOG_DEBUG("Stage %d module finished after %zu packages", stage_index, module->get_cnt());
+}
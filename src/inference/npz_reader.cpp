@@ -0,0 +1,206 @@
+#include "inference/npz_reader.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t kEndOfCentralDirSig = 0x06054b50;
+constexpr uint32_t kZip64EndOfCentralDirSig = 0x06064b50;
+constexpr uint32_t kZip64LocatorSig = 0x07064b50;
+constexpr uint32_t kCentralDirSig = 0x02014b50;
+constexpr uint32_t kLocalHeaderSig = 0x04034b50;
+
+uint16_t read_u16(const unsigned char* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t read_u32(const unsigned char* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+uint64_t read_u64(const unsigned char* p) {
+  return static_cast<uint64_t>(read_u32(p)) | (static_cast<uint64_t>(read_u32(p + 4)) << 32);
+}
+
+void require(bool condition, const std::string& message) {
+  if (!condition) {
+    throw std::runtime_error("npz: " + message);
+  }
+}
+
+// 从 .npy 头部的字典字符串中取出某个键对应的原始值文本
+std::string header_field(const std::string& header, const std::string& key) {
+  size_t pos = header.find("'" + key + "'");
+  require(pos != std::string::npos, "missing '" + key + "' in npy header");
+  pos = header.find(':', pos);
+  require(pos != std::string::npos, "malformed npy header");
+  ++pos;
+  while (pos < header.size() && header[pos] == ' ') ++pos;
+  if (header[pos] == '(') {
+    size_t end = header.find(')', pos);
+    return header.substr(pos, end - pos + 1);
+  }
+  size_t end = header.find_first_of(",}", pos);
+  return header.substr(pos, end - pos);
+}
+
+template <class T>
+void convert(const unsigned char* src, size_t count, std::vector<double>& dst) {
+  for (size_t i = 0; i < count; ++i) {
+    T value;
+    std::memcpy(&value, src + i * sizeof(T), sizeof(T));
+    dst[i] = static_cast<double>(value);
+  }
+}
+
+}  // namespace
+
+NpyArray parse_npy(const unsigned char* data, size_t size) {
+  require(size >= 10 && std::memcmp(data, "\x93NUMPY", 6) == 0, "bad npy magic");
+  uint8_t major = data[6];
+  size_t header_len = 0;
+  size_t offset = 0;
+  if (major == 1) {
+    header_len = read_u16(data + 8);
+    offset = 10;
+  } else {
+    require(size >= 12, "truncated npy header");
+    header_len = read_u32(data + 8);
+    offset = 12;
+  }
+  require(offset + header_len <= size, "truncated npy header");
+  std::string header(reinterpret_cast<const char*>(data + offset), header_len);
+  offset += header_len;
+
+  std::string descr = header_field(header, "descr");
+  std::string fortran = header_field(header, "fortran_order");
+  std::string shape_text = header_field(header, "shape");
+
+  NpyArray array;
+  size_t count = 1;
+  size_t pos = 1;  // 跳过 '('
+  while (pos < shape_text.size()) {
+    size_t next = shape_text.find_first_of(",)", pos);
+    std::string token = shape_text.substr(pos, next - pos);
+    if (token.find_first_not_of(' ') != std::string::npos) {
+      size_t dim = std::stoul(token);
+      array.shape.push_back(dim);
+      count *= dim;
+    }
+    if (next == std::string::npos || shape_text[next] == ')') break;
+    pos = next + 1;
+  }
+
+  // descr 形如 '<f8'，取出类型字符和字节数
+  require(descr.size() >= 5, "bad dtype " + descr);
+  char byte_order = descr[1];
+  char kind = descr[2];
+  size_t item_size = std::stoul(descr.substr(3, descr.size() - 4));
+  require(byte_order == '<' || byte_order == '|' || byte_order == '=', "big-endian arrays are not supported");
+  require(offset + count * item_size <= size, "truncated npy data");
+
+  const unsigned char* raw = data + offset;
+  array.data.resize(count);
+  if (kind == 'f' && item_size == 8) {
+    convert<double>(raw, count, array.data);
+  } else if (kind == 'f' && item_size == 4) {
+    convert<float>(raw, count, array.data);
+  } else if (kind == 'i' && item_size == 8) {
+    convert<int64_t>(raw, count, array.data);
+  } else if (kind == 'i' && item_size == 4) {
+    convert<int32_t>(raw, count, array.data);
+  } else if ((kind == 'b' || kind == 'u') && item_size == 1) {
+    convert<uint8_t>(raw, count, array.data);
+  } else {
+    throw std::runtime_error("npz: unsupported dtype " + descr);
+  }
+
+  // Fortran 顺序转为 C 顺序
+  if (fortran.find("True") != std::string::npos && array.shape.size() > 1) {
+    std::vector<double> c_order(count);
+    std::vector<size_t> index(array.shape.size(), 0);
+    for (size_t f = 0; f < count; ++f) {
+      size_t c = 0;
+      for (size_t axis = 0; axis < array.shape.size(); ++axis) {
+        c = c * array.shape[axis] + index[axis];
+      }
+      c_order[c] = array.data[f];
+      for (size_t axis = 0; axis < array.shape.size(); ++axis) {
+        if (++index[axis] < array.shape[axis]) break;
+        index[axis] = 0;
+      }
+    }
+    array.data.swap(c_order);
+  }
+  return array;
+}
+
+std::map<std::string, NpyArray> load_npz(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  require(file.is_open(), "failed to open " + path);
+  std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  require(bytes.size() >= 22, "file too small: " + path);
+
+  // 定位中央目录结束记录
+  size_t eocd = bytes.size() - 22;
+  while (read_u32(&bytes[eocd]) != kEndOfCentralDirSig) {
+    require(eocd > 0, "end of central directory not found");
+    --eocd;
+  }
+  uint64_t entry_count = read_u16(&bytes[eocd + 10]);
+  uint64_t cd_offset = read_u32(&bytes[eocd + 16]);
+
+  // ZIP64（较新的 NumPy 会强制使用）
+  if (cd_offset == 0xFFFFFFFFu || entry_count == 0xFFFFu) {
+    require(eocd >= 20 && read_u32(&bytes[eocd - 20]) == kZip64LocatorSig, "zip64 locator not found");
+    uint64_t zip64_eocd = read_u64(&bytes[eocd - 20 + 8]);
+    require(zip64_eocd + 56 <= bytes.size() && read_u32(&bytes[zip64_eocd]) == kZip64EndOfCentralDirSig,
+            "bad zip64 end of central directory");
+    entry_count = read_u64(&bytes[zip64_eocd + 32]);
+    cd_offset = read_u64(&bytes[zip64_eocd + 48]);
+  }
+
+  std::map<std::string, NpyArray> arrays;
+  size_t pos = cd_offset;
+  for (uint64_t i = 0; i < entry_count; ++i) {
+    require(pos + 46 <= bytes.size() && read_u32(&bytes[pos]) == kCentralDirSig, "bad central directory entry");
+    uint16_t method = read_u16(&bytes[pos + 10]);
+    uint64_t comp_size = read_u32(&bytes[pos + 20]);
+    uint64_t uncomp_size = read_u32(&bytes[pos + 24]);
+    uint16_t name_len = read_u16(&bytes[pos + 28]);
+    uint16_t extra_len = read_u16(&bytes[pos + 30]);
+    uint16_t comment_len = read_u16(&bytes[pos + 32]);
+    uint64_t local_offset = read_u32(&bytes[pos + 42]);
+    std::string name(reinterpret_cast<const char*>(&bytes[pos + 46]), name_len);
+
+    // ZIP64 扩展字段：按 "原始大小 / 压缩大小 / 本地头偏移" 的顺序出现被置为 0xFFFFFFFF 的字段
+    size_t extra = pos + 46 + name_len;
+    size_t extra_end = extra + extra_len;
+    while (extra + 4 <= extra_end) {
+      uint16_t id = read_u16(&bytes[extra]);
+      uint16_t len = read_u16(&bytes[extra + 2]);
+      if (id == 0x0001) {
+        size_t field = extra + 4;
+        if (uncomp_size == 0xFFFFFFFFu) { uncomp_size = read_u64(&bytes[field]); field += 8; }
+        if (comp_size == 0xFFFFFFFFu) { comp_size = read_u64(&bytes[field]); field += 8; }
+        if (local_offset == 0xFFFFFFFFu) { local_offset = read_u64(&bytes[field]); }
+      }
+      extra += 4 + len;
+    }
+    require(method == 0 && comp_size == uncomp_size,
+            "compressed entry '" + name + "' (use np.savez, not np.savez_compressed)");
+
+    require(local_offset + 30 <= bytes.size() && read_u32(&bytes[local_offset]) == kLocalHeaderSig,
+            "bad local header for " + name);
+    size_t data_offset = local_offset + 30 + read_u16(&bytes[local_offset + 26]) + read_u16(&bytes[local_offset + 28]);
+    require(data_offset + comp_size <= bytes.size(), "truncated entry " + name);
+
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0) {
+      name.resize(name.size() - 4);
+    }
+    arrays[name] = parse_npy(&bytes[data_offset], comp_size);
+    pos += 46 + name_len + extra_len + comment_len;
+  }
+  return arrays;
+}
@@ -0,0 +1,544 @@
+#include "inference/simd_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RSVP_SIMD_X86 1
+#endif
+
+namespace {
+
+float dot_f32_scalar(const float* a, const float* b, size_t n) {
+  // 4 路独立累加，便于编译器向量化（aarch64 上生成 NEON 代码）
+  float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc0 += a[i] * b[i];
+    acc1 += a[i + 1] * b[i + 1];
+    acc2 += a[i + 2] * b[i + 2];
+    acc3 += a[i + 3] * b[i + 3];
+  }
+  for (; i < n; ++i) {
+    acc0 += a[i] * b[i];
+  }
+  return (acc0 + acc1) + (acc2 + acc3);
+}
+
+float gather_dot_f32_scalar(const float* w, size_t w_stride, const int32_t* rows, const int32_t* cols,
+                            size_t n_models, int n_rows, int run, const float* x, size_t x_stride) {
+  float total = 0.0f;
+  for (size_t k = 0; k < n_models; ++k) {
+    const float* wk = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    float acc = 0.0f;
+    for (int r = 0; r < n_rows; ++r) {
+      const float* xr = x + rk[r] * x_stride + cols[k];
+      const float* wr = wk + r * run;
+      for (int t = 0; t < run; ++t) {
+        acc += wr[t] * xr[t];
+      }
+    }
+    total += acc;
+  }
+  return total;
+}
+
+int32_t dot_i16i8_scalar(const int16_t* x, const int8_t* w, size_t n) {
+  int32_t acc = 0;
+  for (size_t i = 0; i < n; ++i) {
+    acc += static_cast<int32_t>(x[i]) * w[i];
+  }
+  return acc;
+}
+
+// 权重按 4 个电极一组、8 个采样点一块存放：w[((r / 4) * (run / 8) + t / 8) * 32 + (r % 4) * 8 + t % 8]
+float gather_dot_i16i8_scalar(const int8_t* w, size_t w_stride, const float* scales, const int32_t* rows,
+                              const int32_t* cols, size_t n_models, int n_rows, int run, const int16_t* x,
+                              size_t x_stride) {
+  float total = 0.0f;
+  for (size_t k = 0; k < n_models; ++k) {
+    const int8_t* block = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    int32_t acc = 0;
+    for (int r0 = 0; r0 < n_rows; r0 += 4) {
+      for (int t0 = 0; t0 < run; t0 += 8, block += 32) {
+        for (int r = 0; r < 4; ++r) {
+          const int16_t* xr = x + rk[r0 + r] * x_stride + cols[k] + t0;
+          for (int t = 0; t < 8; ++t) {
+            acc += static_cast<int32_t>(xr[t]) * block[r * 8 + t];
+          }
+        }
+      }
+    }
+    total += scales[k] * static_cast<float>(acc);
+  }
+  return total;
+}
+
+float max_abs_f32_scalar(const float* x, size_t n) {
+  float result = 0.0f;
+  for (size_t i = 0; i < n; ++i) {
+    result = std::max(result, std::fabs(x[i]));
+  }
+  return result;
+}
+
+void quantize_f32_i16_scalar(const float* x, size_t n, float scale, int16_t* out) {
+  for (size_t i = 0; i < n; ++i) {
+    float v = x[i] * scale;
+    out[i] = static_cast<int16_t>(v + (v >= 0.0f ? 0.5f : -0.5f));  // 四舍五入（远离 0）
+  }
+}
+
+#ifdef RSVP_SIMD_X86
+__attribute__((target("avx2,fma"))) inline float hsum256(__m256 v) {
+  __m128 lo = _mm256_castps256_ps128(v);
+  __m128 hi = _mm256_extractf128_ps(v, 1);
+  lo = _mm_add_ps(lo, hi);
+  __m128 shuf = _mm_movehdup_ps(lo);
+  __m128 sums = _mm_add_ps(lo, shuf);
+  shuf = _mm_movehl_ps(shuf, sums);
+  sums = _mm_add_ss(sums, shuf);
+  return _mm_cvtss_f32(sums);
+}
+
+__attribute__((target("avx2,fma"))) float dot_f32_avx2(const float* a, const float* b, size_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+  }
+  float sum = hsum256(_mm256_add_ps(acc0, acc1));
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+__attribute__((target("avx512f"))) float dot_f32_avx512(const float* a, const float* b, size_t n) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+  }
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+  }
+  if (i < n) {
+    // 尾部用掩码加载，避免标量循环
+    __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+    acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), acc1);
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+// 每段数据用掩码加载（run <= 8 时一段一次加载），所有子模型累加在同一组向量寄存器中，最后只归约一次
+__attribute__((target("avx2,fma"))) float gather_dot_f32_avx2(const float* w, size_t w_stride, const int32_t* rows,
+                                                              const int32_t* cols, size_t n_models, int n_rows,
+                                                              int run, const float* x, size_t x_stride) {
+  alignas(32) static const int32_t kMaskTable[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  const int tail = run % 8;
+  const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kMaskTable + 8 - tail));
+  for (size_t k = 0; k < n_models; ++k) {
+    const float* wk = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    for (int r = 0; r < n_rows; ++r) {
+      const float* xr = x + rk[r] * x_stride + cols[k];
+      const float* wr = wk + r * run;
+      int t = 0;
+      for (; t + 8 <= run; t += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(wr + t), _mm256_loadu_ps(xr + t), acc0);
+      }
+      if (tail) {
+        acc1 = _mm256_fmadd_ps(_mm256_maskload_ps(wr + t, mask), _mm256_maskload_ps(xr + t, mask), acc1);
+      }
+    }
+  }
+  return hsum256(_mm256_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) float gather_dot_f32_avx512(const float* w, size_t w_stride, const int32_t* rows,
+                                                               const int32_t* cols, size_t n_models, int n_rows,
+                                                               int run, const float* x, size_t x_stride) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  const int tail = run % 16;
+  const __mmask16 mask = static_cast<__mmask16>((1u << tail) - 1);
+  for (size_t k = 0; k < n_models; ++k) {
+    const float* wk = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    for (int r = 0; r < n_rows; ++r) {
+      const float* xr = x + rk[r] * x_stride + cols[k];
+      const float* wr = wk + r * run;
+      int t = 0;
+      for (; t + 16 <= run; t += 16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(wr + t), _mm512_loadu_ps(xr + t), acc0);
+      }
+      if (tail) {
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, wr + t), _mm512_maskz_loadu_ps(mask, xr + t), acc1);
+      }
+    }
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+// ---------- 定点内核 ----------
+
+__attribute__((target("avx2"))) float max_abs_f32_avx2(const float* x, size_t n) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 acc = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc = _mm256_max_ps(acc, _mm256_andnot_ps(sign, _mm256_loadu_ps(x + i)));
+  }
+  __m128 m = _mm_max_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+  m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_max_ss(m, _mm_movehdup_ps(m));
+  float result = _mm_cvtss_f32(m);
+  for (; i < n; ++i) {
+    result = std::max(result, std::fabs(x[i]));
+  }
+  return result;
+}
+
+// 舍入方式与标量版本一致（四舍五入，远离 0）：先按符号加 0.5 再截断
+__attribute__((target("avx2"))) void quantize_f32_i16_avx2(const float* x, size_t n, float scale, int16_t* out) {
+  const __m256 s = _mm256_set1_ps(scale);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 a = _mm256_mul_ps(_mm256_loadu_ps(x + i), s);
+    __m256 b = _mm256_mul_ps(_mm256_loadu_ps(x + i + 8), s);
+    a = _mm256_add_ps(a, _mm256_or_ps(half, _mm256_and_ps(sign, a)));
+    b = _mm256_add_ps(b, _mm256_or_ps(half, _mm256_and_ps(sign, b)));
+    __m256i packed = _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+    packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+  }
+  quantize_f32_i16_scalar(x + i, n - i, scale, out + i);
+}
+// 权重 int8 符号扩展为 int16 后与 int16 输入做成对乘加（vpmaddwd），VNNI 版本用 vpdpwssd 一步完成
+
+__attribute__((target("avx2"))) inline int32_t hsum256_epi32(__m256i v) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// 两段各 8 个元素拼成一个 256 位向量
+__attribute__((target("avx2"))) inline __m256i load_x2(const int16_t* a, const int16_t* b) {
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a))),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)), 1);
+}
+
+// 四段各 8 个元素拼成一个 512 位向量
+__attribute__((target("avx512f,avx512bw"))) inline __m512i load_x4(const int16_t* a, const int16_t* b,
+                                                                  const int16_t* c, const int16_t* d) {
+  __m512i v = _mm512_castsi128_si512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)));
+  v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)), 1);
+  v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(c)), 2);
+  return _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(d)), 3);
+}
+
+__attribute__((target("avx2"))) int32_t dot_i16i8_avx2(const int16_t* x, const int8_t* w, size_t n) {
+  __m256i acc = _mm256_setzero_si256();
+  for (size_t i = 0; i < n; i += 16) {
+    __m256i wv = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i)));
+    __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(xv, wv));
+  }
+  return hsum256_epi32(acc);
+}
+
+__attribute__((target("avx2,avxvnni"))) int32_t dot_i16i8_avxvnni(const int16_t* x, const int8_t* w, size_t n) {
+  __m256i acc = _mm256_setzero_si256();
+  for (size_t i = 0; i < n; i += 16) {
+    __m256i wv = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i)));
+    __m256i xv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    acc = _mm256_dpwssd_avx_epi32(acc, xv, wv);
+  }
+  return hsum256_epi32(acc);
+}
+
+__attribute__((target("avx512f,avx512bw"))) int32_t dot_i16i8_avx512(const int16_t* x, const int8_t* w, size_t n) {
+  __m512i acc = _mm512_setzero_si512();
+  for (size_t i = 0; i < n; i += 32) {
+    __m512i wv = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i)));
+    __m512i xv = _mm512_loadu_si512(x + i);
+    acc = _mm512_add_epi32(acc, _mm512_madd_epi16(xv, wv));
+  }
+  return _mm512_reduce_add_epi32(acc);
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vnni"))) int32_t dot_i16i8_avx512vnni(const int16_t* x, const int8_t* w,
+                                                                                    size_t n) {
+  __m512i acc = _mm512_setzero_si512();
+  for (size_t i = 0; i < n; i += 32) {
+    __m512i wv = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i)));
+    __m512i xv = _mm512_loadu_si512(x + i);
+    acc = _mm512_dpwssd_epi32(acc, xv, wv);
+  }
+  return _mm512_reduce_add_epi32(acc);
+}
+
+// 聚集版本：每次处理 4 个电极各 8 个采样点（权重 32 字节连续存放），每个子模型的整数累加器转为 float 后
+// 按缩放系数乘加到 float 累加器，最后只归约一次
+__attribute__((target("avx2,fma"))) float gather_dot_i16i8_avx2(const int8_t* w, size_t w_stride, const float* scales,
+                                                                const int32_t* rows, const int32_t* cols, size_t n_models,
+                                                                int n_rows, int run, const int16_t* x, size_t x_stride) {
+  __m256 total = _mm256_setzero_ps();
+  for (size_t k = 0; k < n_models; ++k) {
+    const int8_t* block = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    const int16_t* xk = x + cols[k];
+    __m256i acc = _mm256_setzero_si256();
+    for (int r0 = 0; r0 < n_rows; r0 += 4) {
+      const int16_t* x0 = xk + rk[r0] * x_stride;
+      const int16_t* x1 = xk + rk[r0 + 1] * x_stride;
+      const int16_t* x2 = xk + rk[r0 + 2] * x_stride;
+      const int16_t* x3 = xk + rk[r0 + 3] * x_stride;
+      for (int t = 0; t < run; t += 8, block += 32) {
+        __m256i w01 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)));
+        __m256i w23 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(load_x2(x0 + t, x1 + t), w01));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(load_x2(x2 + t, x3 + t), w23));
+      }
+    }
+    total = _mm256_fmadd_ps(_mm256_cvtepi32_ps(acc), _mm256_set1_ps(scales[k]), total);
+  }
+  return hsum256(total);
+}
+
+__attribute__((target("avx2,fma,avxvnni"))) float gather_dot_i16i8_avxvnni(const int8_t* w, size_t w_stride, const float* scales,
+                                                                           const int32_t* rows, const int32_t* cols, size_t n_models,
+                                                                           int n_rows, int run, const int16_t* x, size_t x_stride) {
+  __m256 total = _mm256_setzero_ps();
+  for (size_t k = 0; k < n_models; ++k) {
+    const int8_t* block = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    const int16_t* xk = x + cols[k];
+    __m256i acc = _mm256_setzero_si256();
+    for (int r0 = 0; r0 < n_rows; r0 += 4) {
+      const int16_t* x0 = xk + rk[r0] * x_stride;
+      const int16_t* x1 = xk + rk[r0 + 1] * x_stride;
+      const int16_t* x2 = xk + rk[r0 + 2] * x_stride;
+      const int16_t* x3 = xk + rk[r0 + 3] * x_stride;
+      for (int t = 0; t < run; t += 8, block += 32) {
+        __m256i w01 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)));
+        __m256i w23 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)));
+        acc = _mm256_dpwssd_avx_epi32(acc, load_x2(x0 + t, x1 + t), w01);
+        acc = _mm256_dpwssd_avx_epi32(acc, load_x2(x2 + t, x3 + t), w23);
+      }
+    }
+    total = _mm256_fmadd_ps(_mm256_cvtepi32_ps(acc), _mm256_set1_ps(scales[k]), total);
+  }
+  return hsum256(total);
+}
+
+__attribute__((target("avx512f,avx512bw"))) float gather_dot_i16i8_avx512(const int8_t* w, size_t w_stride, const float* scales,
+                                                                          const int32_t* rows, const int32_t* cols, size_t n_models,
+                                                                          int n_rows, int run, const int16_t* x, size_t x_stride) {
+  __m512 total = _mm512_setzero_ps();
+  for (size_t k = 0; k < n_models; ++k) {
+    const int8_t* block = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    const int16_t* xk = x + cols[k];
+    __m512i acc = _mm512_setzero_si512();
+    for (int r0 = 0; r0 < n_rows; r0 += 4) {
+      const int16_t* x0 = xk + rk[r0] * x_stride;
+      const int16_t* x1 = xk + rk[r0 + 1] * x_stride;
+      const int16_t* x2 = xk + rk[r0 + 2] * x_stride;
+      const int16_t* x3 = xk + rk[r0 + 3] * x_stride;
+      for (int t = 0; t < run; t += 8, block += 32) {
+        __m512i wv = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)));
+        acc = _mm512_add_epi32(acc, _mm512_madd_epi16(load_x4(x0 + t, x1 + t, x2 + t, x3 + t), wv));
+      }
+    }
+    total = _mm512_fmadd_ps(_mm512_cvtepi32_ps(acc), _mm512_set1_ps(scales[k]), total);
+  }
+  return _mm512_reduce_add_ps(total);
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vnni"))) float gather_dot_i16i8_avx512vnni(const int8_t* w, size_t w_stride, const float* scales,
+                                                                                         const int32_t* rows, const int32_t* cols, size_t n_models,
+                                                                                         int n_rows, int run, const int16_t* x, size_t x_stride) {
+  __m512 total = _mm512_setzero_ps();
+  for (size_t k = 0; k < n_models; ++k) {
+    const int8_t* block = w + k * w_stride;
+    const int32_t* rk = rows + k * n_rows;
+    const int16_t* xk = x + cols[k];
+    __m512i acc = _mm512_setzero_si512();
+    for (int r0 = 0; r0 < n_rows; r0 += 4) {
+      const int16_t* x0 = xk + rk[r0] * x_stride;
+      const int16_t* x1 = xk + rk[r0 + 1] * x_stride;
+      const int16_t* x2 = xk + rk[r0 + 2] * x_stride;
+      const int16_t* x3 = xk + rk[r0 + 3] * x_stride;
+      for (int t = 0; t < run; t += 8, block += 32) {
+        __m512i wv = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)));
+        acc = _mm512_dpwssd_epi32(acc, load_x4(x0 + t, x1 + t, x2 + t, x3 + t), wv);
+      }
+    }
+    total = _mm512_fmadd_ps(_mm512_cvtepi32_ps(acc), _mm512_set1_ps(scales[k]), total);
+  }
+  return _mm512_reduce_add_ps(total);
+}
+#endif
+
+using DotFn = float (*)(const float*, const float*, size_t);
+using GatherDotFn = float (*)(const float*, size_t, const int32_t*, const int32_t*, size_t, int, int, const float*,
+                              size_t);
+using DotI16I8Fn = int32_t (*)(const int16_t*, const int8_t*, size_t);
+using MaxAbsFn = float (*)(const float*, size_t);
+using QuantizeFn = void (*)(const float*, size_t, float, int16_t*);
+using GatherDotI16I8Fn = float (*)(const int8_t*, size_t, const float*, const int32_t*, const int32_t*, size_t, int, int,
+                                   const int16_t*, size_t);
+
+SimdLevel detect_level() {
+#ifdef RSVP_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::kAvx2;
+#endif
+  return SimdLevel::kScalar;
+}
+
+DotFn select_dot(SimdLevel level) {
+#ifdef RSVP_SIMD_X86
+  if (level == SimdLevel::kAvx512) return dot_f32_avx512;
+  if (level == SimdLevel::kAvx2) return dot_f32_avx2;
+#endif
+  (void)level;
+  return dot_f32_scalar;
+}
+
+GatherDotFn select_gather_dot(SimdLevel level) {
+#ifdef RSVP_SIMD_X86
+  if (level == SimdLevel::kAvx512) return gather_dot_f32_avx512;
+  if (level == SimdLevel::kAvx2) return gather_dot_f32_avx2;
+#endif
+  (void)level;
+  return gather_dot_f32_scalar;
+}
+
+// 定点内核：在选定指令集内再按 AVX512BW / VNNI 细分
+struct QuantKernels {
+  const char* name;
+  DotI16I8Fn dot;
+  GatherDotI16I8Fn gather_dot;
+  MaxAbsFn max_abs{max_abs_f32_scalar};
+  QuantizeFn quantize{quantize_f32_i16_scalar};
+};
+
+QuantKernels select_quant(SimdLevel level) {
+#ifdef RSVP_SIMD_X86
+  __builtin_cpu_init();
+  if (level == SimdLevel::kAvx512 && __builtin_cpu_supports("avx512bw")) {
+    if (__builtin_cpu_supports("avx512vnni")) {
+      return {"avx512-vnni", dot_i16i8_avx512vnni, gather_dot_i16i8_avx512vnni, max_abs_f32_avx2,
+              quantize_f32_i16_avx2};
+    }
+    return {"avx512bw", dot_i16i8_avx512, gather_dot_i16i8_avx512, max_abs_f32_avx2, quantize_f32_i16_avx2};
+  }
+  if (level != SimdLevel::kScalar) {
+    if (__builtin_cpu_supports("avxvnni")) {
+      return {"avx-vnni", dot_i16i8_avxvnni, gather_dot_i16i8_avxvnni, max_abs_f32_avx2, quantize_f32_i16_avx2};
+    }
+    return {"avx2", dot_i16i8_avx2, gather_dot_i16i8_avx2, max_abs_f32_avx2, quantize_f32_i16_avx2};
+  }
+#endif
+  (void)level;
+  return {"scalar", dot_i16i8_scalar, gather_dot_i16i8_scalar};
+}
+
+// 当前选用的实现（首次调用时初始化）
+struct Dispatch {
+  std::atomic<SimdLevel> level;
+  std::atomic<DotFn> dot;
+  std::atomic<GatherDotFn> gather_dot;
+  std::atomic<const char*> quant_name;
+  std::atomic<DotI16I8Fn> quant_dot;
+  std::atomic<GatherDotI16I8Fn> quant_gather_dot;
+  std::atomic<MaxAbsFn> max_abs;
+  std::atomic<QuantizeFn> quantize;
+  Dispatch()
+      : level(detect_level()), dot(select_dot(level.load())), gather_dot(select_gather_dot(level.load())) {
+    store_quant(select_quant(level.load()));
+  }
+  void store_quant(const QuantKernels& kernels) {
+    quant_name.store(kernels.name, std::memory_order_relaxed);
+    quant_dot.store(kernels.dot, std::memory_order_relaxed);
+    quant_gather_dot.store(kernels.gather_dot, std::memory_order_relaxed);
+    max_abs.store(kernels.max_abs, std::memory_order_relaxed);
+    quantize.store(kernels.quantize, std::memory_order_relaxed);
+  }
+};
+
+Dispatch& dispatch() {
+  static Dispatch instance;
+  return instance;
+}
+
+}  // namespace
+
+SimdLevel simd_level() { return dispatch().level.load(std::memory_order_relaxed); }
+
+const char* simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kAvx512: return "avx512";
+    case SimdLevel::kAvx2: return "avx2";
+    default: return "scalar";
+  }
+}
+
+void set_simd_level(SimdLevel level) {
+  SimdLevel supported = detect_level();
+  if (static_cast<int>(level) > static_cast<int>(supported)) {
+    level = SimdLevel::kScalar;
+  }
+  dispatch().level.store(level, std::memory_order_relaxed);
+  dispatch().dot.store(select_dot(level), std::memory_order_relaxed);
+  dispatch().gather_dot.store(select_gather_dot(level), std::memory_order_relaxed);
+  dispatch().store_quant(select_quant(level));
+}
+
+float dot_f32(const float* a, const float* b, size_t n) {
+  return dispatch().dot.load(std::memory_order_relaxed)(a, b, n);
+}
+
+float gather_dot_f32(const float* w, size_t w_stride, const int32_t* rows, const int32_t* cols, size_t n_models,
+                     int n_rows, int run, const float* x, size_t x_stride) {
+  return dispatch().gather_dot.load(std::memory_order_relaxed)(w, w_stride, rows, cols, n_models, n_rows, run, x,
+                                                               x_stride);
+}
+
+int32_t dot_i16i8(const int16_t* x, const int8_t* w, size_t n) {
+  return dispatch().quant_dot.load(std::memory_order_relaxed)(x, w, n);
+}
+
+float gather_dot_i16i8(const int8_t* w, size_t w_stride, const float* scales, const int32_t* rows,
+                       const int32_t* cols, size_t n_models, int n_rows, int run, const int16_t* x, size_t x_stride) {
+  return dispatch().quant_gather_dot.load(std::memory_order_relaxed)(w, w_stride, scales, rows, cols, n_models,
+                                                                     n_rows, run, x, x_stride);
+}
+
+float max_abs_f32(const float* x, size_t n) { return dispatch().max_abs.load(std::memory_order_relaxed)(x, n); }
+
+void quantize_f32_i16(const float* x, size_t n, float scale, int16_t* out) {
+  dispatch().quantize.load(std::memory_order_relaxed)(x, n, scale, out);
+}
+
+const char* quant_kernel_name() { return dispatch().quant_name.load(std::memory_order_relaxed); }
@@ -0,0 +1,352 @@
+#include "inference/xgbdim_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "inference/simd_kernels.h"
+#include "inference/xgbdim_quantized.h"
+
+namespace {
+
+constexpr size_t kWeightBlockBytes = 16 * 1024;  // 批推理时每段权重的大小（留在 L1 中）
+
+// 严格模式的舍入余量（相对于全部局部项的上界）：分段求和与一次求和的 float 舍入差远小于此值
+constexpr double kStrictSlack = 1e-4;
+
+// 每个线程复用的去均值 epoch 缓冲区（批推理时每个 epoch 一块）
+AlignedBuffer<float>& thread_scratch(size_t size) {
+  thread_local AlignedBuffer<float> scratch;
+  if (scratch.size() < size) {
+    scratch.resize(size);
+  }
+  return scratch;
+}
+
+// 按通道去均值，结果连续存放到 dst
+void demean_epoch(const float* epoch, size_t row_stride, int channels, int samples, float* dst) {
+  for (int c = 0; c < channels; ++c) {
+    const float* src = epoch + c * row_stride;
+    float* row = dst + static_cast<size_t>(c) * samples;
+    // 8 路独立累加，避免逐个相加的加法延迟链
+    double lanes[8] = {};
+    int t = 0;
+    for (; t + 8 <= samples; t += 8) {
+      for (int l = 0; l < 8; ++l) lanes[l] += src[t + l];
+    }
+    double sum = 0.0;
+    for (; t < samples; ++t) sum += src[t];
+    for (double lane : lanes) sum += lane;
+    float mean = static_cast<float>(sum / samples);
+    for (t = 0; t < samples; ++t) row[t] = src[t] - mean;
+  }
+}
+
+XgbdimResult make_result(double h, int models_evaluated) {
+  XgbdimResult result;
+  result.decision = static_cast<float>(h);
+  result.score = static_cast<float>(1.0 / (1.0 + std::exp(-h)));
+  result.label = result.score >= 0.5f ? 1 : 0;
+  result.models_evaluated = models_evaluated;
+  return result;
+}
+
+}  // namespace
+
+XgbdimEarlyExit XgbdimEarlyExit::from_config(const ConfigNode& node) {
+  XgbdimEarlyExit early_exit;
+  early_exit.enabled = node.get_bool("enabled", early_exit.enabled);
+  early_exit.strict = node.get_bool("strict", early_exit.strict);
+  early_exit.bound_scale = node.get_double("bound_scale", early_exit.bound_scale);
+  early_exit.block = node.get_int("block", early_exit.block);
+  if (early_exit.block < 1) {
+    throw std::runtime_error("early_exit.block must be >= 1");
+  }
+  if (!(early_exit.bound_scale > 0.0)) {
+    throw std::runtime_error("early_exit.bound_scale must be > 0");
+  }
+  return early_exit;
+}
+
+XgbdimEngine::XgbdimEngine(const XgbdimParams& params, const XgbdimGeometry& geometry) : geometry_(geometry) {
+  if (geometry_.n_conv == 0) {
+    geometry_.build();
+  }
+  params.validate(geometry_);
+  fold_global(params);
+  fold_local(params);
+  folded_.global_weight = global_weight_.data();
+  folded_.local_weight = local_weight_.data();
+  folded_.local_rows = local_rows_.data();
+  folded_.local_cols = local_cols_.data();
+  build_bounds();
+}
+
+XgbdimEngine::XgbdimEngine(const XgbdimGeometry& geometry, const XgbdimFoldedModel& folded,
+                           std::shared_ptr<const void> storage)
+    : geometry_(geometry), folded_(folded), storage_(std::move(storage)) {
+  if (geometry_.n_conv == 0) {
+    geometry_.build();
+  }
+  build_bounds();
+}
+
+void XgbdimEngine::set_precision(XgbdimPrecision precision) {
+  if (precision == XgbdimPrecision::kInt8) {
+    quantized_ = std::make_shared<XgbdimQuantizedModel>(geometry_, folded_);
+  } else {
+    quantized_.reset();
+  }
+}
+
+XgbdimPrecision XgbdimEngine::parse_precision(const std::string& name) {
+  if (name == "float32") return XgbdimPrecision::kFloat32;
+  if (name == "int8") return XgbdimPrecision::kInt8;
+  throw std::runtime_error("Unknown XGB-DIM precision: " + name);
+}
+
+const char* XgbdimEngine::precision_name(XgbdimPrecision precision) {
+  return precision == XgbdimPrecision::kInt8 ? "int8" : "float32";
+}
+
+void XgbdimEngine::fold_global(const XgbdimParams& params) {
+  const int channels = geometry_.n_channels;
+  const int samples = geometry_.n_samples;
+
+  // sum_{m,p} W[m,:] X Q[:,p] / (N_sp N_te) = w_bar^T X q_bar
+  std::vector<double> w_bar(channels, 0.0);
+  std::vector<double> q_bar(samples, 0.0);
+  for (int m = 0; m < params.n_sp; ++m) {
+    for (int c = 0; c < channels; ++c) {
+      w_bar[c] += params.w_global[static_cast<size_t>(m) * channels + c];
+    }
+  }
+  for (int t = 0; t < samples; ++t) {
+    for (int p = 0; p < params.n_te; ++p) {
+      q_bar[t] += params.q_global[static_cast<size_t>(t) * params.n_te + p];
+    }
+  }
+
+  // 有局部子模型时全局项乘以 gstf_weight
+  const double scale = (geometry_.n_model > 1 ? geometry_.gstf_weight : 1.0) / params.n_sp / params.n_te;
+  global_weight_.resize(static_cast<size_t>(channels) * samples);
+  double constant = 0.0;
+  for (int c = 0; c < channels; ++c) {
+    for (int t = 0; t < samples; ++t) {
+      size_t i = static_cast<size_t>(c) * samples + t;
+      double inv_std = 1.0 / std::sqrt(params.sigma_global[i]);
+      double coeff = scale * w_bar[c] * q_bar[t];
+      // gamma (x - m) / std + beta
+      global_weight_[i] = static_cast<float>(coeff * params.gamma_global[i] * inv_std);
+      constant += coeff * (params.beta_global[i] - params.gamma_global[i] * params.m_global[i] * inv_std);
+    }
+  }
+  folded_.bias = constant + (geometry_.n_model > 1 ? geometry_.gstf_weight : 1.0) * params.b_global;
+}
+
+void XgbdimEngine::fold_local(const XgbdimParams& params) {
+  const int t_local = geometry_.t_local;
+  const int chan_len = geometry_.chan_len;
+  const int win_len = geometry_.win_len;
+  const int n_local = geometry_.n_model > 1 ? geometry_.n_model - 1 : 0;
+  const size_t local_stride = (static_cast<size_t>(t_local) + 15) / 16 * 16;
+  folded_.n_local = n_local;
+  folded_.local_stride = local_stride;
+  local_weight_.resize(static_cast<size_t>(n_local) * local_stride);
+  local_rows_.assign(static_cast<size_t>(n_local) * chan_len, 0);
+  local_cols_.assign(n_local, 0);
+
+  for (int k = 0; k < n_local; ++k) {
+    const double lr = params.lr_model[k];
+    const double g = params.gamma[k];
+    const double b = params.beta[k];
+    const double* w = &params.w_local[static_cast<size_t>(k) * (t_local + 1)];
+    const double* m = &params.m_local[static_cast<size_t>(k) * t_local];
+    const double* s = &params.sigma[static_cast<size_t>(k) * t_local];
+
+    // lr * (sum_j w_j (g (x_j - m_j) / std_j + b) + w_0)
+    // 立方体第 j 个元素为 (t, c) = (j / chan_len, j % chan_len)，权重改存到 [c][t]
+    double constant = w[0];
+    for (int j = 0; j < t_local; ++j) {
+      double inv_std = 1.0 / std::sqrt(s[j]);
+      int t = j / chan_len;
+      int c = j % chan_len;
+      local_weight_[k * local_stride + c * win_len + t] = static_cast<float>(lr * w[j + 1] * g * inv_std);
+      constant += w[j + 1] * (b - g * m[j] * inv_std);
+    }
+    folded_.bias += lr * constant;
+
+    geometry_.cuboid_gather(params.conv_sort[k], &local_rows_[static_cast<size_t>(k) * chan_len], &local_cols_[k]);
+  }
+}
+
+void XgbdimEngine::build_bounds() {
+  const int chan_len = geometry_.chan_len;
+  const int win_len = geometry_.win_len;
+  local_l1_.assign(static_cast<size_t>(folded_.n_local) * chan_len, 0.0f);
+  for (int k = 0; k < folded_.n_local; ++k) {
+    const float* w = folded_.local_weight + k * folded_.local_stride;
+    for (int r = 0; r < chan_len; ++r) {
+      double l1 = 0.0;
+      for (int t = 0; t < win_len; ++t) l1 += std::fabs(w[r * win_len + t]);
+      local_l1_[static_cast<size_t>(k) * chan_len + r] = static_cast<float>(l1);
+    }
+  }
+}
+
+int XgbdimEngine::local_early_exit(const float* x, size_t stride, const XgbdimEarlyExit& early_exit,
+                                   double& h) const {
+  const XgbdimFoldedModel& model = folded_;
+  const int chan_len = geometry_.chan_len;
+  const int block = early_exit.block;
+  const int n_blocks = (model.n_local + block - 1) / block;
+
+  // 各行最大绝对值 -> 从每个检查点起剩余子模型贡献之和的上界 bounds[b]（n_blocks + 1 项）
+  thread_local std::vector<float> row_max;
+  thread_local std::vector<double> bounds;
+  row_max.resize(geometry_.n_channels);
+  for (int c = 0; c < geometry_.n_channels; ++c) {
+    row_max[c] = max_abs_f32(x + c * stride, geometry_.n_samples);
+  }
+  bounds.assign(n_blocks + 1, 0.0);
+  double remaining = 0.0;
+  for (int k = model.n_local - 1; k >= 0; --k) {
+    const float* l1 = &local_l1_[static_cast<size_t>(k) * chan_len];
+    const int32_t* rows = model.local_rows + static_cast<size_t>(k) * chan_len;
+    for (int r = 0; r < chan_len; ++r) remaining += static_cast<double>(l1[r]) * row_max[rows[r]];
+    if (k % block == 0) {
+      bounds[k / block] = remaining;
+    }
+  }
+  const double scale = early_exit.strict ? 1.0 : early_exit.bound_scale;
+  const double slack = early_exit.strict ? kStrictSlack * bounds[0] : 0.0;
+
+  int k0 = 0;
+  for (int b = 0; b < n_blocks; ++b, k0 += block) {
+    if (std::fabs(h) > bounds[b] * scale + slack) {
+      break;
+    }
+    const int models = std::min(block, model.n_local - k0);
+    h += gather_dot_f32(model.local_weight + k0 * model.local_stride, model.local_stride,
+                        model.local_rows + static_cast<size_t>(k0) * chan_len, model.local_cols + k0, models,
+                        chan_len, geometry_.win_len, x, stride);
+  }
+  return std::min(k0, model.n_local);
+}
+
+XgbdimResult XgbdimEngine::predict(const float* epoch, size_t row_stride) const {
+  return predict(epoch, row_stride, early_exit_);
+}
+
+XgbdimResult XgbdimEngine::predict(const float* epoch, size_t row_stride, const XgbdimEarlyExit& early_exit) const {
+  const int channels = geometry_.n_channels;
+  const int samples = geometry_.n_samples;
+  const XgbdimFoldedModel& model = folded_;
+
+  // 去均值（不去均值时直接读取输入，行间距任意）
+  const float* x = epoch;
+  size_t stride = row_stride;
+  if (demean_) {
+    float* scratch = thread_scratch(static_cast<size_t>(channels) * samples).data();
+    demean_epoch(epoch, row_stride, channels, samples, scratch);
+    x = scratch;
+    stride = samples;
+  }
+
+  if (quantized_) {
+    return make_result(quantized_->decision(x, stride), model.n_local);
+  }
+
+  // 全局项：连续存放时为一次长度 n_channels * n_samples 的点积，否则逐行点积
+  double h = model.bias;
+  if (stride == static_cast<size_t>(samples)) {
+    h += dot_f32(model.global_weight, x, static_cast<size_t>(channels) * samples);
+  } else {
+    for (int c = 0; c < channels; ++c) {
+      h += dot_f32(model.global_weight + static_cast<size_t>(c) * samples, x + c * stride, samples);
+    }
+  }
+
+  // 局部项：按聚集表直接从 epoch 各行读取，不生成立方体
+  if (early_exit.enabled) {
+    int evaluated = local_early_exit(x, stride, early_exit, h);
+    return make_result(h, evaluated);
+  }
+  if (model.n_local > 0) {
+    h += gather_dot_f32(model.local_weight, model.local_stride, model.local_rows, model.local_cols, model.n_local,
+                        geometry_.chan_len, geometry_.win_len, x, stride);
+  }
+
+  return make_result(h, model.n_local);
+}
+
+void XgbdimEngine::predict_batch(const float* const* epochs, const size_t* row_strides, size_t count,
+                                 XgbdimResult* results) const {
+  const int channels = geometry_.n_channels;
+  const int samples = geometry_.n_samples;
+  const size_t epoch_size = static_cast<size_t>(channels) * samples;
+  const XgbdimFoldedModel& model = folded_;
+
+  // 定点模型的权重本身已经很小；提前退出时各 epoch 求值的子模型数不同，均逐个推理
+  if (quantized_ || early_exit_.enabled) {
+    for (size_t i = 0; i < count; ++i) {
+      results[i] = predict(epochs[i], row_strides[i]);
+    }
+    return;
+  }
+
+  for (size_t first = 0; first < count; first += kBatchBlock) {
+    const size_t n = std::min(kBatchBlock, count - first);
+    const float* x[kBatchBlock];
+    size_t stride[kBatchBlock];
+    double h[kBatchBlock];
+
+    float* scratch = demean_ ? thread_scratch(kBatchBlock * epoch_size).data() : nullptr;
+    for (size_t b = 0; b < n; ++b) {
+      if (demean_) {
+        demean_epoch(epochs[first + b], row_strides[first + b], channels, samples, scratch + b * epoch_size);
+        x[b] = scratch + b * epoch_size;
+        stride[b] = samples;
+      } else {
+        x[b] = epochs[first + b];
+        stride[b] = row_strides[first + b];
+      }
+      h[b] = model.bias;
+    }
+
+    // 全局项：每次取一段约 kWeightBlockBytes 的权重，依次与本块所有 epoch 的对应行做点积
+    const int row_block = std::max(1, static_cast<int>(kWeightBlockBytes / sizeof(float) / samples));
+    for (int c0 = 0; c0 < channels; c0 += row_block) {
+      const int rows = std::min(row_block, channels - c0);
+      const float* w = model.global_weight + static_cast<size_t>(c0) * samples;
+      for (size_t b = 0; b < n; ++b) {
+        if (stride[b] == static_cast<size_t>(samples)) {
+          h[b] += dot_f32(w, x[b] + static_cast<size_t>(c0) * samples, static_cast<size_t>(rows) * samples);
+        } else {
+          for (int c = 0; c < rows; ++c) {
+            h[b] += dot_f32(w + static_cast<size_t>(c) * samples, x[b] + (c0 + c) * stride[b], samples);
+          }
+        }
+      }
+    }
+
+    // 局部项：同样按权重分段，每段子模型的权重与聚集表读入一次，依次作用于本块所有 epoch
+    if (model.n_local > 0) {
+      const int model_block = std::max(1, static_cast<int>(kWeightBlockBytes / sizeof(float) / model.local_stride));
+      for (int k0 = 0; k0 < model.n_local; k0 += model_block) {
+        const int models = std::min(model_block, model.n_local - k0);
+        const float* w = model.local_weight + k0 * model.local_stride;
+        const int32_t* rows = model.local_rows + static_cast<size_t>(k0) * geometry_.chan_len;
+        for (size_t b = 0; b < n; ++b) {
+          h[b] += gather_dot_f32(w, model.local_stride, rows, model.local_cols + k0, models, geometry_.chan_len,
+                                 geometry_.win_len, x[b], stride[b]);
+        }
+      }
+    }
+
+    for (size_t b = 0; b < n; ++b) {
+      results[first + b] = make_result(h[b], model.n_local);
+    }
+  }
+}
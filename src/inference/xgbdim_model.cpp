@@ -0,0 +1,178 @@
+#include "inference/xgbdim_model.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "inference/npz_reader.h"
+
+namespace {
+
+// NeuroScan 64 导联下 self.channel 的默认取值（1 基）
+std::vector<int> default_channel_map() {
+  std::vector<int> channel;
+  for (int c = 6; c < 54; ++c) channel.push_back(c);
+  for (int c : {58, 54, 60, 55, 56, 57}) channel.push_back(c);
+  return channel;
+}
+
+void check_size(const std::vector<double>& values, size_t expected, const char* name) {
+  if (values.size() != expected) {
+    throw std::runtime_error(std::string("XGB-DIM model field ") + name + " has " + std::to_string(values.size()) +
+                             " values, expected " + std::to_string(expected));
+  }
+}
+
+const NpyArray& field(const std::map<std::string, NpyArray>& arrays, const char* name) {
+  auto it = arrays.find(name);
+  if (it == arrays.end()) {
+    throw std::runtime_error(std::string("XGB-DIM model is missing field ") + name);
+  }
+  return it->second;
+}
+
+// 标量或与目标同形状的数组，统一展开为 count 个元素
+std::vector<double> broadcast(const NpyArray& array, size_t count, const char* name) {
+  if (array.size() == 1) {
+    return std::vector<double>(count, array.scalar());
+  }
+  check_size(array.data, count, name);
+  return array.data;
+}
+
+}  // namespace
+
+void XgbdimGeometry::build() {
+  if (channel_map.empty()) {
+    channel_map = default_channel_map();
+  }
+  chan_len = chan_xlen * chan_ylen;
+  t_local = win_len * chan_len;
+
+  // 电极块：按 get_3Dconv 的顺序（先纵向起点，再横向起点），块内按 cup.T.reshape(-1) 展开
+  channel_conv.clear();
+  for (int y = 0; y + chan_ylen <= grid_rows; y += step_y) {
+    for (int x = 0; x + chan_xlen <= grid_cols; x += step_x) {
+      std::vector<int> block;
+      for (int cx = 0; cx < chan_xlen; ++cx) {
+        for (int cy = 0; cy < chan_ylen; ++cy) {
+          block.push_back((y + cy) * grid_cols + (x + cx) + 1);
+        }
+      }
+      channel_conv.push_back(block);
+    }
+  }
+
+  // 时间窗：range(1, n_samples - win_len + 1, win_len / 2)，转为 0 基
+  window_start.clear();
+  int step_win = std::max(1, win_len / 2);
+  for (int st = 1; st < n_samples - win_len + 1; st += step_win) {
+    window_start.push_back(st - 1);
+  }
+
+  n_win = static_cast<int>(window_start.size());
+  n_chanwin = static_cast<int>(channel_conv.size());
+  n_conv = n_win * n_chanwin;
+  n_model = std::min(n_conv, max_n_model);
+
+  for (const auto& block : channel_conv) {
+    for (int logical : block) {
+      if (logical < 1 || logical > static_cast<int>(channel_map.size())) {
+        throw std::runtime_error("XGB-DIM channel_map does not cover electrode " + std::to_string(logical));
+      }
+      int row = channel_map[logical - 1];
+      if (row < 1 || row > n_channels) {
+        throw std::runtime_error("XGB-DIM channel_map row " + std::to_string(row) + " is outside the epoch");
+      }
+    }
+  }
+}
+
+void XgbdimGeometry::cuboid_gather(int conv, int* rows, int* col) const {
+  int idx_chan = conv / n_win;
+  int idx_win = conv % n_win;
+  for (int c = 0; c < chan_len; ++c) {
+    rows[c] = channel_map[channel_conv[idx_chan][c] - 1] - 1;
+  }
+  *col = window_start[idx_win];
+}
+
+XgbdimGeometry XgbdimGeometry::from_config(const ConfigNode& node) {
+  XgbdimGeometry geometry;
+  geometry.n_channels = node.get_int("n_channels", geometry.n_channels);
+  geometry.n_samples = node.get_int("n_samples", geometry.n_samples);
+  geometry.win_len = node.get_int("win_len", geometry.win_len);
+  geometry.chan_xlen = node.get_int("chan_xlen", geometry.chan_xlen);
+  geometry.chan_ylen = node.get_int("chan_ylen", geometry.chan_ylen);
+  geometry.step_x = node.get_int("step_x", geometry.step_x);
+  geometry.step_y = node.get_int("step_y", geometry.step_y);
+  geometry.grid_rows = node.get_int("grid_rows", geometry.grid_rows);
+  geometry.grid_cols = node.get_int("grid_cols", geometry.grid_cols);
+  geometry.max_n_model = node.get_int("max_n_model", geometry.max_n_model);
+  geometry.gstf_weight = static_cast<float>(node.get_double("gstf_weight", geometry.gstf_weight));
+  geometry.channel_map = node.get_int_array("channel_map");
+  geometry.build();
+  return geometry;
+}
+
+XgbdimParams XgbdimParams::load_npz(const std::string& path, const XgbdimGeometry& geometry) {
+  auto arrays = ::load_npz(path);
+  const size_t global_size = static_cast<size_t>(geometry.n_channels) * geometry.n_samples;
+
+  XgbdimParams params;
+  const NpyArray& w_global = field(arrays, "W_global");
+  const NpyArray& q_global = field(arrays, "Q_global");
+  params.n_sp = static_cast<int>(w_global.dim(0));
+  params.n_te = static_cast<int>(q_global.dim(1));
+  params.w_global = w_global.data;
+  params.q_global = q_global.data;
+  params.b_global = field(arrays, "b_global").scalar();
+  params.gamma_global = broadcast(field(arrays, "Gamma_global"), global_size, "Gamma_global");
+  params.beta_global = broadcast(field(arrays, "Beta_global"), global_size, "Beta_global");
+  params.m_global = field(arrays, "M_global").data;
+  params.sigma_global = field(arrays, "Sigma_global").data;
+
+  const NpyArray& w_local = field(arrays, "W_local");
+  params.n_local = static_cast<int>(w_local.dim(0));
+  params.w_local = w_local.data;
+  params.gamma = field(arrays, "Gamma").data;
+  params.beta = field(arrays, "Beta").data;
+  params.m_local = field(arrays, "M_local").data;
+  params.sigma = field(arrays, "Sigma").data;
+  params.lr_model = field(arrays, "lr_model").data;
+  for (double index : field(arrays, "conv_sort").data) {
+    params.conv_sort.push_back(static_cast<int>(index));
+  }
+
+  params.validate(geometry);
+  return params;
+}
+
+void XgbdimParams::validate(const XgbdimGeometry& geometry) const {
+  const size_t channels = geometry.n_channels;
+  const size_t samples = geometry.n_samples;
+  check_size(w_global, static_cast<size_t>(n_sp) * channels, "W_global");
+  check_size(q_global, samples * n_te, "Q_global");
+  check_size(gamma_global, channels * samples, "Gamma_global");
+  check_size(beta_global, channels * samples, "Beta_global");
+  check_size(m_global, channels * samples, "M_global");
+  check_size(sigma_global, channels * samples, "Sigma_global");
+
+  const size_t used = geometry.n_model > 1 ? geometry.n_model - 1 : 0;
+  if (static_cast<size_t>(n_local) < used) {
+    throw std::runtime_error("XGB-DIM model has " + std::to_string(n_local) + " local models, geometry needs " +
+                             std::to_string(used));
+  }
+  check_size(w_local, static_cast<size_t>(n_local) * (geometry.t_local + 1), "W_local");
+  check_size(gamma, n_local, "Gamma");
+  check_size(beta, n_local, "Beta");
+  check_size(m_local, static_cast<size_t>(n_local) * geometry.t_local, "M_local");
+  check_size(sigma, static_cast<size_t>(n_local) * geometry.t_local, "Sigma");
+  if (lr_model.size() < used || conv_sort.size() < used) {
+    throw std::runtime_error("XGB-DIM lr_model / conv_sort are shorter than the number of local models");
+  }
+  for (size_t k = 0; k < used; ++k) {
+    if (conv_sort[k] < 0 || conv_sort[k] >= geometry.n_conv) {
+      throw std::runtime_error("XGB-DIM conv_sort entry out of range: " + std::to_string(conv_sort[k]));
+    }
+  }
+}
@@ -0,0 +1,173 @@
+#include "inference/xgbdim_model_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "utils/checksum.h"
+#include "utils/mapped_file.h"
+
+namespace {
+
+constexpr size_t kCrcOffset = 16;  // magic + version + crc32 之后的内容参与校验
+
+size_t align_up(size_t offset) { return (offset + kSimdAlignment - 1) / kSimdAlignment * kSimdAlignment; }
+
+// 在输出缓冲区末尾按 64 字节对齐追加一段数组，返回其偏移
+template <class T>
+uint64_t append_array(std::vector<unsigned char>& buffer, const T* data, size_t count) {
+  size_t offset = align_up(buffer.size());
+  buffer.resize(offset + count * sizeof(T), 0);
+  if (count > 0) {
+    std::memcpy(buffer.data() + offset, data, count * sizeof(T));
+  }
+  return offset;
+}
+
+// 检查一段数组是否完整落在文件内且满足对齐要求，返回其地址
+template <class T>
+const T* array_at(const MappedFile& file, uint64_t offset, size_t count, const char* name) {
+  if (offset % kSimdAlignment != 0 || offset > file.size() || count > (file.size() - offset) / sizeof(T)) {
+    throw std::runtime_error(file.path() + ": array " + name + " is misaligned or out of bounds");
+  }
+  return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+}  // namespace
+
+void save_xgbdim_model(const XgbdimEngine& engine, const std::string& path) {
+  const XgbdimGeometry& geometry = engine.geometry();
+  const XgbdimFoldedModel& folded = engine.folded();
+  const size_t row_count = static_cast<size_t>(folded.n_local) * geometry.chan_len;
+
+  XgbdimModelHeader header{};
+  std::memcpy(header.magic, kXgbdimModelMagic, sizeof(header.magic));
+  header.version = kXgbdimModelVersion;
+  header.header_size = sizeof(XgbdimModelHeader);
+  header.flags = engine.demean() ? kXgbdimModelFlagDemean : 0;
+  header.n_channels = geometry.n_channels;
+  header.n_samples = geometry.n_samples;
+  header.win_len = geometry.win_len;
+  header.chan_xlen = geometry.chan_xlen;
+  header.chan_ylen = geometry.chan_ylen;
+  header.step_x = geometry.step_x;
+  header.step_y = geometry.step_y;
+  header.grid_rows = geometry.grid_rows;
+  header.grid_cols = geometry.grid_cols;
+  header.max_n_model = geometry.max_n_model;
+  header.n_local = folded.n_local;
+  header.t_local = geometry.t_local;
+  header.local_stride = static_cast<uint32_t>(folded.local_stride);
+  header.gstf_weight = geometry.gstf_weight;
+  header.bias = folded.bias;
+  header.channel_map_count = static_cast<uint32_t>(geometry.channel_map.size());
+
+  std::vector<unsigned char> buffer(sizeof(XgbdimModelHeader), 0);
+  std::vector<int32_t> channel_map(geometry.channel_map.begin(), geometry.channel_map.end());
+  header.channel_map_offset = append_array(buffer, channel_map.data(), channel_map.size());
+  header.global_weight_offset =
+      append_array(buffer, folded.global_weight, static_cast<size_t>(geometry.n_channels) * geometry.n_samples);
+  header.local_weight_offset =
+      append_array(buffer, folded.local_weight, static_cast<size_t>(folded.n_local) * folded.local_stride);
+  header.local_rows_offset = append_array(buffer, folded.local_rows, row_count);
+  header.local_cols_offset = append_array(buffer, folded.local_cols, folded.n_local);
+  buffer.resize(align_up(buffer.size()), 0);
+
+  header.file_size = buffer.size();
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  header.crc32 = crc32(buffer.data() + kCrcOffset, buffer.size() - kCrcOffset);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Failed to create " + temp_path);
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!out) {
+      throw std::runtime_error("Failed to write " + temp_path);
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    throw std::runtime_error("Failed to rename " + temp_path + " to " + path);
+  }
+}
+
+std::shared_ptr<XgbdimEngine> load_xgbdim_model(const std::string& path) {
+  auto file = std::make_shared<MappedFile>(path);
+  if (file->size() < sizeof(XgbdimModelHeader)) {
+    throw std::runtime_error(path + ": file is too small to be an XGB-DIM model");
+  }
+
+  XgbdimModelHeader header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, kXgbdimModelMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error(path + ": not an XGB-DIM binary model");
+  }
+  if (header.version != kXgbdimModelVersion) {
+    throw std::runtime_error(path + ": unsupported model version " + std::to_string(header.version) +
+                             " (re-run xgbdim_convert to regenerate it)");
+  }
+  if (header.header_size != sizeof(XgbdimModelHeader) || header.file_size != file->size()) {
+    throw std::runtime_error(path + ": header size or file size mismatch (truncated file?)");
+  }
+  uint32_t crc = crc32(file->data() + kCrcOffset, file->size() - kCrcOffset);
+  if (crc != header.crc32) {
+    throw std::runtime_error(path + ": checksum mismatch");
+  }
+
+  // 按文件中的参数重建时空划分，并核对折叠结果的形状
+  XgbdimGeometry geometry;
+  geometry.n_channels = header.n_channels;
+  geometry.n_samples = header.n_samples;
+  geometry.win_len = header.win_len;
+  geometry.chan_xlen = header.chan_xlen;
+  geometry.chan_ylen = header.chan_ylen;
+  geometry.step_x = header.step_x;
+  geometry.step_y = header.step_y;
+  geometry.grid_rows = header.grid_rows;
+  geometry.grid_cols = header.grid_cols;
+  geometry.max_n_model = header.max_n_model;
+  geometry.gstf_weight = header.gstf_weight;
+  const int32_t* channel_map = array_at<int32_t>(*file, header.channel_map_offset, header.channel_map_count,
+                                                 "channel_map");
+  geometry.channel_map.assign(channel_map, channel_map + header.channel_map_count);
+  geometry.build();
+
+  const int expected_local = geometry.n_model > 1 ? geometry.n_model - 1 : 0;
+  if (header.n_local != expected_local || header.t_local != geometry.t_local ||
+      header.local_stride < static_cast<uint32_t>(geometry.t_local)) {
+    throw std::runtime_error(path + ": local model shape does not match its geometry");
+  }
+
+  const size_t row_count = static_cast<size_t>(header.n_local) * geometry.chan_len;
+  XgbdimFoldedModel folded;
+  folded.bias = header.bias;
+  folded.n_local = header.n_local;
+  folded.local_stride = header.local_stride;
+  folded.global_weight = array_at<float>(*file, header.global_weight_offset,
+                                         static_cast<size_t>(geometry.n_channels) * geometry.n_samples,
+                                         "global_weight");
+  folded.local_weight = array_at<float>(*file, header.local_weight_offset,
+                                        static_cast<size_t>(header.n_local) * header.local_stride, "local_weight");
+  folded.local_rows = array_at<int32_t>(*file, header.local_rows_offset, row_count, "local_rows");
+  folded.local_cols = array_at<int32_t>(*file, header.local_cols_offset, header.n_local, "local_cols");
+  for (size_t i = 0; i < row_count; ++i) {
+    if (folded.local_rows[i] < 0 || folded.local_rows[i] >= geometry.n_channels) {
+      throw std::runtime_error(path + ": cuboid row outside the epoch");
+    }
+  }
+  for (int k = 0; k < header.n_local; ++k) {
+    if (folded.local_cols[k] < 0 || folded.local_cols[k] + geometry.win_len > geometry.n_samples) {
+      throw std::runtime_error(path + ": cuboid window outside the epoch");
+    }
+  }
+
+  auto engine = std::make_shared<XgbdimEngine>(geometry, folded, file);
+  engine->set_demean((header.flags & kXgbdimModelFlagDemean) != 0);
+  return engine;
+}
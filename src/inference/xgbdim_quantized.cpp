@@ -0,0 +1,127 @@
+#include "inference/xgbdim_quantized.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "inference/simd_kernels.h"
+#include "inference/xgbdim_engine.h"
+
+namespace {
+
+constexpr size_t kLanes = 32;        // 行与权重的补零粒度（AVX-512 一次 32 个 int16）
+constexpr float kInputRange = 32767.0f;
+constexpr float kWeightRange = 127.0f;
+
+size_t round_up(size_t value, size_t multiple) { return (value + multiple - 1) / multiple * multiple; }
+
+// 对称量化到 [-127, 127] 的缩放系数（全为 0 时返回 0）
+float weight_scale(const float* values, size_t n) {
+  float max_abs = 0.0f;
+  for (size_t i = 0; i < n; ++i) max_abs = std::max(max_abs, std::fabs(values[i]));
+  return max_abs / kWeightRange;
+}
+
+int8_t quantize_weight(float value, float scale) {
+  return scale == 0.0f ? 0 : static_cast<int8_t>(std::lrint(value / scale));
+}
+
+AlignedBuffer<int16_t>& thread_scratch(size_t size) {
+  thread_local AlignedBuffer<int16_t> scratch;
+  if (scratch.size() < size) {
+    scratch.resize(size);
+  }
+  return scratch;
+}
+
+}  // namespace
+
+XgbdimQuantizedModel::XgbdimQuantizedModel(const XgbdimGeometry& geometry, const XgbdimFoldedModel& folded)
+    : n_channels_(geometry.n_channels),
+      n_samples_(geometry.n_samples),
+      n_local_(folded.n_local),
+      n_rows_(static_cast<int>(round_up(geometry.chan_len, 4))),
+      run_(static_cast<int>(round_up(geometry.win_len, 8))),
+      bias_(folded.bias) {
+  row_stride_ = round_up(static_cast<size_t>(n_samples_) + run_, kLanes);
+  local_stride_ = static_cast<size_t>(n_rows_) * run_;
+  if (local_stride_ > kQuantMaxDot) {
+    throw std::runtime_error("Quantized XGB-DIM needs chan_len x win_len (padded) <= " +
+                             std::to_string(kQuantMaxDot));
+  }
+
+  // 全局权重：每行一个缩放系数，行尾补零
+  global_weight_.resize(static_cast<size_t>(n_channels_) * row_stride_);
+  global_scale_.resize(n_channels_);
+  for (int c = 0; c < n_channels_; ++c) {
+    const float* row = folded.global_weight + static_cast<size_t>(c) * n_samples_;
+    global_scale_[c] = weight_scale(row, n_samples_);
+    for (int t = 0; t < n_samples_; ++t) {
+      global_weight_[c * row_stride_ + t] = quantize_weight(row[t], global_scale_[c]);
+    }
+  }
+
+  // 局部权重：按 gather_dot_i16i8 的分块布局存放，时间窗补零到 run_，补齐的电极指向第 0 行、权重为 0
+  const int chan_len = geometry.chan_len;
+  const int win_len = geometry.win_len;
+  local_weight_.resize(static_cast<size_t>(n_local_) * local_stride_);
+  local_scale_.resize(n_local_);
+  local_rows_.assign(static_cast<size_t>(n_local_) * n_rows_, 0);
+  local_cols_.assign(folded.local_cols, folded.local_cols + n_local_);
+  for (int k = 0; k < n_local_; ++k) {
+    const float* weight = folded.local_weight + k * folded.local_stride;
+    int8_t* block = local_weight_.data() + k * local_stride_;
+    local_scale_[k] = weight_scale(weight, static_cast<size_t>(chan_len) * win_len);
+    for (int r = 0; r < chan_len; ++r) {
+      for (int t = 0; t < win_len; ++t) {
+        block[((r / 4) * (run_ / 8) + t / 8) * 32 + (r % 4) * 8 + t % 8] =
+            quantize_weight(weight[r * win_len + t], local_scale_[k]);
+      }
+    }
+    std::copy(folded.local_rows + static_cast<size_t>(k) * chan_len, folded.local_rows + (k + 1) * chan_len,
+              local_rows_.begin() + static_cast<size_t>(k) * n_rows_);
+  }
+}
+
+double XgbdimQuantizedModel::decision(const float* epoch, size_t row_stride) const {
+  // 输入按整个 epoch 的最大绝对值量化
+  float max_abs = 0.0f;
+  for (int c = 0; c < n_channels_; ++c) {
+    max_abs = std::max(max_abs, max_abs_f32(epoch + c * row_stride, n_samples_));
+  }
+  if (max_abs == 0.0f) {
+    return bias_;
+  }
+  const float input_scale = max_abs / kInputRange;
+  const float inverse = kInputRange / max_abs;
+
+  // 行尾的补零区在首次分配时清零，之后只写前 n_samples 个元素
+  int16_t* x = thread_scratch(static_cast<size_t>(n_channels_) * row_stride_).data();
+  for (int c = 0; c < n_channels_; ++c) {
+    quantize_f32_i16(epoch + c * row_stride, n_samples_, inverse, x + c * row_stride_);
+  }
+
+  // 全局项：逐行整数点积（每次不超过 kQuantMaxDot 个元素）后乘以该行的缩放系数
+  double global = 0.0;
+  for (int c = 0; c < n_channels_; ++c) {
+    const int16_t* xr = x + c * row_stride_;
+    const int8_t* wr = global_weight_.data() + c * row_stride_;
+    int64_t acc = 0;
+    for (size_t t = 0; t < row_stride_; t += kQuantMaxDot) {
+      acc += dot_i16i8(xr + t, wr + t, std::min(kQuantMaxDot, row_stride_ - t));
+    }
+    global += static_cast<double>(global_scale_[c]) * acc;
+  }
+
+  double local = 0.0;
+  if (n_local_ > 0) {
+    local = gather_dot_i16i8(local_weight_.data(), local_stride_, local_scale_.data(), local_rows_.data(),
+                             local_cols_.data(), n_local_, n_rows_, run_, x, row_stride_);
+  }
+  return bias_ + input_scale * (global + local);
+}
+
+size_t XgbdimQuantizedModel::weight_bytes() const {
+  return global_weight_.size() + global_scale_.size() * sizeof(float) + local_weight_.size() +
+         local_scale_.size() * sizeof(float) + (local_rows_.size() + local_cols_.size()) * sizeof(int32_t);
+}
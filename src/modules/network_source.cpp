@@ -0,0 +1,329 @@
+#include "modules/network_source.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <thread>  // NOLINT
+
+#include "utils/package_trace.h"
+
+namespace {
+
+int64_t realtime_ns() {
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+sockaddr_in make_address(const std::string &host, int port) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<uint16_t>(port));
+  if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+    throw std::runtime_error("NetworkSource: invalid IPv4 address " + host);
+  }
+  return address;
+}
+
+constexpr size_t kControlBytes = CMSG_SPACE(sizeof(timespec));
+
+}  // namespace
+
+NetworkSourceConfig NetworkSourceConfig::from_config(const ConfigNode &node) {
+  NetworkSourceConfig config;
+  config.host = node.get_string("host", config.host);
+  config.port = node.get_int("port", config.port);
+  config.n_channels = node.get_int("n_channels", config.n_channels);
+  config.max_samples = node.get_int("max_samples", config.max_samples);
+  config.batch = node.get_int("batch", config.batch);
+  config.socket_buffer_kb = node.get_int("socket_buffer_kb", config.socket_buffer_kb);
+
+  std::string protocol = node.get_string("protocol", "udp");
+  if (protocol == "udp") {
+    config.protocol = Protocol::kUdp;
+  } else if (protocol == "tcp") {
+    config.protocol = Protocol::kTcp;
+  } else {
+    throw std::runtime_error("Unknown network protocol: " + protocol);
+  }
+  return config;
+}
+
+NetworkSource::NetworkSource(const NetworkSourceConfig &config, int max_queue_length, bool enable_profiler,
+                             int cpu_id, int npu_id, const WaitStrategy &wait_strategy)
+    : Source(max_queue_length, enable_profiler, cpu_id, npu_id, wait_strategy), config_(config) {
+  if (config_.n_channels < 1 || config_.n_channels > UINT16_MAX || config_.max_samples < 1 ||
+      config_.max_samples > INT16_MAX || config_.batch < 1 || config_.port < 0 || config_.port > 65535) {
+    throw std::invalid_argument("NetworkSource: invalid channel count, frame size, batch or port");
+  }
+  const size_t frame_bytes = config_.max_frame_bytes();
+  if (config_.protocol == NetworkSourceConfig::Protocol::kUdp) {
+    // 每个数据报一段缓冲区与一段控制消息（接收时间戳），地址在 recvmmsg 之间保持不变
+    const size_t batch = static_cast<size_t>(config_.batch);
+    datagrams_.resize(batch * frame_bytes);
+    controls_.resize(batch * kControlBytes);
+    iovecs_.resize(batch);
+    messages_.resize(batch);
+    for (size_t i = 0; i < batch; ++i) {
+      iovecs_[i].iov_base = datagrams_.data() + i * frame_bytes;
+      iovecs_[i].iov_len = frame_bytes;
+    }
+    open_udp();
+  } else {
+    stream_.resize(4 * frame_bytes);
+  }
+}
+
+NetworkSource::~NetworkSource() { close_socket(); }
+
+NetworkSource::Stats NetworkSource::stats() const {
+  Stats stats;
+  stats.frames = frames_.load(std::memory_order_relaxed);
+  stats.lost = lost_.load(std::memory_order_relaxed);
+  stats.gaps = gaps_.load(std::memory_order_relaxed);
+  stats.out_of_order = out_of_order_.load(std::memory_order_relaxed);
+  stats.malformed = malformed_.load(std::memory_order_relaxed);
+  stats.bytes = bytes_.load(std::memory_order_relaxed);
+  stats.reconnects = reconnects_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void NetworkSource::open_udp() {
+  fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0) {
+    throw std::runtime_error(std::string("NetworkSource: socket failed: ") + std::strerror(errno));
+  }
+  const int buffer_bytes = config_.socket_buffer_kb * 1024;
+  const int on = 1;
+  setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buffer_bytes, sizeof(buffer_bytes));
+  setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  setsockopt(fd_, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+  sockaddr_in address = make_address(config_.host, config_.port);
+  if (::bind(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+    const int error = errno;
+    close_socket();
+    throw std::runtime_error("NetworkSource: bind " + config_.host + ":" + std::to_string(config_.port) +
+                             " failed: " + std::strerror(error));
+  }
+  socklen_t length = sizeof(address);
+  getsockname(fd_, reinterpret_cast<sockaddr *>(&address), &length);
+  local_port_ = ntohs(address.sin_port);
+  MLOG_INFO("NetworkSource listening on udp %s:%d (%d channels, batch %d)", config_.host.c_str(), local_port_,
+            config_.n_channels, config_.batch);
+}
+
+bool NetworkSource::connect_tcp() {
+  fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0) {
+    throw std::runtime_error(std::string("NetworkSource: socket failed: ") + std::strerror(errno));
+  }
+  const int buffer_bytes = config_.socket_buffer_kb * 1024;
+  const int on = 1;
+  setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buffer_bytes, sizeof(buffer_bytes));
+  setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  sockaddr_in address = make_address(config_.host, config_.port);
+  if (::connect(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+    close_socket();
+    return false;
+  }
+  read_pos_ = write_pos_ = 0;
+  has_sequence_ = false;  // 重连后放大器可能重新编号
+  MLOG_INFO("NetworkSource connected to tcp %s:%d", config_.host.c_str(), config_.port);
+  return true;
+}
+
+void NetworkSource::close_socket() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool NetworkSource::wait_readable() {
+  if (!may_block()) {
+    return false;  // 执行器模式下不等待，下次 step 再取
+  }
+  pollfd descriptor{fd_, POLLIN, 0};
+  return ::poll(&descriptor, 1, static_cast<int>((block_timeout().count() + 999) / 1000)) > 0;
+}
+
+bool NetworkSource::process(Package *package) {
+  Frame frame;
+  while (config_.protocol == NetworkSourceConfig::Protocol::kUdp ? next_udp_frame(frame) : next_tcp_frame(frame)) {
+    if (accept_frame(frame, package)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool NetworkSource::next_udp_frame(Frame &frame) {
+  if (cursor_ == received_) {
+    // 先非阻塞地取，取不到再等待，避免每批都多一次 poll 系统调用
+    for (size_t i = 0; i < messages_.size(); ++i) {
+      msghdr &header = messages_[i].msg_hdr;
+      header = msghdr{};
+      header.msg_iov = &iovecs_[i];
+      header.msg_iovlen = 1;
+      header.msg_control = controls_.data() + i * kControlBytes;
+      header.msg_controllen = kControlBytes;
+    }
+    int count = ::recvmmsg(fd_, messages_.data(), static_cast<unsigned>(messages_.size()), MSG_DONTWAIT, nullptr);
+    if (count <= 0 && wait_readable()) {
+      count = ::recvmmsg(fd_, messages_.data(), static_cast<unsigned>(messages_.size()), MSG_DONTWAIT, nullptr);
+    }
+    if (count <= 0) {
+      return false;
+    }
+    received_ = count;
+    cursor_ = 0;
+  }
+
+  const int index = cursor_++;
+  msghdr &header = messages_[index].msg_hdr;
+  frame.data = static_cast<const unsigned char *>(iovecs_[index].iov_base);
+  frame.size = messages_[index].msg_len;
+  frame.receive_ns = 0;
+  for (cmsghdr *control = CMSG_FIRSTHDR(&header); control != nullptr; control = CMSG_NXTHDR(&header, control)) {
+    if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS) {
+      timespec ts;
+      std::memcpy(&ts, CMSG_DATA(control), sizeof(ts));
+      frame.receive_ns = static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+  }
+  if (frame.receive_ns == 0) {
+    frame.receive_ns = realtime_ns();
+  }
+  if (header.msg_flags & MSG_TRUNC) {
+    frame.size = 0;  // 超过 max_samples 的数据报按格式错误处理
+  }
+  bytes_.fetch_add(messages_[index].msg_len, std::memory_order_relaxed);
+  return true;
+}
+
+bool NetworkSource::next_tcp_frame(Frame &frame) {
+  if (fd_ < 0) {
+    if (!connect_tcp()) {
+      if (may_block()) {
+        std::this_thread::sleep_for(block_timeout());
+      }
+      return false;
+    }
+  }
+
+  while (true) {
+    // 对齐到帧头：magic 不符时逐字节向后查找
+    while (write_pos_ - read_pos_ >= sizeof(uint32_t)) {
+      uint32_t magic;
+      std::memcpy(&magic, stream_.data() + read_pos_, sizeof(magic));
+      if (magic == kEegFrameMagic) {
+        break;
+      }
+      size_t next = read_pos_ + 1;
+      while (next + sizeof(uint32_t) <= write_pos_ &&
+             std::memcmp(stream_.data() + next, &kEegFrameMagic, sizeof(uint32_t)) != 0) {
+        ++next;
+      }
+      malformed_.fetch_add(1, std::memory_order_relaxed);
+      read_pos_ = next;
+    }
+
+    if (write_pos_ - read_pos_ >= sizeof(EegFrameHeader)) {
+      EegFrameHeader header;
+      std::memcpy(&header, stream_.data() + read_pos_, sizeof(header));
+      const size_t size = eeg_frame_bytes(header);
+      if (size > config_.max_frame_bytes() || header.format > static_cast<uint8_t>(EegSampleFormat::kFloat32)) {
+        // 帧头损坏：跳过这个 magic 重新对齐
+        malformed_.fetch_add(1, std::memory_order_relaxed);
+        read_pos_ += sizeof(uint32_t);
+        continue;
+      }
+      if (write_pos_ - read_pos_ >= size) {
+        frame.data = stream_.data() + read_pos_;
+        frame.size = size;
+        frame.receive_ns = stream_receive_ns_;
+        read_pos_ += size;
+        return true;
+      }
+    }
+
+    // 数据不足一帧：把剩余部分移到缓冲区开头，再读一段
+    if (read_pos_ > 0) {
+      std::memmove(stream_.data(), stream_.data() + read_pos_, write_pos_ - read_pos_);
+      write_pos_ -= read_pos_;
+      read_pos_ = 0;
+    }
+    ssize_t n = ::recv(fd_, stream_.data() + write_pos_, stream_.size() - write_pos_, MSG_DONTWAIT);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && wait_readable()) {
+      n = ::recv(fd_, stream_.data() + write_pos_, stream_.size() - write_pos_, MSG_DONTWAIT);
+    }
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      MLOG_WARN("NetworkSource: connection to %s:%d closed, reconnecting", config_.host.c_str(), config_.port);
+      close_socket();
+      reconnects_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    if (n < 0) {
+      return false;
+    }
+    stream_receive_ns_ = realtime_ns();
+    write_pos_ += static_cast<size_t>(n);
+    bytes_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+  }
+}
+
+bool NetworkSource::accept_frame(const Frame &frame, Package *package) {
+  EegFrameHeader header;
+  if (frame.size < sizeof(header)) {
+    malformed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  std::memcpy(&header, frame.data, sizeof(header));
+  if (header.magic != kEegFrameMagic || header.n_channels != config_.n_channels || header.n_samples == 0 ||
+      header.n_samples > config_.max_samples || header.format > static_cast<uint8_t>(EegSampleFormat::kFloat32) ||
+      eeg_frame_bytes(header) != frame.size) {
+    malformed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // 按序号检测丢帧（有符号差值处理回绕）
+  if (has_sequence_) {
+    const int32_t delta = static_cast<int32_t>(header.sequence - next_sequence_);
+    if (delta < 0) {
+      out_of_order_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    if (delta > 0) {
+      lost_.fetch_add(static_cast<uint64_t>(delta), std::memory_order_relaxed);
+      gaps_.fetch_add(1, std::memory_order_relaxed);
+      MLOG_WARN("NetworkSource: lost %d frames before sequence %u", delta, header.sequence);
+    }
+  }
+  has_sequence_ = true;
+  next_sequence_ = header.sequence + 1;
+
+  // 直接从接收缓冲区解码到包内复用的缓冲区
+  cv::Mat &raw = package->slot<Slot::kRawEeg>();
+  raw.create(header.n_channels, header.n_samples, CV_32F);
+  decode_eeg_frame(header, frame.data + sizeof(header), raw.ptr<float>(0), raw.step1());
+  if (header.trigger_offset >= 0 && header.trigger_offset < header.n_samples) {
+    package->slot<Slot::kTrigger>() = header.trigger_code;
+    package->slot<Slot::kTriggerOffset>() = header.trigger_offset;
+  }
+
+  const int64_t latency_ns = realtime_ns() - frame.receive_ns;
+  ingest_latency_.record(latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0);
+  if (tracker_) {
+    package->trace().origin = TraceClock::now() - TraceClock::from_ns(latency_ns > 0 ? latency_ns : 0);
+  }
+  frames_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
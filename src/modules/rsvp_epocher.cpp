@@ -0,0 +1,205 @@
+#include "modules/rsvp_epocher.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <utility>
+
+namespace {
+
+// 检查截取参数，返回环形缓冲区每个通道至少要保存的采样点数
+size_t ring_capacity(const EpochConfig &config) {
+  if (config.pre < 0 || config.post < 1 || config.capacity < 0) {
+    throw std::invalid_argument("RsvpEpocher: pre must be >= 0, post >= 1 and capacity >= 0");
+  }
+  if (config.capacity > 0 && config.capacity < 2 * config.length()) {
+    throw std::invalid_argument("RsvpEpocher: capacity must hold at least two epochs");
+  }
+  return static_cast<size_t>(config.capacity > 0 ? config.capacity : 4 * config.length());
+}
+
+}  // namespace
+
+EpochConfig EpochConfig::from_config(const ConfigNode &node) {
+  EpochConfig config;
+  config.pre = node.get_int("pre", config.pre);
+  config.post = node.get_int("post", config.post);
+  config.capacity = node.get_int("capacity", config.capacity);
+  return config;
+}
+
+RsvpEpocher::RsvpEpocher(const EpochConfig &config, int n_channels, int pre_module_nums, bool enable_profiler,
+                         int cpu_id, int npu_id, const WaitStrategy &wait_strategy)
+    : Module<PackagePtr>(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy),
+      config_(config),
+      ring_(std::make_shared<MirroredChannelRing>(n_channels, ring_capacity(config))),
+      package_pool_(kDefaultPackagePoolCapacity, ring_) {}
+
+RsvpEpocher::Stats RsvpEpocher::stats() const {
+  Stats stats;
+  stats.epochs = epochs_.load(std::memory_order_relaxed);
+  stats.dropped = dropped_.load(std::memory_order_relaxed);
+  stats.stalls = stalls_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+template <class Emit>
+void RsvpEpocher::emit_ready(const Package &input, Emit emit) {
+  const size_t stride_bytes = ring_->row_stride() * sizeof(float);
+  while (!pending_.empty() && pending_.front().onset + static_cast<uint64_t>(config_.post) <= ring_->written()) {
+    const PendingEpoch pending = pending_.front();
+    pending_.pop_front();
+    const uint64_t start = pending.onset - static_cast<uint64_t>(config_.pre);
+
+    PackagePtr epoch = package_pool_.acquire();
+    if (tracker_) {
+      epoch->trace() = input.trace();
+    }
+    // 直接指向环中的窗口（镜像映射保证每个通道内连续）
+    epoch->slot<Slot::kRawEeg>() =
+        cv::Mat(ring_->n_channels(), config_.length(), CV_32F, ring_->at(start), stride_bytes);
+    epoch->slot<Slot::kTrigger>() = pending.code;
+    epoch->slot<Slot::kTriggerOffset>() = config_.pre;
+    epoch->set_sequence(next_sequence_++);
+    epoch->set_deadline(input.get_deadline());  // 使试次完整的输入包决定其时效
+    leases_.push_back(Lease{epoch, start});
+
+    onset_latency_.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - pending.arrived)
+            .count()));
+    epochs_.fetch_add(1, std::memory_order_relaxed);
+    trace_enqueue(epoch.get());
+    emit(epoch);
+  }
+}
+
+void RsvpEpocher::run() {
+  set_cpu_affinity("Epocher");
+
+  while (!exit_flag_) {
+    try {
+      auto start_time = std::chrono::steady_clock::now();
+
+      auto input_package = pop_input();
+      if (!input_package) {
+        continue;
+      }
+      trace_dequeue(input_package->get());
+
+      // 环中空间被未释放的试次占住时，等下游释放（释放没有通知，按 100us 轮询）
+      const size_t n = input_samples(**input_package);
+      if (n > 0 && !has_room(n)) {
+        stalls_.fetch_add(1, std::memory_order_relaxed);
+        while (!exit_flag_ && !has_room(n)) {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (exit_flag_) {
+          break;
+        }
+      }
+
+      if (!process(input_package->get())) {
+        MLOG_ERROR("RsvpEpocher failed to process package");
+        continue;
+      }
+      emit_ready(**input_package, [this](const PackagePtr &epoch) { push_output(epoch); });
+
+      if (profiler_.is_enabled()) {
+        auto end_time = std::chrono::steady_clock::now();
+        profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+      }
+    } catch (const std::exception &e) {
+      MLOG_ERROR("Exception in RsvpEpocher: %s", e.what());
+    }
+  }
+
+  MLOG_INFO("RsvpEpocher has exited.");
+}
+
+StepResult RsvpEpocher::step() {
+  if (!flush_stalled()) {
+    return StepResult::kBlocked;
+  }
+  PackagePtr input_package = std::move(held_);
+  const bool fresh = !input_package;
+  if (fresh) {
+    if (!input_ptr_->try_pop(input_package)) {
+      return StepResult::kIdle;
+    }
+    trace_dequeue(input_package.get());
+  }
+  try {
+    auto start_time = std::chrono::steady_clock::now();
+    const size_t n = input_samples(*input_package);
+    if (n > 0 && !has_room(n)) {
+      if (fresh) stalls_.fetch_add(1, std::memory_order_relaxed);
+      held_ = std::move(input_package);  // 下次 step 再试
+      return StepResult::kBlocked;
+    }
+    if (!process(input_package.get())) {
+      MLOG_ERROR("RsvpEpocher failed to process package");
+      return StepResult::kProgress;
+    }
+    emit_ready(*input_package, [this](const PackagePtr &epoch) { emit_output(epoch); });
+    if (profiler_.is_enabled()) {
+      auto end_time = std::chrono::steady_clock::now();
+      profiler_.add_profile(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+    }
+  } catch (const std::exception &e) {
+    MLOG_ERROR("Exception in RsvpEpocher: %s", e.what());
+  }
+  return StepResult::kProgress;
+}
+
+size_t RsvpEpocher::input_samples(const Package &package) const {
+  if (!package.has_slot<Slot::kRawEeg>()) {
+    return 0;
+  }
+  const cv::Mat &raw = package.slot<Slot::kRawEeg>();
+  if (raw.type() != CV_32F || raw.rows != ring_->n_channels() || raw.cols < 1 ||
+      static_cast<size_t>(raw.cols) + config_.length() > ring_->capacity()) {
+    return 0;
+  }
+  return static_cast<size_t>(raw.cols);
+}
+
+bool RsvpEpocher::has_room(size_t n) {
+  // 追加后环中保留 [floor, written + n)；等待截取的触发不会落在 floor 之前（输入包不超过 capacity - pre - post）
+  const uint64_t end = ring_->written() + n;
+  const uint64_t floor = end > ring_->capacity() ? end - ring_->capacity() : 0;
+  leases_.erase(std::remove_if(leases_.begin(), leases_.end(),
+                               [](const Lease &lease) { return lease.package.expired(); }),
+                leases_.end());
+  for (const Lease &lease : leases_) {
+    if (lease.start < floor) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RsvpEpocher::process(Package *package) {
+  const size_t n = input_samples(*package);
+  if (n == 0) {
+    MLOG_ERROR("RsvpEpocher: raw EEG must be CV_32F with %d channels and at most %zu samples per package",
+               ring_->n_channels(), ring_->capacity() - config_.length());
+    return false;
+  }
+  const cv::Mat &raw = std::as_const(*package).slot<Slot::kRawEeg>();
+  const uint64_t first = ring_->written();
+  ring_->append(raw.ptr<float>(0), raw.step1(), n);
+
+  if (package->has_slot<Slot::kTrigger>() && package->has_slot<Slot::kTriggerOffset>()) {
+    const int offset = package->slot<Slot::kTriggerOffset>();
+    if (offset >= 0 && static_cast<size_t>(offset) < n) {
+      const uint64_t onset = first + static_cast<uint64_t>(offset);
+      if (onset < static_cast<uint64_t>(config_.pre)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);  // 基线落在数据流开始之前
+      } else {
+        pending_.push_back(PendingEpoch{onset, package->slot<Slot::kTrigger>(), std::chrono::steady_clock::now()});
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,107 @@
+#include "modules/rsvp_preprocessor.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+RsvpPreprocessor::InputMode RsvpPreprocessor::parse_input_mode(const std::string &name) {
+  if (name == "stream") {
+    return InputMode::kStream;
+  }
+  if (name == "epoch") {
+    return InputMode::kEpoch;
+  }
+  throw std::runtime_error("Unknown preprocessor input mode: " + name);
+}
+
+RsvpPreprocessor::RsvpPreprocessor(const DecimatorConfig &decimation, const IirFilterConfig &filter,
+                                   const NormalizerConfig &normalization, int n_input_channels, int pre_module_nums,
+                                   bool enable_profiler, int cpu_id, int npu_id, const WaitStrategy &wait_strategy)
+    : Preprocessor(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy),
+      filter_(filter),
+      normalization_(normalization),
+      n_input_channels_(n_input_channels),
+      decimator_(decimation) {
+  for (int c : decimation.channels) {
+    if (c < 0 || c >= n_input_channels_) {
+      throw std::invalid_argument("RsvpPreprocessor: channel " + std::to_string(c) + " is outside the input");
+    }
+  }
+
+  // 带通滤波工作在抽取后的采样率上
+  filter_.fs = decimation.fs / decimation.factor;
+  const int n_channels = n_output_channels();
+  auto sections = design_butterworth_bandpass(filter_.order, filter_.low_cut, filter_.high_cut, filter_.fs);
+  if (filter_.mode == IirFilterConfig::Mode::kZeroPhase) {
+    zero_phase_ = std::make_unique<ZeroPhaseFilterBank>(std::move(sections), n_channels, filter_.lag);
+  } else {
+    causal_ = std::make_unique<SosFilterBank>(std::move(sections), n_channels);
+  }
+
+  // 归一化同样按抽取后的采样率计算滑动窗长
+  normalization_.fs = filter_.fs;
+  if (normalization_.mode != NormalizerConfig::Mode::kNone) {
+    normalizer_ = std::make_unique<ChannelNormalizer>(normalization_, n_channels);
+  }
+}
+
+bool RsvpPreprocessor::process(Package *package) {
+  if (!package->has_slot<Slot::kRawEeg>()) {
+    MLOG_ERROR("RsvpPreprocessor: package has no raw EEG");
+    return false;
+  }
+
+  const cv::Mat &raw = std::as_const(*package).slot<Slot::kRawEeg>();
+  if (raw.type() != CV_32F || raw.rows != n_input_channels_) {
+    MLOG_ERROR("RsvpPreprocessor: raw EEG must be CV_32F with %d channels, got type %d %dx%d", n_input_channels_,
+               raw.type(), raw.rows, raw.cols);
+    return false;
+  }
+
+  // 试次之间相互独立：以本试次的第一个采样点为基线重新开始抽取，归一化只统计本试次
+  const bool independent = input_mode_ == InputMode::kEpoch && raw.cols > 0;
+  if (independent) {
+    decimator_.prime(raw.ptr<float>(0), raw.step1());
+    if (normalizer_) {
+      normalizer_->reset();
+    }
+  }
+
+  // 选通道 + 抽取，直接写入 kEpoch
+  cv::Mat &epoch = package->slot<Slot::kEpoch>();
+  const size_t n_out = decimator_.output_samples(raw.cols);
+  epoch.create(n_output_channels(), static_cast<int>(n_out), CV_32F);
+  if (n_out == 0) {
+    decimator_.process(raw.ptr<float>(0), raw.step1(), raw.cols, nullptr, 0);
+    return true;
+  }
+  decimator_.process(raw.ptr<float>(0), raw.step1(), raw.cols, epoch.ptr<float>(0), epoch.step1());
+
+  // 原地带通滤波，同一次遍历中完成归一化
+  float *data = epoch.ptr<float>(0);
+  if (zero_phase_) {
+    if (independent) {
+      zero_phase_->process_epoch(data, epoch.step1(), data, epoch.step1(), n_out, normalizer_.get());
+    } else {
+      zero_phase_->process(data, epoch.step1(), data, epoch.step1(), n_out, normalizer_.get());
+    }
+  } else {
+    if (independent) {
+      causal_->settle(data, epoch.step1());
+    }
+    causal_->process(data, epoch.step1(), data, epoch.step1(), n_out, normalizer_.get());
+  }
+  return true;
+}
+
+void RsvpPreprocessor::reset() {
+  decimator_.reset();
+  if (zero_phase_) {
+    zero_phase_->reset();
+  } else {
+    causal_->reset();
+  }
+  if (normalizer_) {
+    normalizer_->reset();
+  }
+}
@@ -0,0 +1,158 @@
+#include "modules/rsvp_runner.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#include "inference/simd_kernels.h"
+#include "inference/xgbdim_model_file.h"
+
+namespace {
+
+bool is_binary_model(const std::string &path) {
+  const std::string suffix = ".xgbm";
+  return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+RsvpRunner::RsvpRunner(std::shared_ptr<const XgbdimEngine> engine, int pre_module_nums, bool enable_profiler,
+                       int cpu_id, int npu_id, const WaitStrategy &wait_strategy)
+    : Runner(pre_module_nums, enable_profiler, cpu_id, npu_id, wait_strategy), engine_(std::move(engine)) {
+  if (!engine_) {
+    throw std::invalid_argument("RsvpRunner requires an inference engine");
+  }
+}
+
+std::shared_ptr<const XgbdimEngine> RsvpRunner::load_engine(const ConfigNode &node) {
+  std::string model_path = node.get_string("model_path", "");
+  if (model_path.empty()) {
+    throw std::runtime_error("RsvpRunner config is missing model_path");
+  }
+
+  std::shared_ptr<XgbdimEngine> engine;
+  if (is_binary_model(model_path)) {
+    engine = load_xgbdim_model(model_path);
+    engine->set_demean(node.get_bool("demean", engine->demean()));
+  } else {
+    XgbdimGeometry geometry;
+    if (node.has("geometry")) {
+      geometry = XgbdimGeometry::from_config(node["geometry"]);
+    } else {
+      geometry.build();
+    }
+    engine = std::make_shared<XgbdimEngine>(XgbdimParams::load_npz(model_path, geometry), geometry);
+    engine->set_demean(node.get_bool("demean", true));
+  }
+  engine->set_precision(XgbdimEngine::parse_precision(node.get_string("precision", "float32")));
+  if (node.has("early_exit")) {
+    engine->set_early_exit(XgbdimEarlyExit::from_config(node["early_exit"]));
+  }
+
+  MLOG_INFO("XGB-DIM model loaded: %s, %d local models, %s, kernel %s", model_path.c_str(), engine->n_local_models(),
+            XgbdimEngine::precision_name(engine->precision()),
+            engine->quantized() ? quant_kernel_name() : simd_level_name(simd_level()));
+  return engine;
+}
+
+bool RsvpRunner::reload_model(const std::string &model_path) {
+  auto current = engine();
+  const XgbdimGeometry &geometry = current->geometry();
+  try {
+    std::shared_ptr<XgbdimEngine> next;
+    if (is_binary_model(model_path)) {
+      next = load_xgbdim_model(model_path);
+    } else {
+      next = std::make_shared<XgbdimEngine>(XgbdimParams::load_npz(model_path, geometry), geometry);
+      next->set_demean(current->demean());
+    }
+    next->set_precision(current->precision());
+    next->set_early_exit(current->early_exit());
+    if (next->geometry().n_channels != geometry.n_channels || next->geometry().n_samples != geometry.n_samples) {
+      MLOG_ERROR("RsvpRunner: model %s expects %dx%d epochs, current pipeline produces %dx%d", model_path.c_str(),
+                 next->geometry().n_channels, next->geometry().n_samples, geometry.n_channels, geometry.n_samples);
+      return false;
+    }
+    swap_engine(std::move(next));
+  } catch (const std::exception &e) {
+    MLOG_ERROR("RsvpRunner: failed to reload model %s: %s", model_path.c_str(), e.what());
+    return false;
+  }
+
+  MLOG_INFO("XGB-DIM model reloaded: %s", model_path.c_str());
+  return true;
+}
+
+void RsvpRunner::swap_engine(std::shared_ptr<const XgbdimEngine> engine) {
+  if (!engine) {
+    throw std::invalid_argument("RsvpRunner requires an inference engine");
+  }
+  std::atomic_store_explicit(&engine_, std::move(engine), std::memory_order_release);
+}
+
+std::shared_ptr<const XgbdimEngine> RsvpRunner::engine() const {
+  return std::atomic_load_explicit(&engine_, std::memory_order_acquire);
+}
+
+bool RsvpRunner::check_epoch(const Package &package, const XgbdimGeometry &geometry) {
+  if (!package.has_slot<Slot::kEpoch>()) {
+    MLOG_ERROR("RsvpRunner: package has no epoch");
+    return false;
+  }
+  const cv::Mat &epoch = package.slot<Slot::kEpoch>();
+  if (epoch.type() != CV_32F || epoch.rows != geometry.n_channels || epoch.cols != geometry.n_samples) {
+    MLOG_ERROR("RsvpRunner: epoch must be CV_32F %dx%d, got type %d %dx%d", geometry.n_channels, geometry.n_samples,
+               epoch.type(), epoch.rows, epoch.cols);
+    return false;
+  }
+  return true;
+}
+
+bool RsvpRunner::process(Package *package) {
+  // 每个包只取一次引擎，处理期间即使发生热替换也使用同一个模型
+  auto engine = this->engine();
+  if (!check_epoch(*package, engine->geometry())) {
+    return false;
+  }
+
+  predict_one(*engine, package);
+  return true;
+}
+
+void RsvpRunner::predict_one(const XgbdimEngine &engine, Package *package) {
+  const cv::Mat &epoch = std::as_const(*package).slot<Slot::kEpoch>();
+  XgbdimResult result = package->is_degraded() && degraded_early_exit_.enabled
+                            ? engine.predict(epoch.ptr<float>(0), epoch.step1(), degraded_early_exit_)
+                            : engine.predict(epoch.ptr<float>(0), epoch.step1());
+  package->set_slot<Slot::kScore>(result.score);
+  package->set_slot<Slot::kLabel>(result.label);
+  package->set_slot<Slot::kModelsEvaluated>(result.models_evaluated);
+}
+
+void RsvpRunner::process_batch(Package *const *packages, size_t count, bool *ok) {
+  // 整批使用同一个引擎；形状不对的包单独标记失败，降级的包单独快速推理，其余包照常批量推理
+  auto engine = this->engine();
+  batch_epochs_.clear();
+  batch_strides_.clear();
+  batch_index_.clear();
+  for (size_t i = 0; i < count; ++i) {
+    ok[i] = check_epoch(*packages[i], engine->geometry());
+    if (ok[i] && packages[i]->is_degraded() && degraded_early_exit_.enabled) {
+      predict_one(*engine, packages[i]);
+    } else if (ok[i]) {
+      const cv::Mat &epoch = std::as_const(*packages[i]).slot<Slot::kEpoch>();
+      batch_epochs_.push_back(epoch.ptr<float>(0));
+      batch_strides_.push_back(epoch.step1());
+      batch_index_.push_back(i);
+    }
+  }
+
+  batch_results_.resize(batch_epochs_.size());
+  engine->predict_batch(batch_epochs_.data(), batch_strides_.data(), batch_epochs_.size(), batch_results_.data());
+  for (size_t j = 0; j < batch_index_.size(); ++j) {
+    Package *package = packages[batch_index_[j]];
+    package->set_slot<Slot::kScore>(batch_results_[j].score);
+    package->set_slot<Slot::kLabel>(batch_results_[j].label);
+    package->set_slot<Slot::kModelsEvaluated>(batch_results_[j].models_evaluated);
+  }
+}
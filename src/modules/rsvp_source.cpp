@@ -0,0 +1,114 @@
+#include "modules/rsvp_source.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>  // NOLINT
+
+#include "utils/package_trace.h"
+
+ReplayConfig ReplayConfig::from_config(const ConfigNode &node) {
+  ReplayConfig config;
+  config.path = node.get_string("path", config.path);
+  config.speed = node.get_double("speed", config.speed);
+  config.chunk = node.get_int("chunk", config.chunk);
+  config.loop = node.get_bool("loop", config.loop);
+  config.populate = node.get_bool("populate", config.populate);
+  config.verify = node.get_bool("verify", config.verify);
+
+  std::string mode = node.get_string("mode", "realtime");
+  if (mode == "realtime") {
+    config.mode = Mode::kRealtime;
+  } else if (mode == "max_speed") {
+    config.mode = Mode::kMaxSpeed;
+  } else {
+    throw std::runtime_error("Unknown replay mode: " + mode);
+  }
+  return config;
+}
+
+RsvpSource::RsvpSource(const ReplayConfig &config, int max_queue_length, bool enable_profiler, int cpu_id,
+                       int npu_id, const WaitStrategy &wait_strategy)
+    : Source(max_queue_length, enable_profiler, cpu_id, npu_id, wait_strategy),
+      config_(config),
+      recording_(config.path, config.populate, config.verify) {
+  if (config_.chunk < 1 || !(config_.speed > 0.0)) {
+    throw std::invalid_argument("RsvpSource requires chunk >= 1 and speed > 0");
+  }
+  seconds_per_sample_ = 1.0 / (recording_.fs() * config_.speed);
+  MLOG_INFO("Replaying %s: %d channels, %zu samples at %.1f Hz, %zu events, %s", config_.path.c_str(),
+            recording_.n_channels(), recording_.n_samples(), recording_.fs(), recording_.n_events(),
+            config_.mode == ReplayConfig::Mode::kRealtime ? "realtime" : "max speed");
+}
+
+bool RsvpSource::process(Package *package) {
+  const size_t n_samples = recording_.n_samples();
+  if (position_ >= n_samples) {
+    if (!config_.loop || n_samples == 0) {
+      if (!finished_.exchange(true, std::memory_order_acq_rel)) {
+        MLOG_INFO("Replay of %s finished after %llu samples", config_.path.c_str(),
+                  static_cast<unsigned long long>(samples_emitted()));
+      }
+      if (may_block()) {
+        std::this_thread::sleep_for(block_timeout());
+      }
+      return false;
+    }
+    position_ = 0;
+    next_event_ = 0;
+  }
+
+  // 本包的范围 [position_, end)，每包最多一个触发
+  size_t end = std::min(n_samples, position_ + static_cast<size_t>(config_.chunk));
+  const RecordingEvent *events = recording_.events();
+  const size_t n_events = recording_.n_events();
+  const RecordingEvent *trigger = nullptr;
+  size_t skip_to = next_event_;
+  if (next_event_ < n_events && static_cast<size_t>(events[next_event_].sample) < end) {
+    trigger = &events[next_event_];
+    skip_to = next_event_ + 1;
+    while (skip_to < n_events && events[skip_to].sample == trigger->sample) ++skip_to;  // 同一采样点只取第一个
+    if (skip_to < n_events && static_cast<size_t>(events[skip_to].sample) < end) {
+      end = static_cast<size_t>(events[skip_to].sample);
+    }
+  }
+  const size_t count = end - position_;
+  const uint64_t emitted = emitted_.load(std::memory_order_relaxed);
+
+  // 实时模式：本包最后一个采样点采集完成后才产生
+  int64_t late_ns = 0;
+  if (config_.mode == ReplayConfig::Mode::kRealtime) {
+    auto now = std::chrono::steady_clock::now();
+    if (!started_) {
+      start_time_ = now;
+      started_ = true;
+    }
+    const auto due = start_time_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                       std::chrono::duration<double>((emitted + count) * seconds_per_sample_));
+    if (now < due && may_block()) {
+      std::this_thread::sleep_until(std::min(due, now + block_timeout()));
+      now = std::chrono::steady_clock::now();
+    }
+    if (now < due) {
+      return false;
+    }
+    late_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count();
+  }
+
+  // kRawEeg 直接指向映射内存
+  const int n_channels = recording_.n_channels();
+  package->slot<Slot::kRawEeg>() =
+      cv::Mat(n_channels, static_cast<int>(count), CV_32F, const_cast<float *>(recording_.row(0) + position_),
+              recording_.row_stride() * sizeof(float));
+  if (trigger) {
+    package->slot<Slot::kTrigger>() = trigger->code;
+    package->slot<Slot::kTriggerOffset>() = static_cast<int>(trigger->sample - static_cast<int64_t>(position_));
+  }
+  if (tracker_ && config_.mode == ReplayConfig::Mode::kRealtime) {
+    package->trace().origin = TraceClock::now() - TraceClock::from_ns(late_ns);
+  }
+
+  position_ = end;
+  next_event_ = skip_to;
+  emitted_.store(emitted + count, std::memory_order_relaxed);
+  return true;
+}
@@ -0,0 +1,313 @@
+#include "modules/serial_source.h"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <thread>  // NOLINT
+
+#include "utils/package_trace.h"
+
+namespace {
+
+int64_t realtime_ns() {
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// 标准波特率到 termios 常量
+speed_t baud_constant(int baud) {
+  switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 500000: return B500000;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 1500000: return B1500000;
+    case 2000000: return B2000000;
+    case 3000000: return B3000000;
+    case 4000000: return B4000000;
+    default: throw std::invalid_argument("SerialSource: unsupported baud rate " + std::to_string(baud));
+  }
+}
+
+}  // namespace
+
+SerialSourceConfig SerialSourceConfig::from_config(const ConfigNode &node) {
+  SerialSourceConfig config;
+  config.device = node.get_string("device", config.device);
+  config.baud = node.get_int("baud", config.baud);
+  config.n_channels = node.get_int("n_channels", config.n_channels);
+  config.chunk = node.get_int("chunk", config.chunk);
+  config.resolution = static_cast<float>(node.get_double("resolution", config.resolution));
+  config.batch_frames = node.get_int("batch_frames", config.batch_frames);
+  config.buffer_frames = node.get_int("buffer_frames", config.buffer_frames);
+
+  std::string wakeup = node.get_string("wakeup", "epoll");
+  if (wakeup == "epoll") {
+    config.wakeup = Wakeup::kEpoll;
+  } else if (wakeup == "batch") {
+    config.wakeup = Wakeup::kBatch;
+  } else {
+    throw std::runtime_error("Unknown serial wakeup: " + wakeup);
+  }
+  return config;
+}
+
+SerialSource::SerialSource(const SerialSourceConfig &config, int max_queue_length, bool enable_profiler, int cpu_id,
+                           int npu_id, const WaitStrategy &wait_strategy)
+    : Source(max_queue_length, enable_profiler, cpu_id, npu_id, wait_strategy),
+      config_(config),
+      frame_bytes_(serial_frame_bytes(config.n_channels)) {
+  if (config_.n_channels < 1 || config_.chunk < 1 || config_.batch_frames < 1 ||
+      config_.buffer_frames < 2 * config_.chunk) {
+    throw std::invalid_argument("SerialSource: invalid channel count, chunk, batch_frames or buffer_frames");
+  }
+  baud_constant(config_.baud);
+  buffer_.resize(static_cast<size_t>(config_.buffer_frames) * frame_bytes_);
+  frames_.reserve(static_cast<size_t>(config_.chunk));
+  reads_.reserve(static_cast<size_t>(config_.buffer_frames));
+  if (config_.wakeup == SerialSourceConfig::Wakeup::kEpoll) {
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+      throw std::runtime_error(std::string("SerialSource: epoll_create1 failed: ") + std::strerror(errno));
+    }
+  }
+  open_device(true);
+}
+
+SerialSource::~SerialSource() {
+  close_device();
+  if (epoll_fd_ >= 0) ::close(epoll_fd_);
+}
+
+SerialSource::Stats SerialSource::stats() const {
+  Stats stats;
+  stats.samples = samples_.load(std::memory_order_relaxed);
+  stats.packages = packages_.load(std::memory_order_relaxed);
+  stats.lost = lost_.load(std::memory_order_relaxed);
+  stats.gaps = gaps_.load(std::memory_order_relaxed);
+  stats.crc_errors = crc_errors_.load(std::memory_order_relaxed);
+  stats.skipped_bytes = skipped_bytes_.load(std::memory_order_relaxed);
+  stats.bytes = bytes_.load(std::memory_order_relaxed);
+  stats.reopens = reopens_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+bool SerialSource::open_device(bool throw_on_error) {
+  fd_ = ::open(config_.device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  termios options{};
+  if (fd_ < 0 || tcgetattr(fd_, &options) != 0) {
+    const int error = errno;
+    close_device();
+    if (throw_on_error) {
+      throw std::runtime_error("SerialSource: open " + config_.device + " failed: " + std::strerror(error));
+    }
+    return false;
+  }
+  // raw 模式：不做行缓冲、回显与字符转换；非阻塞读，等待由 epoll 或按波特率估算的休眠完成。
+  // VMIN = 1 时没有数据的非阻塞 read 返回 EAGAIN，返回 0 只表示设备挂断
+  cfmakeraw(&options);
+  options.c_cflag |= CLOCAL | CREAD;
+  options.c_cc[VMIN] = 1;
+  options.c_cc[VTIME] = 0;
+  cfsetispeed(&options, baud_constant(config_.baud));
+  cfsetospeed(&options, baud_constant(config_.baud));
+  if (tcsetattr(fd_, TCSANOW, &options) != 0) {
+    const int error = errno;
+    close_device();
+    if (throw_on_error) {
+      throw std::runtime_error("SerialSource: configure " + config_.device + " failed: " + std::strerror(error));
+    }
+    return false;
+  }
+  tcflush(fd_, TCIFLUSH);  // 丢弃打开之前积压的字节
+  if (epoll_fd_ >= 0) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd_, &event);
+  }
+
+  // 重新打开后从头对齐，未成包的帧丢弃
+  scan_pos_ = write_pos_ = 0;
+  frames_.clear();
+  reads_.clear();
+  read_head_ = 0;
+  trigger_index_ = -1;
+  trigger_level_ = 0;
+  has_counter_ = false;
+  MLOG_INFO("SerialSource opened %s at %d baud (%d channels, %zu bytes per frame)", config_.device.c_str(),
+            config_.baud, config_.n_channels, frame_bytes_);
+  return true;
+}
+
+void SerialSource::close_device() {
+  if (fd_ >= 0) {
+    ::close(fd_);  // 关闭时自动从 epoll 中移除
+    fd_ = -1;
+  }
+}
+
+bool SerialSource::process(Package *package) {
+  if (fd_ < 0 && !open_device(false)) {
+    if (may_block()) {
+      std::this_thread::sleep_for(block_timeout());
+    }
+    return false;
+  }
+  while (!index_frames()) {
+    if (!fill()) {
+      return false;  // 不足一包的帧留在缓冲区中，下次继续
+    }
+  }
+  emit(package);
+  return true;
+}
+
+bool SerialSource::index_frames() {
+  const size_t chunk = static_cast<size_t>(config_.chunk);
+  while (frames_.size() < chunk) {
+    if (write_pos_ - scan_pos_ < frame_bytes_) {
+      return false;
+    }
+    const unsigned char *frame = buffer_.data() + scan_pos_;
+    if (!serial_frame_valid(frame, config_.n_channels)) {
+      if (frame[0] == kSerialSync0 && frame[1] == kSerialSync1) {
+        crc_errors_.fetch_add(1, std::memory_order_relaxed);
+      }
+      // 原地跳到下一个可能的同步字
+      const void *next = std::memchr(frame + 1, kSerialSync0, write_pos_ - scan_pos_ - 1);
+      const size_t to = next != nullptr ? static_cast<size_t>(static_cast<const unsigned char *>(next) - buffer_.data())
+                                        : write_pos_;
+      skipped_bytes_.fetch_add(to - scan_pos_, std::memory_order_relaxed);
+      scan_pos_ = to;
+      continue;
+    }
+
+    const uint8_t level = frame[3];
+    const bool onset = level != 0 && level != trigger_level_;
+    if (onset && trigger_index_ >= 0) {
+      return true;  // 第二个触发：在它之前截断，下一个包从它开始
+    }
+
+    const uint8_t counter = frame[2];
+    if (has_counter_ && counter != next_counter_) {
+      const uint8_t missing = static_cast<uint8_t>(counter - next_counter_);
+      lost_.fetch_add(missing, std::memory_order_relaxed);
+      gaps_.fetch_add(1, std::memory_order_relaxed);
+    }
+    has_counter_ = true;
+    next_counter_ = static_cast<uint8_t>(counter + 1);
+
+    trigger_level_ = level;
+    if (onset) {
+      trigger_index_ = static_cast<int>(frames_.size());
+      trigger_code_ = level;
+    }
+    frames_.push_back(scan_pos_);
+    scan_pos_ += frame_bytes_;
+  }
+  return true;
+}
+
+bool SerialSource::fill() {
+  if (buffer_.size() - write_pos_ < frame_bytes_) {
+    // 缓冲区写满：把当前包已找到的帧与未解析的字节（不足一包）移回开头
+    const size_t start = frames_.empty() ? scan_pos_ : frames_.front();
+    std::memmove(buffer_.data(), buffer_.data() + start, write_pos_ - start);
+    for (size_t &offset : frames_) offset -= start;
+    scan_pos_ -= start;
+    write_pos_ -= start;
+    size_t kept = 0;
+    for (size_t i = read_head_; i < reads_.size(); ++i) {
+      if (reads_[i].end > start) reads_[kept++] = ReadMark{reads_[i].end - start, reads_[i].ns};
+    }
+    reads_.resize(kept);
+    read_head_ = 0;
+  }
+
+  if (config_.wakeup == SerialSourceConfig::Wakeup::kBatch && may_block()) {
+    // 按波特率（8N1，每字节 10 位）估算还要多久才能攒够 batch_frames 帧（不超过当前包缺的帧数）
+    const size_t frames = std::min<size_t>(config_.batch_frames, config_.chunk - frames_.size());
+    const size_t wanted = frames * frame_bytes_;
+    int available = 0;
+    ioctl(fd_, FIONREAD, &available);
+    const size_t pending = write_pos_ - scan_pos_ + static_cast<size_t>(std::max(available, 0));
+    if (pending < wanted) {
+      const auto wait = std::chrono::microseconds((wanted - pending) * 10 * 1000000 / config_.baud);
+      std::this_thread::sleep_for(std::min<std::chrono::microseconds>(wait, block_timeout()));
+    }
+  }
+
+  ssize_t n = ::read(fd_, buffer_.data() + write_pos_, buffer_.size() - write_pos_);
+  if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && epoll_fd_ >= 0 && may_block()) {
+    epoll_event event;
+    if (::epoll_wait(epoll_fd_, &event, 1, static_cast<int>((block_timeout().count() + 999) / 1000)) > 0) {
+      n = ::read(fd_, buffer_.data() + write_pos_, buffer_.size() - write_pos_);
+    }
+  }
+  if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+    MLOG_WARN("SerialSource: %s disconnected, reopening", config_.device.c_str());
+    close_device();
+    reopens_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (n < 0) {
+    return false;
+  }
+  write_pos_ += static_cast<size_t>(n);
+  reads_.push_back(ReadMark{write_pos_, realtime_ns()});
+  bytes_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+  return true;
+}
+
+int64_t SerialSource::read_time(size_t end) {
+  while (read_head_ + 1 < reads_.size() && reads_[read_head_].end < end) {
+    ++read_head_;
+  }
+  return reads_.empty() ? realtime_ns() : reads_[read_head_].ns;
+}
+
+void SerialSource::emit(Package *package) {
+  const int n_samples = static_cast<int>(frames_.size());
+  cv::Mat &raw = package->slot<Slot::kRawEeg>();
+  raw.create(config_.n_channels, n_samples, CV_32F);
+  float *out = raw.ptr<float>(0);
+  const size_t stride = raw.step1();
+  const float scale = config_.resolution;
+  for (int s = 0; s < n_samples; ++s) {
+    const unsigned char *frame = buffer_.data() + frames_[s];
+    for (int c = 0; c < config_.n_channels; ++c) {
+      out[c * stride + s] = static_cast<float>(serial_frame_count(frame, c)) * scale;
+    }
+  }
+  if (trigger_index_ >= 0) {
+    package->slot<Slot::kTrigger>() = trigger_code_;
+    package->slot<Slot::kTriggerOffset>() = trigger_index_;
+  }
+
+  const int64_t latency_ns = realtime_ns() - read_time(frames_.back() + frame_bytes_);
+  ingest_latency_.record(latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0);
+  if (tracker_) {
+    package->trace().origin = TraceClock::now() - TraceClock::from_ns(latency_ns > 0 ? latency_ns : 0);
+  }
+  samples_.fetch_add(static_cast<uint64_t>(n_samples), std::memory_order_relaxed);
+  packages_.fetch_add(1, std::memory_order_relaxed);
+  frames_.clear();
+  trigger_index_ = -1;
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "dsp/iir_filter.h"
+#include "inference/npz_reader.h"
+
+// 用 python/validate_filter.py 生成的 SciPy 参考结果核对流式滤波器
+//
+// 用法：filter_verify <reference.npz> [chunk] [lag]
+//   chunk  每次送入的采样点数（模拟逐包处理，默认 40）
+//   lag    零相位模式的固定延迟（默认 2000）
+
+namespace {
+
+// 误差统计：最大绝对误差与相对参考信号 RMS 的误差
+struct ErrorStats {
+  double max_abs{0.0};
+  double rms_ratio{0.0};
+};
+
+ErrorStats compare(const std::vector<float>& actual, const std::vector<double>& expected, size_t channels,
+                   size_t samples, size_t shift, size_t skip) {
+  ErrorStats stats;
+  double error_energy = 0.0;
+  double signal_energy = 0.0;
+  for (size_t c = 0; c < channels; ++c) {
+    for (size_t t = skip + shift; t < samples; ++t) {
+      double ref = expected[c * samples + t - shift];
+      double diff = actual[c * samples + t] - ref;
+      stats.max_abs = std::max(stats.max_abs, std::fabs(diff));
+      error_energy += diff * diff;
+      signal_energy += ref * ref;
+    }
+  }
+  stats.rms_ratio = signal_energy > 0 ? std::sqrt(error_energy / signal_energy) : 0.0;
+  return stats;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <reference.npz> [chunk] [lag]\n", argv[0]);
+    return 1;
+  }
+  const size_t chunk = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 40;
+  const size_t lag = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 2000;
+
+  try {
+    auto reference = load_npz(argv[1]);
+    const NpyArray& x = reference.at("x");
+    const NpyArray& params = reference.at("params");
+    const size_t channels = x.dim(0);
+    const size_t samples = x.dim(1);
+    const double fs = params.data[0];
+    auto sections = design_butterworth_bandpass(static_cast<int>(params.data[3]), params.data[1], params.data[2], fs);
+
+    // 传递函数：与 SciPy 的二阶节在频率网格上比较（节的配对顺序可以不同）
+    const NpyArray& sos = reference.at("sos");
+    std::vector<Biquad> scipy_sections(sos.dim(0));
+    for (size_t i = 0; i < scipy_sections.size(); ++i) {
+      const double* row = &sos.data[i * 6];
+      scipy_sections[i] = Biquad{row[0] / row[3], row[1] / row[3], row[2] / row[3], row[4] / row[3], row[5] / row[3]};
+    }
+    double max_response_error = 0.0;
+    for (double f = 0.0; f < fs / 2; f += fs / 2000) {
+      max_response_error =
+          std::max(max_response_error, std::abs(sos_response(sections, f, fs) - sos_response(scipy_sections, f, fs)));
+    }
+    std::printf("frequency response: max |H - H_scipy| = %.3g\n", max_response_error);
+
+    std::vector<float> input(x.data.begin(), x.data.end());
+    std::vector<float> output(input.size());
+
+    // 因果模式：逐段送入，对比 sosfilt
+    SosFilterBank causal(sections, static_cast<int>(channels));
+    for (size_t start = 0; start < samples; start += chunk) {
+      size_t count = std::min(chunk, samples - start);
+      causal.process(input.data() + start, samples, output.data() + start, samples, count);
+    }
+    ErrorStats causal_stats = compare(output, reference.at("causal").data, channels, samples, 0, 0);
+    std::printf("causal vs sosfilt: max abs %.3g, relative rms %.3g\n", causal_stats.max_abs, causal_stats.rms_ratio);
+
+    // 零相位模式：输出延迟 lag，对比 filtfilt（跳过两端瞬态）
+    ZeroPhaseFilterBank zero_phase(sections, static_cast<int>(channels), lag);
+    for (size_t start = 0; start < samples; start += chunk) {
+      size_t count = std::min(chunk, samples - start);
+      zero_phase.process(input.data() + start, samples, output.data() + start, samples, count);
+    }
+    ErrorStats zero_phase_stats = compare(output, reference.at("filtfilt").data, channels, samples, lag, lag);
+    std::printf("zero-phase (lag %zu) vs filtfilt: max abs %.3g, relative rms %.3g\n", lag, zero_phase_stats.max_abs,
+                zero_phase_stats.rms_ratio);
+
+    return max_response_error < 1e-6 && causal_stats.rms_ratio < 1e-5 ? 0 : 2;
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+}
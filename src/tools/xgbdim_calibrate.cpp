@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inference/npz_reader.h"
+#include "inference/simd_kernels.h"
+#include "inference/xgbdim_engine.h"
+#include "inference/xgbdim_model_file.h"
+#include "inference/xgbdim_quantized.h"
+
+// 在记录的 trial 上对比定点模型与 float 模型：分数漂移、平衡准确率与推理耗时，
+// 平衡准确率下降超过门限时返回非零（doc/Requirements.md：部署后准确率下降 <= 5%）
+//
+// 用法：xgbdim_calibrate <model.npz | model.xgbm> <data.npz> [--max-drop 0.05] [--no-demean]
+//   data.npz     与 UI_XGBDIM_cpu.py 相同，X1 为目标 trial，X2（可选）为非目标 trial，均为 Ch x Te x K
+//   --max-drop   允许的平衡准确率下降（需要 X2）
+//   --no-demean  关闭按通道去均值（默认 .npz 开启，.xgbm 取文件中的设置）
+
+namespace {
+
+struct Trials {
+  std::vector<float> epochs;  // 每个 trial 一个 Ch x Te 的 float 矩阵
+  std::vector<int> labels;
+  size_t count{0};
+};
+
+// X[c, t, k] -> 每个 trial 一个 Ch x Te 矩阵，追加到 trials
+void append_trials(const NpyArray& x, int label, Trials& trials) {
+  const size_t plane = x.dim(0) * x.dim(1);
+  const size_t n = x.dim(2);
+  trials.epochs.resize((trials.count + n) * plane);
+  for (size_t i = 0; i < plane; ++i) {
+    for (size_t k = 0; k < n; ++k) {
+      trials.epochs[(trials.count + k) * plane + i] = static_cast<float>(x.data[i * n + k]);
+    }
+  }
+  trials.labels.insert(trials.labels.end(), n, label);
+  trials.count += n;
+}
+
+struct Evaluation {
+  std::vector<XgbdimResult> results;
+  double p50_us{0.0};
+  double p99_us{0.0};
+};
+
+Evaluation evaluate(const XgbdimEngine& engine, const Trials& trials) {
+  const XgbdimGeometry& geometry = engine.geometry();
+  const size_t plane = static_cast<size_t>(geometry.n_channels) * geometry.n_samples;
+  Evaluation evaluation;
+  evaluation.results.resize(trials.count);
+  std::vector<double> latency_us(trials.count);
+  for (size_t k = 0; k < trials.count; ++k) {
+    auto start = std::chrono::steady_clock::now();
+    evaluation.results[k] = engine.predict(&trials.epochs[k * plane], geometry.n_samples);
+    auto end = std::chrono::steady_clock::now();
+    latency_us[k] = std::chrono::duration<double, std::micro>(end - start).count();
+  }
+  std::sort(latency_us.begin(), latency_us.end());
+  evaluation.p50_us = latency_us[trials.count / 2];
+  evaluation.p99_us = latency_us[std::min(trials.count - 1, trials.count * 99 / 100)];
+  return evaluation;
+}
+
+// 平衡准确率 (TPR + TNR) / 2
+double balanced_accuracy(const std::vector<XgbdimResult>& results, const std::vector<int>& labels) {
+  size_t positive = 0, negative = 0, tp = 0, tn = 0;
+  for (size_t k = 0; k < results.size(); ++k) {
+    if (labels[k] == 1) {
+      ++positive;
+      tp += results[k].label == 1;
+    } else {
+      ++negative;
+      tn += results[k].label == 0;
+    }
+  }
+  return 0.5 * (static_cast<double>(tp) / positive + static_cast<double>(tn) / negative);
+}
+
+bool ends_with(const std::string& text, const std::string& suffix) {
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s <model.npz | model.xgbm> <data.npz> [--max-drop 0.05] [--no-demean]\n", argv[0]);
+    return 1;
+  }
+  double max_drop = 0.05;
+  bool demean = true;
+  for (int i = 3; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--max-drop") == 0 && i + 1 < argc) {
+      max_drop = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--no-demean") == 0) {
+      demean = false;
+    } else {
+      std::fprintf(stderr, "unknown option: %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  try {
+    auto data = load_npz(argv[2]);
+    const NpyArray& x1 = data.at("X1");
+    Trials trials;
+    append_trials(x1, 1, trials);
+    const bool labelled = data.count("X2") > 0;
+    if (labelled) {
+      append_trials(data.at("X2"), 0, trials);
+    }
+
+    // float 模型与定点模型共用一份折叠后的权重来源
+    const std::string model_path = argv[1];
+    std::shared_ptr<XgbdimEngine> reference;
+    std::shared_ptr<XgbdimEngine> quantized;
+    if (ends_with(model_path, ".xgbm")) {
+      reference = load_xgbdim_model(model_path);
+      quantized = load_xgbdim_model(model_path);
+    } else {
+      XgbdimGeometry geometry;
+      geometry.n_channels = static_cast<int>(x1.dim(0));
+      geometry.n_samples = static_cast<int>(x1.dim(1));
+      geometry.build();
+      XgbdimParams params = XgbdimParams::load_npz(model_path, geometry);
+      reference = std::make_shared<XgbdimEngine>(params, geometry);
+      quantized = std::make_shared<XgbdimEngine>(params, geometry);
+    }
+    const XgbdimGeometry& geometry = reference->geometry();
+    if (static_cast<int>(x1.dim(0)) != geometry.n_channels || static_cast<int>(x1.dim(1)) != geometry.n_samples) {
+      throw std::runtime_error("data epochs do not match the model input shape");
+    }
+    if (!demean) {
+      reference->set_demean(false);
+      quantized->set_demean(false);
+    }
+    quantized->set_precision(XgbdimPrecision::kInt8);
+
+    const XgbdimFoldedModel& folded = reference->folded();
+    const size_t float_bytes =
+        (static_cast<size_t>(geometry.n_channels) * geometry.n_samples + folded.n_local * folded.local_stride) *
+            sizeof(float) +
+        static_cast<size_t>(folded.n_local) * (geometry.chan_len + 1) * sizeof(int32_t);
+    std::printf("model: %d local models, %zu trials%s, kernels %s / %s\n", reference->n_local_models(), trials.count,
+                labelled ? " (X1 target, X2 non-target)" : "", simd_level_name(simd_level()), quant_kernel_name());
+    std::printf("weights: float32 %.1f KiB, int8 %.1f KiB\n", float_bytes / 1024.0,
+                quantized->quantized()->weight_bytes() / 1024.0);
+
+    Evaluation f32 = evaluate(*reference, trials);
+    Evaluation i8 = evaluate(*quantized, trials);
+    std::printf("latency: float32 p50 %.1f us p99 %.1f us, int8 p50 %.1f us p99 %.1f us\n", f32.p50_us, f32.p99_us,
+                i8.p50_us, i8.p99_us);
+
+    double max_drift = 0.0;
+    double sum_drift = 0.0;
+    size_t flips = 0;
+    for (size_t k = 0; k < trials.count; ++k) {
+      double drift = std::fabs(i8.results[k].score - f32.results[k].score);
+      max_drift = std::max(max_drift, drift);
+      sum_drift += drift;
+      flips += i8.results[k].label != f32.results[k].label;
+    }
+    std::printf("score drift: mean %.3g, max %.3g, label flips %zu / %zu\n", sum_drift / trials.count, max_drift,
+                flips, trials.count);
+
+    if (labelled) {
+      double ba_f32 = balanced_accuracy(f32.results, trials.labels);
+      double ba_i8 = balanced_accuracy(i8.results, trials.labels);
+      double drop = ba_f32 - ba_i8;
+      std::printf("balanced accuracy: float32 %.4f, int8 %.4f, drop %.4f (limit %.4f)\n", ba_f32, ba_i8, drop,
+                  max_drop);
+      if (drop > max_drop) {
+        std::printf("FAIL: int8 accuracy drop exceeds the limit\n");
+        return 2;
+      }
+      std::printf("PASS\n");
+    }
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
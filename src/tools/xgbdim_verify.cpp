@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "inference/npz_reader.h"
+#include "inference/simd_kernels.h"
+#include "inference/xgbdim_engine.h"
+
+// 用真实模型与数据核对原生引擎和 Python 实现的输出，并统计单个 trial 的推理耗时
+//
+// 用法：xgbdim_verify <model.npz> <data.npz> [reference.npz]
+//   data.npz       与 UI_XGBDIM_cpu.py 相同，X1 为 Ch x Te x K 的 epoch
+//   reference.npz  python/export_xgbdim_reference.py 导出的 score / decision
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "usage: %s <model.npz> <data.npz> [reference.npz]\n", argv[0]);
+    return 1;
+  }
+
+  try {
+    auto data = load_npz(argv[2]);
+    const NpyArray& x1 = data.at("X1");
+    XgbdimGeometry geometry;
+    geometry.n_channels = static_cast<int>(x1.dim(0));
+    geometry.n_samples = static_cast<int>(x1.dim(1));
+    geometry.build();
+    const size_t trials = x1.dim(2);
+
+    XgbdimEngine engine(XgbdimParams::load_npz(argv[1], geometry), geometry);
+    std::printf("model: %d local models, kernel %s, %zu trials\n", engine.n_local_models(),
+                simd_level_name(simd_level()), trials);
+
+    // X1[c, t, k] -> 每个 trial 一个 Ch x Te 的 float 矩阵
+    const size_t plane = static_cast<size_t>(geometry.n_channels) * geometry.n_samples;
+    std::vector<float> epochs(plane * trials);
+    for (size_t i = 0; i < plane; ++i) {
+      for (size_t k = 0; k < trials; ++k) {
+        epochs[k * plane + i] = static_cast<float>(x1.data[i * trials + k]);
+      }
+    }
+
+    std::vector<XgbdimResult> results(trials);
+    std::vector<double> latency_us(trials);
+    for (size_t k = 0; k < trials; ++k) {
+      auto start = std::chrono::steady_clock::now();
+      results[k] = engine.predict(&epochs[k * plane], geometry.n_samples);
+      auto end = std::chrono::steady_clock::now();
+      latency_us[k] = std::chrono::duration<double, std::micro>(end - start).count();
+    }
+    std::sort(latency_us.begin(), latency_us.end());
+    std::printf("latency: p50 %.1f us, p99 %.1f us, max %.1f us\n", latency_us[trials / 2],
+                latency_us[std::min(trials - 1, trials * 99 / 100)], latency_us.back());
+
+    if (argc > 3) {
+      auto reference = load_npz(argv[3]);
+      const NpyArray& score = reference.at("score");
+      const NpyArray& decision = reference.at("decision");
+      double max_score_error = 0.0;
+      double max_decision_error = 0.0;
+      size_t label_mismatch = 0;
+      for (size_t k = 0; k < trials; ++k) {
+        max_score_error = std::max(max_score_error, std::fabs(results[k].score - score.data[k]));
+        max_decision_error = std::max(max_decision_error, std::fabs(results[k].decision - decision.data[k]));
+        label_mismatch += results[k].label != (score.data[k] >= 0.5 ? 1 : 0);
+      }
+      std::printf("max |score - ref| %.3g, max |h - ref| %.3g, label mismatches %zu\n", max_score_error,
+                  max_decision_error, label_mismatch);
+      return label_mismatch == 0 && max_score_error < 1e-4 ? 0 : 2;
+    }
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,300 @@
+#include "utils/eeg_simulator.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+sockaddr_in make_address(const std::string &host, int port) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(static_cast<uint16_t>(port));
+  if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+    throw std::runtime_error("EegSimulator: invalid IPv4 address " + host);
+  }
+  return address;
+}
+
+uint64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+EegSimulator::EegSimulator(const EegSimulatorConfig &config) : config_(config) {
+  if (config_.n_channels < 1 || config_.n_channels > UINT16_MAX || config_.samples_per_frame < 1 ||
+      config_.samples_per_frame > INT16_MAX || !(config_.fs > 0.0)) {
+    throw std::invalid_argument("EegSimulator: invalid channel count, frame size or fs");
+  }
+  EegFrameHeader header{};
+  header.n_channels = static_cast<uint16_t>(config_.n_channels);
+  header.n_samples = static_cast<uint16_t>(config_.samples_per_frame);
+  header.format = static_cast<uint8_t>(config_.format);
+  frame_.resize(eeg_frame_bytes(header));
+
+  sockaddr_in address = make_address(config_.host, config_.port);
+  if (config_.tcp) {
+    fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const int on = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (fd_ < 0 || ::bind(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(fd_, 1) != 0) {
+      const int error = errno;
+      if (fd_ >= 0) ::close(fd_);
+      throw std::runtime_error("EegSimulator: listen on " + config_.host + ":" + std::to_string(config_.port) +
+                               " failed: " + std::strerror(error));
+    }
+    socklen_t length = sizeof(address);
+    getsockname(fd_, reinterpret_cast<sockaddr *>(&address), &length);
+    local_port_ = ntohs(address.sin_port);
+  } else {
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0 || ::connect(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+      const int error = errno;
+      if (fd_ >= 0) ::close(fd_);
+      throw std::runtime_error("EegSimulator: udp " + config_.host + ":" + std::to_string(config_.port) +
+                               " failed: " + std::strerror(error));
+    }
+    local_port_ = config_.port;
+  }
+}
+
+EegSimulator::~EegSimulator() {
+  stop();
+  if (client_fd_ >= 0) ::close(client_fd_);
+  if (fd_ >= 0) ::close(fd_);
+}
+
+float EegSimulator::sample_value(int channel, uint64_t sample, double fs) {
+  const double kPi = 3.14159265358979323846;
+  return static_cast<float>(20.0 * std::sin(2.0 * kPi * 10.0 * static_cast<double>(sample) / fs + 0.1 * channel));
+}
+
+void EegSimulator::start(uint64_t n_frames) {
+  stop();
+  running_ = true;
+  thread_ = std::thread([this, n_frames] { send(n_frames); });
+}
+
+void EegSimulator::stop() {
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void EegSimulator::send(uint64_t n_frames) {
+  running_ = true;
+  if (config_.tcp && client_fd_ < 0) {
+    // 等待客户端接入（每 10ms 检查一次是否已停止）
+    pollfd descriptor{fd_, POLLIN, 0};
+    while (running_ && ::poll(&descriptor, 1, 10) <= 0) {
+    }
+    if (!running_) return;
+    client_fd_ = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    const int on = 1;
+    setsockopt(client_fd_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const double frame_seconds = config_.samples_per_frame / config_.fs;
+  for (uint64_t i = 0; (n_frames == 0 || i < n_frames) && running_; ++i) {
+    if (config_.realtime) {
+      std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                std::chrono::duration<double>((i + 1) * frame_seconds)));
+    }
+    if (config_.drop_every > 0 && sequence_ % static_cast<uint32_t>(config_.drop_every) ==
+                                      static_cast<uint32_t>(config_.drop_every) - 1) {
+      ++sequence_;  // 跳过一个序号，接收端应计为丢失一帧
+      sample_ += config_.samples_per_frame;
+    }
+    build_frame();
+    if (!write_frame()) {
+      break;
+    }
+    ++sequence_;
+    sample_ += config_.samples_per_frame;
+    frames_sent_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void EegSimulator::build_frame() {
+  EegFrameHeader header{};
+  header.magic = kEegFrameMagic;
+  header.sequence = sequence_;
+  header.n_channels = static_cast<uint16_t>(config_.n_channels);
+  header.n_samples = static_cast<uint16_t>(config_.samples_per_frame);
+  header.format = static_cast<uint8_t>(config_.format);
+  header.resolution = config_.resolution;
+  header.trigger_offset = -1;
+  if (config_.trigger_every > 0) {
+    // 本帧内第一个 trigger_every 的整数倍
+    const uint64_t every = static_cast<uint64_t>(config_.trigger_every);
+    const uint64_t next = (sample_ + every - 1) / every * every;
+    if (next < sample_ + config_.samples_per_frame) {
+      header.trigger_offset = static_cast<int16_t>(next - sample_);
+      header.trigger_code = (next / every) % 2 == 0 ? kTriggerTarget : kTriggerNonTarget;
+    }
+  }
+
+  unsigned char *payload = frame_.data() + sizeof(header);
+  const size_t n_channels = config_.n_channels;
+  for (int s = 0; s < config_.samples_per_frame; ++s) {
+    for (size_t c = 0; c < n_channels; ++c) {
+      const float value = sample_value(static_cast<int>(c), sample_ + s, config_.fs);
+      if (config_.format == EegSampleFormat::kInt16) {
+        const int16_t count = static_cast<int16_t>(std::lround(value / config_.resolution));
+        std::memcpy(payload + (s * n_channels + c) * sizeof(int16_t), &count, sizeof(count));
+      } else {
+        std::memcpy(payload + (s * n_channels + c) * sizeof(float), &value, sizeof(value));
+      }
+    }
+  }
+  header.send_ns = steady_ns();
+  std::memcpy(frame_.data(), &header, sizeof(header));
+}
+
+bool EegSimulator::write_frame() {
+  if (!config_.tcp) {
+    // 接收端未就绪（ECONNREFUSED）时丢弃本帧，与真实放大器一致
+    ::send(fd_, frame_.data(), frame_.size(), 0);
+    return true;
+  }
+  size_t offset = 0;
+  while (offset < frame_.size()) {
+    const ssize_t n = ::send(client_fd_, frame_.data() + offset, frame_.size() - offset, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) {
+      return false;  // 客户端断开
+    }
+    offset += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+SerialEegSimulator::SerialEegSimulator(const SerialSimulatorConfig &config) : config_(config) {
+  if (config_.n_channels < 1 || !(config_.fs > 0.0) || config_.baud <= 0 || !(config_.resolution > 0.0f)) {
+    throw std::invalid_argument("SerialEegSimulator: invalid channel count, fs, baud or resolution");
+  }
+  const size_t frame_bytes = serial_frame_bytes(config_.n_channels);
+  if (config_.realtime && frame_bytes * 10 * config_.fs > config_.baud) {
+    throw std::invalid_argument("SerialEegSimulator: " + std::to_string(config_.baud) + " baud cannot carry " +
+                                std::to_string(config_.n_channels) + " channels at " + std::to_string(config_.fs) +
+                                " Hz");
+  }
+  counts_.resize(config_.n_channels);
+  frame_.resize(frame_bytes);
+
+  master_fd_ = ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+  char name[128] = {};
+  if (master_fd_ < 0 || grantpt(master_fd_) != 0 || unlockpt(master_fd_) != 0 ||
+      ptsname_r(master_fd_, name, sizeof(name)) != 0) {
+    const int error = errno;
+    if (master_fd_ >= 0) ::close(master_fd_);
+    throw std::runtime_error(std::string("SerialEegSimulator: pseudo-terminal failed: ") + std::strerror(error));
+  }
+  device_ = name;
+  // 从端设为 raw，接收端打开之前写入的字节也不会被行规程改写或回显
+  slave_fd_ = ::open(name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+  termios options{};
+  if (slave_fd_ >= 0 && tcgetattr(slave_fd_, &options) == 0) {
+    cfmakeraw(&options);
+    tcsetattr(slave_fd_, TCSANOW, &options);
+  }
+  ::fcntl(master_fd_, F_SETFL, ::fcntl(master_fd_, F_GETFL) | O_NONBLOCK);
+}
+
+SerialEegSimulator::~SerialEegSimulator() {
+  stop();
+  if (slave_fd_ >= 0) ::close(slave_fd_);
+  if (master_fd_ >= 0) ::close(master_fd_);
+}
+
+void SerialEegSimulator::send(uint64_t n_frames) {
+  start_time_ = std::chrono::steady_clock::now();
+  running_ = true;
+  run(n_frames);
+}
+
+void SerialEegSimulator::start(uint64_t n_frames) {
+  stop();
+  start_time_ = std::chrono::steady_clock::now();
+  running_ = true;
+  thread_ = std::thread([this, n_frames] { run(n_frames); });
+}
+
+void SerialEegSimulator::stop() {
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void SerialEegSimulator::run(uint64_t n_frames) {
+  const double frame_seconds = 1.0 / config_.fs;
+  for (uint64_t i = 0; (n_frames == 0 || i < n_frames) && running_; ++i) {
+    if (config_.realtime) {
+      std::this_thread::sleep_until(start_time_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                      std::chrono::duration<double>((i + 1) * frame_seconds)));
+    }
+    if (config_.drop_every > 0 && i % config_.drop_every == static_cast<uint64_t>(config_.drop_every) - 1) {
+      ++counter_;  // 跳过一个计数，接收端应计为丢失一帧
+      ++sample_;
+    }
+
+    uint8_t trigger = 0;
+    if (config_.trigger_every > 0) {
+      const uint64_t every = static_cast<uint64_t>(config_.trigger_every);
+      if (sample_ % every < static_cast<uint64_t>(config_.trigger_hold)) {
+        trigger = static_cast<uint8_t>((sample_ / every) % 2 == 0 ? kTriggerTarget : kTriggerNonTarget);
+      }
+    }
+    for (int c = 0; c < config_.n_channels; ++c) {
+      counts_[c] = static_cast<int32_t>(
+          std::lround(EegSimulator::sample_value(c, sample_, config_.fs) / config_.resolution));
+    }
+    encode_serial_frame(frame_.data(), counter_, trigger, counts_.data(), config_.n_channels);
+    if (config_.corrupt_every > 0 && i % config_.corrupt_every == static_cast<uint64_t>(config_.corrupt_every) - 1) {
+      frame_[kSerialHeaderBytes] ^= 0x5A;  // 破坏第一个通道，CRC 不再匹配
+    }
+    if (!write_frame()) {
+      break;
+    }
+    ++counter_;
+    ++sample_;
+    frames_sent_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool SerialEegSimulator::write_frame() {
+  size_t offset = 0;
+  while (offset < frame_.size()) {
+    const ssize_t n = ::write(master_fd_, frame_.data() + offset, frame_.size() - offset);
+    if (n > 0) {
+      offset += static_cast<size_t>(n);
+    } else if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+      // 接收端读得慢，伪终端缓冲区已满：等待（每 10ms 检查一次是否已停止）
+      pollfd descriptor{master_fd_, POLLOUT, 0};
+      while (running_ && ::poll(&descriptor, 1, 10) <= 0) {
+      }
+      if (!running_) return false;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
@@ -1,3 +1,323 @@
-#include "logger.h"
+#include <time.h>
 
-// Logger 实现 (如果需要其他功能，可以在此扩展)
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "utils/async_logger.h"
+
+// ==================== AsyncLogger 实现 ====================
+
+std::atomic<int> AsyncLogger::level_{static_cast<int>(LogLevel::INFO)};
+
+namespace {
+
+int64_t system_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+const char *level_name(LogLevel level) {
+  switch (level) {
+    case LogLevel::DEBUG: return "DEBUG";
+    case LogLevel::INFO: return "INFO";
+    case LogLevel::WARN: return "WARN";
+    case LogLevel::ERROR: return "ERROR";
+    default: return "UNKNOWN";
+  }
+}
+
+// 按类型标签读出 payload 中的下一个参数
+struct ArgReader {
+  const LogRecord &record;
+  size_t offset{0};
+
+  char next_tag() const { return offset < record.size ? record.payload[offset] : '\0'; }
+
+  template <class T>
+  T read_value() {
+    T value;
+    std::memcpy(&value, record.payload + offset + 1, sizeof(T));
+    offset += 1 + sizeof(T);
+    return value;
+  }
+
+  std::string read_string() {
+    uint16_t length = 0;
+    std::memcpy(&length, record.payload + offset + 1, sizeof(length));
+    std::string value(record.payload + offset + 1 + sizeof(length), length);
+    offset += 1 + sizeof(length) + length;
+    return value;
+  }
+
+  void skip() {
+    switch (next_tag()) {
+      case 's': read_string(); break;
+      case '\0': break;
+      default: offset += 1 + 8; break;
+    }
+  }
+};
+
+// 格式化一个转换说明（spec 不含长度修饰符），参数类型与说明不符时输出 "<?>"
+void format_arg(std::string &buffer, const std::string &spec, char conversion, ArgReader &args) {
+  char text[512];
+  const size_t start = args.offset;
+  const char tag = args.next_tag();
+  int written = -1;
+  if (tag == '\0') {
+    buffer += "<?>";
+    return;
+  }
+  switch (conversion) {
+    case 'd':
+    case 'i':
+    case 'c': {
+      if (tag != 'i' && tag != 'u') break;
+      long long value = tag == 'i' ? static_cast<long long>(args.read_value<int64_t>())
+                                   : static_cast<long long>(args.read_value<uint64_t>());
+      written = conversion == 'c' ? snprintf(text, sizeof(text), (spec + 'c').c_str(), static_cast<int>(value))
+                                  : snprintf(text, sizeof(text), (spec + "ll" + conversion).c_str(), value);
+      break;
+    }
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X': {
+      if (tag != 'i' && tag != 'u') break;
+      unsigned long long value = tag == 'u' ? static_cast<unsigned long long>(args.read_value<uint64_t>())
+                                            : static_cast<unsigned long long>(args.read_value<int64_t>());
+      written = snprintf(text, sizeof(text), (spec + "ll" + conversion).c_str(), value);
+      break;
+    }
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A': {
+      if (tag != 'd') break;
+      written = snprintf(text, sizeof(text), (spec + conversion).c_str(), args.read_value<double>());
+      break;
+    }
+    case 's': {
+      if (tag != 's') break;
+      written = snprintf(text, sizeof(text), (spec + 's').c_str(), args.read_string().c_str());
+      break;
+    }
+    case 'p': {
+      if (tag != 'p') break;
+      written = snprintf(text, sizeof(text), (spec + 'p').c_str(), args.read_value<const void *>());
+      break;
+    }
+    default:
+      break;
+  }
+  if (written < 0) {
+    // 类型不符时参数尚未读取，跳过它；已读取但格式化失败时不能再跳，否则后续参数错位
+    if (args.offset == start) {
+      args.skip();
+    }
+    buffer += "<?>";
+    return;
+  }
+  buffer.append(text, std::min<size_t>(static_cast<size_t>(written), sizeof(text) - 1));
+}
+
+}  // namespace
+
+AsyncLogger &AsyncLogger::instance() {
+  static AsyncLogger logger;
+  return logger;
+}
+
+AsyncLogger::AsyncLogger() {
+  coarse_now_ns_.store(system_now_ns(), std::memory_order_relaxed);
+  worker_ = std::thread(&AsyncLogger::run, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+  running_.store(false, std::memory_order_release);
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  if (owned_file_) {
+    std::fclose(owned_file_);
+  }
+}
+
+bool AsyncLogger::set_output_file(const std::string &path) {
+  if (path.empty()) {
+    return false;
+  }
+  FILE *file = std::fopen(path.c_str(), "a");
+  if (file == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  if (owned_file_) {
+    std::fclose(owned_file_);
+  }
+  owned_file_ = file;
+  output_ = file;
+  return true;
+}
+
+void AsyncLogger::set_output(FILE *stream) {
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  output_ = stream ? stream : stdout;
+}
+
+void AsyncLogger::flush() {
+  const uint64_t target = cycles_.load(std::memory_order_acquire) + 2;
+  while (worker_.joinable() && running_.load(std::memory_order_acquire) &&
+         cycles_.load(std::memory_order_acquire) < target) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+uint64_t AsyncLogger::dropped() const {
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  uint64_t total = dropped_total_;
+  for (const auto &ring : rings_) total += ring->dropped.load(std::memory_order_relaxed);
+  return total;
+}
+
+AsyncLogger::Ring &AsyncLogger::local_ring() {
+  // 线程退出时标记环已关闭，后台线程取空后回收
+  struct Handle {
+    std::shared_ptr<Ring> ring;
+    ~Handle() {
+      if (ring) ring->closed.store(true, std::memory_order_release);
+    }
+  };
+  thread_local Handle handle;
+  if (!handle.ring) {
+    handle.ring = std::make_shared<Ring>(next_thread_.fetch_add(1, std::memory_order_relaxed));
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(handle.ring);
+  }
+  return *handle.ring;
+}
+
+void AsyncLogger::submit(const LogRecord &record) {
+  Ring &ring = local_ring();
+  if (!ring.records.try_push(record)) {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void AsyncLogger::run() {
+  std::string buffer;
+  buffer.reserve(64 * 1024);
+  bool stopping = false;
+  while (!stopping) {
+    stopping = !running_.load(std::memory_order_acquire);  // 停止前再完整取一轮
+    coarse_now_ns_.store(system_now_ns(), std::memory_order_relaxed);
+    const size_t count = drain(buffer);
+
+    const uint64_t dropped_now = dropped();
+    if (dropped_now > dropped_reported_) {
+      LogRecord record;
+      record.format = "logger dropped %llu records (ring full)";
+      record.level = LogLevel::WARN;
+      record.time_ns = coarse_now_ns_.load(std::memory_order_relaxed);
+      record.put_uint(dropped_now - dropped_reported_);
+      format(record, 0, buffer);
+      dropped_reported_ = dropped_now;
+    }
+
+    if (!buffer.empty()) {
+      std::lock_guard<std::mutex> lock(output_mutex_);
+      std::fwrite(buffer.data(), 1, buffer.size(), output_);
+      std::fflush(output_);
+      buffer.clear();
+    }
+    cycles_.fetch_add(1, std::memory_order_release);
+    if (count == 0 && !stopping) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+size_t AsyncLogger::drain(std::string &buffer) {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings = rings_;
+  }
+  size_t count = 0;
+  LogRecord record;
+  for (auto &ring : rings) {
+    const bool closed = ring->closed.load(std::memory_order_acquire);
+    while (ring->records.try_pop(record)) {
+      format(record, ring->thread, buffer);
+      ++count;
+    }
+    // 所属线程已退出且已取空：回收
+    if (closed) {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      dropped_total_ += ring->dropped.load(std::memory_order_relaxed);
+      rings_.erase(std::remove(rings_.begin(), rings_.end(), ring), rings_.end());
+    }
+  }
+  return count;
+}
+
+void AsyncLogger::format(const LogRecord &record, uint32_t thread, std::string &buffer) {
+  // 时间字符串按秒缓存
+  const time_t seconds = static_cast<time_t>(record.time_ns / 1000000000);
+  if (seconds != cached_second_) {
+    struct tm local_time;
+    localtime_r(&seconds, &local_time);
+    strftime(cached_time_, sizeof(cached_time_), "%Y-%m-%d %H:%M:%S", &local_time);
+    cached_second_ = seconds;
+  }
+  char prefix[128];
+  const char *file = record.file ? std::strrchr(record.file, '/') : nullptr;
+  file = file ? file + 1 : record.file;
+  int length;
+  if (file) {
+    length = snprintf(prefix, sizeof(prefix), "[%s.%03d] [%s] [T%u %s:%d] ", cached_time_,
+                      static_cast<int>(record.time_ns / 1000000 % 1000), level_name(record.level), thread, file,
+                      record.line);
+  } else {
+    length = snprintf(prefix, sizeof(prefix), "[%s.%03d] [%s] [T%u] ", cached_time_,
+                      static_cast<int>(record.time_ns / 1000000 % 1000), level_name(record.level), thread);
+  }
+  buffer.append(prefix, std::min<size_t>(static_cast<size_t>(std::max(length, 0)), sizeof(prefix) - 1));
+
+  // 逐个转换说明格式化参数
+  ArgReader args{record};
+  const char *p = record.format ? record.format : "";
+  while (*p) {
+    if (*p != '%') {
+      const char *next = std::strchr(p, '%');
+      const size_t run = next ? static_cast<size_t>(next - p) : std::strlen(p);
+      buffer.append(p, run);
+      p += run;
+      continue;
+    }
+    if (p[1] == '%') {
+      buffer += '%';
+      p += 2;
+      continue;
+    }
+    const char *start = p++;
+    while (*p && std::strchr("-+ #0", *p)) ++p;
+    while (*p >= '0' && *p <= '9') ++p;
+    if (*p == '.') {
+      ++p;
+      while (*p >= '0' && *p <= '9') ++p;
+    }
+    std::string spec(start, p);  // 去掉长度修饰符，按参数的实际类型重新加上
+    while (*p && std::strchr("hlLqjzt", *p)) ++p;
+    if (*p == '\0') {
+      break;
+    }
+    format_arg(buffer, spec, *p++, args);
+  }
+  buffer += '\n';
+}
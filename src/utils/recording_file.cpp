@@ -0,0 +1,126 @@
+#include "utils/recording_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "utils/aligned_buffer.h"
+#include "utils/checksum.h"
+
+namespace {
+
+constexpr size_t kCrcOffset = 16;        // magic + version + crc32 之后的内容参与校验
+constexpr size_t kRowAlignment = 16;     // 每行按 16 个 float 对齐
+
+size_t align_up(size_t offset, size_t alignment = kSimdAlignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+void save_recording(const std::string& path, double fs, int n_channels, size_t n_samples, const float* data,
+                    std::vector<RecordingEvent> events) {
+  if (fs <= 0.0 || n_channels <= 0) {
+    throw std::invalid_argument("save_recording: fs and n_channels must be positive");
+  }
+  std::sort(events.begin(), events.end(),
+            [](const RecordingEvent& a, const RecordingEvent& b) { return a.sample < b.sample; });
+  for (const RecordingEvent& event : events) {
+    if (event.sample < 0 || static_cast<size_t>(event.sample) >= n_samples) {
+      throw std::invalid_argument("save_recording: event at sample " + std::to_string(event.sample) +
+                                  " is outside the recording");
+    }
+  }
+
+  RecordingHeader header{};
+  std::memcpy(header.magic, kRecordingMagic, sizeof(header.magic));
+  header.version = kRecordingVersion;
+  header.header_size = sizeof(RecordingHeader);
+  header.n_channels = n_channels;
+  header.fs = fs;
+  header.n_samples = n_samples;
+  header.row_stride = align_up(n_samples, kRowAlignment);
+  header.data_offset = align_up(sizeof(RecordingHeader));
+  header.n_events = events.size();
+  header.events_offset = align_up(header.data_offset + n_channels * header.row_stride * sizeof(float));
+  header.file_size = align_up(header.events_offset + events.size() * sizeof(RecordingEvent));
+
+  std::vector<unsigned char> buffer(header.file_size, 0);
+  for (int c = 0; c < n_channels && n_samples > 0; ++c) {
+    std::memcpy(buffer.data() + header.data_offset + c * header.row_stride * sizeof(float), data + c * n_samples,
+                n_samples * sizeof(float));
+  }
+  if (!events.empty()) {
+    std::memcpy(buffer.data() + header.events_offset, events.data(), events.size() * sizeof(RecordingEvent));
+  }
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  header.crc32 = crc32(buffer.data() + kCrcOffset, buffer.size() - kCrcOffset);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Failed to create " + temp_path);
+    }
+    out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!out) {
+      throw std::runtime_error("Failed to write " + temp_path);
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    throw std::runtime_error("Failed to rename " + temp_path + " to " + path);
+  }
+}
+
+RecordingFile::RecordingFile(const std::string& path, bool populate, bool verify) : file_(path, populate) {
+  if (file_.size() < sizeof(RecordingHeader)) {
+    throw std::runtime_error(path + ": file is too small to be a recording");
+  }
+  std::memcpy(&header_, file_.data(), sizeof(header_));
+  if (std::memcmp(header_.magic, kRecordingMagic, sizeof(header_.magic)) != 0) {
+    throw std::runtime_error(path + ": not an RSVP recording");
+  }
+  if (header_.version != kRecordingVersion) {
+    throw std::runtime_error(path + ": unsupported recording version " + std::to_string(header_.version) +
+                             " (re-run convert_recording.py to regenerate it)");
+  }
+  if (header_.header_size != sizeof(RecordingHeader) || header_.file_size != file_.size()) {
+    throw std::runtime_error(path + ": header size or file size mismatch (truncated file?)");
+  }
+  if (verify && crc32(file_.data() + kCrcOffset, file_.size() - kCrcOffset) != header_.crc32) {
+    throw std::runtime_error(path + ": checksum mismatch");
+  }
+
+  // 各段必须对齐且完整落在文件内
+  const uint64_t size = file_.size();
+  if (header_.n_channels <= 0 || !(header_.fs > 0.0) || header_.row_stride < header_.n_samples ||
+      header_.data_offset % kSimdAlignment != 0 || header_.events_offset % kSimdAlignment != 0) {
+    throw std::runtime_error(path + ": invalid recording header");
+  }
+  const uint64_t row_bytes = header_.row_stride * sizeof(float);
+  if (header_.data_offset > size ||
+      (row_bytes > 0 && static_cast<uint64_t>(header_.n_channels) > (size - header_.data_offset) / row_bytes) ||
+      header_.events_offset > size || header_.n_events > (size - header_.events_offset) / sizeof(RecordingEvent)) {
+    throw std::runtime_error(path + ": data or events out of bounds");
+  }
+  data_ = reinterpret_cast<const float*>(file_.data() + header_.data_offset);
+  events_ = reinterpret_cast<const RecordingEvent*>(file_.data() + header_.events_offset);
+  for (size_t i = 0; i < n_events(); ++i) {
+    if (events_[i].sample < 0 || static_cast<uint64_t>(events_[i].sample) >= header_.n_samples ||
+        (i > 0 && events_[i].sample < events_[i - 1].sample)) {
+      throw std::runtime_error(path + ": events are out of range or not sorted");
+    }
+  }
+}
+
+size_t RecordingFile::lower_event(size_t sample) const {
+  const RecordingEvent* end = events_ + n_events();
+  const RecordingEvent* it = std::lower_bound(
+      events_, end, static_cast<int64_t>(sample),
+      [](const RecordingEvent& event, int64_t value) { return event.sample < value; });
+  return static_cast<size_t>(it - events_);
+}
@@ -0,0 +1,194 @@
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "framework/executor.h"
+#include "framework/pipeline.h"
+
+// 比较每个模块独占一个线程（Pipeline::run）、工作窃取执行器（Pipeline::run_executor）与融合执行（Pipeline::run_fused，
+// 1 个与 workers 个工作线程）：Source -> Preprocessor（轻） -> Runner（重，忙等 runner_us） -> Postprocessor -> Sink，
+// 记录前 packages 个包的吞吐量、"计划产生 -> Sink 处理" 的时延分位数以及整个进程的 CPU 占用。
+// 用法：bench_executor [packages] [workers] [runner_us] [interval_us]，interval_us 为 0 时 Source 全速产生。
+
+static int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t process_cpu_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// 忙等模拟计算量
+static void busy_for(int64_t ns) {
+  const int64_t until = now_ns() + ns;
+  while (now_ns() < until) {
+  }
+}
+
+struct Shared {
+  std::vector<int64_t> planned;   // 按序号记录的计划产生时刻
+  std::vector<int64_t> latency;   // 按序号记录的时延
+  std::atomic<size_t> done{0};    // Sink 已处理的前 packages 个包
+  int64_t interval_ns{0};
+  int64_t start_ns{0};
+};
+
+class BenchSource : public Source {
+ public:
+  BenchSource(Shared *shared, bool blocking, const WaitStrategy &wait)
+      : Source(32, false, -1, -1, wait), shared_(shared), blocking_(blocking) {}
+
+  // 按计划时刻产生；执行器模式下未到时刻返回 false（本轮无数据），不占用工作线程
+  bool process(Package *) override {
+    int64_t due = shared_->start_ns + static_cast<int64_t>(produced_) * shared_->interval_ns;
+    int64_t now = now_ns();
+    if (shared_->interval_ns > 0 && now < due) {
+      if (!blocking_) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+    }
+    if (produced_ < shared_->planned.size()) {
+      shared_->planned[produced_] = shared_->interval_ns > 0 ? due : now_ns();
+    }
+    ++produced_;
+    return true;
+  }
+
+ private:
+  Shared *shared_;
+  bool blocking_;
+  size_t produced_{0};
+};
+
+class BenchPreprocessor : public Preprocessor {
+ public:
+  BenchPreprocessor(int64_t work_ns, const WaitStrategy &wait)
+      : Preprocessor(1, false, -1, -1, wait), work_ns_(work_ns) {}
+  bool process(Package *) override {
+    busy_for(work_ns_);
+    return true;
+  }
+
+ private:
+  int64_t work_ns_;
+};
+
+class BenchRunner : public Runner {
+ public:
+  BenchRunner(int64_t work_ns, const WaitStrategy &wait) : Runner(1, false, -1, -1, wait), work_ns_(work_ns) {}
+  bool process(Package *) override {
+    busy_for(work_ns_);
+    return true;
+  }
+
+ private:
+  int64_t work_ns_;
+};
+
+class BenchPostprocessor : public Postprocessor {
+ public:
+  explicit BenchPostprocessor(const WaitStrategy &wait) : Postprocessor(1, false, -1, -1, wait) {}
+  bool process(Package *) override { return true; }
+};
+
+class BenchSink : public Sink {
+ public:
+  BenchSink(Shared *shared, const WaitStrategy &wait) : Sink(1, false, -1, -1, wait), shared_(shared) {}
+  bool process(Package *package) override {
+    uint64_t sequence = package->get_sequence();
+    if (sequence < shared_->latency.size()) {
+      shared_->latency[sequence] = now_ns() - shared_->planned[sequence];
+      shared_->done.fetch_add(1, std::memory_order_release);
+    }
+    return true;
+  }
+
+ private:
+  Shared *shared_;
+};
+
+enum class Mode { kThreads, kExecutor, kFused };
+
+static void run_case(const char *name, Mode mode, int workers, size_t packages, int64_t runner_ns,
+                     int64_t interval_ns) {
+  WaitStrategy wait = WaitStrategy::spin_yield();
+  wait.timeout = std::chrono::microseconds(1000);
+  Shared shared;
+  shared.planned.assign(packages, 0);
+  shared.latency.assign(packages, 0);
+  shared.interval_ns = interval_ns;
+
+  BenchSource source(&shared, mode != Mode::kExecutor, wait);
+  BenchPreprocessor preprocessor(runner_ns / 20, wait);
+  BenchRunner runner(runner_ns, wait);
+  BenchPostprocessor postprocessor(wait);
+  BenchSink sink(&shared, wait);
+  Pipeline pipeline(5, 64);
+  std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&preprocessor}, {&runner}, {&postprocessor}, {&sink}};
+
+  ExecutorConfig config;
+  config.workers = workers;
+  FusedConfig fused;
+  fused.workers = workers;
+  shared.start_ns = now_ns();
+  const int64_t cpu_start = process_cpu_ns();
+  std::thread driver([&] {
+    if (mode == Mode::kThreads) {
+      pipeline.run(modules, false);
+    } else if (mode == Mode::kExecutor) {
+      pipeline.run_executor(modules, config, false);
+    } else {
+      pipeline.run_fused(modules, fused, false);
+    }
+  });
+  while (shared.done.load(std::memory_order_acquire) < packages) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const int64_t wall_ns = now_ns() - shared.start_ns;
+  const int64_t cpu_ns = process_cpu_ns() - cpu_start;
+  source.exit();
+  preprocessor.exit();
+  runner.exit();
+  postprocessor.exit();
+  sink.exit();
+  pipeline.exit();
+  driver.join();
+
+  std::vector<int64_t> &latency = shared.latency;
+  std::sort(latency.begin(), latency.end());
+  auto pct = [&](double p) { return latency[static_cast<size_t>(p * (latency.size() - 1))] / 1000.0; };
+  std::printf("%-12s %9.0f pkg/s  p50 = %8.1f us  p99 = %8.1f us  p99.9 = %8.1f us  CPU = %5.2f cores\n", name,
+              packages * 1e9 / wall_ns, pct(0.50), pct(0.99), pct(0.999), static_cast<double>(cpu_ns) / wall_ns);
+}
+
+int main(int argc, char **argv) {
+  size_t packages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+  int workers = argc > 2 ? std::atoi(argv[2]) : 2;
+  int runner_us = argc > 3 ? std::atoi(argv[3]) : 200;
+  int interval_us = argc > 4 ? std::atoi(argv[4]) : 0;
+  std::printf("%zu packages, runner %d us/package, %s, %u hardware threads\n", packages, runner_us,
+              interval_us > 0 ? "paced" : "max speed", std::thread::hardware_concurrency());
+
+  const int64_t runner_ns = static_cast<int64_t>(runner_us) * 1000;
+  const int64_t interval_ns = static_cast<int64_t>(interval_us) * 1000;
+  run_case("threads", Mode::kThreads, 0, packages, runner_ns, interval_ns);
+  char name[32];
+  std::snprintf(name, sizeof(name), "executor x%d", workers);
+  run_case(name, Mode::kExecutor, workers, packages, runner_ns, interval_ns);
+  run_case("fused x1", Mode::kFused, 1, packages, runner_ns, interval_ns);
+  std::snprintf(name, sizeof(name), "fused x%d", workers);
+  run_case(name, Mode::kFused, workers, packages, runner_ns, interval_ns);
+  return 0;
+}
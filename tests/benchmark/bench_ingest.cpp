@@ -0,0 +1,110 @@
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "framework/pipeline.h"
+#include "modules/network_source.h"
+#include "utils/eeg_simulator.h"
+
+// 回环上的网络接入时延：EegSimulator 按给定帧率发送 64 通道 x 40 采样点（int16）的数据帧，
+// NetworkSource -> Sink 组成两级流水线，报告每帧 "内核收到 -> Source 入队" 的时延分位数、丢帧与 CPU 占用。
+// 用法：bench_ingest [frames] [frames_per_second] [udp|tcp] [threads|executor]，frames_per_second 为 0 时全速发送。
+
+static int64_t process_cpu_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+class CountingSink : public Sink {
+ public:
+  explicit CountingSink(const WaitStrategy &wait) : Sink(1, false, -1, -1, wait) {}
+
+  bool process(Package *) override {
+    done_.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+
+  uint64_t done() const { return done_.load(std::memory_order_acquire); }
+
+ private:
+  std::atomic<uint64_t> done_{0};
+};
+
+int main(int argc, char **argv) {
+  const uint64_t frames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+  const double rate = argc > 2 ? std::atof(argv[2]) : 2000.0;
+  const bool tcp = argc > 3 && std::strcmp(argv[3], "tcp") == 0;
+  const bool executor = argc > 4 && std::strcmp(argv[4], "executor") == 0;
+
+  EegSimulatorConfig simulator_config;
+  simulator_config.tcp = tcp;
+  simulator_config.port = 0;
+  simulator_config.realtime = rate > 0.0;
+  simulator_config.fs = rate > 0.0 ? rate * simulator_config.samples_per_frame : 1000.0;
+
+  NetworkSourceConfig source_config;
+  source_config.protocol = tcp ? NetworkSourceConfig::Protocol::kTcp : NetworkSourceConfig::Protocol::kUdp;
+  source_config.port = 0;
+
+  WaitStrategy wait = WaitStrategy::spin_yield();
+  wait.timeout = std::chrono::microseconds(1000);
+
+  // UDP 由接收端先绑定端口；TCP 由模拟器先监听
+  std::unique_ptr<EegSimulator> simulator;
+  if (tcp) {
+    simulator = std::make_unique<EegSimulator>(simulator_config);
+    source_config.port = simulator->local_port();
+  }
+  NetworkSource source(source_config, 32, false, -1, -1, wait);
+  if (!tcp) {
+    simulator_config.port = source.local_port();
+    simulator = std::make_unique<EegSimulator>(simulator_config);
+  }
+  CountingSink sink(wait);
+
+  Pipeline pipeline(2, 64);
+  std::thread runner([&] {
+    if (executor) {
+      ExecutorConfig config;
+      config.workers = 2;
+      pipeline.run_executor({{&source}, {&sink}}, config, false);
+    } else {
+      pipeline.run({{&source}, {&sink}}, false);
+    }
+  });
+
+  const int64_t cpu_start = process_cpu_ns();
+  const auto start = std::chrono::steady_clock::now();
+  simulator->start(frames);
+  // 发送结束后再等 200ms 收尾（UDP 丢掉的帧不会再到）
+  while (simulator->frames_sent() < frames) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+  while (sink.done() < frames && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const double cpu = (process_cpu_ns() - cpu_start) / 1e9;
+
+  simulator->stop();
+  source.exit();
+  sink.exit();
+  pipeline.exit();
+  runner.join();
+
+  const NetworkSource::Stats stats = source.stats();
+  std::printf("%s / %s, %llu frames at %.0f fps (0 = max)\n", tcp ? "tcp" : "udp", executor ? "executor" : "threads",
+              static_cast<unsigned long long>(frames), rate);
+  std::printf("  received %llu, lost %llu (%llu gaps), malformed %llu, %.1f MB in %.2f s, cpu %.0f%%\n",
+              static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.lost),
+              static_cast<unsigned long long>(stats.gaps), static_cast<unsigned long long>(stats.malformed),
+              stats.bytes / 1e6, seconds, 100.0 * cpu / seconds);
+  std::printf("  %s\n", source.ingest_latency().format("ingest (kernel -> queue)").c_str());
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "utils/common.h"
+
+// 比较字符串键接口（哈希 + variant + 按值返回）与编译期槽位接口（数组下标 + 引用）的访问开销
+
+template <class F>
+static double time_ns_per_op(int iterations, F&& body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    body(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  Package package;
+  package.slot<Slot::kEpoch>().create(54, 250, CV_32F);
+  volatile float sink = 0.0f;
+
+  double string_scalar = time_ns_per_op(iterations, [&](int i) {
+    package.add_data("score", static_cast<float>(i));
+    sink = sink + package.get_data<float>("score");
+  });
+  double slot_scalar = time_ns_per_op(iterations, [&](int i) {
+    package.slot<Slot::kScore>() = static_cast<float>(i);
+    sink = sink + package.slot<Slot::kScore>();
+  });
+
+  // 张量：字符串接口按值返回 cv::Mat 头（引用计数 +1/-1），槽位接口返回引用
+  double string_tensor = time_ns_per_op(iterations, [&](int) {
+    cv::Mat epoch = package.get_data<cv::Mat>("epoch");
+    sink = sink + epoch.ptr<float>(0)[0];
+  });
+  double slot_tensor = time_ns_per_op(iterations, [&](int) {
+    const cv::Mat& epoch = package.slot<Slot::kEpoch>();
+    sink = sink + epoch.ptr<float>(0)[0];
+  });
+
+  // 非 schema 的字符串键：std::unordered_map<std::string, variant> 原始路径
+  double map_scalar = time_ns_per_op(iterations, [&](int i) {
+    package.add_data("custom_score", static_cast<float>(i));
+    sink = sink + package.get_data<float>("custom_score");
+  });
+
+  std::printf("Package access, %d iterations (ns/op)\n", iterations);
+  std::printf("  scalar write+read  map key: %7.2f  schema key: %7.2f  slot: %7.2f\n", map_scalar, string_scalar,
+              slot_scalar);
+  std::printf("  tensor read        schema key: %7.2f  slot: %7.2f\n", string_tensor, slot_tensor);
+  return 0;
+}
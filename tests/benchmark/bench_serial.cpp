@@ -0,0 +1,109 @@
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "framework/pipeline.h"
+#include "modules/serial_source.h"
+#include "utils/eeg_simulator.h"
+#include "utils/latency_histogram.h"
+
+// 伪终端上的串口接入时延：SerialEegSimulator 按 fs 逐采样点发帧，SerialSource -> Sink 组成两级流水线，
+// 报告 "字节读入 -> Source 入队" 与 "最后一个采样点按时间表发出 -> Sink 处理" 两段时延的分位数、丢帧与 CPU 占用。
+// 用法：bench_serial [seconds] [fs] [n_channels] [baud] [epoll|batch]
+
+static int64_t process_cpu_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+// 按累计采样点数推算包最后一个采样点的计划发出时刻
+class LagSink : public Sink {
+ public:
+  LagSink(const WaitStrategy &wait, double fs) : Sink(1, false, -1, -1, wait), fs_(fs) {}
+
+  void set_start(std::chrono::steady_clock::time_point start) { start_ = start; }
+
+  bool process(Package *package) override {
+    samples_ += static_cast<uint64_t>(package->slot<Slot::kRawEeg>().cols);
+    const auto due = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double>(samples_ / fs_));
+    const int64_t lag = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - due)
+                            .count();
+    lag_.record(lag > 0 ? static_cast<uint64_t>(lag) : 0);
+    done_.store(samples_, std::memory_order_release);
+    return true;
+  }
+
+  uint64_t done() const { return done_.load(std::memory_order_acquire); }
+  LatencySnapshot lag() const { return lag_.snapshot(); }
+
+ private:
+  double fs_;
+  std::chrono::steady_clock::time_point start_;
+  uint64_t samples_{0};
+  std::atomic<uint64_t> done_{0};
+  LatencyHistogram lag_;
+};
+
+int main(int argc, char **argv) {
+  const double seconds = argc > 1 ? std::atof(argv[1]) : 5.0;
+  const double fs = argc > 2 ? std::atof(argv[2]) : 1000.0;
+  const int n_channels = argc > 3 ? std::atoi(argv[3]) : 8;
+  const int baud = argc > 4 ? std::atoi(argv[4]) : 921600;
+  const bool batch = argc > 5 && std::strcmp(argv[5], "batch") == 0;
+
+  SerialSimulatorConfig simulator_config;
+  simulator_config.n_channels = n_channels;
+  simulator_config.fs = fs;
+  simulator_config.baud = baud;
+  SerialEegSimulator simulator(simulator_config);
+
+  SerialSourceConfig source_config;
+  source_config.device = simulator.device();
+  source_config.baud = baud;
+  source_config.n_channels = n_channels;
+  source_config.wakeup = batch ? SerialSourceConfig::Wakeup::kBatch : SerialSourceConfig::Wakeup::kEpoll;
+
+  WaitStrategy wait = WaitStrategy::park();
+  wait.timeout = std::chrono::microseconds(1000);
+  SerialSource source(source_config, 32, false, -1, -1, wait);
+  LagSink sink(wait, fs);
+
+  Pipeline pipeline(2, 64);
+  std::thread runner([&] { pipeline.run({{&source}, {&sink}}, false); });
+
+  const uint64_t frames = static_cast<uint64_t>(seconds * fs);
+  const int64_t cpu_start = process_cpu_ns();
+  simulator.start(frames);
+  sink.set_start(simulator.start_time());
+  const uint64_t expected = frames / source_config.chunk * source_config.chunk;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds + 1.0);
+  while (sink.done() < expected && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const double cpu = (process_cpu_ns() - cpu_start) / 1e9;
+
+  simulator.stop();
+  source.exit();
+  sink.exit();
+  pipeline.exit();
+  runner.join();
+
+  const SerialSource::Stats stats = source.stats();
+  std::printf("serial / %s, %d channels at %.0f Hz, %d baud (%zu bytes per frame)\n", batch ? "batch" : "epoll",
+              n_channels, fs, baud, serial_frame_bytes(n_channels));
+  std::printf("  samples %llu in %llu packages, lost %llu, crc errors %llu, skipped %llu bytes, cpu %.1f%%\n",
+              static_cast<unsigned long long>(stats.samples), static_cast<unsigned long long>(stats.packages),
+              static_cast<unsigned long long>(stats.lost), static_cast<unsigned long long>(stats.crc_errors),
+              static_cast<unsigned long long>(stats.skipped_bytes), 100.0 * cpu / seconds);
+  std::printf("  %s\n", source.ingest_latency().format("ingest (read -> queue)").c_str());
+  std::printf("  %s\n", sink.lag().format("end to end (due -> sink)").c_str());
+  return 0;
+}
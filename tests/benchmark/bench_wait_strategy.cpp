@@ -0,0 +1,69 @@
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "framework/channel.h"
+#include "framework/wait_strategy.h"
+
+// 测量不同等待策略下消费者的唤醒延迟：生产者间隔发送带时间戳的消息，
+// 消费者按策略阻塞在 Channel::pop 上，记录 "写入 -> 取到" 的时间以及消费者线程的 CPU 占用
+
+static int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t thread_cpu_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static void run_case(const WaitStrategy& strategy, int messages, std::chrono::microseconds interval) {
+  Channel<int64_t> channel(64);
+  std::vector<int64_t> latencies;
+  latencies.reserve(messages);
+  int64_t consumer_cpu_ns = 0;
+
+  std::thread consumer([&]() {
+    int64_t cpu_start = thread_cpu_ns();
+    int64_t stamp = 0;
+    while (static_cast<int>(latencies.size()) < messages) {
+      if (channel.pop(stamp, strategy)) {
+        latencies.push_back(now_ns() - stamp);
+      }
+    }
+    consumer_cpu_ns = thread_cpu_ns() - cpu_start;
+  });
+
+  int64_t wall_start = now_ns();
+  for (int i = 0; i < messages; ++i) {
+    std::this_thread::sleep_for(interval);
+    while (!channel.try_push(now_ns())) {
+    }
+  }
+  consumer.join();
+  int64_t wall_ns = now_ns() - wall_start;
+
+  std::sort(latencies.begin(), latencies.end());
+  auto pct = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))] / 1000.0; };
+  std::printf("%-10s p50 = %8.2f us  p90 = %8.2f us  p99 = %8.2f us  max = %9.2f us  consumer CPU = %5.1f%%\n",
+              WaitStrategy::type_name(strategy.type), pct(0.50), pct(0.90), pct(0.99), latencies.back() / 1000.0,
+              100.0 * consumer_cpu_ns / wall_ns);
+}
+
+int main(int argc, char** argv) {
+  int messages = argc > 1 ? std::atoi(argv[1]) : 2000;
+  int interval_us = argc > 2 ? std::atoi(argv[2]) : 200;
+  std::printf("Wake-up latency, %d messages every %d us\n", messages, interval_us);
+  run_case(WaitStrategy::busy_spin(), messages, std::chrono::microseconds(interval_us));
+  run_case(WaitStrategy::spin_yield(), messages, std::chrono::microseconds(interval_us));
+  run_case(WaitStrategy::park(), messages, std::chrono::microseconds(interval_us));
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/module_logger.h"
+
+// 把 fn 中写出的日志收集到临时文件后读回
+template <class Fn>
+static std::string capture(Fn fn) {
+  FILE *file = std::tmpfile();
+  assert(file != nullptr);
+  AsyncLogger &logger = AsyncLogger::instance();
+  logger.flush();
+  logger.set_output(file);
+  fn();
+  logger.flush();
+  logger.set_output(stdout);
+  std::string content;
+  std::rewind(file);
+  char chunk[4096];
+  size_t n;
+  while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) content.append(chunk, n);
+  std::fclose(file);
+  return content;
+}
+
+static size_t count_of(const std::string &text, const std::string &needle) {
+  size_t count = 0;
+  for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size())) {
+    ++count;
+  }
+  return count;
+}
+
+// 后台线程按 printf 语义格式化
+static void test_format() {
+  int value = 7;
+  const std::string out = capture([&] {
+    MLOG_INFO("int=%d neg=%+d size=%zu big=%llu hex=%#x", 42, -3, static_cast<size_t>(12),
+              18446744073709551615ULL, 255u);
+    MLOG_WARN("str=%s pad=[%-5s] prec=%.2f pct=100%% ptr=%p", "abc", "ab", 3.14159, static_cast<void *>(&value));
+    MLOG_INFO("char=[%c] int=[%5d] str=[%-4s]", 'A', 42, "ab");
+    MLOG_ERROR("missing=%d", 1);
+    AsyncLogger::instance().write(LogLevel::ERROR, nullptr, 0, "args=%d %d", 1);  // 缺参数
+  });
+  assert(out.find("[INFO] [T") != std::string::npos);
+  assert(out.find("test_async_logger.cpp:") != std::string::npos);
+  assert(out.find("int=42 neg=-3 size=12 big=18446744073709551615 hex=0xff\n") != std::string::npos);
+  char ptr[32];
+  snprintf(ptr, sizeof(ptr), "%p", static_cast<void *>(&value));
+  assert(out.find(std::string("str=abc pad=[ab   ] prec=3.14 pct=100% ptr=") + ptr + "\n") != std::string::npos);
+  assert(out.find("char=[A] int=[   42] str=[ab  ]\n") != std::string::npos);
+  assert(out.find("[ERROR]") != std::string::npos && out.find("missing=1\n") != std::string::npos);
+  assert(out.find("args=1 <?>\n") != std::string::npos);
+
+  // 过长的字符串在记录中截断，不越界
+  const std::string long_text(1000, 'x');
+  const std::string truncated = capture([&] { MLOG_INFO("long=%s|", long_text.c_str()); });
+  assert(truncated.find("long=xxxx") != std::string::npos);
+  assert(count_of(truncated, "x") < LogRecord::kPayloadSize);
+}
+
+// 级别过滤：被过滤的日志不求值参数
+static void test_level() {
+  int evaluated = 0;
+  auto touch = [&] { return ++evaluated; };
+  const std::string out = capture([&] {
+    AsyncLogger::set_level(LogLevel::WARN);
+    MLOG_INFO("hidden %d", touch());
+    MLOG_WARN("shown %d", touch());
+    AsyncLogger::set_level(LogLevel::INFO);
+  });
+  assert(evaluated == 1);
+  assert(out.find("hidden") == std::string::npos && out.find("shown 1") != std::string::npos);
+}
+
+// ModuleLogger 经同一后端输出
+static void test_module_logger() {
+  ModuleLogger logger(LogLevel::INFO);
+  const std::string out = capture([&] {
+    logger.info("Runner", "batch=", 16, " fill=", 0.5);
+    logger.debug("Runner", "hidden");
+  });
+  assert(out.find("[INFO] [T") != std::string::npos);
+  assert(out.find("[Runner] batch=16 fill=0.5\n") != std::string::npos);
+  assert(out.find("hidden") == std::string::npos);
+}
+
+// 环满时丢弃并计数，写出的条数 + 丢弃的条数 = 写入的条数
+static void test_drop() {
+  const int total = 200000;
+  const uint64_t dropped_before = AsyncLogger::instance().dropped();
+  const std::string out = capture([&] {
+    for (int i = 0; i < total; ++i) MLOG_INFO("burst %d", i);
+  });
+  const uint64_t dropped = AsyncLogger::instance().dropped() - dropped_before;
+  assert(count_of(out, "burst ") + dropped == static_cast<uint64_t>(total));
+  if (dropped > 0) {
+    assert(out.find("logger dropped") != std::string::npos);
+  }
+  std::cout << "  burst of " << total << ": dropped " << dropped << std::endl;
+}
+
+// 多线程写入：每个线程各自的环，线程退出后剩余记录仍被写出
+static void test_threads() {
+  const int thread_num = 4, per_thread = 500;
+  const uint64_t dropped_before = AsyncLogger::instance().dropped();
+  const std::string out = capture([&] {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_num; ++t) {
+      threads.emplace_back([t] {
+        for (int i = 0; i < per_thread; ++i) MLOG_INFO("worker %d line %d", t, i);
+      });
+    }
+    for (auto &thread : threads) thread.join();
+  });
+  const uint64_t dropped = AsyncLogger::instance().dropped() - dropped_before;
+  assert(count_of(out, "worker ") + dropped == static_cast<uint64_t>(thread_num * per_thread));
+  for (int t = 0; t < thread_num; ++t) {
+    assert(out.find("worker " + std::to_string(t) + " line") != std::string::npos);
+  }
+}
+
+int main() {
+  std::cout << "Running async logger tests..." << std::endl;
+  test_format();
+  test_level();
+  test_module_logger();
+  test_drop();
+  test_threads();
+  std::cout << "All async logger tests passed!" << std::endl;
+  return 0;
+}
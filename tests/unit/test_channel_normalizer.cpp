@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "dsp/channel_normalizer.h"
+#include "dsp/iir_filter.h"
+
+// 两遍法参考：每行减均值、除以总体标准差（标准差低于 min_std 时只减均值），即 EEGPreprocess.zscore
+static std::vector<double> reference_zscore(const std::vector<float>& data, int channels, size_t samples,
+                                            bool scale, double min_std) {
+  std::vector<double> out(data.size());
+  for (int c = 0; c < channels; ++c) {
+    double mean = 0.0;
+    for (size_t t = 0; t < samples; ++t) mean += data[c * samples + t];
+    mean /= samples;
+    double var = 0.0;
+    for (size_t t = 0; t < samples; ++t) var += (data[c * samples + t] - mean) * (data[c * samples + t] - mean);
+    double std = std::sqrt(var / samples);
+    double gain = scale && std >= min_std ? 1.0 / std : 1.0;
+    for (size_t t = 0; t < samples; ++t) out[c * samples + t] = (data[c * samples + t] - mean) * gain;
+  }
+  return out;
+}
+
+static std::vector<float> noise_input(int channels, size_t samples, float offset, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> noise(0.0f, 10.0f);
+  std::vector<float> input(channels * samples);
+  for (int c = 0; c < channels; ++c) {
+    for (size_t t = 0; t < samples; ++t) input[c * samples + t] = offset * (c + 1) + noise(rng);
+  }
+  return input;
+}
+
+// 同一次遍历中归一化的结果与"先滤波、再两遍法 zscore"一致
+static void test_epoch_matches_two_pass() {
+  const int channels = 13;  // 非 8 的倍数，覆盖填充通道
+  const size_t samples = 275;
+  auto sections = design_butterworth_bandpass(4, 0.5, 49.0, 250.0);
+  std::vector<float> input = noise_input(channels, samples, 0.0f, 5);
+  // 最后一个通道无信号（电极脱落）：滤波后恒为 0，按平坦通道处理
+  std::fill(input.begin() + (channels - 1) * samples, input.end(), 0.0f);
+
+  std::vector<float> filtered(input.size());
+  SosFilterBank plain(sections, channels);
+  plain.process(input.data(), samples, filtered.data(), samples, samples);
+
+  for (bool scale : {true, false}) {
+    NormalizerConfig config;
+    config.mode = NormalizerConfig::Mode::kEpoch;
+    config.scale = scale;
+    ChannelNormalizer normalizer(config, channels);
+    SosFilterBank bank(sections, channels);
+    std::vector<float> output(input);
+    bank.process(output.data(), samples, output.data(), samples, samples, &normalizer);
+
+    std::vector<double> expected = reference_zscore(filtered, channels, samples, scale, config.min_std);
+    for (size_t i = 0; i < output.size(); ++i) {
+      assert(std::isfinite(output[i]));
+      assert(std::fabs(output[i] - expected[i]) < 1e-4 * (1.0 + std::fabs(expected[i])));
+    }
+    for (size_t t = 0; t < samples; ++t) assert(output[(channels - 1) * samples + t] == 0.0f);
+    assert(normalizer.flat_channels() == (scale ? 1u : 0u));
+  }
+}
+
+// 直流分量远大于波动时（未滤波的原始数据），偏移累加仍能得到准确的方差
+static void test_epoch_large_offset() {
+  const int channels = 4;
+  const size_t samples = 1000;
+  std::vector<float> input = noise_input(channels, samples, 20000.0f, 7);
+  NormalizerConfig config;
+  config.mode = NormalizerConfig::Mode::kEpoch;
+  ChannelNormalizer normalizer(config, channels);
+
+  // 直接按滤波器组的方式驱动：转置成"采样点 x 通道"后分块累积，再原地归一化
+  const size_t padded = normalizer.padded_channels();
+  std::vector<double> block(samples * padded, 0.0);
+  for (int c = 0; c < channels; ++c) {
+    for (size_t t = 0; t < samples; ++t) block[t * padded + c] = input[c * samples + t];
+  }
+  for (size_t start = 0; start < samples; start += 64) {
+    normalizer.accumulate(block.data() + start * padded, padded, std::min<size_t>(64, samples - start));
+  }
+  std::vector<float> output(input);
+  normalizer.finish(output.data(), samples, samples);
+
+  std::vector<double> expected = reference_zscore(input, channels, samples, true, config.min_std);
+  for (int c = 0; c < channels; ++c) {
+    assert(std::fabs(normalizer.mean(c) - 20000.0 * (c + 1)) < 2.0);
+    assert(std::fabs(normalizer.stddev(c) - 10.0) < 1.0);
+  }
+  // 输入本身是 float，均值附近的量化误差约 1e-3 / 10
+  for (size_t i = 0; i < output.size(); ++i) assert(std::fabs(output[i] - expected[i]) < 1e-3);
+}
+
+// 滑动基线：与逐采样点的指数加权 Welford 参考一致，跨包保存，分段方式不影响结果
+static void test_running_baseline() {
+  const int channels = 3;
+  const size_t samples = 3000;
+  const double fs = 250.0;
+  auto sections = design_butterworth_bandpass(4, 0.5, 49.0, fs);
+  std::vector<float> input = noise_input(channels, samples, 50.0f, 11);
+
+  NormalizerConfig config;
+  config.mode = NormalizerConfig::Mode::kRunning;
+  config.window = 1.0;
+  config.fs = fs;
+
+  std::vector<float> filtered(input.size());
+  SosFilterBank plain(sections, channels);
+  plain.process(input.data(), samples, filtered.data(), samples, samples);
+  const double n_window = config.window * fs;
+  for (int c = 0; c < channels; ++c) {
+    double mean = 0.0, var = 0.0;
+    for (size_t t = 0; t < samples; ++t) {
+      double alpha = 1.0 / std::min<double>(t + 1, n_window);
+      double x = filtered[c * samples + t];
+      double diff = x - mean;
+      mean += alpha * diff;
+      var = (1.0 - alpha) * (var + diff * alpha * diff);
+      double gain = var >= config.min_std * config.min_std ? 1.0 / std::sqrt(var) : 1.0;
+      filtered[c * samples + t] = static_cast<float>((x - mean) * gain);
+    }
+  }
+
+  ChannelNormalizer whole_normalizer(config, channels);
+  SosFilterBank whole_bank(sections, channels);
+  std::vector<float> whole(input.size());
+  whole_bank.process(input.data(), samples, whole.data(), samples, samples, &whole_normalizer);
+  for (size_t i = 0; i < whole.size(); ++i) {
+    assert(std::fabs(whole[i] - filtered[i]) < 1e-4 * (1.0 + std::fabs(filtered[i])));
+  }
+  // 第一个采样点方差为 0，按平坦通道只减均值
+  for (int c = 0; c < channels; ++c) assert(whole[c * samples] == 0.0f);
+
+  ChannelNormalizer normalizer(config, channels);
+  SosFilterBank bank(sections, channels);
+  std::vector<float> chunked(input);
+  size_t offset = 0;
+  for (size_t length : {1, 5, 64, 100, 130, 700, 2000}) {
+    bank.process(chunked.data() + offset, samples, chunked.data() + offset, samples, length, &normalizer);
+    offset += length;
+  }
+  assert(offset == samples);
+  assert(chunked == whole);
+
+  // 稳态下归一化结果近似零均值、单位方差
+  for (int c = 0; c < channels; ++c) {
+    double sum = 0.0, sum_sq = 0.0;
+    for (size_t t = samples / 2; t < samples; ++t) {
+      sum += whole[c * samples + t];
+      sum_sq += whole[c * samples + t] * whole[c * samples + t];
+    }
+    const double n = samples - samples / 2;
+    assert(std::fabs(sum / n) < 0.2 && std::fabs(sum_sq / n - 1.0) < 0.3);
+  }
+
+  normalizer.reset();
+  assert(normalizer.mean(0) == 0.0 && normalizer.stddev(0) == 0.0);
+}
+
+// 零相位模式下归一化作用于延迟后的输出
+static void test_zero_phase() {
+  const int channels = 5;
+  const size_t samples = 500, lag = 100;
+  auto sections = design_butterworth_bandpass(4, 0.5, 49.0, 250.0);
+  std::vector<float> input = noise_input(channels, samples, 0.0f, 13);
+
+  std::vector<float> filtered(input.size());
+  ZeroPhaseFilterBank plain(sections, channels, lag);
+  plain.process(input.data(), samples, filtered.data(), samples, samples);
+
+  NormalizerConfig config;
+  config.mode = NormalizerConfig::Mode::kEpoch;
+  ChannelNormalizer normalizer(config, channels);
+  ZeroPhaseFilterBank bank(sections, channels, lag);
+  std::vector<float> output(input.size());
+  bank.process(input.data(), samples, output.data(), samples, samples, &normalizer);
+
+  std::vector<double> expected = reference_zscore(filtered, channels, samples, true, config.min_std);
+  for (size_t i = 0; i < output.size(); ++i) {
+    assert(std::fabs(output[i] - expected[i]) < 1e-4 * (1.0 + std::fabs(expected[i])));
+  }
+}
+
+// 配置解析与参数检查
+static void test_config() {
+  NormalizerConfig config = NormalizerConfig::from_config(
+      parse_config(R"({"mode": "running", "scale": false, "window": 0.5, "min_std": 0.01})"));
+  assert(config.mode == NormalizerConfig::Mode::kRunning && !config.scale);
+  assert(config.window == 0.5 && config.min_std == 0.01);
+  assert(NormalizerConfig::from_config(parse_config("{}")).mode == NormalizerConfig::Mode::kNone);
+
+  bool threw = false;
+  try {
+    NormalizerConfig::from_config(parse_config(R"({"mode": "global"})"));
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  assert(threw);
+
+  threw = false;
+  try {
+    config.window = 0.0;
+    ChannelNormalizer normalizer(config, 4);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+int main() {
+  test_epoch_matches_two_pass();
+  test_epoch_large_offset();
+  test_running_baseline();
+  test_zero_phase();
+  test_config();
+  std::cout << "Channel normalizer tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,323 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "framework/pipeline.h"
+
+using Clock = std::chrono::steady_clock;
+
+// 已过期 / 未过期的包
+static PackagePtr make_package(uint64_t sequence, bool expired) {
+  PackagePtr package = std::make_shared<Package>();
+  package->set_sequence(sequence);
+  package->set_deadline(expired ? Clock::now() - std::chrono::milliseconds(1) : Clock::now() + std::chrono::hours(1));
+  return package;
+}
+
+// 截止时刻、削减与失败标记随包传递，归还到池中时清除
+static void test_package_deadline() {
+  Package package;
+  assert(!package.has_deadline() && !package.expired(Clock::now()));
+  const auto deadline = Clock::now() + std::chrono::milliseconds(10);
+  package.set_deadline(deadline);
+  assert(package.has_deadline() && package.get_deadline() == deadline);
+  assert(!package.expired(deadline) && package.expired(deadline + std::chrono::nanoseconds(1)));
+  package.mark_shed();
+  package.mark_degraded();
+  package.mark_failed();
+  assert(package.is_shed() && package.is_degraded() && package.is_failed());
+  package.recycle();
+  assert(!package.has_deadline() && !package.is_shed() && !package.is_degraded() && !package.is_failed());
+}
+
+class CountingPreprocessor : public Preprocessor {
+ public:
+  CountingPreprocessor() : Preprocessor(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    ++processed;
+    degraded += package->is_degraded() ? 1 : 0;
+    return true;
+  }
+  int processed{0};
+  int degraded{0};
+};
+
+// 各策略下过期包的处理：照常处理 / 跳过并转发 / 降级处理
+static void test_stage_policies() {
+  for (ShedPolicy policy : {ShedPolicy::kNone, ShedPolicy::kSkipExpired, ShedPolicy::kDegrade}) {
+    CountingPreprocessor stage;
+    stage.set_shed_policy(policy);
+    Channel<PackagePtr> input(16), output(16);
+    stage.set_input_ptr(&input);
+    stage.set_output_ptr(&output);
+    for (uint64_t i = 0; i < 6; ++i) assert(input.try_push(make_package(i, i % 2 == 1)));
+    assert(input.try_push(std::make_shared<Package>()));  // 没有截止时刻
+    while (stage.step() == StepResult::kProgress) {
+    }
+
+    // 所有包都按顺序转发，被削减的包带有标记
+    PackagePtr package;
+    for (uint64_t i = 0; i < 6; ++i) {
+      assert(output.try_pop(package) && package->get_sequence() == i);
+      assert(package->is_shed() == (policy == ShedPolicy::kSkipExpired && i % 2 == 1));
+    }
+    assert(output.try_pop(package) && !package->is_shed());
+
+    const ShedStats stats = stage.get_shed_stats();
+    if (policy == ShedPolicy::kNone) {
+      assert(stage.processed == 7 && stats.late == 3 && stats.shed == 0 && stats.degraded == 0);
+    } else if (policy == ShedPolicy::kSkipExpired) {
+      assert(stage.processed == 4 && stats.shed == 3 && stats.late == 0);
+    } else {
+      assert(stage.processed == 7 && stage.degraded == 3 && stats.degraded == 3 && stats.late == 0);
+    }
+  }
+
+  // 上游已削减的包不再处理，也不重复计数
+  CountingPreprocessor stage;
+  stage.set_shed_policy(ShedPolicy::kSkipExpired);
+  Channel<PackagePtr> input(4), output(4);
+  stage.set_input_ptr(&input);
+  stage.set_output_ptr(&output);
+  PackagePtr shed = make_package(0, true);
+  shed->mark_shed();
+  assert(input.try_push(shed));
+  assert(stage.step() == StepResult::kProgress);
+  assert(stage.processed == 0 && stage.get_shed_stats().total() == 0 && output.size() == 1);
+}
+
+class CountingRunner : public Runner {
+ public:
+  CountingRunner() : Runner(1, false, -1, -1) {}
+  bool process(Package *) override { return true; }
+  void process_batch(Package *const *packages, size_t count, bool *ok) override {
+    for (size_t i = 0; i < count; ++i) {
+      assert(!packages[i]->is_shed());
+      ok[i] = packages[i]->get_sequence() != 4;  // 第 4 个包处理失败，标记后照常推入下游
+      ++processed;
+    }
+  }
+  int processed{0};
+};
+
+// 微批中夹杂被削减的包：只处理未削减的，输出仍按原顺序（处理失败的包标记后同样输出）
+static void test_runner_batch() {
+  CountingRunner runner;
+  BatchConfig batching;
+  batching.max_batch = 8;
+  runner.set_batching(batching);
+  runner.set_shed_policy(ShedPolicy::kSkipExpired);
+  Channel<PackagePtr> input(16), output(16);
+  runner.set_input_ptr(&input);
+  runner.set_output_ptr(&output);
+  for (uint64_t i = 0; i < 8; ++i) assert(input.try_push(make_package(i, i == 1 || i == 2 || i == 6)));
+  assert(runner.step() == StepResult::kProgress);
+  assert(runner.processed == 5 && runner.get_shed_stats().shed == 3);
+
+  PackagePtr package;
+  for (uint64_t expected = 0; expected < 8; ++expected) {
+    assert(output.try_pop(package) && package->get_sequence() == expected);
+    assert(package->is_shed() == (expected == 1 || expected == 2 || expected == 6));
+    assert(package->is_failed() == (expected == 4));
+  }
+  assert(!output.try_pop(package));
+
+  // 整批都被削减时不调用 process_batch
+  for (uint64_t i = 8; i < 10; ++i) assert(input.try_push(make_package(i, true)));
+  assert(runner.step() == StepResult::kProgress);
+  assert(runner.processed == 5 && output.size() == 2);
+}
+
+class CountingPostprocessor : public Postprocessor {
+ public:
+  CountingPostprocessor() : Postprocessor(1, false, -1, -1) {}
+  bool process(Package *) override {
+    ++processed;
+    return true;
+  }
+  int processed{0};
+};
+
+class CountingSink : public Sink {
+ public:
+  CountingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *) override {
+    ++processed;
+    return true;
+  }
+  int processed{0};
+};
+
+// 被削减的包仍占据序号，重排窗口不会把它当作缺包等待；Sink 不处理被削减的包
+static void test_postprocessor_and_sink() {
+  CountingPostprocessor post;
+  CountingSink sink;
+  post.set_shed_policy(ShedPolicy::kSkipExpired);
+  ReorderConfig reorder;
+  reorder.max_gap_wait = std::chrono::microseconds(10000000);  // 若按缺包等待会卡住
+  post.set_reorder(reorder);
+  Channel<PackagePtr> input(16), middle(16);
+  post.set_input_ptr(&input);
+  post.set_output_ptr(&middle);
+  sink.set_input_ptr(&middle);
+
+  PackagePtr upstream_shed = make_package(1, false);
+  upstream_shed->mark_shed();
+  assert(input.try_push(make_package(0, false)));
+  assert(input.try_push(upstream_shed));
+  assert(input.try_push(make_package(3, false)));
+  assert(input.try_push(make_package(2, true)));
+  for (int i = 0; i < 8; ++i) post.step();
+  assert(post.processed == 2 && post.get_shed_stats().shed == 1 && middle.size() == 4);
+
+  while (sink.step() == StepResult::kProgress) {
+  }
+  assert(sink.processed == 2 && middle.size() == 0);
+}
+
+class TickSource : public Source {
+ public:
+  TickSource(int max_queue_length) : Source(max_queue_length, false, -1, -1) {}
+  bool process(Package *) override {
+    ++produced;
+    return true;
+  }
+  int produced{0};
+};
+
+// Source 按预算分配截止时刻；kDropNewest 下输出通道满时丢弃新包，序号保持连续
+static void test_source() {
+  TickSource source(4);
+  DeadlineConfig config;
+  config.budget = std::chrono::microseconds(10000);
+  config.policy = ShedPolicy::kDropNewest;
+  source.set_deadline(config);
+  assert(source.get_deadline_budget() == config.budget && source.get_shed_policy() == ShedPolicy::kDropNewest);
+  Channel<PackagePtr> output(16);
+  source.set_output_ptr(&output);
+
+  const auto before = Clock::now();
+  for (int i = 0; i < 10; ++i) assert(source.step() == StepResult::kProgress);
+  assert(source.produced == 10 && output.size() == 4 && source.get_shed_stats().dropped == 6);
+  PackagePtr package;
+  for (uint64_t i = 0; i < 4; ++i) {
+    assert(output.try_pop(package) && package->get_sequence() == i);
+    assert(package->get_deadline() >= before + config.budget);
+    assert(package->get_deadline() <= Clock::now() + config.budget);
+  }
+  assert(source.step() == StepResult::kProgress && output.try_pop(package) && package->get_sequence() == 4);
+
+  // 默认策略下输出通道满时阻塞，不丢包
+  TickSource blocking(2);
+  Channel<PackagePtr> blocked(16);
+  blocking.set_output_ptr(&blocked);
+  assert(blocking.step() == StepResult::kProgress && blocking.step() == StepResult::kProgress);
+  assert(blocking.step() == StepResult::kBlocked && blocking.produced == 2);
+  assert(blocked.try_pop(package) && !package->has_deadline());
+  package.reset();  // 池中的包须在 Source 之前释放
+}
+
+// 过载：Runner 处理一个包要 2ms，Source 每 0.5ms 产生一个包，预算 10ms；
+// skip_expired 时积压不增长，Sink 只看到在预算内开始推理的包
+class PacedSource : public Source {
+ public:
+  PacedSource() : Source(32, false, -1, -1) {}
+  bool process(Package *) override {
+    if (produced_.load() >= 400) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    produced_.fetch_add(1);
+    return true;
+  }
+  uint64_t produced() const { return produced_.load(); }
+
+ private:
+  std::atomic<uint64_t> produced_{0};
+};
+
+class SlowRunner : public Runner {
+ public:
+  SlowRunner() : Runner(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    // admit() 与这里之间只差几百纳秒，留 1ms 余量
+    if (package->expired(Clock::now() - std::chrono::milliseconds(1))) late_starts.fetch_add(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return true;
+  }
+  std::atomic<uint64_t> late_starts{0};
+};
+
+class SeenSink : public Sink {
+ public:
+  SeenSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *) override {
+    processed.fetch_add(1);
+    return true;
+  }
+  std::atomic<uint64_t> processed{0};
+};
+
+static void test_overload() {
+  PacedSource source;
+  DeadlineConfig config;
+  config.budget = std::chrono::microseconds(10000);
+  source.set_deadline(config);
+  SlowRunner runner;
+  runner.set_shed_policy(ShedPolicy::kSkipExpired);
+  SeenSink sink;
+  Pipeline pipeline(3, 64);
+  std::thread thread([&] { pipeline.run({{&source}, {&runner}, {&sink}}, false); });
+  const auto give_up = Clock::now() + std::chrono::seconds(10);
+  while (Clock::now() < give_up &&
+         (source.produced() < 400 || sink.processed.load() + runner.get_shed_stats().shed < 400)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  source.exit();
+  runner.exit();
+  sink.exit();
+  pipeline.exit();
+  thread.join();
+
+  const ShedStats stats = runner.get_shed_stats();
+  assert(sink.processed.load() + stats.shed == 400);
+  assert(stats.shed > 100 && runner.late_starts.load() == 0);
+}
+
+static void test_config() {
+  DeadlineConfig config = DeadlineConfig::from_config(parse_config(R"({"budget_us": 10000, "policy": "degrade"})"));
+  assert(config.budget == std::chrono::microseconds(10000) && config.policy == ShedPolicy::kDegrade);
+  assert(DeadlineConfig::from_config(parse_config("{}")).policy == ShedPolicy::kNone);
+  assert(DeadlineConfig::parse_policy("drop_newest") == ShedPolicy::kDropNewest);
+  assert(DeadlineConfig::parse_policy("skip_expired") == ShedPolicy::kSkipExpired);
+  bool threw = false;
+  try {
+    DeadlineConfig::from_config(parse_config(R"({"policy": "drop_random"})"));
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+
+  ShedStats stats;
+  stats.shed = 12;
+  assert(stats.format() == " late=0 shed=12 degraded=0 dropped=0");
+}
+
+int main() {
+  std::cout << "Running deadline tests..." << std::endl;
+  test_package_deadline();
+  test_stage_policies();
+  test_runner_batch();
+  test_postprocessor_and_sink();
+  test_source();
+  test_overload();
+  test_config();
+  std::cout << "All deadline tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "dsp/decimator.h"
+
+static const double kPi = std::acos(-1.0);
+
+// 低通 FIR：直流增益为 1，系数对称（线性相位）
+static void test_lowpass_design() {
+  auto taps = design_lowpass_fir(32, 110.0, 1000.0);
+  assert(taps.size() == 32);
+  double sum = std::accumulate(taps.begin(), taps.end(), 0.0);
+  assert(std::fabs(sum - 1.0) < 1e-6);
+  for (size_t k = 0; k < taps.size(); ++k) {
+    assert(taps[k] == taps[taps.size() - 1 - k]);
+  }
+}
+
+// 默认通道与 EEGPreprocess.forward 中 np.delete(x, [32, 42, 59, 63], axis=0) 一致
+static void test_default_channels() {
+  auto channels = DecimatorConfig::default_channels();
+  assert(channels.size() == 60);
+  for (int dropped : {32, 42, 59, 63}) {
+    assert(std::find(channels.begin(), channels.end(), dropped) == channels.end());
+  }
+  assert(std::is_sorted(channels.begin(), channels.end()));
+}
+
+// 与"先复制选中通道 -> 全速率 FIR -> 每 factor 个取一个"的朴素实现一致，且与分段方式无关
+static void test_matches_naive_path() {
+  const int in_channels = 64;
+  const size_t samples = 1003;
+  const int factor = 4;
+  std::vector<int> channels = {5, 0, 63, 17, 17, 40};
+  std::vector<float> taps = design_lowpass_fir(32, 110.0, 1000.0);
+
+  std::mt19937 rng(11);
+  std::normal_distribution<float> noise(0.0f, 5.0f);
+  std::vector<float> input(in_channels * samples);
+  for (float& v : input) v = noise(rng);
+
+  const size_t n_out = (samples + factor - 1) / factor;
+  std::vector<float> whole(channels.size() * n_out);
+  ChannelDecimator decimator(channels, factor, taps);
+  assert(decimator.output_samples(samples) == n_out);
+  assert(decimator.process(input.data(), samples, samples, whole.data(), n_out) == n_out);
+
+  for (size_t c = 0; c < channels.size(); ++c) {
+    const float* row = &input[channels[c] * samples];
+    for (size_t j = 0; j < n_out; ++j) {
+      double expected = 0.0;
+      size_t i = j * factor;
+      for (size_t k = 0; k < taps.size() && k <= i; ++k) {
+        expected += static_cast<double>(taps[k]) * row[i - k];
+      }
+      assert(std::fabs(whole[c * n_out + j] - expected) < 1e-4);
+    }
+  }
+
+  // 分段（含短于抽头数、短于抽取倍数的段）处理，结果逐位相同
+  std::vector<float> chunked(whole.size());
+  decimator.reset();
+  size_t offset = 0;
+  size_t produced = 0;
+  for (size_t length : {1, 2, 7, 30, 100, 250, 613}) {
+    std::vector<float> part(channels.size() * n_out);
+    size_t count = decimator.process(input.data() + offset, samples, length, part.data(), n_out);
+    for (size_t c = 0; c < channels.size(); ++c) {
+      std::copy(part.begin() + c * n_out, part.begin() + c * n_out + count, chunked.begin() + c * n_out + produced);
+    }
+    offset += length;
+    produced += count;
+  }
+  assert(offset == samples);
+  assert(produced == n_out);
+  assert(chunked == whole);
+}
+
+// 抽取后会混叠到通带内的高频分量被充分衰减
+static void test_alias_rejection() {
+  const size_t samples = 4000;
+  std::vector<float> input(samples);
+  for (size_t t = 0; t < samples; ++t) {
+    input[t] = static_cast<float>(std::sin(2 * kPi * 300.0 * t / 1000.0));  // 抽取到 250 Hz 后折叠为 50 Hz
+  }
+  DecimatorConfig config;
+  config.channels = {0};
+  ChannelDecimator decimator(config);
+  std::vector<float> output(samples / config.factor);
+  decimator.process(input.data(), samples, samples, output.data(), output.size());
+  float peak = 0.0f;
+  for (size_t j = 20; j < output.size(); ++j) peak = std::max(peak, std::fabs(output[j]));
+  assert(peak < 0.03f);
+}
+
+int main() {
+  test_lowpass_design();
+  test_default_channels();
+  test_matches_naive_path();
+  test_alias_rejection();
+  std::cout << "Decimator tests passed!" << std::endl;
+  return 0;
+}
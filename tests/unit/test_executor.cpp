@@ -0,0 +1,192 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "framework/executor.h"
+
+// 记录在哪些工作线程上被调用；busy 为 true 时每次 step 都有进展
+class RecordingTask : public Module<PackagePtr> {
+ public:
+  explicit RecordingTask(bool busy, int cpu_id = -1) : Module<PackagePtr>(0, false, cpu_id, -1), busy_(busy) {}
+  void run() override {}
+  StepResult step() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      threads_.insert(std::this_thread::get_id());
+    }
+    steps.fetch_add(1, std::memory_order_relaxed);
+    if (!busy_) {
+      return StepResult::kIdle;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    return StepResult::kProgress;
+  }
+  bool process(Package *) override { return true; }
+
+  std::set<std::thread::id> threads() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_;
+  }
+  size_t thread_count() { return threads().size(); }
+  std::atomic<uint64_t> steps{0};
+
+ private:
+  bool busy_;
+  std::mutex mutex_;
+  std::set<std::thread::id> threads_;
+};
+
+template <class Done>
+static void wait_until(Done done) {
+  const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done() && std::chrono::steady_clock::now() < give_up) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// 任务整轮都没有进展的工作线程从其他线程队列中窃取排队的任务，任务随之迁移到窃取者上运行
+// （add 轮流分配：a、c 都在 0 号线程的队列中，idle 在 1 号线程；不窃取时 a、c 只会在 0 号线程上运行）
+static void test_stealing() {
+  ExecutorConfig config;
+  config.workers = 2;
+  WorkStealingExecutor executor(config);
+  RecordingTask a(true), idle(false), c(true);
+  executor.add(&a);
+  executor.add(&idle);
+  executor.add(&c);
+  executor.start();
+  auto busy_threads = [&] {
+    std::set<std::thread::id> threads = a.threads();
+    for (auto id : c.threads()) threads.insert(id);
+    return threads.size();
+  };
+  wait_until([&] { return executor.steals() > 0 && busy_threads() == 2; });
+  executor.stop();
+  assert(executor.steals() > 0 && busy_threads() == 2);
+}
+
+// 设置了 cpu_id 的任务固定在一个工作线程上，不会被窃取；与它同队列的未固定任务照常被窃取
+static void test_pinned_not_stolen() {
+  ExecutorConfig config;
+  config.workers = 2;
+  WorkStealingExecutor executor(config);
+  RecordingTask pinned(true, 0), free_task(true), idle(false);
+  executor.add(&pinned);     // 固定在 0 号线程
+  executor.add(&free_task);  // 0 号线程
+  executor.add(&idle);       // 1 号线程
+  executor.start();
+  // free_task 曾在 pinned 所在线程之外的线程上运行（说明它被窃取过）
+  auto free_task_moved = [&] {
+    std::set<std::thread::id> pinned_threads = pinned.threads();
+    for (auto id : free_task.threads()) {
+      if (pinned_threads.count(id) == 0) return true;
+    }
+    return false;
+  };
+  wait_until([&] { return executor.steals() > 0 && pinned.steps.load() > 1000 && free_task_moved(); });
+  executor.stop();
+  assert(executor.steals() > 0);
+  assert(pinned.steps.load() > 1000 && pinned.thread_count() == 1);
+  assert(free_task_moved());
+}
+
+// 单个工作线程上轮转：每轮连续 step 的次数为 quantum * 优先级
+class CountingTask : public Module<PackagePtr> {
+ public:
+  CountingTask(int id, std::vector<int> *trace) : Module<PackagePtr>(0, false, -1, -1), id_(id), trace_(trace) {}
+  void run() override {}
+  StepResult step() override {
+    trace_->push_back(id_);
+    return StepResult::kProgress;
+  }
+  bool process(Package *) override { return true; }
+
+ private:
+  int id_;
+  std::vector<int> *trace_;
+};
+
+static void test_priority_quantum() {
+  ExecutorConfig config;
+  config.workers = 1;
+  config.quantum = 4;
+  WorkStealingExecutor executor(config);
+  std::vector<int> trace;  // 只有一个工作线程写入，stop() 之后读取
+  CountingTask low(0, &trace), high(1, &trace);
+  high.set_priority(3);
+  executor.add(&low);
+  executor.add(&high);
+  executor.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  executor.stop();
+  assert(executor.steps() == trace.size());  // 用完配额时也只统计实际调用的 step()
+
+  // 按连续段统计（去掉最后一段，可能被 stop() 截断）
+  std::vector<std::pair<int, size_t>> runs;
+  for (int id : trace) {
+    if (runs.empty() || runs.back().first != id) {
+      runs.emplace_back(id, 0);
+    }
+    ++runs.back().second;
+  }
+  assert(runs.size() > 4);
+  runs.pop_back();
+  for (const auto &run : runs) {
+    assert(run.second == (run.first == 0 ? 4u : 12u));
+  }
+}
+
+// stop() 之后不再调用 step()，每个模块的 finish() 恰好调用一次，用于处理完暂存的输出；重复 stop() 无副作用
+class DrainingTask : public Module<PackagePtr> {
+ public:
+  DrainingTask() : Module<PackagePtr>(0, false, -1, -1) {}
+  void run() override {}
+  StepResult step() override {
+    assert(finished.load() == 0);
+    ++held;
+    return held % 8 == 0 ? StepResult::kBlocked : StepResult::kProgress;
+  }
+  void finish() override {
+    drained += held;
+    held = 0;
+    finished.fetch_add(1);
+  }
+  bool process(Package *) override { return true; }
+
+  uint64_t held{0};
+  uint64_t drained{0};
+  std::atomic<int> finished{0};
+};
+
+static void test_stop_finish() {
+  ExecutorConfig config;
+  config.workers = 2;
+  DrainingTask first, second;
+  {
+    WorkStealingExecutor executor(config);
+    executor.add(&first);
+    executor.add(&second);
+    executor.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    executor.stop();
+    assert(first.finished.load() == 1 && second.finished.load() == 1);
+    assert(first.held == 0 && second.held == 0 && first.drained > 0 && second.drained > 0);
+    executor.stop();
+  }
+  assert(first.finished.load() == 1 && second.finished.load() == 1);
+}
+
+int main() {
+  std::cout << "Running executor tests..." << std::endl;
+  test_stealing();
+  test_pinned_not_stolen();
+  test_priority_quantum();
+  test_stop_finish();
+  std::cout << "All executor tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,280 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "framework/pipeline.h"
+
+// 产生 total 个包后不再有数据
+class CountingSource : public Source {
+ public:
+  explicit CountingSource(uint64_t total, bool enable_profiler = false)
+      : Source(32, enable_profiler, -1, -1), total_(total) {}
+  bool process(Package *) override {
+    if (produced_ >= total_) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      return false;
+    }
+    ++produced_;
+    return true;
+  }
+
+ private:
+  uint64_t total_;
+  uint64_t produced_{0};
+};
+
+// 记录看到的序号（检查各阶段仍按产生顺序处理），可选地让某个序号失败或处理得慢
+class OrderedStage : public Runner {
+ public:
+  explicit OrderedStage(bool enable_profiler = false, int64_t fail_sequence = -1,
+                        std::chrono::microseconds delay = std::chrono::microseconds(0))
+      : Runner(1, enable_profiler, -1, -1), fail_sequence_(fail_sequence), delay_(delay) {}
+  bool process(Package *package) override {
+    const uint64_t sequence = package->get_sequence();
+    if (!seen.empty() && sequence <= seen.back()) {
+      out_of_order = true;
+    }
+    seen.push_back(sequence);
+    if (delay_.count() > 0) {
+      std::this_thread::sleep_for(delay_);
+    }
+    return static_cast<int64_t>(sequence) != fail_sequence_;
+  }
+  std::vector<uint64_t> seen;
+  bool out_of_order{false};
+
+ private:
+  int64_t fail_sequence_;
+  std::chrono::microseconds delay_;
+};
+
+class CollectingSink : public Sink {
+ public:
+  CollectingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    seen.push_back(package->get_sequence());
+    done.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+  std::mutex mutex;
+  std::vector<uint64_t> seen;
+  std::atomic<size_t> done{0};
+};
+
+// 在后台运行流水线，等 Sink 收到 expected 个包后退出
+template <class Run>
+static void run_until(Pipeline &pipeline, CollectingSink &sink, size_t expected, Run run) {
+  std::thread driver(run);
+  const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (sink.done.load(std::memory_order_acquire) < expected && std::chrono::steady_clock::now() < give_up) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  pipeline.exit();
+  driver.join();
+}
+
+// 单线程：每个包依次经过所有阶段，各阶段的处理时延分别统计
+static void test_seq_run() {
+  CountingSource source(200, true);
+  OrderedStage preprocess(true), runner(true), postprocess(true);
+  CollectingSink sink;
+  Pipeline pipeline(5);
+  std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&preprocess}, {&runner}, {&postprocess}, {&sink}};
+  run_until(pipeline, sink, 200, [&] { pipeline.seq_run(modules, false); });
+
+  assert(sink.seen.size() == 200);
+  for (uint64_t i = 0; i < 200; ++i) assert(sink.seen[i] == i);
+  for (auto *stage : {&preprocess, &runner, &postprocess}) {
+    assert(stage->seen.size() == 200 && !stage->out_of_order);
+    assert(stage->get_profile().count == 200);
+  }
+  assert(source.get_profile().count == 200 && source.get_next_sequence() == 200);
+}
+
+// 多个工作线程：有状态的阶段仍按产生顺序处理，复制阶段按序号轮流分给各副本
+static void test_workers() {
+  CountingSource source(1000);
+  OrderedStage preprocess(false, -1, std::chrono::microseconds(20));
+  OrderedStage replica0, replica1;
+  OrderedStage postprocess;
+  CollectingSink sink;
+  Pipeline pipeline(5);
+  std::vector<std::vector<Module<PackagePtr> *>> modules = {
+      {&source}, {&preprocess}, {&replica0, &replica1}, {&postprocess}, {&sink}};
+  FusedConfig config;
+  config.workers = 4;
+  run_until(pipeline, sink, 1000, [&] { pipeline.run_fused(modules, config, false); });
+
+  assert(sink.seen.size() == 1000);
+  for (uint64_t i = 0; i < 1000; ++i) assert(sink.seen[i] == i);
+  assert(!preprocess.out_of_order && !postprocess.out_of_order);
+  assert(replica0.seen.size() == 500 && replica1.seen.size() == 500);
+  for (uint64_t sequence : replica0.seen) assert(sequence % 2 == 0);
+  for (uint64_t sequence : replica1.seen) assert(sequence % 2 == 1);
+}
+
+// 某个阶段处理失败的包不再进入后续阶段，其余的包不受影响（不会因为入口等待而卡住）
+static void test_failure() {
+  CountingSource source(100);
+  OrderedStage preprocess(false, 10), runner, postprocess;
+  CollectingSink sink;
+  Pipeline pipeline(5);
+  std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&preprocess}, {&runner}, {&postprocess}, {&sink}};
+  FusedConfig config;
+  config.workers = 2;
+  run_until(pipeline, sink, 99, [&] { pipeline.run_fused(modules, config, false); });
+
+  assert(sink.seen.size() == 99 && preprocess.seen.size() == 100 && runner.seen.size() == 99);
+  for (uint64_t sequence : sink.seen) assert(sequence != 10);
+}
+
+// 截止时刻照常检查：慢阶段之后过期的包被削减，不再调用后续阶段的 process()
+static void test_deadline() {
+  CountingSource source(50);
+  source.set_deadline(DeadlineConfig{std::chrono::microseconds(1000), ShedPolicy::kNone});
+  OrderedStage preprocess;
+  OrderedStage runner(false, -1, std::chrono::microseconds(2000));
+  OrderedStage postprocess;
+  postprocess.set_shed_policy(ShedPolicy::kSkipExpired);
+  CollectingSink sink;
+  Pipeline pipeline(5);
+  std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&preprocess}, {&runner}, {&postprocess}, {&sink}};
+  std::thread driver([&] { pipeline.seq_run(modules, false); });
+  const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (postprocess.get_shed_stats().shed < 50 && std::chrono::steady_clock::now() < give_up) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  pipeline.exit();
+  driver.join();
+
+  // Runner 之前的包都在预算内，Runner 处理 2ms 后全部过期
+  assert(preprocess.seen.size() == 50 && runner.get_shed_stats().total() == 0);
+  assert(postprocess.seen.empty() && postprocess.get_shed_stats().shed == 50);
+  assert(sink.seen.empty() && sink.get_shed_stats().total() == 0);
+}
+
+class NonFusable : public Preprocessor {
+ public:
+  NonFusable() : Preprocessor(1, false, -1, -1) {}
+  bool process(Package *) override { return true; }
+  bool fusable() const override { return false; }
+};
+
+// 第 0 阶段不是 Source 或有一进多出的模块时拒绝运行（立即返回）
+static void test_validation() {
+  CountingSource source(10);
+  OrderedStage stage;
+  NonFusable non_fusable;
+  CollectingSink sink;
+  Pipeline pipeline(3);
+  pipeline.run_fused({{&source}, {&non_fusable}, {&sink}}, FusedConfig(), false);
+  pipeline.run_fused({{&stage}, {&stage}, {&sink}}, FusedConfig(), false);
+  assert(sink.seen.empty() && source.get_next_sequence() == 0);
+}
+
+static void test_config() {
+  PipelineRunConfig config = PipelineRunConfig::from_config(
+      parse_config(R"({"mode": "fused", "executor": {"workers": 3}, "fused": {"workers": 2, "cpus": [1, 2]}})"));
+  assert(config.mode == PipelineMode::kFused && config.fused.workers == 2 && config.fused.cpus.size() == 2);
+  assert(config.executor.workers == 3);
+  assert(PipelineRunConfig::from_config(parse_config("{}")).mode == PipelineMode::kThreads);
+  assert(PipelineRunConfig::from_config(parse_config(R"({"mode": "executor"})")).mode == PipelineMode::kExecutor);
+  for (const char *text : {R"({"mode": "fibers"})", R"({"fused": {"workers": 0}})", R"({"channel_capacity": 0})",
+                           R"({"wait_strategy": "sleep"})"}) {
+    bool threw = false;
+    try {
+      PipelineRunConfig::from_config(parse_config(text));
+    } catch (const std::runtime_error &) {
+      threw = true;
+    }
+    assert(threw);
+  }
+
+  // 通道容量与等待策略：模块的 wait_strategy 覆盖 pipeline 的默认值，只写类型名时其余参数沿用默认值
+  const PipelineRunConfig defaults = PipelineRunConfig::from_config(parse_config("{}"));
+  assert(defaults.channel_capacity == kDefaultChannelCapacity);
+  assert(defaults.wait_strategy.type == WaitStrategyType::kSpinYield);
+  const PipelineRunConfig tuned = PipelineRunConfig::from_config(parse_config(
+      R"({"channel_capacity": 8, "wait_strategy": {"type": "park", "spin_iterations": 32, "timeout_us": 500}})"));
+  assert(tuned.channel_capacity == 8);
+  const WaitStrategy inherited = tuned.module_wait_strategy(parse_config(R"({"max_queue_length": 4})"));
+  assert(inherited.type == WaitStrategyType::kPark && inherited.spin_iterations == 32);
+  const WaitStrategy by_name = tuned.module_wait_strategy(parse_config(R"({"wait_strategy": "busy_spin"})"));
+  assert(by_name.type == WaitStrategyType::kBusySpin && by_name.spin_iterations == 32);
+  assert(by_name.timeout == std::chrono::microseconds(500));
+  const WaitStrategy full = tuned.module_wait_strategy(
+      parse_config(R"({"wait_strategy": {"type": "spin_yield", "spin_iterations": 8}})"));
+  assert(full.type == WaitStrategyType::kSpinYield && full.spin_iterations == 8);
+  assert(full.timeout == std::chrono::microseconds(500));
+
+  // 按配置选择运行方式（不绑核），通道容量取配置值
+  config.fused.cpus.clear();
+  CountingSource source(20);
+  OrderedStage stage;
+  CollectingSink sink;
+  Pipeline pipeline(3, tuned);
+  std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&stage}, {&sink}};
+  run_until(pipeline, sink, 20, [&] { pipeline.run(modules, config, false); });
+  assert(sink.seen.size() == 20 && !stage.out_of_order);
+}
+
+// exit() 只结束当前这次运行：同一个 Pipeline 可以再次运行（融合模式与执行器模式）
+static void test_rerun() {
+  Pipeline pipeline(3);
+  for (int round = 0; round < 2; ++round) {
+    CountingSource source(100);
+    OrderedStage stage;
+    CollectingSink sink;
+    std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&stage}, {&sink}};
+    run_until(pipeline, sink, 100, [&] { pipeline.seq_run(modules, false); });
+    assert(sink.seen.size() == 100 && !stage.out_of_order);
+  }
+  for (int round = 0; round < 2; ++round) {
+    CountingSource source(100);
+    OrderedStage stage;
+    CollectingSink sink;
+    std::vector<std::vector<Module<PackagePtr> *>> modules = {{&source}, {&stage}, {&sink}};
+    ExecutorConfig config;
+    config.workers = 2;
+    run_until(pipeline, sink, 100, [&] { pipeline.run_executor(modules, config, false); });
+    assert(sink.seen.size() == 100);
+    for (uint64_t i = 0; i < 100; ++i) assert(sink.seen[i] == i);
+  }
+}
+
+// 下游先退出、通道被写满后，上游阶段阻塞在写出上；exit() 之后它们的 run() 仍能返回
+static void test_exit_with_full_channel() {
+  CountingSource source(1000);
+  OrderedStage stage;
+  CollectingSink sink;
+  Pipeline pipeline(3, 4);
+  sink.exit();
+  std::thread driver([&] { pipeline.run({{&source}, {&stage}, {&sink}}, false); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  source.exit();
+  stage.exit();
+  pipeline.exit();
+  driver.join();
+  assert(sink.done.load() == 0 && stage.seen.size() > 4);
+}
+
+int main() {
+  std::cout << "Running fused pipeline tests..." << std::endl;
+  test_seq_run();
+  test_workers();
+  test_failure();
+  test_deadline();
+  test_validation();
+  test_config();
+  test_rerun();
+  test_exit_with_full_channel();
+  std::cout << "All fused pipeline tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+#include "utils/histogram.h"
+
+// 线性分桶：每个整数一个桶，超出上界计入溢出桶
+static void test_linear() {
+  Histogram histogram = Histogram::linear(8);
+  assert(histogram.bucket_count() == 9);
+  for (uint64_t v = 1; v <= 8; ++v) {
+    for (uint64_t i = 0; i < v; ++i) histogram.record(v);
+  }
+  histogram.record(100);
+  assert(histogram.count() == 37);
+  assert(histogram.bucket(2) == 3);
+  assert(histogram.bucket(8) == 1);
+  assert(histogram.percentile(0) == 1);
+  assert(histogram.percentile(50) == 6);
+  assert(histogram.percentile(100) == 8);
+  assert(histogram.mean() > 6.0 && histogram.mean() < 9.0);
+
+  histogram.reset();
+  assert(histogram.count() == 0 && histogram.percentile(50) == 0 && histogram.mean() == 0.0);
+}
+
+// 指数分桶：值落在 (2^(k-1), 2^k] 所在的桶
+static void test_exponential() {
+  Histogram histogram = Histogram::exponential(1000);
+  assert(histogram.bounds().front() == 0 && histogram.bounds().back() == 1024);
+  histogram.record(0);
+  histogram.record(3);
+  histogram.record(4);
+  histogram.record(5);
+  assert(histogram.bucket(0) == 1);  // 0
+  assert(histogram.bucket(3) == 2);  // (2, 4]
+  assert(histogram.bucket(4) == 1);  // (4, 8]
+  assert(histogram.percentile(99) == 8);
+  assert(histogram.report("delay").find("n=4") != std::string::npos);
+
+  bool thrown = false;
+  try {
+    Histogram invalid({4, 2});
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
+
+int main() {
+  test_linear();
+  test_exponential();
+  std::cout << "Histogram tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "dsp/iir_filter.h"
+
+static const double kPi = std::acos(-1.0);
+
+// 预畸变双线性变换下 Butterworth 带通的理论幅频响应
+static double butterworth_magnitude(int order, double low, double high, double fs, double f) {
+  auto warp = [&](double hz) { return 4.0 * std::tan(kPi * hz / fs); };
+  double w = warp(f);
+  double bw = warp(high) - warp(low);
+  double wo2 = warp(low) * warp(high);
+  double ratio = (w * w - wo2) / (w * bw);
+  return 1.0 / std::sqrt(1.0 + std::pow(ratio, 2 * order));
+}
+
+// 设计结果与 scipy.signal.butter 的理论响应一致：截止频率 -3 dB，通带为 1，阻带衰减
+static void test_design_matches_butterworth() {
+  const double fs = 1000.0;
+  for (int order : {2, 4, 6}) {
+    auto sections = design_butterworth_bandpass(order, 0.5, 49.0, fs);
+    assert(static_cast<int>(sections.size()) == order);
+    for (double f : {0.1, 0.5, 1.0, 5.0, 10.0, 30.0, 49.0, 60.0, 120.0, 400.0}) {
+      double expected = butterworth_magnitude(order, 0.5, 49.0, fs, f);
+      double actual = std::abs(sos_response(sections, f, fs));
+      assert(std::fabs(actual - expected) < 1e-6);
+    }
+    assert(std::fabs(std::abs(sos_response(sections, 49.0, fs)) - std::sqrt(0.5)) < 1e-9);
+    assert(std::abs(sos_response(sections, 0.0, fs)) < 1e-12);  // 零点在 z = 1
+  }
+
+  bool thrown = false;
+  try {
+    design_butterworth_bandpass(4, 10.0, 600.0, fs);
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
+
+// 逐采样点的单通道参考实现（直接 II 型转置）
+static std::vector<double> reference_filter(const std::vector<Biquad>& sections, const std::vector<float>& x) {
+  std::vector<double> y(x.begin(), x.end());
+  for (const Biquad& s : sections) {
+    double z1 = 0.0, z2 = 0.0;
+    for (double& v : y) {
+      double out = s.b0 * v + z1;
+      z1 = s.b1 * v - s.a1 * out + z2;
+      z2 = s.b2 * v - s.a2 * out;
+      v = out;
+    }
+  }
+  return y;
+}
+
+// 多通道流式结果与逐通道参考一致，且与分段方式无关
+static void test_streaming_matches_reference() {
+  const int channels = 13;  // 非 8 的倍数，覆盖填充通道
+  const size_t samples = 700;
+  auto sections = design_butterworth_bandpass(4, 0.5, 49.0, 1000.0);
+
+  std::mt19937 rng(3);
+  std::normal_distribution<float> noise(0.0f, 10.0f);
+  std::vector<float> input(channels * samples);
+  for (float& v : input) v = noise(rng);
+
+  std::vector<float> whole(input.size());
+  SosFilterBank bank(sections, channels);
+  bank.process(input.data(), samples, whole.data(), samples, samples);
+
+  for (int c = 0; c < channels; ++c) {
+    std::vector<float> row(input.begin() + c * samples, input.begin() + (c + 1) * samples);
+    std::vector<double> expected = reference_filter(sections, row);
+    for (size_t t = 0; t < samples; ++t) {
+      assert(std::fabs(whole[c * samples + t] - expected[t]) < 1e-4 * (1.0 + std::fabs(expected[t])));
+    }
+  }
+
+  // 原地、分段（含 1 个采样点和跨越内部块大小的段）处理，结果逐位相同
+  std::vector<float> chunked(input);
+  bank.reset();
+  size_t offset = 0;
+  for (size_t length : {1, 5, 64, 100, 130, 400}) {
+    bank.process(chunked.data() + offset, samples, chunked.data() + offset, samples, length);
+    offset += length;
+  }
+  assert(offset == samples);
+  assert(chunked == whole);
+}
+
+// 固定延迟零相位模式：通带内正弦波输出相对输入恰好延迟 lag，相位误差很小
+static void test_zero_phase_lag() {
+  const double fs = 1000.0;
+  const size_t lag = 400;
+  const int channels = 2;
+  const size_t samples = 4000;
+  auto sections = design_butterworth_bandpass(4, 0.5, 49.0, fs);
+  ZeroPhaseFilterBank bank(sections, channels, lag);
+  assert(bank.lag() == lag);
+
+  std::vector<float> input(channels * samples);
+  for (size_t t = 0; t < samples; ++t) {
+    input[t] = static_cast<float>(std::sin(2 * kPi * 10.0 * t / fs));
+    input[samples + t] = static_cast<float>(std::cos(2 * kPi * 20.0 * t / fs));
+  }
+  std::vector<float> output(input.size());
+  for (size_t start = 0; start < samples; start += 250) {
+    bank.process(input.data() + start, samples, output.data() + start, samples, 250);
+  }
+
+  // 跳过启动瞬态，比较 output[t] 与 input[t - lag]
+  double max_error = 0.0;
+  for (int c = 0; c < channels; ++c) {
+    for (size_t t = 2000; t < samples; ++t) {
+      double error = std::fabs(output[c * samples + t] - input[c * samples + t - lag]);
+      max_error = std::max(max_error, error);
+    }
+  }
+  assert(max_error < 0.02);
+
+  // 因果模式下同一信号有明显相移
+  SosFilterBank causal(sections, channels);
+  std::vector<float> causal_out(input.size());
+  causal.process(input.data(), samples, causal_out.data(), samples, samples);
+  double causal_error = 0.0;
+  for (size_t t = 2000; t < samples; ++t) {
+    causal_error = std::max(causal_error, static_cast<double>(std::fabs(causal_out[t] - input[t])));
+  }
+  assert(causal_error > 0.1);
+}
+
+int main() {
+  test_design_matches_butterworth();
+  test_streaming_matches_reference();
+  test_zero_phase_lag();
+  std::cout << "IIR filter tests passed!" << std::endl;
+  return 0;
+}
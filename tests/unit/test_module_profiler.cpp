@@ -0,0 +1,83 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "utils/latency_histogram.h"
+#include "utils/module_profiler.h"
+
+// 桶的上界覆盖桶内所有值，相对误差不超过 1/32
+static void test_bucket_layout() {
+  for (uint64_t v : {0ULL, 1ULL, 63ULL, 64ULL, 65ULL, 1000ULL, 123456ULL, 999999999ULL, (1ULL << 40) + 7}) {
+    size_t index = LatencyHistogram::bucket_index(v);
+    assert(index < LatencyHistogram::kBucketCount);
+    uint64_t upper = LatencyHistogram::bucket_upper(index);
+    assert(upper >= v);
+    assert(upper - v <= v / 32);
+    assert(index == 0 || LatencyHistogram::bucket_upper(index - 1) < v);
+  }
+  assert(LatencyHistogram::bucket_index(~0ULL) == LatencyHistogram::kBucketCount - 1);
+}
+
+// 亚毫秒的时延不再被截断为 0
+static void test_percentiles() {
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 1000; ++i) histogram.record(i * 1000);  // 1 ~ 1000 us
+  LatencySnapshot snapshot = histogram.snapshot();
+  assert(snapshot.count == 1000);
+  assert(snapshot.min_ns == 1000 && snapshot.max_ns == 1000000);
+  assert(snapshot.mean_ns > 500000 && snapshot.mean_ns < 501000);
+  auto near = [](uint64_t actual, uint64_t expected) { return actual >= expected && actual - expected <= expected / 32; };
+  assert(near(snapshot.p50_ns, 500000));
+  assert(near(snapshot.p90_ns, 900000));
+  assert(near(snapshot.p99_ns, 990000));
+  assert(near(snapshot.p999_ns, 999000));
+  assert(snapshot.format("stage").find("max=1000.0us") != std::string::npos);
+
+  // 分位数不超过观测到的最大值
+  LatencyHistogram single;
+  single.record(1000000);
+  assert(single.snapshot().p50_ns == 1000000);
+}
+
+// 多线程同时记录，合并后计数不丢失
+static void test_profiler_threads() {
+  ModuleProfiler disabled;
+  disabled.add_profile(100);
+  assert(disabled.get_profile().count == 0);
+  assert(disabled.report("Off").find("Disabled") != std::string::npos);
+
+  ModuleProfiler profiler(true);
+  const int threads = 12, per_thread = 20000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&profiler, t] {
+      for (int i = 0; i < per_thread; ++i) profiler.add_profile(static_cast<uint64_t>(100 + t));
+    });
+  }
+  // 记录的同时读取快照
+  for (int i = 0; i < 100; ++i) assert(profiler.get_profile().count <= static_cast<uint64_t>(threads) * per_thread);
+  for (auto &worker : workers) worker.join();
+
+  LatencySnapshot snapshot = profiler.get_profile();
+  assert(snapshot.count == static_cast<uint64_t>(threads) * per_thread);
+  assert(snapshot.min_ns == 100 && snapshot.max_ns == 100 + threads - 1);
+  assert(snapshot.throughput > 0.0);
+  assert(profiler.get_run_count() == snapshot.count);
+
+  profiler.start();
+  profiler.stop();
+  assert(profiler.get_profile().count == snapshot.count + 1);
+  profiler.reset();
+  assert(profiler.get_profile().count == 0);
+}
+
+int main() {
+  std::cout << "Running module profiler tests..." << std::endl;
+  test_bucket_layout();
+  test_percentiles();
+  test_profiler_threads();
+  std::cout << "All module profiler tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "modules/network_source.h"
+#include "utils/eeg_simulator.h"
+
+// 非阻塞地调用 process 直到收到 n 个包（最多等 5s），每个包交给 check
+template <class Check>
+static uint64_t receive(NetworkSource &source, uint64_t n, Check check) {
+  Package package;
+  uint64_t count = 0;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (count < n && std::chrono::steady_clock::now() < deadline) {
+    if (source.process(&package)) {
+      check(package, count++);
+      package.recycle();
+    }
+  }
+  return count;
+}
+
+static NetworkSourceConfig make_source_config(NetworkSourceConfig::Protocol protocol, int port) {
+  NetworkSourceConfig config;
+  config.protocol = protocol;
+  config.port = port;
+  config.n_channels = 8;
+  config.max_samples = 64;
+  config.batch = 8;
+  return config;
+}
+
+static EegSimulatorConfig make_simulator_config(bool tcp, int port) {
+  EegSimulatorConfig config;
+  config.tcp = tcp;
+  config.port = port;
+  config.n_channels = 8;
+  config.samples_per_frame = 40;
+  config.format = EegSampleFormat::kFloat32;
+  config.realtime = false;
+  return config;
+}
+
+// 逐点核对解码结果与触发（第 k 个包对应采样点 [40k, 40k + 40)）
+static void check_frame(const Package &package, uint64_t k, float tolerance) {
+  const cv::Mat &raw = package.slot<Slot::kRawEeg>();
+  assert(raw.rows == 8 && raw.cols == 40 && raw.type() == CV_32F);
+  for (int c = 0; c < raw.rows; ++c) {
+    for (int s = 0; s < raw.cols; ++s) {
+      const float expected = EegSimulator::sample_value(c, k * 40 + s, 1000.0);
+      assert(std::fabs(raw.ptr<float>(c)[s] - expected) <= tolerance);
+    }
+  }
+  // 每 100 个采样点一个触发：第 0、3、5、8 ... 帧
+  const uint64_t first = k * 40, next = (first + 99) / 100 * 100;
+  if (next < first + 40) {
+    assert(package.has_slot<Slot::kTrigger>() && package.has_slot<Slot::kTriggerOffset>());
+    assert(package.slot<Slot::kTriggerOffset>() == static_cast<int>(next - first));
+    assert(package.slot<Slot::kTrigger>() == ((next / 100) % 2 == 0 ? kTriggerTarget : kTriggerNonTarget));
+  } else {
+    assert(!package.has_slot<Slot::kTrigger>());
+  }
+}
+
+// UDP：recvmmsg 批量接收，float32 与 int16 两种编码
+static void test_udp() {
+  for (EegSampleFormat format : {EegSampleFormat::kFloat32, EegSampleFormat::kInt16}) {
+    NetworkSource source(make_source_config(NetworkSourceConfig::Protocol::kUdp, 0), 32, false, -1, -1);
+    EegSimulatorConfig config = make_simulator_config(false, source.local_port());
+    config.format = format;
+    EegSimulator simulator(config);
+    simulator.start(60);
+    const float tolerance = format == EegSampleFormat::kInt16 ? config.resolution : 0.0f;
+    const uint64_t received =
+        receive(source, 60, [&](const Package &package, uint64_t k) { check_frame(package, k, tolerance); });
+    simulator.stop();
+    assert(received == 60);
+    const NetworkSource::Stats stats = source.stats();
+    assert(stats.frames == 60 && stats.lost == 0 && stats.malformed == 0);
+    assert(source.ingest_latency().count == 60);
+  }
+}
+
+// 序号跳跃计为丢帧
+static void test_udp_gaps() {
+  NetworkSource source(make_source_config(NetworkSourceConfig::Protocol::kUdp, 0), 32, false, -1, -1);
+  EegSimulatorConfig config = make_simulator_config(false, source.local_port());
+  config.drop_every = 10;  // 序号 9、19、29 ... 被跳过
+  EegSimulator simulator(config);
+  simulator.start(90);
+  const uint64_t received = receive(source, 90, [](const Package &, uint64_t) {});
+  simulator.stop();
+  const NetworkSource::Stats stats = source.stats();
+  assert(received == 90 && stats.frames == 90);
+  assert(stats.lost == 9 && stats.gaps == 9 && stats.out_of_order == 0);
+}
+
+// TCP：字节流按帧切分
+static void test_tcp() {
+  EegSimulator simulator(make_simulator_config(true, 0));
+  NetworkSource source(make_source_config(NetworkSourceConfig::Protocol::kTcp, simulator.local_port()), 32, false,
+                       -1, -1);
+  simulator.start(100);
+  const uint64_t received =
+      receive(source, 100, [](const Package &package, uint64_t k) { check_frame(package, k, 0.0f); });
+  simulator.stop();
+  assert(received == 100);
+  assert(source.stats().frames == 100 && source.stats().lost == 0 && source.stats().malformed == 0);
+}
+
+// TCP：帧之间夹杂的无效字节被跳过，重复的序号被丢弃
+static void test_tcp_resync() {
+  int server = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  assert(::bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0 && ::listen(server, 1) == 0);
+  socklen_t length = sizeof(address);
+  getsockname(server, reinterpret_cast<sockaddr *>(&address), &length);
+
+  NetworkSource source(make_source_config(NetworkSourceConfig::Protocol::kTcp, ntohs(address.sin_port)), 32, false,
+                       -1, -1);
+  std::thread sender([server] {
+    int client = ::accept(server, nullptr, nullptr);
+    EegFrameHeader header{};
+    header.magic = kEegFrameMagic;
+    header.n_channels = 8;
+    header.n_samples = 2;
+    header.format = static_cast<uint8_t>(EegSampleFormat::kFloat32);
+    header.trigger_offset = -1;
+    std::vector<unsigned char> frame(eeg_frame_bytes(header), 0);
+    const unsigned char junk[7] = {'E', 'E', 'G', 0, 1, 2, 3};
+    for (uint32_t sequence : {0u, 1u, 1u, 2u}) {
+      header.sequence = sequence;
+      std::memcpy(frame.data(), &header, sizeof(header));
+      ::send(client, junk, sizeof(junk), 0);
+      ::send(client, frame.data(), frame.size(), 0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ::close(client);
+  });
+  const uint64_t received = receive(source, 3, [](const Package &package, uint64_t) {
+    assert(package.slot<Slot::kRawEeg>().cols == 2);
+  });
+  sender.join();
+  ::close(server);
+  const NetworkSource::Stats stats = source.stats();
+  assert(received == 3 && stats.frames == 3);
+  assert(stats.out_of_order == 1 && stats.malformed >= 4 && stats.lost == 0);
+}
+
+// 配置解析
+static void test_config() {
+  NetworkSourceConfig config = NetworkSourceConfig::from_config(
+      parse_config(R"({"protocol": "tcp", "host": "10.0.0.2", "port": 4455, "n_channels": 32, "batch": 4})"));
+  assert(config.protocol == NetworkSourceConfig::Protocol::kTcp && config.host == "10.0.0.2");
+  assert(config.port == 4455 && config.n_channels == 32 && config.batch == 4 && config.max_samples == 256);
+  bool threw = false;
+  try {
+    NetworkSourceConfig::from_config(parse_config(R"({"protocol": "serial"})"));
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+int main() {
+  std::cout << "Running network source tests..." << std::endl;
+  test_udp();
+  test_udp_gaps();
+  test_tcp();
+  test_tcp_resync();
+  test_config();
+  std::cout << "All network source tests passed!" << std::endl;
+  return 0;
+}
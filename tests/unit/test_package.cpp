@@ -0,0 +1,61 @@
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "utils/common.h"
+
+// 槽位接口与字符串键接口访问的是同一份数据
+static void test_slot_and_string_keys_agree() {
+  Package package;
+  assert(!package.has_slot<Slot::kScore>());
+  assert(!package.has_key("score"));
+
+  package.slot<Slot::kScore>() = 0.75f;
+  assert(package.has_key("score"));
+  assert(package.get_data<float>("score") == 0.75f);
+  assert(package.get_data<double>("score") == 0.75);  // 兼容路径允许算术类型转换
+
+  package.add_data("label", 1);
+  assert(package.has_slot<Slot::kLabel>());
+  assert(package.slot<Slot::kLabel>() == 1);
+
+  // schema 之外的键走通用键值表
+  package.add_data("subject", std::string("sub1"));
+  assert(package.get_data<std::string>("subject") == "sub1");
+  assert(!package.try_get_data<int>("subject"));
+
+  package.remove_data("label");
+  assert(!package.has_slot<Slot::kLabel>());
+}
+
+// 引用访问不拷贝张量，recycle 后槽位失效但缓冲区保留
+static void test_reference_access_and_recycle() {
+  Package package;
+  cv::Mat& epoch = package.slot<Slot::kEpoch>();
+  epoch.create(54, 250, CV_32F);
+  const unsigned char* buffer = epoch.data;
+
+  const Package& view = package;
+  assert(view.slot<Slot::kEpoch>().data == buffer);
+
+  package.recycle();
+  assert(!package.has_slot<Slot::kEpoch>());
+  bool thrown = false;
+  try {
+    view.slot<Slot::kEpoch>();
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  package.slot<Slot::kEpoch>().create(54, 250, CV_32F);
+  assert(package.slot<Slot::kEpoch>().data == buffer);
+}
+
+int main() {
+  std::cout << "Running package tests..." << std::endl;
+  test_slot_and_string_keys_agree();
+  test_reference_access_and_recycle();
+  std::cout << "All package tests passed!" << std::endl;
+  return 0;
+}
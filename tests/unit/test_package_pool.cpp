@@ -0,0 +1,128 @@
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "utils/package_pool.h"
+
+// 统计全局堆分配次数，用于验证稳态下零分配
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// 模拟一个阶段写入数据：复用已有的张量缓冲区
+static void fill(Package* package, int trial) {
+  cv::Mat& eeg = package->mutable_data<cv::Mat>("eeg");
+  eeg.create(64, 1000, CV_32F);
+  eeg.ptr<float>(0)[0] = static_cast<float>(trial);
+  package->add_data("label", trial % 2);
+}
+
+// 预热后，acquire -> 写入 -> 释放 的循环不再触发任何堆分配
+static void test_steady_state_zero_malloc() {
+  PackagePool pool(8);
+  for (int i = 0; i < 32; ++i) {
+    PackagePtr package = pool.acquire();
+    fill(package.get(), i);
+  }
+
+  size_t before = g_allocations.load();
+  for (int i = 0; i < 10000; ++i) {
+    PackagePtr package = pool.acquire();
+    fill(package.get(), i);
+    PackagePtr copy = package;  // 模拟多个阶段共同持有
+  }
+  size_t after = g_allocations.load();
+  assert(after == before);
+
+  PackagePoolStats stats = pool.stats();
+  assert(stats.acquired == 10032);
+  assert(stats.recycled == stats.acquired);
+  assert(stats.block_allocations == 0);
+  assert(stats.available == stats.package_allocations);
+}
+
+// 在其他线程释放的包同样会回到池中
+static void test_cross_thread_release() {
+  PackagePool pool(4);
+  std::vector<PackagePtr> in_flight;
+  for (int i = 0; i < 4; ++i) {
+    in_flight.push_back(pool.acquire());
+  }
+  assert(pool.available() == 0);
+  std::thread sink([&]() { in_flight.clear(); });
+  sink.join();
+  assert(pool.available() == 4);
+
+  // 池空时补充新包，归还后同样保留
+  std::vector<PackagePtr> burst;
+  for (int i = 0; i < 6; ++i) {
+    burst.push_back(pool.acquire());
+  }
+  burst.clear();
+  assert(pool.stats().package_allocations == 6);
+  assert(pool.available() == 6);
+}
+
+// 归还后再取出的包读起来是空的：字符串键与槽位都无效，但张量缓冲区仍被复用
+static void test_recycled_package_is_empty() {
+  PackagePool pool(1);
+  const float* buffer = nullptr;
+  {
+    PackagePtr package = pool.acquire();
+    fill(package.get(), 1);
+    package->add_data("note", std::string("trial 1"));
+    package->set_slot<Slot::kLabel>(1);
+    buffer = package->mutable_data<cv::Mat>("eeg").ptr<float>(0);
+  }
+  PackagePtr package = pool.acquire();
+  assert(!package->has_key("eeg") && !package->has_key("label") && !package->has_key("note"));
+  assert(!package->has_slot<Slot::kLabel>());
+  assert(!package->try_get_data<int>("label").has_value());
+  bool threw = false;
+  try {
+    package->get_data<int>("label");
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  assert(threw);
+
+  cv::Mat& eeg = package->mutable_data<cv::Mat>("eeg");
+  eeg.create(64, 1000, CV_32F);
+  assert(eeg.ptr<float>(0) == buffer && package->has_key("eeg"));
+  package->add_data("label", 2);
+  assert(package->get_data<int>("label") == 2);
+}
+
+// 包可以比池活得更久：池析构后释放的包归还到仍被包持有的共享状态中
+static void test_package_outlives_pool() {
+  PackagePtr package;
+  {
+    PackagePool pool(2);
+    package = pool.acquire();
+    fill(package.get(), 7);
+  }
+  assert(package->mutable_data<cv::Mat>("eeg").ptr<float>(0)[0] == 7.0f);
+  PackagePtr copy = package;
+  package.reset();
+  copy.reset();
+}
+
+int main() {
+  std::cout << "Running package pool tests..." << std::endl;
+  test_steady_state_zero_malloc();
+  test_cross_thread_release();
+  test_recycled_package_is_empty();
+  test_package_outlives_pool();
+  std::cout << "All package pool tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "utils/reorder_buffer.h"
+
+// 乱序到达的元素按序号连续释放
+static void test_in_order_release() {
+  ReorderBuffer<int> buffer(8);
+  assert(buffer.capacity() == 8);
+  int value = -1;
+  assert(buffer.insert(2, 20) == ReorderStatus::kAccepted);
+  assert(buffer.insert(1, 10) == ReorderStatus::kAccepted);
+  assert(!buffer.pop_ready(value));
+  assert(buffer.head_missing());
+  assert(buffer.find(2) != nullptr && *buffer.find(2) == 20);
+  assert(buffer.find(0) == nullptr);
+
+  assert(buffer.insert(0, 0) == ReorderStatus::kAccepted);
+  std::vector<int> released;
+  while (buffer.pop_ready(value)) released.push_back(value);
+  assert((released == std::vector<int>{0, 10, 20}));
+  assert(buffer.next_sequence() == 3 && buffer.pending() == 0 && !buffer.head_missing());
+}
+
+// 迟到、重复与超出窗口
+static void test_rejects() {
+  ReorderBuffer<int> buffer(4, 10);
+  assert(buffer.insert(9, 0) == ReorderStatus::kLate);
+  assert(buffer.insert(10, 0) == ReorderStatus::kAccepted);
+  assert(buffer.insert(10, 1) == ReorderStatus::kDuplicate);
+  assert(buffer.insert(13, 3) == ReorderStatus::kAccepted);
+  assert(buffer.insert(14, 4) == ReorderStatus::kOutOfWindow);
+  assert(buffer.in_window(13) && !buffer.in_window(14));
+  assert(buffer.find(14) == nullptr);
+
+  int value = -1;
+  assert(buffer.pop_ready(value) && value == 0);
+  assert(buffer.insert(10, 0) == ReorderStatus::kLate);  // 已释放
+  assert(buffer.insert(14, 4) == ReorderStatus::kAccepted);
+}
+
+// 放弃等待缺失的序号
+static void test_skip_gap() {
+  ReorderBuffer<int> buffer(8);
+  int value = -1;
+  assert(buffer.skip_gap() == 0);  // 窗口为空时不动
+  assert(buffer.insert(3, 30) == ReorderStatus::kAccepted);
+  assert(buffer.insert(5, 50) == ReorderStatus::kAccepted);
+  assert(buffer.skip_gap() == 3);
+  assert(buffer.pop_ready(value) && value == 30);
+  assert(!buffer.pop_ready(value));
+  assert(buffer.skip_gap() == 1);
+  assert(buffer.pop_ready(value) && value == 50);
+  assert(buffer.insert(4, 40) == ReorderStatus::kLate);  // 已被跳过
+
+  // 窗口为空时直接前移到新的序号
+  assert(buffer.advance_to(100) == 94);
+  assert(buffer.insert(100, 1) == ReorderStatus::kAccepted);
+  assert(buffer.advance_to(200) == 0);
+}
+
+// 释放后窗口不再持有元素，长时间运行占用不变
+static void test_releases_ownership() {
+  ReorderBuffer<std::shared_ptr<int>> buffer(4);
+  std::weak_ptr<int> watch;
+  for (uint64_t sequence = 0; sequence < 1000; ++sequence) {
+    auto item = std::make_shared<int>(static_cast<int>(sequence));
+    if (sequence == 500) watch = item;
+    assert(buffer.insert(sequence, std::move(item)) == ReorderStatus::kAccepted);
+    std::shared_ptr<int> out;
+    assert(buffer.pop_ready(out) && *out == static_cast<int>(sequence));
+  }
+  assert(watch.expired());
+  assert(buffer.pending() == 0 && buffer.next_sequence() == 1000);
+}
+
+int main() {
+  std::cout << "Running reorder buffer tests..." << std::endl;
+  test_in_order_release();
+  test_rejects();
+  test_skip_gap();
+  test_releases_ownership();
+  std::cout << "All reorder buffer tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "framework/pipeline.h"
+
+// 产生 total 个包后不再有数据
+class CountingSource : public Source {
+ public:
+  explicit CountingSource(uint64_t total) : Source(16, false, -1, -1), total_(total) {}
+  bool process(Package *) override {
+    if (produced_ >= total_) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      return false;
+    }
+    ++produced_;
+    return true;
+  }
+
+ private:
+  uint64_t total_;
+  uint64_t produced_{0};
+};
+
+// 副本：处理时间随序号变化，使各副本的输出交错乱序；
+// 可让指定序号的包处理失败（标记后转发），或抛出异常（包丢失，下游出现缺口）
+class ReplicaRunner : public Runner {
+ public:
+  explicit ReplicaRunner(int64_t fail_sequence = -1, int64_t lose_sequence = -1)
+      : Runner(1, false, -1, -1), fail_sequence_(fail_sequence), lose_sequence_(lose_sequence) {}
+  bool process(Package *package) override {
+    const uint64_t sequence = package->get_sequence();
+    std::this_thread::sleep_for(std::chrono::microseconds((sequence * 37) % 50));
+    seen.push_back(sequence);
+    if (static_cast<int64_t>(sequence) == lose_sequence_) {
+      throw std::runtime_error("lost package");
+    }
+    return static_cast<int64_t>(sequence) != fail_sequence_;
+  }
+  std::vector<uint64_t> seen;
+
+ private:
+  int64_t fail_sequence_;
+  int64_t lose_sequence_;
+};
+
+class RecordingSink : public Sink {
+ public:
+  RecordingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    sequences.push_back(package->get_sequence());
+    done.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+  std::mutex mutex;
+  std::vector<uint64_t> sequences;
+  std::atomic<size_t> done{0};
+};
+
+// 可以查看复制阶段合并线程的流水线
+class InspectablePipeline : public Pipeline {
+ public:
+  using Pipeline::Pipeline;
+  const OrderedMerge &merge(int stage) const { return replica_stages_[stage].merger->get_merge(); }
+};
+
+static void wait_for(const RecordingSink &sink, size_t expected) {
+  const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (sink.done.load(std::memory_order_acquire) < expected && std::chrono::steady_clock::now() < give_up) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// 第 1 阶段复制为 3 个副本，按序号恢复顺序后交给 Sink；各模块与 Pipeline 依次 exit() 后 run() 返回
+static void run_replicated(InspectablePipeline &pipeline, CountingSource &source, std::vector<ReplicaRunner *> replicas,
+                           RecordingSink &sink, size_t expected) {
+  std::vector<Module<PackagePtr> *> stage(replicas.begin(), replicas.end());
+  std::thread driver([&] { pipeline.run({{&source}, stage, {&sink}}, false); });
+  wait_for(sink, expected);
+  source.exit();
+  for (auto *replica : replicas) replica->exit();
+  sink.exit();
+  pipeline.exit();
+  driver.join();
+}
+
+// 两种分发策略下 Sink 看到的顺序都与不复制时相同
+static void test_order_preserved() {
+  for (DispatchPolicy policy : {DispatchPolicy::kRoundRobin, DispatchPolicy::kLeastLoaded}) {
+    CountingSource source(1000);
+    ReplicaRunner r0, r1, r2;
+    RecordingSink sink;
+    InspectablePipeline pipeline(3, 8);
+    ReplicationConfig config;
+    config.dispatch = policy;
+    pipeline.set_replication(1, config);
+    run_replicated(pipeline, source, {&r0, &r1, &r2}, sink, 1000);
+
+    assert(sink.sequences.size() == 1000);
+    for (uint64_t i = 0; i < 1000; ++i) assert(sink.sequences[i] == i);
+    assert(r0.seen.size() + r1.seen.size() + r2.seen.size() == 1000);
+    assert(pipeline.merge(1).late() == 0 && pipeline.merge(1).skipped() == 0);
+    if (policy == DispatchPolicy::kRoundRobin) {
+      for (uint64_t sequence : r0.seen) assert(sequence % 3 == 0);
+      for (uint64_t sequence : r1.seen) assert(sequence % 3 == 1);
+      for (uint64_t sequence : r2.seen) assert(sequence % 3 == 2);
+    }
+  }
+}
+
+// 副本丢失的包在等待 max_gap_wait 后被跳过，其后的包照常按顺序输出
+// （包数小于重排窗口，不会因新包超出窗口而提前跳过）
+static void test_dropped_package_skipped() {
+  CountingSource source(40);
+  ReplicaRunner r0, r1(-1, 10), r2;
+  RecordingSink sink;
+  InspectablePipeline pipeline(3, 8);
+  ReplicationConfig config;
+  config.reorder.max_gap_wait = std::chrono::milliseconds(20);
+  pipeline.set_replication(1, config);
+  const auto start = std::chrono::steady_clock::now();
+  run_replicated(pipeline, source, {&r0, &r1, &r2}, sink, 39);
+
+  assert(std::chrono::steady_clock::now() - start >= config.reorder.max_gap_wait);
+  assert(sink.sequences.size() == 39);
+  for (uint64_t i = 0; i < 39; ++i) assert(sink.sequences[i] == (i < 10 ? i : i + 1));
+  assert(pipeline.merge(1).skipped() == 1 && pipeline.merge(1).late() == 0);
+}
+
+// 副本处理失败的包照常到达合并线程：不在缺口上等待 max_gap_wait，Sink 不处理它
+static void test_failed_package_not_waited() {
+  CountingSource source(40);
+  ReplicaRunner r0, r1(10), r2;
+  RecordingSink sink;
+  InspectablePipeline pipeline(3, 8);
+  ReplicationConfig config;
+  config.reorder.max_gap_wait = std::chrono::seconds(5);
+  pipeline.set_replication(1, config);
+  const auto start = std::chrono::steady_clock::now();
+  run_replicated(pipeline, source, {&r0, &r1, &r2}, sink, 39);
+
+  assert(std::chrono::steady_clock::now() - start < config.reorder.max_gap_wait);
+  assert(sink.sequences.size() == 39);
+  for (uint64_t i = 0; i < 39; ++i) assert(sink.sequences[i] == (i < 10 ? i : i + 1));
+  assert(pipeline.merge(1).released() == 40 && pipeline.merge(1).skipped() == 0);
+}
+
+// 重排窗口至少容纳分发与合并之间在途的包：2 * (副本数 * (输入容量 + 1) + 输出容量)，配置更大时取配置值
+static void test_window_sizing() {
+  for (size_t configured : {size_t(16), size_t(256)}) {
+    CountingSource source(10);
+    ReplicaRunner r0, r1, r2;
+    RecordingSink sink;
+    InspectablePipeline pipeline(3, 8);
+    ReplicationConfig config;
+    config.reorder.window = configured;
+    pipeline.set_replication(1, config);
+    run_replicated(pipeline, source, {&r0, &r1, &r2}, sink, 10);
+    assert(pipeline.merge(1).config().window == std::max<size_t>(configured, 2 * (3 * (8 + 1) + 8)));
+  }
+}
+
+// 执行器模式下只调用 Pipeline::exit() 即可停止所有副本、分发与合并任务，run_executor() 随即返回
+static void test_exit_executor() {
+  CountingSource source(500);
+  ReplicaRunner r0, r1;
+  RecordingSink sink;
+  InspectablePipeline pipeline(3, 8);
+  ExecutorConfig config;
+  config.workers = 2;
+  std::thread driver([&] { pipeline.run_executor({{&source}, {&r0, &r1}, {&sink}}, config, false); });
+  wait_for(sink, 500);
+  pipeline.exit();
+  driver.join();
+
+  assert(sink.sequences.size() == 500);
+  for (uint64_t i = 0; i < 500; ++i) assert(sink.sequences[i] == i);
+}
+
+int main() {
+  std::cout << "Running replica tests..." << std::endl;
+  test_order_preserved();
+  test_dropped_package_skipped();
+  test_failed_package_not_waited();
+  test_window_sizing();
+  test_exit_executor();
+  std::cout << "All replica tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "framework/channel.h"
+#include "utils/ring_buffer.h"
+
+// 单线程下的容量与顺序检查
+static void test_capacity_and_order() {
+  SpscRingBuffer<int> spsc(5);
+  assert(spsc.capacity() == 8);  // 向上取整到 2 的幂
+  for (int i = 0; i < 8; ++i) {
+    assert(spsc.try_push(i));
+  }
+  assert(!spsc.try_push(8));
+  int value = -1;
+  for (int i = 0; i < 8; ++i) {
+    assert(spsc.try_pop(value) && value == i);
+  }
+  assert(!spsc.try_pop(value));
+
+  MpscRingBuffer<int> mpsc(4);
+  for (int i = 0; i < 4; ++i) {
+    assert(mpsc.try_push(i));
+  }
+  assert(!mpsc.try_push(4));
+  for (int i = 0; i < 4; ++i) {
+    assert(mpsc.try_pop(value) && value == i);
+  }
+  assert(mpsc.empty());
+}
+
+// SPSC：跨线程传递，保持 FIFO 顺序
+static void test_spsc_threads() {
+  constexpr int kCount = 200000;
+  Channel<int> channel(64, ChannelMode::kSpsc);
+  std::thread producer([&]() {
+    for (int i = 0; i < kCount; ++i) {
+      while (!channel.try_push(i)) std::this_thread::yield();
+    }
+  });
+  int expected = 0;
+  int value = 0;
+  while (expected < kCount) {
+    if (channel.try_pop(value)) {
+      assert(value == expected);
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
+
+// MPSC：多个生产者扇入，每个生产者内部保持顺序且不丢失
+static void test_mpsc_threads() {
+  constexpr int kProducers = 4;
+  constexpr int kCount = 50000;
+  Channel<int> channel(32, ChannelMode::kMpsc);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&, p]() {
+      for (int i = 0; i < kCount; ++i) {
+        while (!channel.try_push(p * kCount + i)) std::this_thread::yield();
+      }
+    });
+  }
+  std::vector<int> next(kProducers, 0);
+  int received = 0;
+  int value = 0;
+  while (received < kProducers * kCount) {
+    if (channel.try_pop(value)) {
+      int p = value / kCount;
+      assert(value % kCount == next[p]);
+      ++next[p];
+      ++received;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& producer : producers) producer.join();
+}
+
+// 各等待策略：空通道超时返回 false，跨线程写入能唤醒等待者
+static void test_wait_strategies() {
+  for (WaitStrategy strategy : {WaitStrategy::busy_spin(), WaitStrategy::spin_yield(), WaitStrategy::park()}) {
+    strategy.timeout = std::chrono::microseconds(2000);
+    Channel<int> channel(4);
+    int value = 0;
+    assert(!channel.pop(value, strategy));
+
+    strategy.timeout = std::chrono::microseconds(2000000);
+    std::thread producer([&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      channel.try_push(42);
+    });
+    assert(channel.pop(value, strategy) && value == 42);
+    producer.join();
+  }
+}
+
+int main() {
+  std::cout << "Running ring buffer tests..." << std::endl;
+  test_capacity_and_order();
+  test_spsc_threads();
+  test_mpsc_threads();
+  test_wait_strategies();
+  std::cout << "All ring buffer tests passed!" << std::endl;
+  return 0;
+}
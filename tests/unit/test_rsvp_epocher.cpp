@@ -0,0 +1,249 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "framework/pipeline.h"
+#include "modules/rsvp_epocher.h"
+
+// 合成数据：第 c 个通道第 t 个采样点为 t + 100000 * c（float 在这个范围内精确）
+static float sample_value(int channel, uint64_t sample) { return static_cast<float>(sample + 100000ull * channel); }
+
+// 连续数据包：[first, first + n)，每 every 个采样点一个触发（目标与非目标交替）
+static PackagePtr make_chunk(int n_channels, uint64_t first, int n, int every) {
+  PackagePtr package = std::make_shared<Package>();
+  cv::Mat &raw = package->slot<Slot::kRawEeg>();
+  raw.create(n_channels, n, CV_32F);
+  for (int c = 0; c < n_channels; ++c) {
+    for (int s = 0; s < n; ++s) raw.ptr<float>(c)[s] = sample_value(c, first + s);
+  }
+  const uint64_t next = (first + every - 1) / every * every;
+  if (next < first + n) {
+    package->slot<Slot::kTrigger>() = (next / every) % 2 == 0 ? kTriggerTarget : kTriggerNonTarget;
+    package->slot<Slot::kTriggerOffset>() = static_cast<int>(next - first);
+  }
+  return package;
+}
+
+// 检查一个试次：刺激起点为 onset，前 pre 个采样点为基线
+static void check_epoch(const Package &epoch, uint64_t onset, int pre, int post, int n_channels) {
+  const cv::Mat &raw = epoch.slot<Slot::kRawEeg>();
+  assert(raw.rows == n_channels && raw.cols == pre + post && raw.type() == CV_32F);
+  assert(epoch.slot<Slot::kTriggerOffset>() == pre);
+  for (int c = 0; c < n_channels; ++c) {
+    const float *row = raw.ptr<float>(c);
+    for (int s = 0; s < raw.cols; ++s) assert(row[s] == sample_value(c, onset - pre + s));
+  }
+}
+
+// 镜像映射：跨过环尾的窗口在每个通道内连续
+static void test_mirrored_ring() {
+  MirroredChannelRing ring(3, 1000);
+  assert(ring.capacity() >= 1000 && ring.capacity() % 1024 == 0 && ring.row_stride() == 2 * ring.capacity());
+  const size_t capacity = ring.capacity();
+  std::vector<float> chunk(3 * 300);
+  uint64_t written = 0;
+  while (written < capacity + 500) {
+    for (int c = 0; c < 3; ++c) {
+      for (int s = 0; s < 300; ++s) chunk[c * 300 + s] = sample_value(c, written + s);
+    }
+    ring.append(chunk.data(), 300, 300);
+    written += 300;
+  }
+  assert(ring.written() == written && ring.oldest() == written - capacity);
+  // 从环尾前 100 个采样点开始、长 400 的窗口
+  const uint64_t start = 2 * capacity - 100 > written ? capacity - 100 : 2 * capacity - 100;
+  assert(start >= ring.oldest() && start + 400 <= written);
+  for (int c = 0; c < 3; ++c) {
+    const float *row = ring.at(start) + c * ring.row_stride();
+    for (int s = 0; s < 400; ++s) assert(row[s] == sample_value(c, start + s));
+  }
+}
+
+// 10 Hz 呈现、1.1 s 试次：试次在刺激后第 post 个采样点到达时发出，相邻试次共享存储
+static void test_epochs() {
+  const int n_channels = 4, pre = 100, post = 1000;
+  EpochConfig config;
+  config.pre = pre;
+  config.post = post;
+  config.capacity = 8192;
+  RsvpEpocher epocher(config, n_channels, 1, false, -1, -1);
+  Channel<PackagePtr> input(64), output(256);
+  epocher.set_input_ptr(&input);
+  epocher.set_output_ptr(&output);
+
+  uint64_t first = 0, checked = 0;
+  const float *previous = nullptr;
+  for (int i = 0; i < 200; ++i, first += 40) {
+    assert(input.try_push(make_chunk(n_channels, first, 40, 100)));
+    assert(epocher.step() == StepResult::kProgress);
+    PackagePtr epoch;
+    while (output.try_pop(epoch)) {
+      // 起点 0 的基线在数据流开始之前，被丢弃；其余触发在 onset + post 个采样点到达后立即发出
+      const uint64_t onset = 100 * (checked + 1);
+      assert(onset + post <= first + 40 && onset + post > first);
+      check_epoch(*epoch, onset, pre, post, n_channels);
+      assert(epoch->slot<Slot::kTrigger>() == ((onset / 100) % 2 == 0 ? kTriggerTarget : kTriggerNonTarget));
+      assert(epoch->get_sequence() == checked);
+      // 零拷贝：相邻试次指向环中相差 100 个采样点的位置（不跨过环尾时）
+      const float *data = epoch->slot<Slot::kRawEeg>().ptr<float>(0);
+      if (previous != nullptr && data > previous) assert(data - previous == 100);
+      previous = data;
+      ++checked;
+    }
+  }
+  // 8000 个采样点：触发 100 ... 7900 中 onset + 1000 <= 8000 的 70 个（100 ... 7000）
+  assert(checked == 70);
+  const RsvpEpocher::Stats stats = epocher.stats();
+  assert(stats.epochs == 70 && stats.dropped == 1 && stats.stalls == 0);
+  assert(epocher.onset_latency().count == 70);
+}
+
+// 下游一直持有试次时暂停读取输入，释放后继续
+static void test_backpressure() {
+  EpochConfig config;
+  config.pre = 0;
+  config.post = 500;
+  config.capacity = 1024;
+  RsvpEpocher epocher(config, 2, 1, false, -1, -1);
+  Channel<PackagePtr> input(64), output(64);
+  epocher.set_input_ptr(&input);
+  epocher.set_output_ptr(&output);
+
+  std::vector<PackagePtr> held;
+  uint64_t first = 0;
+  bool blocked = false;
+  for (int i = 0; i < 60 && !blocked; ++i) {
+    if (input.size() == 0) {
+      assert(input.try_push(make_chunk(2, first, 50, 100)));
+      first += 50;
+    }
+    blocked = epocher.step() == StepResult::kBlocked;
+    PackagePtr epoch;
+    while (output.try_pop(epoch)) held.push_back(epoch);
+  }
+  assert(blocked && epocher.stats().stalls == 1 && !held.empty());
+  // 被持有的试次内容没有被覆盖
+  for (size_t k = 0; k < held.size(); ++k) check_epoch(*held[k], 100 * k, 0, 500, 2);
+  assert(epocher.step() == StepResult::kBlocked);
+
+  held.clear();
+  assert(epocher.step() == StepResult::kProgress);
+  assert(epocher.stats().stalls == 1);
+}
+
+// Source -> RsvpEpocher -> Sink 流水线
+class ChunkSource : public Source {
+ public:
+  ChunkSource(int n_channels, uint64_t n_chunks)
+      : Source(32, false, -1, -1), n_channels_(n_channels), n_chunks_(n_chunks) {}
+
+  bool process(Package *package) override {
+    if (emitted_ >= n_chunks_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return false;
+    }
+    PackagePtr chunk = make_chunk(n_channels_, emitted_ * 40, 40, 100);
+    package->slot<Slot::kRawEeg>() = chunk->slot<Slot::kRawEeg>();
+    if (chunk->has_slot<Slot::kTrigger>()) {
+      package->slot<Slot::kTrigger>() = chunk->slot<Slot::kTrigger>();
+      package->slot<Slot::kTriggerOffset>() = chunk->slot<Slot::kTriggerOffset>();
+    }
+    ++emitted_;
+    return true;
+  }
+
+ private:
+  int n_channels_;
+  uint64_t n_chunks_;
+  uint64_t emitted_{0};
+};
+
+class CheckingSink : public Sink {
+ public:
+  CheckingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    const uint64_t k = count_.load(std::memory_order_relaxed);
+    check_epoch(*package, 100 * (k + 1), 100, 1000, 8);
+    count_.store(k + 1, std::memory_order_release);
+    return true;
+  }
+  uint64_t count() const { return count_.load(std::memory_order_acquire); }
+
+ private:
+  std::atomic<uint64_t> count_{0};
+};
+
+static void test_pipeline() {
+  EpochConfig config;
+  config.pre = 100;
+  config.post = 1000;
+  ChunkSource source(8, 200);
+  RsvpEpocher epocher(config, 8, 1, false, -1, -1);
+  CheckingSink sink;
+  Pipeline pipeline(3, 16);
+  std::thread runner([&] { pipeline.run({{&source}, {&epocher}, {&sink}}, false); });
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (sink.count() < 70 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  source.exit();
+  epocher.exit();
+  sink.exit();
+  pipeline.exit();
+  runner.join();
+  assert(sink.count() == 70 && epocher.stats().epochs == 70);
+}
+
+// 配置解析与参数检查
+// 试次可以比截取模块活得更久：模块析构后，试次视图所指的环仍然有效，释放时归还到仍然存在的池中
+static void test_epoch_outlives_epocher() {
+  const int n_channels = 2, pre = 10, post = 50;
+  EpochConfig config;
+  config.pre = pre;
+  config.post = post;
+  std::vector<PackagePtr> epochs;
+  {
+    RsvpEpocher epocher(config, n_channels, 1, false, -1, -1);
+    Channel<PackagePtr> input(4), output(16);
+    epocher.set_input_ptr(&input);
+    epocher.set_output_ptr(&output);
+    for (uint64_t first = 0; first < 400; first += 40) {
+      assert(input.try_push(make_chunk(n_channels, first, 40, 100)));
+      assert(epocher.step() == StepResult::kProgress);
+    }
+    PackagePtr epoch;
+    while (output.try_pop(epoch)) epochs.push_back(epoch);
+  }
+  assert(epochs.size() == 3);
+  for (size_t i = 0; i < epochs.size(); ++i) check_epoch(*epochs[i], 100 * (i + 1), pre, post, n_channels);
+  epochs.clear();
+}
+
+static void test_config() {
+  EpochConfig config = EpochConfig::from_config(parse_config(R"({"pre": 200, "post": 800, "capacity": 4096})"));
+  assert(config.pre == 200 && config.post == 800 && config.capacity == 4096 && config.length() == 1000);
+  bool threw = false;
+  try {
+    config.capacity = 1500;  // 不足两个试次
+    RsvpEpocher epocher(config, 4, 1, false, -1, -1);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+int main() {
+  std::cout << "Running epocher tests..." << std::endl;
+  test_mirrored_ring();
+  test_epochs();
+  test_backpressure();
+  test_pipeline();
+  test_epoch_outlives_epocher();
+  test_config();
+  std::cout << "All epocher tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "framework/pipeline.h"
+#include "modules/rsvp_epocher.h"
+#include "modules/rsvp_preprocessor.h"
+
+static const int kInputChannels = 8;
+
+static DecimatorConfig test_decimation() {
+  DecimatorConfig config;
+  config.fs = 1000.0;
+  config.factor = 4;
+  config.taps = 32;
+  config.cutoff = 110.0;
+  config.channels = {0, 2, 3, 5, 7};
+  return config;
+}
+
+// 连续数据流：每个通道为正弦 + 直流偏置 + 噪声
+static cv::Mat make_stream(int samples, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> noise(0.0f, 5.0f);
+  cv::Mat stream(kInputChannels, samples, CV_32F);
+  for (int c = 0; c < kInputChannels; ++c) {
+    for (int t = 0; t < samples; ++t) {
+      stream.at<float>(c, t) = 20.0f * std::sin(0.02f * (c + 1) * t) + 50.0f * c + noise(rng);
+    }
+  }
+  return stream;
+}
+
+// 取数据流中 [start, start + n) 的一段作为一个包
+static PackagePtr make_package(const cv::Mat &stream, int start, int n) {
+  cv::Mat raw(stream.rows, n, CV_32F);
+  for (int c = 0; c < stream.rows; ++c) {
+    std::copy_n(stream.ptr<float>(c) + start, n, raw.ptr<float>(c));
+  }
+  PackagePtr package = std::make_shared<Package>();
+  package->set_slot<Slot::kRawEeg>(raw);
+  return package;
+}
+
+static float max_difference(const cv::Mat &a, const cv::Mat &b) {
+  assert(a.rows == b.rows && a.cols == b.cols);
+  float difference = 0.0f;
+  for (int c = 0; c < a.rows; ++c) {
+    for (int t = 0; t < a.cols; ++t) {
+      difference = std::max(difference, std::fabs(a.ptr<float>(c)[t] - b.ptr<float>(c)[t]));
+    }
+  }
+  return difference;
+}
+
+// 离线参考：整段数据一次抽取、一次滤波（可选滑动基线归一化）
+static cv::Mat offline(const cv::Mat &stream, const IirFilterConfig &filter, const NormalizerConfig &normalization) {
+  DecimatorConfig decimation = test_decimation();
+  ChannelDecimator decimator(decimation);
+  const int n_channels = static_cast<int>(decimation.channels.size());
+  const size_t n_out = decimator.output_samples(stream.cols);
+  cv::Mat out(n_channels, static_cast<int>(n_out), CV_32F);
+  decimator.process(stream.ptr<float>(0), stream.step1(), stream.cols, out.ptr<float>(0), out.step1());
+
+  const double fs = decimation.fs / decimation.factor;
+  SosFilterBank bank(design_butterworth_bandpass(filter.order, filter.low_cut, filter.high_cut, fs), n_channels);
+  NormalizerConfig config = normalization;
+  config.fs = fs;
+  ChannelNormalizer normalizer(config, n_channels);
+  bank.process(out.ptr<float>(0), out.step1(), out.ptr<float>(0), out.step1(), n_out,
+               config.mode == NormalizerConfig::Mode::kNone ? nullptr : &normalizer);
+  return out;
+}
+
+// 按不等长的包送入连续数据流，拼接的输出与离线整段处理一致
+static void test_streaming_matches_offline() {
+  const cv::Mat stream = make_stream(3000, 1);
+  IirFilterConfig filter;
+  for (auto mode : {NormalizerConfig::Mode::kNone, NormalizerConfig::Mode::kRunning}) {
+    NormalizerConfig normalization;
+    normalization.mode = mode;
+    normalization.window = 0.5;
+    RsvpPreprocessor preprocessor(test_decimation(), filter, normalization, kInputChannels, 1, false, -1, -1);
+    assert(preprocessor.n_output_channels() == 5 && preprocessor.filter_config().fs == 250.0);
+
+    const cv::Mat expected = offline(stream, filter, normalization);
+    const int sizes[] = {37, 100, 1, 3, 250, 64, 499};
+    int start = 0, produced = 0;
+    for (int i = 0; start < stream.cols; ++i) {
+      const int n = std::min(sizes[i % 7], stream.cols - start);
+      PackagePtr package = make_package(stream, start, n);
+      assert(preprocessor.process(package.get()));
+      const cv::Mat &epoch = std::as_const(*package).slot<Slot::kEpoch>();
+      assert(epoch.type() == CV_32F && epoch.rows == 5);
+      for (int c = 0; c < epoch.rows; ++c) {
+        for (int t = 0; t < epoch.cols; ++t) {
+          assert(std::fabs(epoch.ptr<float>(c)[t] - expected.ptr<float>(c)[produced + t]) < 1e-4f);
+        }
+      }
+      produced += epoch.cols;
+      start += n;
+    }
+    assert(produced == expected.cols);
+  }
+}
+
+// kEpoch 归一化：每个包输出的每个通道均值为 0、标准差为 1
+static void test_epoch_normalization() {
+  NormalizerConfig normalization;
+  normalization.mode = NormalizerConfig::Mode::kEpoch;
+  RsvpPreprocessor preprocessor(test_decimation(), IirFilterConfig(), normalization, kInputChannels, 1, false, -1, -1);
+  const cv::Mat stream = make_stream(2000, 2);
+  for (int start = 0; start < stream.cols; start += 500) {
+    PackagePtr package = make_package(stream, start, 500);
+    assert(preprocessor.process(package.get()));
+    const cv::Mat &epoch = std::as_const(*package).slot<Slot::kEpoch>();
+    assert(epoch.cols == 125);
+    for (int c = 0; c < epoch.rows; ++c) {
+      double sum = 0.0, sum_sq = 0.0;
+      for (int t = 0; t < epoch.cols; ++t) {
+        const double value = epoch.ptr<float>(c)[t];
+        sum += value;
+        sum_sq += value * value;
+      }
+      const double mean = sum / epoch.cols;
+      assert(std::fabs(mean) < 1e-4 && std::fabs(sum_sq / epoch.cols - mean * mean - 1.0) < 1e-3);
+    }
+  }
+}
+
+// reset() 之后同一段数据得到与首次处理相同的结果
+static void test_reset() {
+  RsvpPreprocessor preprocessor(test_decimation(), IirFilterConfig(), NormalizerConfig(), kInputChannels, 1, false,
+                                -1, -1);
+  const cv::Mat stream = make_stream(400, 3);
+  PackagePtr first = make_package(stream, 0, stream.cols);
+  assert(preprocessor.process(first.get()));
+  PackagePtr second = make_package(stream, 0, stream.cols);
+  assert(preprocessor.process(second.get()));
+  const cv::Mat &a = std::as_const(*first).slot<Slot::kEpoch>();
+  assert(max_difference(a, std::as_const(*second).slot<Slot::kEpoch>()) > 0.0f);
+
+  preprocessor.reset();
+  PackagePtr again = make_package(stream, 0, stream.cols);
+  assert(preprocessor.process(again.get()));
+  assert(max_difference(a, std::as_const(*again).slot<Slot::kEpoch>()) == 0.0f);
+}
+
+// 输入格式不符时返回 false；通道下标越界时构造失败
+static void test_invalid_input() {
+  RsvpPreprocessor preprocessor(test_decimation(), IirFilterConfig(), NormalizerConfig(), kInputChannels, 1, false,
+                                -1, -1);
+  PackagePtr empty = std::make_shared<Package>();
+  assert(!preprocessor.process(empty.get()));
+  PackagePtr wrong_rows = make_package(make_stream(40, 4), 0, 40);
+  wrong_rows->slot<Slot::kRawEeg>().create(kInputChannels - 1, 40, CV_32F);
+  assert(!preprocessor.process(wrong_rows.get()));
+  PackagePtr wrong_type = make_package(make_stream(40, 4), 0, 40);
+  wrong_type->slot<Slot::kRawEeg>().create(kInputChannels, 40, CV_64F);
+  assert(!preprocessor.process(wrong_type.get()));
+
+  DecimatorConfig decimation = test_decimation();
+  decimation.channels.push_back(kInputChannels);
+  bool threw = false;
+  try {
+    RsvpPreprocessor invalid(decimation, IirFilterConfig(), NormalizerConfig(), kInputChannels, 1, false, -1, -1);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+// Source -> RsvpEpocher -> RsvpPreprocessor(kEpoch) -> Sink：相邻试次重叠，每个试次应与离线逐试次处理一致
+class StreamSource : public Source {
+ public:
+  StreamSource(const cv::Mat &stream, int chunk, int every)
+      : Source(32, false, -1, -1), stream_(stream), chunk_(chunk), every_(every) {}
+
+  // 每 chunk 个采样点一个包，每 every 个采样点一个触发
+  bool process(Package *package) override {
+    if (first_ >= stream_.cols) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return false;
+    }
+    const int n = std::min(chunk_, stream_.cols - first_);
+    PackagePtr chunk = make_package(stream_, first_, n);
+    package->slot<Slot::kRawEeg>() = chunk->slot<Slot::kRawEeg>();
+    const int next = (first_ + every_ - 1) / every_ * every_;
+    if (next < first_ + n) {
+      package->slot<Slot::kTrigger>() = kTriggerTarget;
+      package->slot<Slot::kTriggerOffset>() = next - first_;
+    }
+    first_ += n;
+    return true;
+  }
+
+ private:
+  const cv::Mat &stream_;
+  int chunk_;
+  int every_;
+  int first_{0};
+};
+
+// 按到达顺序保存每个试次 kEpoch 的拷贝（Sink 之后包会归还到池中）
+class CollectingSink : public Sink {
+ public:
+  CollectingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    const cv::Mat &epoch = std::as_const(*package).slot<Slot::kEpoch>();
+    cv::Mat copy(epoch.rows, epoch.cols, CV_32F);
+    for (int c = 0; c < epoch.rows; ++c) {
+      std::copy_n(epoch.ptr<float>(c), epoch.cols, copy.ptr<float>(c));
+    }
+    epochs.push_back(copy);
+    count.store(epochs.size(), std::memory_order_release);
+    return true;
+  }
+  std::vector<cv::Mat> epochs;
+  std::atomic<size_t> count{0};
+};
+
+// 离线逐试次参考：试次前补 kPad 个抽取后采样点长度的首采样点（"无限长"基线），全新的抽取器与
+// 零状态滤波器处理后去掉补齐部分；零相位时再在尾部补前向结果的最后一个值做反向滤波。归一化只减均值。
+static cv::Mat offline_trial(const cv::Mat &stream, int start, int length, IirFilterConfig::Mode mode) {
+  const size_t kPad = 5000;
+  DecimatorConfig decimation = test_decimation();
+  ChannelDecimator decimator(decimation);
+  const int n_channels = static_cast<int>(decimation.channels.size());
+  const int pad = static_cast<int>(kPad) * decimation.factor;
+  cv::Mat padded(kInputChannels, pad + length, CV_32F);
+  for (int c = 0; c < kInputChannels; ++c) {
+    std::fill_n(padded.ptr<float>(c), pad, stream.ptr<float>(c)[start]);
+    std::copy_n(stream.ptr<float>(c) + start, length, padded.ptr<float>(c) + pad);
+  }
+  const size_t n_out = decimator.output_samples(padded.cols);
+  cv::Mat decimated(n_channels, static_cast<int>(n_out), CV_32F);
+  decimator.process(padded.ptr<float>(0), padded.step1(), padded.cols, decimated.ptr<float>(0), decimated.step1());
+
+  IirFilterConfig filter;
+  auto sections = design_butterworth_bandpass(filter.order, filter.low_cut, filter.high_cut,
+                                              decimation.fs / decimation.factor);
+  SosFilterBank forward(sections, n_channels);
+  forward.process(decimated.ptr<float>(0), decimated.step1(), decimated.ptr<float>(0), decimated.step1(), n_out);
+
+  const int n = static_cast<int>(n_out - kPad);
+  cv::Mat out(n_channels, n, CV_32F);
+  for (int c = 0; c < n_channels; ++c) {
+    std::copy_n(decimated.ptr<float>(c) + kPad, n, out.ptr<float>(c));
+  }
+  if (mode == IirFilterConfig::Mode::kZeroPhase) {
+    // 反转后在前面补最后一个值，正向滤波即为原序列的反向滤波
+    cv::Mat reversed(n_channels, static_cast<int>(kPad) + n, CV_32F);
+    for (int c = 0; c < n_channels; ++c) {
+      std::fill_n(reversed.ptr<float>(c), kPad, out.ptr<float>(c)[n - 1]);
+      std::reverse_copy(out.ptr<float>(c), out.ptr<float>(c) + n, reversed.ptr<float>(c) + kPad);
+    }
+    SosFilterBank backward(sections, n_channels);
+    backward.process(reversed.ptr<float>(0), reversed.step1(), reversed.ptr<float>(0), reversed.step1(),
+                     reversed.cols);
+    for (int c = 0; c < n_channels; ++c) {
+      std::reverse_copy(reversed.ptr<float>(c) + kPad, reversed.ptr<float>(c) + kPad + n, out.ptr<float>(c));
+    }
+  }
+  for (int c = 0; c < n_channels; ++c) {
+    double mean = 0.0;
+    for (int t = 0; t < n; ++t) mean += out.ptr<float>(c)[t];
+    mean /= n;
+    for (int t = 0; t < n; ++t) out.ptr<float>(c)[t] = static_cast<float>(out.ptr<float>(c)[t] - mean);
+  }
+  return out;
+}
+
+static void test_epoched_pipeline() {
+  const int pre = 50, post = 250, every = 100;
+  const cv::Mat stream = make_stream(3000, 5);
+  // 触发在 0, 100, ..., 2900：0 号之前没有基线，2800 之后的凑不齐 post
+  const size_t expected = 27;
+  for (auto mode : {IirFilterConfig::Mode::kCausal, IirFilterConfig::Mode::kZeroPhase}) {
+    EpochConfig epoching;
+    epoching.pre = pre;
+    epoching.post = post;
+    IirFilterConfig filter;
+    filter.mode = mode;
+    NormalizerConfig normalization;
+    normalization.mode = NormalizerConfig::Mode::kEpoch;
+    normalization.scale = false;
+
+    StreamSource source(stream, 40, every);
+    RsvpEpocher epocher(epoching, kInputChannels, 1, false, -1, -1);
+    RsvpPreprocessor preprocessor(test_decimation(), filter, normalization, kInputChannels, 1, false, -1, -1);
+    preprocessor.set_input_mode(RsvpPreprocessor::InputMode::kEpoch);
+    CollectingSink sink;
+    Pipeline pipeline(4, 16);
+    std::thread driver([&] { pipeline.run({{&source}, {&epocher}, {&preprocessor}, {&sink}}, false); });
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (sink.count.load(std::memory_order_acquire) < expected && std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    source.exit();
+    epocher.exit();
+    preprocessor.exit();
+    sink.exit();
+    pipeline.exit();
+    driver.join();
+
+    assert(sink.epochs.size() == expected);
+    for (size_t k = 0; k < expected; ++k) {
+      const int onset = every * static_cast<int>(k + 1);
+      const cv::Mat reference = offline_trial(stream, onset - pre, pre + post, mode);
+      assert(sink.epochs[k].cols == (pre + post) / test_decimation().factor);
+      assert(max_difference(sink.epochs[k], reference) < 1e-3f);
+    }
+  }
+}
+
+// "stream" / "epoch" 之外的输入方式被拒绝
+static void test_parse_input_mode() {
+  assert(RsvpPreprocessor::parse_input_mode("stream") == RsvpPreprocessor::InputMode::kStream);
+  assert(RsvpPreprocessor::parse_input_mode("epoch") == RsvpPreprocessor::InputMode::kEpoch);
+  bool threw = false;
+  try {
+    RsvpPreprocessor::parse_input_mode("trial");
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+int main() {
+  std::cout << "Running RsvpPreprocessor tests..." << std::endl;
+  test_streaming_matches_offline();
+  test_epoch_normalization();
+  test_reset();
+  test_invalid_input();
+  test_epoched_pipeline();
+  test_parse_input_mode();
+  std::cout << "All RsvpPreprocessor tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,156 @@
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "inference/xgbdim_model_file.h"
+#include "modules/rsvp_runner.h"
+#include "xgbdim_test_utils.h"
+
+// 生成随机模型并保存为 .xgbm
+static std::shared_ptr<XgbdimEngine> make_model(int n_samples, unsigned seed, const std::string &path) {
+  std::mt19937 rng(seed);
+  XgbdimGeometry geometry;
+  geometry.n_samples = n_samples;
+  geometry.build();
+  auto engine = std::make_shared<XgbdimEngine>(random_params(geometry, rng), geometry);
+  save_xgbdim_model(*engine, path);
+  return engine;
+}
+
+static PackagePtr make_epoch(const XgbdimGeometry &geometry, std::mt19937 &rng) {
+  std::normal_distribution<float> noise(0.0f, 0.01f);
+  PackagePtr package = std::make_shared<Package>();
+  cv::Mat epoch(geometry.n_channels, geometry.n_samples, CV_32F);
+  for (int c = 0; c < geometry.n_channels; ++c) {
+    for (int t = 0; t < geometry.n_samples; ++t) epoch.at<float>(c, t) = noise(rng);
+  }
+  package->set_slot<Slot::kEpoch>(epoch);
+  return package;
+}
+
+// 推理线程持续调用 process() 时反复热替换：每个结果都来自某一个完整的模型，替换完成后的包使用新模型
+static void test_reload_under_load(const std::string &path_a, const std::string &path_b) {
+  auto engine_a = load_xgbdim_model(path_a);
+  auto engine_b = load_xgbdim_model(path_b);
+  RsvpRunner runner(engine_a, 1, false, -1, -1);
+
+  std::mt19937 rng(7);
+  PackagePtr package = make_epoch(engine_a->geometry(), rng);
+  const cv::Mat &epoch = std::as_const(*package).slot<Slot::kEpoch>();
+  const float score_a = engine_a->predict(epoch.ptr<float>(0), epoch.step1()).score;
+  const float score_b = engine_b->predict(epoch.ptr<float>(0), epoch.step1()).score;
+  assert(score_a != score_b);
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> processed{0}, mixed{0};
+  std::thread inference([&] {
+    PackagePtr local = std::make_shared<Package>();
+    local->set_slot<Slot::kEpoch>(epoch);
+    while (!stop.load(std::memory_order_acquire)) {
+      assert(runner.process(local.get()));
+      const float score = local->slot<Slot::kScore>();
+      if (score != score_a && score != score_b) {
+        mixed.fetch_add(1);
+      }
+      processed.fetch_add(1);
+    }
+  });
+
+  for (int i = 0; i < 50; ++i) {
+    assert(runner.reload_model(i % 2 == 0 ? path_b : path_a));
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  assert(runner.reload_model(path_b));
+  stop.store(true, std::memory_order_release);
+  inference.join();
+  assert(processed.load() > 0 && mixed.load() == 0);
+
+  // 替换完成后新到的包使用新模型，并沿用原来的精度与提前退出设置
+  assert(runner.process(package.get()) && package->slot<Slot::kScore>() == score_b);
+  assert(runner.engine()->precision() == engine_a->precision());
+}
+
+// 输入形状不符或文件无法加载时拒绝替换，继续使用旧模型
+static void test_reject(const std::string &path_a, const std::string &path_other_shape) {
+  auto engine_a = load_xgbdim_model(path_a);
+  RsvpRunner runner(engine_a, 1, false, -1, -1);
+  assert(!runner.reload_model(path_other_shape));
+  assert(runner.engine() == engine_a);
+  assert(!runner.reload_model("does_not_exist.xgbm"));
+  assert(runner.engine() == engine_a);
+
+  bool threw = false;
+  try {
+    runner.swap_engine(nullptr);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw && runner.engine() == engine_a);
+}
+
+// 降级的包（ShedPolicy::kDegrade）使用 degraded_early_exit 快速推理，其余包照常完整求值；批处理同样如此
+static void test_degraded_early_exit(const std::string &path) {
+  auto engine = load_xgbdim_model(path);
+  RsvpRunner runner(engine, 1, false, -1, -1);
+  XgbdimEarlyExit fast;
+  fast.enabled = true;
+  fast.strict = false;
+  fast.bound_scale = 1e-9;  // 上界几乎为零：第一次检查即退出
+  fast.block = 1;
+  runner.set_degraded_early_exit(fast);
+
+  std::mt19937 rng(11);
+  PackagePtr normal = make_epoch(engine->geometry(), rng);
+  PackagePtr degraded = make_epoch(engine->geometry(), rng);
+  degraded->mark_degraded();
+  const cv::Mat &x_normal = std::as_const(*normal).slot<Slot::kEpoch>();
+  const cv::Mat &x_degraded = std::as_const(*degraded).slot<Slot::kEpoch>();
+  const XgbdimResult full = engine->predict(x_normal.ptr<float>(0), x_normal.step1());
+  const XgbdimResult quick = engine->predict(x_degraded.ptr<float>(0), x_degraded.step1(), fast);
+  assert(quick.models_evaluated < engine->predict(x_degraded.ptr<float>(0), x_degraded.step1()).models_evaluated);
+
+  assert(runner.process(normal.get()) && runner.process(degraded.get()));
+  assert(normal->slot<Slot::kModelsEvaluated>() == full.models_evaluated && normal->slot<Slot::kScore>() == full.score);
+  assert(degraded->slot<Slot::kModelsEvaluated>() == quick.models_evaluated);
+  assert(degraded->slot<Slot::kScore>() == quick.score && degraded->slot<Slot::kLabel>() == quick.label);
+
+  Package *batch[] = {degraded.get(), normal.get()};
+  bool ok[2] = {false, false};
+  degraded->set_slot<Slot::kModelsEvaluated>(-1);
+  normal->set_slot<Slot::kModelsEvaluated>(-1);
+  runner.process_batch(batch, 2, ok);
+  assert(ok[0] && ok[1]);
+  assert(degraded->slot<Slot::kModelsEvaluated>() == quick.models_evaluated);
+  assert(normal->slot<Slot::kModelsEvaluated>() == full.models_evaluated);
+
+  // 关闭后降级的包照常完整求值
+  fast.enabled = false;
+  runner.set_degraded_early_exit(fast);
+  assert(runner.process(degraded.get()));
+  assert(degraded->slot<Slot::kModelsEvaluated>() == full.models_evaluated);
+}
+
+int main() {
+  std::cout << "Running RsvpRunner tests..." << std::endl;
+  const std::string path_a = "test_rsvp_runner_a.xgbm";
+  const std::string path_b = "test_rsvp_runner_b.xgbm";
+  const std::string path_other = "test_rsvp_runner_other.xgbm";
+  make_model(40, 1, path_a);
+  make_model(40, 2, path_b);
+  make_model(50, 3, path_other);
+
+  test_reload_under_load(path_a, path_b);
+  test_reject(path_a, path_other);
+  test_degraded_early_exit(path_a);
+
+  for (const std::string &path : {path_a, path_b, path_other}) std::remove(path.c_str());
+  std::cout << "All RsvpRunner tests passed!" << std::endl;
+  return 0;
+}
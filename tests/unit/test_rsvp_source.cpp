@@ -0,0 +1,155 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modules/rsvp_source.h"
+
+static const std::string kPath = "test_rsvp_source.rsvpr";
+static const int kChannels = 3;
+static const size_t kSamples = 1000;
+
+// 第 c 个通道第 i 个采样点的值为 c * 10000 + i
+static void write_recording() {
+  std::vector<float> data(kChannels * kSamples);
+  for (int c = 0; c < kChannels; ++c) {
+    for (size_t i = 0; i < kSamples; ++i) data[c * kSamples + i] = static_cast<float>(c * 10000 + i);
+  }
+  // 未排序写入；100 上有两个事件（只取第一个）
+  std::vector<RecordingEvent> events = {
+      {350, kTriggerNonTarget, 0}, {95, kTriggerTarget, 0}, {100, kTriggerNonTarget, 0}, {100, kTriggerTarget, 0}};
+  save_recording(kPath, 1000.0, kChannels, kSamples, data.data(), events);
+}
+
+static ReplayConfig make_config(ReplayConfig::Mode mode) {
+  ReplayConfig config;
+  config.path = kPath;
+  config.mode = mode;
+  config.chunk = 40;
+  return config;
+}
+
+// 文件头与校验
+static void test_file() {
+  RecordingFile file(kPath);
+  assert(file.n_channels() == kChannels && file.n_samples() == kSamples && file.fs() == 1000.0);
+  assert(file.row_stride() >= kSamples && file.row_stride() % 16 == 0);
+  assert(file.row(2)[7] == 20007.0f);
+  assert(file.n_events() == 4 && file.events()[0].sample == 95 && file.events()[3].sample == 350);
+  assert(file.lower_event(96) == 1 && file.lower_event(351) == 4);
+
+  // 篡改一个采样点后校验失败（不校验时仍可打开）
+  const std::string corrupt = "test_rsvp_source_corrupt.rsvpr";
+  {
+    std::ifstream in(kPath, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    content[content.size() / 2] ^= 0x40;
+    std::ofstream out(corrupt, std::ios::binary);
+    out << content;
+  }
+  bool threw = false;
+  try {
+    RecordingFile bad(corrupt);
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+  RecordingFile unchecked(corrupt, false, false);
+  assert(unchecked.n_samples() == kSamples);
+  std::remove(corrupt.c_str());
+}
+
+// 最快速度回放：按块切分，包内最多一个触发，数据直接指向映射内存
+static void test_max_speed() {
+  RsvpSource source(make_config(ReplayConfig::Mode::kMaxSpeed), 32, false, -1, -1);
+  Package package;
+  std::vector<int> sizes, triggers, offsets;
+  size_t position = 0;
+  while (source.process(&package)) {
+    const cv::Mat &raw = std::as_const(package).slot<Slot::kRawEeg>();
+    assert(raw.rows == kChannels && raw.type() == CV_32F);
+    for (int c = 0; c < kChannels; ++c) {
+      assert(raw.ptr<float>(c)[0] == static_cast<float>(c * 10000 + position));
+      assert(raw.ptr<float>(c)[raw.cols - 1] == static_cast<float>(c * 10000 + position + raw.cols - 1));
+    }
+    sizes.push_back(raw.cols);
+    triggers.push_back(package.has_slot<Slot::kTrigger>() ? package.slot<Slot::kTrigger>() : 0);
+    offsets.push_back(package.has_slot<Slot::kTriggerOffset>() ? package.slot<Slot::kTriggerOffset>() : -1);
+    position += raw.cols;
+    package.recycle();
+  }
+  assert(position == kSamples && source.samples_emitted() == kSamples);
+  assert(source.finished());
+  assert(!source.process(&package));
+
+  // [80, 100) 含 95 上的触发，并在 100 上的第二个触发之前截断
+  assert(sizes[0] == 40 && sizes[1] == 40 && sizes[2] == 20 && sizes[3] == 40);
+  assert(triggers[2] == kTriggerTarget && offsets[2] == 15);
+  assert(triggers[3] == kTriggerNonTarget && offsets[3] == 0);
+  int trigger_count = 0;
+  for (size_t i = 0; i < triggers.size(); ++i) trigger_count += triggers[i] != 0;
+  assert(trigger_count == 3);
+  assert(triggers[9] == kTriggerNonTarget && offsets[9] == 10);  // [340, 380) 含 350
+}
+
+// 实时回放：10 倍速下 1000 个采样点约 100ms；循环回放时数据从头开始
+static void test_realtime_and_loop() {
+  ReplayConfig config = make_config(ReplayConfig::Mode::kRealtime);
+  config.speed = 10.0;
+  config.loop = true;
+  RsvpSource source(config, 32, false, -1, -1);
+  Package package;
+  const auto start = std::chrono::steady_clock::now();
+  int idle = 0;
+  while (source.samples_emitted() < kSamples) {
+    if (!source.process(&package)) {
+      ++idle;  // 未到时间（执行器模式下不阻塞）
+      continue;
+    }
+    package.recycle();
+  }
+  const double elapsed_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "  realtime x10: " << kSamples << " samples in " << elapsed_ms << " ms" << std::endl;
+  assert(elapsed_ms >= 95.0 && idle > 0);
+
+  // 继续回放：序号连续，数据回到文件开头
+  while (!source.process(&package)) {
+  }
+  const cv::Mat &raw = std::as_const(package).slot<Slot::kRawEeg>();
+  assert(raw.ptr<float>(1)[0] == 10000.0f);
+  assert(!source.finished());
+}
+
+// 配置解析
+static void test_config() {
+  ConfigNode node = parse_config(R"({"path": "a.rsvpr", "mode": "max_speed", "chunk": 25, "loop": true})");
+  ReplayConfig config = ReplayConfig::from_config(node);
+  assert(config.path == "a.rsvpr" && config.mode == ReplayConfig::Mode::kMaxSpeed);
+  assert(config.chunk == 25 && config.loop && config.speed == 1.0);
+  bool threw = false;
+  try {
+    ReplayConfig::from_config(parse_config(R"({"mode": "fast"})"));
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+int main() {
+  std::cout << "Running replay source tests..." << std::endl;
+  write_recording();
+  test_file();
+  test_max_speed();
+  test_realtime_and_loop();
+  test_config();
+  std::remove(kPath.c_str());
+  std::cout << "All replay source tests passed!" << std::endl;
+  return 0;
+}
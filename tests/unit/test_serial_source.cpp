@@ -0,0 +1,225 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "framework/pipeline.h"
+#include "modules/serial_source.h"
+#include "utils/eeg_simulator.h"
+
+// 非阻塞地调用 process 直到收到 n 个采样点（最多等 5s），每个包交给 check
+template <class Check>
+static uint64_t receive(SerialSource &source, uint64_t n, Check check) {
+  Package package;
+  uint64_t samples = 0;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (samples < n && std::chrono::steady_clock::now() < deadline) {
+    if (source.process(&package)) {
+      check(package, samples);
+      samples += package.slot<Slot::kRawEeg>().cols;
+      package.recycle();
+    }
+  }
+  return samples;
+}
+
+static SerialSourceConfig make_source_config(const std::string &device, SerialSourceConfig::Wakeup wakeup) {
+  SerialSourceConfig config;
+  config.device = device;
+  config.n_channels = 8;
+  config.chunk = 40;
+  config.wakeup = wakeup;
+  config.buffer_frames = 128;  // 小缓冲区，让测试覆盖写满后的搬移
+  return config;
+}
+
+static SerialSimulatorConfig make_simulator_config() {
+  SerialSimulatorConfig config;
+  config.n_channels = 8;
+  config.realtime = false;
+  return config;
+}
+
+// 逐点核对解码结果与触发：first 为包的第一个采样点，每 every 个采样点一个触发，触发电平保持 10 个采样点
+static void check_package(const Package &package, uint64_t first, uint64_t every) {
+  const cv::Mat &raw = package.slot<Slot::kRawEeg>();
+  assert(raw.rows == 8 && raw.cols >= 1 && raw.cols <= 40 && raw.type() == CV_32F);
+  const float tolerance = SerialSimulatorConfig().resolution;
+  for (int c = 0; c < raw.rows; ++c) {
+    for (int s = 0; s < raw.cols; ++s) {
+      const float expected = EegSimulator::sample_value(c, first + s, 1000.0);
+      assert(std::fabs(raw.ptr<float>(c)[s] - expected) <= tolerance);
+    }
+  }
+  const uint64_t next = (first + every - 1) / every * every;
+  if (next < first + raw.cols) {
+    assert(package.has_slot<Slot::kTrigger>() && package.has_slot<Slot::kTriggerOffset>());
+    assert(package.slot<Slot::kTriggerOffset>() == static_cast<int>(next - first));
+    assert(package.slot<Slot::kTrigger>() == ((next / every) % 2 == 0 ? kTriggerTarget : kTriggerNonTarget));
+    assert(next + every >= first + raw.cols);  // 每包最多一个触发
+  } else {
+    assert(!package.has_slot<Slot::kTrigger>());
+  }
+}
+
+// 两种唤醒方式下逐点核对
+static void test_decode() {
+  for (SerialSourceConfig::Wakeup wakeup : {SerialSourceConfig::Wakeup::kEpoll, SerialSourceConfig::Wakeup::kBatch}) {
+    SerialEegSimulator simulator(make_simulator_config());
+    SerialSource source(make_source_config(simulator.device(), wakeup), 32, false, -1, -1);
+    simulator.start(1000);
+    const uint64_t received =
+        receive(source, 1000, [](const Package &package, uint64_t first) { check_package(package, first, 100); });
+    simulator.stop();
+    assert(received == 1000);
+    const SerialSource::Stats stats = source.stats();
+    assert(stats.samples == 1000 && stats.packages == 25);
+    assert(stats.lost == 0 && stats.crc_errors == 0 && stats.skipped_bytes == 0);
+    assert(source.ingest_latency().count == 25);
+  }
+}
+
+// 每 30 个采样点一个触发：包在第二个触发之前截断，[0, 30) [30, 60) ...
+static void test_trigger_cut() {
+  SerialSimulatorConfig config = make_simulator_config();
+  config.trigger_every = 30;
+  SerialEegSimulator simulator(config);
+  SerialSource source(make_source_config(simulator.device(), SerialSourceConfig::Wakeup::kEpoll), 32, false, -1, -1);
+  simulator.start(1000);
+  const uint64_t received = receive(source, 990, [](const Package &package, uint64_t first) {
+    assert(package.slot<Slot::kRawEeg>().cols == 30);
+    check_package(package, first, 30);
+  });
+  simulator.stop();
+  assert(received == 990 && source.stats().packages == 33);
+}
+
+// 丢帧与误码：计数跳跃计入 lost，CRC 错误的帧被跳过后重新对齐
+static void test_loss_and_corruption() {
+  SerialSimulatorConfig config = make_simulator_config();
+  config.drop_every = 50;
+  config.corrupt_every = 70;
+  config.trigger_every = 0;
+  SerialEegSimulator simulator(config);
+  SerialSource source(make_source_config(simulator.device(), SerialSourceConfig::Wakeup::kEpoll), 32, false, -1, -1);
+  simulator.start(730);
+  // 730 帧中第 69、139 ... 699 帧被破坏，余下 720 帧；第 49、99 ... 699 帧之前各跳过一个计数
+  const uint64_t received = receive(source, 720, [](const Package &, uint64_t) {});
+  simulator.stop();
+  const SerialSource::Stats stats = source.stats();
+  assert(received == 720 && stats.samples == 720);
+  // 被破坏的帧内可能恰好出现假同步字，CRC 错误数可能多于 10，但跳过的字节数是确定的
+  assert(stats.crc_errors >= 10 && stats.skipped_bytes == 10 * serial_frame_bytes(8));
+  // 14 个跳过的计数加上 10 个被破坏的帧；第 349、699 帧既跳过计数又被破坏，各合并为一次跳跃
+  assert(stats.lost == 24 && stats.gaps == 22);
+}
+
+// 帧之间夹杂的无效字节（包括假同步字）被原地跳过
+static void test_resync() {
+  const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+  assert(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0);
+  SerialSource source(make_source_config(ptsname(master), SerialSourceConfig::Wakeup::kEpoll), 32, false, -1, -1);
+  const size_t frame_bytes = serial_frame_bytes(8);
+  std::vector<unsigned char> frame(frame_bytes);
+  std::vector<int32_t> counts(8);
+  const unsigned char junk[5] = {0x00, kSerialSync0, kSerialSync1, 0x13, kSerialSync0};
+  for (int i = 0; i < 40; ++i) {
+    for (int c = 0; c < 8; ++c) counts[c] = i * 8 + c - 100;
+    encode_serial_frame(frame.data(), static_cast<uint8_t>(i), 0, counts.data(), 8);
+    if (i % 4 == 0) {
+      assert(::write(master, junk, sizeof(junk)) == static_cast<ssize_t>(sizeof(junk)));
+    }
+    assert(::write(master, frame.data(), frame.size()) == static_cast<ssize_t>(frame.size()));
+  }
+  const uint64_t received = receive(source, 40, [](const Package &package, uint64_t) {
+    const cv::Mat &raw = package.slot<Slot::kRawEeg>();
+    for (int i = 0; i < raw.cols; ++i) {
+      for (int c = 0; c < 8; ++c) {
+        assert(std::fabs(raw.ptr<float>(c)[i] - (i * 8 + c - 100) * SerialSourceConfig().resolution) < 1e-5f);
+      }
+    }
+  });
+  ::close(master);
+  const SerialSource::Stats stats = source.stats();
+  assert(received == 40 && stats.lost == 0);
+  assert(stats.skipped_bytes == 10 * sizeof(junk) && stats.crc_errors == 10);
+}
+
+class CountingSink : public Sink {
+ public:
+  CountingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *package) override {
+    samples_.fetch_add(package->slot<Slot::kRawEeg>().cols, std::memory_order_relaxed);
+    return true;
+  }
+  uint64_t samples() const { return samples_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> samples_{0};
+};
+
+// 在流水线中按 1000 Hz 实时接收（process 可以阻塞等待）
+static void test_pipeline() {
+  SerialSimulatorConfig simulator_config = make_simulator_config();
+  simulator_config.realtime = true;
+  SerialEegSimulator simulator(simulator_config);
+  SerialSource source(make_source_config(simulator.device(), SerialSourceConfig::Wakeup::kBatch), 32, false, -1, -1);
+  CountingSink sink;
+  Pipeline pipeline(2, 16);
+  std::thread runner([&] { pipeline.run({{&source}, {&sink}}, false); });
+  simulator.start(400);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (sink.samples() < 400 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  simulator.stop();
+  source.exit();
+  sink.exit();
+  pipeline.exit();
+  runner.join();
+  assert(sink.samples() == 400 && source.stats().lost == 0);
+}
+
+// 配置解析
+static void test_config() {
+  SerialSourceConfig config = SerialSourceConfig::from_config(
+      parse_config(R"({"device": "/dev/ttyACM0", "baud": 460800, "n_channels": 16, "wakeup": "batch"})"));
+  assert(config.device == "/dev/ttyACM0" && config.baud == 460800 && config.n_channels == 16);
+  assert(config.wakeup == SerialSourceConfig::Wakeup::kBatch && config.chunk == 40);
+  bool threw = false;
+  try {
+    SerialSourceConfig::from_config(parse_config(R"({"wakeup": "select"})"));
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  assert(threw);
+  threw = false;
+  try {
+    SerialSimulatorConfig slow;
+    slow.baud = 115200;  // 8 通道 1000 Hz 需要 320 kbaud
+    SerialEegSimulator simulator(slow);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  assert(threw);
+}
+
+int main() {
+  std::cout << "Running serial source tests..." << std::endl;
+  test_decode();
+  test_trigger_cut();
+  test_loss_and_corruption();
+  test_resync();
+  test_pipeline();
+  test_config();
+  std::cout << "All serial source tests passed!" << std::endl;
+  return 0;
+}
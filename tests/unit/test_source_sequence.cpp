@@ -0,0 +1,143 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "framework/pipeline.h"
+
+// 产生 total 个包，用 kLabel 标记来自哪个 Source
+class TaggedSource : public Source {
+ public:
+  TaggedSource(int tag, uint64_t total) : Source(16, false, -1, -1), tag_(tag), total_(total) {}
+  bool process(Package *package) override {
+    if (produced_ >= total_) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      return false;
+    }
+    ++produced_;
+    package->set_slot<Slot::kLabel>(tag_);
+    return true;
+  }
+
+ private:
+  int tag_;
+  uint64_t total_;
+  uint64_t produced_{0};
+};
+
+// 按重排窗口释放的顺序记录序号与来源
+class RecordingPostprocessor : public Postprocessor {
+ public:
+  RecordingPostprocessor() : Postprocessor(2, false, -1, -1) {}
+  bool process(Package *package) override {
+    sequences.push_back(package->get_sequence());
+    ++from[package->slot<Slot::kLabel>()];
+    return true;
+  }
+  std::vector<uint64_t> sequences;
+  uint64_t from[2]{0, 0};
+};
+
+class CountingSink : public Sink {
+ public:
+  CountingSink() : Sink(1, false, -1, -1) {}
+  bool process(Package *) override {
+    done.fetch_add(1, std::memory_order_release);
+    return true;
+  }
+  std::atomic<uint64_t> done{0};
+};
+
+static void wait_for(const CountingSink &sink, uint64_t expected) {
+  const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (sink.done.load(std::memory_order_acquire) < expected && std::chrono::steady_clock::now() < give_up) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// 两个 Source 汇入同一条流水线：序号在两者之间不重复，重排窗口按序号释放全部包，没有包被当作重复或迟到丢弃
+static void test_two_sources_threads() {
+  TaggedSource a(0, 500), b(1, 500);
+  RecordingPostprocessor postprocess;
+  CountingSink sink;
+  Pipeline pipeline(3, 16);
+  std::thread driver([&] { pipeline.run({{&a, &b}, {&postprocess}, {&sink}}, false); });
+  wait_for(sink, 1000);
+  a.exit();
+  b.exit();
+  postprocess.exit();
+  sink.exit();
+  pipeline.exit();
+  driver.join();
+
+  assert(sink.done.load() == 1000 && postprocess.sequences.size() == 1000);
+  for (uint64_t i = 0; i < 1000; ++i) assert(postprocess.sequences[i] == i);
+  assert(postprocess.from[0] == 500 && postprocess.from[1] == 500);
+  assert(postprocess.get_merge().late() == 0 && postprocess.get_merge().skipped() == 0);
+  assert(a.get_next_sequence() == 500 && b.get_next_sequence() == 500);
+}
+
+// 融合模式同样共用序号
+static void test_two_sources_fused() {
+  TaggedSource a(0, 300), b(1, 300);
+  RecordingPostprocessor postprocess;
+  CountingSink sink;
+  Pipeline pipeline(3);
+  std::thread driver([&] { pipeline.seq_run({{&a, &b}, {&postprocess}, {&sink}}, false); });
+  wait_for(sink, 600);
+  pipeline.exit();
+  driver.join();
+
+  std::vector<bool> seen(600, false);
+  assert(postprocess.sequences.size() == 600);
+  for (uint64_t sequence : postprocess.sequences) {
+    assert(sequence < 600 && !seen[sequence]);
+    seen[sequence] = true;
+  }
+  assert(postprocess.from[0] == 300 && postprocess.from[1] == 300);
+}
+
+// 每 10 个包中序号为 3 的那个处理失败
+class FailingRunner : public Runner {
+ public:
+  FailingRunner() : Runner(1, false, -1, -1) {}
+  bool process(Package *package) override { return package->get_sequence() % 10 != 3; }
+};
+
+// 处理失败的包标记后照常转发：重排窗口不在缺口上等待 max_gap_wait，后续阶段不再处理它
+static void test_failed_packages_leave_no_gap() {
+  TaggedSource source(0, 200);
+  FailingRunner runner;
+  RecordingPostprocessor postprocess;
+  ReorderConfig reorder;
+  reorder.max_gap_wait = std::chrono::seconds(5);
+  postprocess.set_reorder(reorder);
+  CountingSink sink;
+  Pipeline pipeline(4, 16);
+  const auto start = std::chrono::steady_clock::now();
+  std::thread driver([&] { pipeline.run({{&source}, {&runner}, {&postprocess}, {&sink}}, false); });
+  wait_for(sink, 180);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  source.exit();
+  runner.exit();
+  postprocess.exit();
+  sink.exit();
+  pipeline.exit();
+  driver.join();
+
+  assert(elapsed < reorder.max_gap_wait);
+  assert(sink.done.load() == 180 && postprocess.sequences.size() == 180);
+  for (uint64_t sequence : postprocess.sequences) assert(sequence % 10 != 3);
+  assert(postprocess.get_merge().released() == 200 && postprocess.get_merge().skipped() == 0);
+}
+
+int main() {
+  std::cout << "Running source sequence tests..." << std::endl;
+  test_two_sources_threads();
+  test_two_sources_fused();
+  test_failed_packages_leave_no_gap();
+  std::cout << "All source sequence tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "framework/tracker.h"
+
+// 按给定的各阶段时间戳（微秒）构造一个走完三个阶段的包
+static void stamp(Package &package, uint64_t sequence, int64_t origin_us, const int64_t (&hops_us)[3][2]) {
+  package.recycle();
+  package.set_sequence(sequence);
+  PackageTrace &trace = package.trace();
+  trace.origin = TraceClock::from_ns(origin_us * 1000);
+  for (int i = 0; i < 3; ++i) {
+    trace.mark_dequeue(i, TraceClock::from_ns(hops_us[i][0] * 1000));
+    trace.mark_enqueue(i, TraceClock::from_ns(hops_us[i][1] * 1000));
+  }
+}
+
+// 换算回纳秒后误差在 1% 以内
+static bool near(uint64_t actual, uint64_t expected) {
+  return actual + expected / 100 >= expected && actual <= expected + expected / 100;
+}
+
+// 排队/处理时间与端到端时延
+static void test_breakdown() {
+  TrackerConfig config;
+  config.sample_every = 0;
+  Tracker tracker(3, config);
+  Package package;
+  for (uint64_t n = 0; n < 100; ++n) {
+    const int64_t t = 1000 + static_cast<int64_t>(n) * 10000;
+    // origin -> Source 开始 +5，Source 处理 10，排队 20，处理 100，排队 30，处理 1
+    const int64_t hops[3][2] = {{t + 5, t + 15}, {t + 35, t + 135}, {t + 165, t + 166}};
+    stamp(package, n, t, hops);
+    tracker.complete(package);
+  }
+  assert(tracker.service(0).count == 100 && tracker.queue_wait(0).count == 0);
+  assert(near(tracker.service(1).min_ns, 100000) && near(tracker.service(1).max_ns, 100000));
+  assert(near(tracker.queue_wait(1).max_ns, 20000));
+  assert(near(tracker.queue_wait(2).max_ns, 30000));
+  assert(near(tracker.service(2).max_ns, 1000));
+  assert(tracker.end_to_end().count == 100 && near(tracker.end_to_end().max_ns, 166000));
+  assert(tracker.sample_count() == 0);
+  assert(tracker.report().find("end-to-end: n=100") != std::string::npos);
+
+  // 缺失的时间戳（例如没有经过某阶段）不计入
+  package.recycle();
+  tracker.complete(package);
+  assert(tracker.end_to_end().count == 100);
+}
+
+// 抽样样本环与 Chrome trace 导出
+static void test_export() {
+  TrackerConfig config;
+  config.sample_every = 10;
+  config.max_samples = 4;
+  Tracker tracker(3, config);
+  tracker.set_stage_name(1, "Runner");
+  Package package;
+  for (uint64_t n = 0; n < 100; ++n) {
+    const int64_t t = 1000000 + static_cast<int64_t>(n) * 1000;
+    const int64_t hops[3][2] = {{t, t + 10}, {t + 20, t + 120}, {t + 130, t + 140}};
+    stamp(package, n, t, hops);
+    tracker.complete(package);
+  }
+  assert(tracker.sample_count() == 4);  // 10 个样本，环中保留最近的 4 个
+
+  const std::string path = "test_tracker_trace.json";
+  assert(tracker.export_chrome_trace(path));
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  const std::string json = content.str();
+  assert(json.find("\"traceEvents\"") != std::string::npos);
+  assert(json.find("\"name\":\"Runner\",\"ph\":\"X\"") != std::string::npos);
+  assert(json.find("\"name\":\"queue\"") != std::string::npos);
+  assert(json.find("\"sequence\":90") != std::string::npos);
+  assert(json.find("\"sequence\":50") == std::string::npos);  // 已被覆盖
+  std::remove(path.c_str());
+}
+
+int main() {
+  std::cout << "Running tracker tests..." << std::endl;
+  test_breakdown();
+  test_export();
+  std::cout << "All tracker tests passed!" << std::endl;
+  return 0;
+}
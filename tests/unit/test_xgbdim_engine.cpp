@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "inference/simd_kernels.h"
+#include "inference/xgbdim_engine.h"
+#include "inference/xgbdim_quantized.h"
+#include "xgbdim_test_utils.h"
+
+// 逐行照搬 predict_ZT206_HYX / decision_value 的双精度参考实现（不做任何折叠）
+static double reference_decision(const XgbdimParams& p, const XgbdimGeometry& g, const std::vector<double>& epoch) {
+  const int ch = g.n_channels;
+  const int te = g.n_samples;
+
+  // preprocess_ZT206_HYX：按通道去均值
+  std::vector<double> x(epoch);
+  for (int c = 0; c < ch; ++c) {
+    double mean = 0.0;
+    for (int t = 0; t < te; ++t) mean += x[c * te + t];
+    mean /= te;
+    for (int t = 0; t < te; ++t) x[c * te + t] -= mean;
+  }
+
+  // get_3Dconv：channel_loc 为 1..54 排成 6 x 9，cup.T.reshape(-1)
+  std::vector<int> channel;
+  for (int c = 6; c < 54; ++c) channel.push_back(c);
+  for (int c : {58, 54, 60, 55, 56, 57}) channel.push_back(c);
+  std::vector<std::vector<int>> channel_conv;
+  for (int y = 0; y + 3 <= 6; y += 3) {
+    for (int xs = 0; xs + 3 <= 9; xs += 3) {
+      std::vector<int> cup;
+      for (int cx = 0; cx < 3; ++cx) {
+        for (int cy = 0; cy < 3; ++cy) cup.push_back((y + cy) * 9 + xs + cx + 1);
+      }
+      channel_conv.push_back(cup);
+    }
+  }
+  std::vector<int> window_st;
+  for (int st = 1; st < te - g.win_len + 1; st += g.win_len / 2) window_st.push_back(st);
+  const int n_win = static_cast<int>(window_st.size());
+  const int n_model = std::min(n_win * static_cast<int>(channel_conv.size()), g.max_n_model);
+
+  // batchnormalize_global + 三重循环
+  std::vector<double> x_bn(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    x_bn[i] = p.gamma_global[i] * (x[i] - p.m_global[i]) / std::sqrt(p.sigma_global[i]) + p.beta_global[i];
+  }
+  double h = 0.0;
+  for (int m = 0; m < p.n_sp; ++m) {
+    for (int q = 0; q < p.n_te; ++q) {
+      double value = 0.0;
+      for (int c = 0; c < ch; ++c) {
+        for (int t = 0; t < te; ++t) {
+          value += p.w_global[m * ch + c] * x_bn[c * te + t] * p.q_global[t * p.n_te + q];
+        }
+      }
+      h += value / p.n_sp / p.n_te;
+    }
+  }
+  h += p.b_global;
+  if (n_model > 1) h *= g.gstf_weight;
+
+  // get_3D_cuboids_ZT206_HYX + batchnormalize + 局部子模型
+  const int t_local = g.win_len * 9;
+  for (int k = 0; k < n_model - 1; ++k) {
+    int conv = p.conv_sort[k];
+    int idx_chan = conv / n_win;
+    int idx_win = conv % n_win;
+    double f = p.w_local[k * (t_local + 1)];
+    for (int j = 0; j < t_local; ++j) {
+      int row = channel[channel_conv[idx_chan][j % 9] - 1] - 1;
+      int col = window_st[idx_win] - 1 + j / 9;
+      double bn = p.gamma[k] * (x[row * te + col] - p.m_local[k * t_local + j]) / std::sqrt(p.sigma[k * t_local + j]) +
+                  p.beta[k];
+      f += p.w_local[k * (t_local + 1) + 1 + j] * bn;
+    }
+    h += p.lr_model[k] * f;
+  }
+  return h;
+}
+
+static void check_against_reference(int n_samples, int max_n_model) {
+  std::mt19937 rng(1234 + max_n_model);
+  XgbdimGeometry geometry;
+  geometry.n_samples = n_samples;
+  geometry.max_n_model = max_n_model;
+  geometry.build();
+
+  XgbdimParams params = random_params(geometry, rng);
+  XgbdimEngine engine(params, geometry);
+  assert(engine.n_local_models() == std::max(geometry.n_model - 1, 0));
+
+  // 每个通道带一个直流偏置，检验去均值；行间距大于 n_samples，检验 row_stride
+  const size_t stride = n_samples + 7;
+  std::uniform_real_distribution<double> noise(-20.0, 20.0);
+  std::vector<double> epoch(static_cast<size_t>(geometry.n_channels) * n_samples);
+  std::vector<float> input(geometry.n_channels * stride, 0.0f);
+  for (int c = 0; c < geometry.n_channels; ++c) {
+    double offset = 50.0 * c;
+    for (int t = 0; t < n_samples; ++t) {
+      float value = static_cast<float>(offset + noise(rng));
+      epoch[c * n_samples + t] = value;
+      input[c * stride + t] = value;
+    }
+  }
+
+  double expected = reference_decision(params, geometry, epoch);
+  for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+    set_simd_level(level);
+    XgbdimResult result = engine.predict(input.data(), stride);
+    double tolerance = 1e-4 * (1.0 + std::fabs(expected));
+    if (std::fabs(result.decision - expected) > tolerance) {
+      std::cerr << "decision mismatch (" << simd_level_name(simd_level()) << "): " << result.decision << " vs "
+                << expected << std::endl;
+      assert(false);
+    }
+    double score = 1.0 / (1.0 + std::exp(-expected));
+    assert(std::fabs(result.score - score) < 1e-5);
+    assert(result.label == (result.score >= 0.5f ? 1 : 0));
+  }
+  set_simd_level(SimdLevel::kAvx512);
+}
+
+// 关闭去均值时，输入按原样参与计算
+static void test_demean_switch() {
+  std::mt19937 rng(7);
+  XgbdimGeometry geometry;
+  geometry.n_samples = 24;
+  geometry.build();
+  XgbdimEngine engine(random_params(geometry, rng), geometry);
+
+  std::vector<float> zero_mean(geometry.n_channels * geometry.n_samples, 0.0f);
+  std::vector<float> shifted(zero_mean.size(), 3.0f);
+  float base = engine.predict(zero_mean.data(), geometry.n_samples).decision;
+  assert(engine.predict(shifted.data(), geometry.n_samples).decision == base);
+  engine.set_demean(false);
+  assert(engine.predict(shifted.data(), geometry.n_samples).decision != base);
+}
+
+// 批量推理与逐个推理一致（块大小不整除批大小，行间距各不相同，去均值开关都覆盖）
+static void test_predict_batch() {
+  std::mt19937 rng(11);
+  XgbdimGeometry geometry;
+  geometry.n_samples = 60;
+  geometry.max_n_model = 40;
+  geometry.build();
+  XgbdimEngine engine(random_params(geometry, rng), geometry);
+
+  const size_t count = XgbdimEngine::kBatchBlock * 2 + 3;
+  std::uniform_real_distribution<float> noise(-20.0f, 20.0f);
+  std::vector<std::vector<float>> inputs(count);
+  std::vector<const float*> epochs(count);
+  std::vector<size_t> strides(count);
+  for (size_t i = 0; i < count; ++i) {
+    strides[i] = geometry.n_samples + i % 3;
+    inputs[i].resize(geometry.n_channels * strides[i]);
+    for (float& v : inputs[i]) v = 10.0f * (i % 4) + noise(rng);
+    epochs[i] = inputs[i].data();
+  }
+
+  for (bool demean : {true, false}) {
+    engine.set_demean(demean);
+    std::vector<XgbdimResult> results(count);
+    engine.predict_batch(epochs.data(), strides.data(), count, results.data());
+    for (size_t i = 0; i < count; ++i) {
+      XgbdimResult single = engine.predict(epochs[i], strides[i]);
+      assert(std::fabs(results[i].decision - single.decision) < 1e-4f * (1.0f + std::fabs(single.decision)));
+      assert(results[i].label == single.label || std::fabs(single.score - 0.5f) < 1e-5f);
+    }
+  }
+}
+
+// 定点模式：与 float 模式的判决值接近，且各指令集的整数内核结果一致
+static void test_quantized() {
+  std::mt19937 rng(13);
+  XgbdimGeometry geometry;
+  geometry.max_n_model = 120;
+  geometry.build();
+  XgbdimEngine engine(random_params(geometry, rng), geometry);
+  std::mt19937 same(13);
+  XgbdimEngine reference(random_params(geometry, same), geometry);
+  engine.set_precision(XgbdimPrecision::kInt8);
+  assert(engine.precision() == XgbdimPrecision::kInt8 && engine.quantized() != nullptr);
+  assert(XgbdimEngine::parse_precision(XgbdimEngine::precision_name(XgbdimPrecision::kInt8)) ==
+         XgbdimPrecision::kInt8);
+
+  // 定点权重约为 float 权重的 1/4
+  const size_t float_bytes = (static_cast<size_t>(geometry.n_channels) * geometry.n_samples +
+                              static_cast<size_t>(engine.n_local_models()) * geometry.t_local) * sizeof(float);
+  assert(engine.quantized()->weight_bytes() * 2 < float_bytes);
+
+  const size_t stride = geometry.n_samples + 3;
+  std::uniform_real_distribution<float> noise(-20.0f, 20.0f);
+  for (int trial = 0; trial < 5; ++trial) {
+    std::vector<float> input(geometry.n_channels * stride);
+    for (float& v : input) v = 5.0f * trial + noise(rng);
+
+    double expected = reference.predict(input.data(), stride).decision;
+    float first = 0.0f;
+    for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kAvx2, SimdLevel::kAvx512}) {
+      set_simd_level(level);
+      float decision = engine.predict(input.data(), stride).decision;
+      if (level == SimdLevel::kScalar) {
+        first = decision;
+      }
+      assert(std::fabs(decision - first) < 1e-5f * std::fabs(first));  // 整数点积相同，只差 float 累加顺序
+      assert(std::fabs(decision - expected) < 0.02 * (1.0 + std::fabs(expected)));
+    }
+  }
+  set_simd_level(SimdLevel::kAvx512);
+
+  // 切回 float 后与原模型相同
+  engine.set_precision(XgbdimPrecision::kFloat32);
+  assert(engine.quantized() == nullptr);
+  std::vector<float> zeros(geometry.n_channels * geometry.n_samples, 1.0f);
+  assert(engine.predict(zeros.data(), geometry.n_samples).decision ==
+         reference.predict(zeros.data(), geometry.n_samples).decision);
+}
+
+// 严格模式的提前退出与完整求和标签相同；非严格模式退出更早
+static void test_early_exit() {
+  std::mt19937 rng(21);
+  XgbdimGeometry geometry;
+  geometry.build();
+  XgbdimParams params = random_params(geometry, rng);
+  XgbdimEngine full(params, geometry);
+  XgbdimEngine strict(params, geometry);
+  XgbdimEngine loose(params, geometry);
+  XgbdimEarlyExit early_exit;
+  early_exit.enabled = true;
+  early_exit.block = 8;
+  strict.set_early_exit(early_exit);
+  early_exit.strict = false;
+  loose.set_early_exit(early_exit);
+
+  const int n_local = full.n_local_models();
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  int strict_total = 0;
+  int loose_total = 0;
+  for (int trial = 0; trial < 50; ++trial) {
+    // 部分 trial 叠加与全局权重同号的成分，使判决值远离 0
+    std::vector<float> input(geometry.n_channels * geometry.n_samples);
+    const float drive = static_cast<float>(trial % 5) * 2.0f;
+    for (size_t i = 0; i < input.size(); ++i) {
+      float w = full.folded().global_weight[i];
+      input[i] = noise(rng) + drive * (trial % 2 == 0 ? w : -w) / (std::fabs(w) + 1e-3f);
+    }
+
+    XgbdimResult expected = full.predict(input.data(), geometry.n_samples);
+    XgbdimResult result = strict.predict(input.data(), geometry.n_samples);
+    assert(expected.models_evaluated == n_local);
+    assert(result.label == expected.label);
+    assert(result.models_evaluated >= 0 && result.models_evaluated <= n_local);
+    if (result.models_evaluated == n_local) {
+      assert(std::fabs(result.decision - expected.decision) < 1e-3f * (1.0f + std::fabs(expected.decision)));
+    }
+    XgbdimResult approx = loose.predict(input.data(), geometry.n_samples);
+    assert(approx.models_evaluated <= result.models_evaluated);
+    // 单次调用指定提前退出设置，与引擎自身设置的结果相同
+    XgbdimResult overridden = full.predict(input.data(), geometry.n_samples, early_exit);
+    assert(overridden.models_evaluated == approx.models_evaluated && overridden.decision == approx.decision);
+    strict_total += result.models_evaluated;
+    loose_total += approx.models_evaluated;
+  }
+  assert(strict_total < 50 * n_local);  // 至少有 trial 提前结束
+  assert(loose_total <= strict_total);
+
+  // 批推理逐个调用 predict，结果与单个推理相同
+  std::vector<float> input(geometry.n_channels * geometry.n_samples, 0.5f);
+  const float* epochs[2] = {input.data(), input.data()};
+  const size_t strides[2] = {static_cast<size_t>(geometry.n_samples), static_cast<size_t>(geometry.n_samples)};
+  XgbdimResult batch[2];
+  strict.predict_batch(epochs, strides, 2, batch);
+  assert(batch[1].models_evaluated == strict.predict(input.data(), geometry.n_samples).models_evaluated);
+
+  // 非法配置
+  bool thrown = false;
+  try {
+    XgbdimEarlyExit::from_config(parse_config(R"({"enabled": true, "block": 0})"));
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
+
+// 形状不匹配的参数在构造时报错
+static void test_shape_validation() {
+  std::mt19937 rng(9);
+  XgbdimGeometry geometry;
+  geometry.n_samples = 24;
+  geometry.build();
+  XgbdimParams params = random_params(geometry, rng);
+  params.sigma.pop_back();
+  bool thrown = false;
+  try {
+    XgbdimEngine engine(params, geometry);
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
+
+int main() {
+  check_against_reference(40, 299);  // 全部立方体都参与
+  check_against_reference(40, 10);   // 子模型数被 max_n_model 截断
+  check_against_reference(40, 1);    // 只有全局模型
+  test_demean_switch();
+  test_predict_batch();
+  test_quantized();
+  test_early_exit();
+  test_shape_validation();
+  std::cout << "XGB-DIM engine tests passed!" << std::endl;
+  return 0;
+}
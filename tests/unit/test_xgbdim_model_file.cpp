@@ -0,0 +1,78 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "inference/xgbdim_model_file.h"
+#include "xgbdim_test_utils.h"
+
+static std::vector<char> read_file(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void write_file(const std::string& path, const std::vector<char>& bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+static bool load_fails(const std::string& path) {
+  try {
+    load_xgbdim_model(path);
+  } catch (const std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+int main() {
+  std::mt19937 rng(42);
+  XgbdimGeometry geometry;
+  geometry.n_samples = 40;
+  geometry.build();
+  XgbdimEngine engine(random_params(geometry, rng, 2), geometry);
+  engine.set_demean(false);
+
+  const std::string path = "test_xgbdim_model_file.xgbm";
+  save_xgbdim_model(engine, path);
+
+  // 映射加载后与原引擎结果完全一致，权重指向 64 字节对齐的映射内存
+  auto loaded = load_xgbdim_model(path);
+  assert(!loaded->demean());
+  assert(loaded->n_local_models() == engine.n_local_models());
+  assert(loaded->folded().bias == engine.folded().bias);
+  assert(reinterpret_cast<uintptr_t>(loaded->folded().global_weight) % kSimdAlignment == 0);
+  assert(reinterpret_cast<uintptr_t>(loaded->folded().local_weight) % kSimdAlignment == 0);
+
+  std::uniform_real_distribution<float> noise(-10.0f, 10.0f);
+  std::vector<float> epoch(static_cast<size_t>(geometry.n_channels) * geometry.n_samples);
+  for (int trial = 0; trial < 5; ++trial) {
+    for (float& v : epoch) v = noise(rng);
+    assert(loaded->predict(epoch.data(), geometry.n_samples).decision ==
+           engine.predict(epoch.data(), geometry.n_samples).decision);
+  }
+
+  // 任意一个字节被改动都会被校验和发现
+  std::vector<char> original = read_file(path);
+  std::vector<char> corrupted = original;
+  corrupted[corrupted.size() / 2] ^= 0x01;
+  write_file(path, corrupted);
+  assert(load_fails(path));
+
+  // 截断的文件
+  write_file(path, std::vector<char>(original.begin(), original.begin() + original.size() / 2));
+  assert(load_fails(path));
+
+  // 版本号不符
+  corrupted = original;
+  corrupted[8] = 99;
+  write_file(path, corrupted);
+  assert(load_fails(path));
+
+  std::remove(path.c_str());
+  std::cout << "XGB-DIM model file tests passed!" << std::endl;
+  return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "inference/xgbdim_model.h"
+
+// 随机生成一组形状合法的模型参数（n_sp 为全局模型的空间滤波器数）
+inline XgbdimParams random_params(const XgbdimGeometry& geometry, std::mt19937& rng, int n_sp = 3) {
+  std::uniform_real_distribution<double> weight(-1.0, 1.0);
+  std::uniform_real_distribution<double> variance(0.5, 2.0);
+  auto fill = [&](size_t count, std::uniform_real_distribution<double>& dist) {
+    std::vector<double> values(count);
+    for (double& v : values) v = dist(rng);
+    return values;
+  };
+
+  const size_t global_size = static_cast<size_t>(geometry.n_channels) * geometry.n_samples;
+  XgbdimParams params;
+  params.n_sp = n_sp;
+  params.n_te = 2;
+  params.w_global = fill(static_cast<size_t>(params.n_sp) * geometry.n_channels, weight);
+  params.q_global = fill(static_cast<size_t>(geometry.n_samples) * params.n_te, weight);
+  params.b_global = weight(rng);
+  params.gamma_global = fill(global_size, variance);
+  params.beta_global = fill(global_size, weight);
+  params.m_global = fill(global_size, weight);
+  params.sigma_global = fill(global_size, variance);
+
+  params.n_local = geometry.n_conv;
+  params.w_local = fill(static_cast<size_t>(params.n_local) * (geometry.t_local + 1), weight);
+  params.gamma = fill(params.n_local, variance);
+  params.beta = fill(params.n_local, weight);
+  params.m_local = fill(static_cast<size_t>(params.n_local) * geometry.t_local, weight);
+  params.sigma = fill(static_cast<size_t>(params.n_local) * geometry.t_local, variance);
+  params.lr_model = fill(params.n_local, variance);
+  params.conv_sort.resize(params.n_local);
+  std::iota(params.conv_sort.begin(), params.conv_sort.end(), 0);
+  std::shuffle(params.conv_sort.begin(), params.conv_sort.end(), rng);
+  return params;
+}